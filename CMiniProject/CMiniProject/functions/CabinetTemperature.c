@@ -2,20 +2,29 @@
 #include "..\\src\\headers\\Functions.h"
 #include "..\\src\\headers\\Globals.h"
 
+bool SetCabinetTemperature(short temperature) {
+	if (temperature < 0 || temperature > 35) {
+		return false;
+	}
+	if (temperature < 10 || temperature > 30) {
+		cabinetTemperatureControl = '1';
+		cabinetTemperature = 20;
+	} else {
+		cabinetTemperatureControl = '0';
+		cabinetTemperature = temperature;
+	}
+	return true;
+}
+
 void CabinetTemperature() {
+	short temperature;
 	while (true) {
-		printf("%s", "Enter cabinet temperature: ");
-		scanf(" %hu", &cabinetTemperature);
-		if (cabinetTemperature < 0 || cabinetTemperature > 35) {
+		OutputPrompt("Enter cabinet temperature: ");
+		if (InputTemperature(&temperature) == false
+				|| SetCabinetTemperature(temperature) == false) {
 			printf("%s",
 					"\nCabinet temperature is invalid, initiate cabinet temperature stabilization protocol.\n\n");
 		} else {
-			if (cabinetTemperature < 10 || cabinetTemperature > 30) {
-				cabinetTemperatureControl = '1';
-				cabinetTemperature = 20;
-			} else {
-				cabinetTemperatureControl = '0';
-			}
 			VehicleStatus();
 			return;
 		}
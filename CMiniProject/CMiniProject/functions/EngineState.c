@@ -0,0 +1,12 @@
+#include "..\\src\\headers\\Functions.h"
+#include "..\\src\\headers\\Globals.h"
+
+void EngineOn() {
+	engineTemperature = 125;
+	engineState = '1';
+}
+
+void EngineOff() {
+	engineTemperature = 30;
+	engineState = '0';
+}
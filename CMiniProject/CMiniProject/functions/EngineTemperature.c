@@ -2,20 +2,29 @@
 #include "..\\src\\headers\\Functions.h"
 #include "..\\src\\headers\\Globals.h"
 
+bool SetEngineTemperature(short temperature) {
+	if (temperature < 70 || temperature > 175) {
+		return false;
+	}
+	if (temperature < 100 || temperature > 150) {
+		engineTemperatureControl = '1';
+		engineTemperature = 125;
+	} else {
+		engineTemperatureControl = '0';
+		engineTemperature = temperature;
+	}
+	return true;
+}
+
 void EngineTemperature() {
+	short temperature;
 	while (true) {
-		printf("%s", "Enter engine temperature: ");
-		scanf(" %hu", &engineTemperature);
-		if (engineTemperature < 70 || engineTemperature > 175) {
+		OutputPrompt("Enter engine temperature: ");
+		if (InputTemperature(&temperature) == false
+				|| SetEngineTemperature(temperature) == false) {
 			printf("%s",
 					"\nEngine temperature is invalid, initiate engine temperature stabilization protocol.\n\n");
 		} else {
-			if (engineTemperature < 100 || engineTemperature > 150) {
-				engineTemperatureControl = '1';
-				engineTemperature = 125;
-			} else {
-				engineTemperatureControl = '0';
-			}
 			VehicleStatus();
 			return;
 		}
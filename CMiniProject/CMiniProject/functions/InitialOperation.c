@@ -5,24 +5,23 @@
 void InitialOperation() {
 	while (true) {
 #ifdef WITH_ENGINE_TEMP_CONTROLLER
-		printf("%s", "\nPlease choose what you do want:\n\n"
+		OutputMenu("\nPlease choose what you do want:\n\n"
 				"\ta. Turn off vehicle engine.\n"
 				"\tb. Set traffic light color.\n"
 				"\tc. Sets cabinet temperature.\n"
 				"\td. Set engine temperature.\n");
 #else
-		printf("%s", "\nPlease choose what you do want:\n\n"
+		OutputMenu("\nPlease choose what you do want:\n\n"
 						"\ta. Turn off vehicle engine.\n"
 						"\tb. Set traffic light color.\n"
 						"\tc. Sets cabinet temperature.\n");
 #endif
-		printf("%s", "\nYour choice: ");
-		scanf(" %c", &userInput);
+		OutputPrompt("\nYour choice: ");
+		userInput = InputChoice();
 		switch (userInput) {
 		case 'a':
 		case 'A':
-			engineTemperature = 30;
-			engineState = false;
+			EngineOff();
 			printf("%s", "\nEngine turned off.\n\n");
 			return;
 		case 'b':
@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "..\\src\\headers\\Functions.h"
+#include "..\\src\\headers\\Globals.h"
+
+/*
+ * Reports are buffered & written when the buffer fills, before waiting on a
+ * prompt or at exit. Quiet mode skips menus & prompts for batch runs, the
+ * reports are then written once the buffer fills or at exit. The end of the
+ * input ends the program from any menu.
+ */
+
+#define OUTPUT_BUFFER_SIZE	65536
+
+static char outputBuffer[OUTPUT_BUFFER_SIZE];
+static bool outputQuiet = false;
+
+void OutputInit(bool quiet) {
+	outputQuiet = quiet;
+	setvbuf(stdout, outputBuffer, _IOFBF, sizeof(outputBuffer));
+}
+
+void OutputMenu(const char *text) {
+	if (outputQuiet == false) {
+		fputs(text, stdout);
+	}
+}
+
+void OutputPrompt(const char *text) {
+	if (outputQuiet == false) {
+		fputs(text, stdout);
+		fflush(stdout);
+	}
+}
+
+char InputChoice() {
+	char choice;
+	if (scanf(" %c", &choice) == EOF) {
+		exit(0);
+	}
+	return choice;
+}
+
+bool InputTemperature(short *temperature) {
+	int result = scanf(" %hd", temperature);
+	if (result == EOF) {
+		exit(0);
+	}
+	if (result == 0) {
+		scanf("%*s"); // Not a number, skip it
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,194 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "..\\src\\headers\\Functions.h"
+#include "..\\src\\headers\\Globals.h"
+
+/*
+ * Scenario file, one command per line, blank lines & lines starting with '#'
+ * are skipped:
+ *
+ *	on				Turn on vehicle engine.
+ *	off				Turn off vehicle engine.
+ *	light G|O|R		Set traffic light color.
+ *	cabinet N		Set cabinet temperature.
+ *	engine N		Set engine temperature.
+ *	reset			Start a new scenario from the power up state.
+ *	quit			Stop reading the file.
+ *
+ * As in the menus, light & temperatures need the engine to be on. Every
+ * command prints one CSV line of the vehicle status after it, the result is
+ * one of: ok, invalid (value rejected), ignored (engine off) or unknown.
+ * Lines longer than SCENARIO_LINE_SIZE, tokens longer than SCENARIO_TOKEN_SIZE
+ * & extra tokens are invalid. Echoed command & value holding a comma or a
+ * quote are quoted so every line keeps the header columns.
+ */
+
+#define SCENARIO_LINE_SIZE	128
+#define SCENARIO_TOKEN_SIZE	15
+
+static void ResetVehicle() {
+	engineState = '0';
+	cabinetTemperatureControl = '0';
+	vehicleSpeed = 0;
+	cabinetTemperature = 30;
+	engineTemperatureControl = '0';
+	engineTemperature = 30;
+}
+
+static bool ReadTemperature(const char *value, short *temperature) {
+	char *end;
+	long number = strtol(value, &end, 10);
+	if (end == value || *end != '\0' || number < -32768 || number > 32767) {
+		return false;
+	}
+	*temperature = (short) number;
+	return true;
+}
+
+// Copies the next blank separated token of text, an empty token at the end of the
+// line, & returns the text after it
+static const char *ReadToken(const char *text, char *token, bool *tooLong) {
+	size_t length = 0;
+	while (isspace((unsigned char) *text)) {
+		text++;
+	}
+	while (*text != '\0' && !isspace((unsigned char) *text)) {
+		if (length < SCENARIO_TOKEN_SIZE) {
+			token[length++] = *text;
+		} else {
+			*tooLong = true; // Echoed truncated
+		}
+		text++;
+	}
+	token[length] = '\0';
+	return text;
+}
+
+static void ScenarioField(const char *field) {
+	if (strpbrk(field, ",\"") == NULL) {
+		printf(",%s", field);
+		return;
+	}
+	printf("%s", ",\"");
+	for (; *field != '\0'; field++) {
+		if (*field == '"') {
+			putchar('"'); // Quote doubled as in CSV
+		}
+		putchar(*field);
+	}
+	putchar('"');
+}
+
+static void ScenarioStatus(unsigned long line, const char *command, const char *value,
+		const char *result) {
+	printf("%lu", line);
+	ScenarioField(command);
+	ScenarioField(value);
+	printf(",%s,%s,%s,%d,%d", result,
+			engineState == '0' ? "OFF" : "ON",
+			cabinetTemperatureControl == '0' ? "OFF" : "ON", vehicleSpeed,
+			cabinetTemperature);
+#ifdef WITH_ENGINE_TEMP_CONTROLLER
+	printf(",%s,%d", engineTemperatureControl == '0' ? "OFF" : "ON",
+			engineTemperature);
+#endif
+	printf("%s", "\n");
+}
+
+int RunScenario(const char *path) {
+	char text[SCENARIO_LINE_SIZE];
+	char command[SCENARIO_TOKEN_SIZE + 1];
+	char value[SCENARIO_TOKEN_SIZE + 1];
+	char extra[SCENARIO_TOKEN_SIZE + 1];
+	const char *rest;
+	const char *result;
+	bool invalid;
+	int character;
+	short temperature;
+	unsigned long line = 0;
+	FILE *scenario = stdin;
+
+	if (strcmp(path, "-") != 0) {
+		scenario = fopen(path, "r");
+		if (scenario == NULL) {
+			perror(path);
+			return 1;
+		}
+	}
+#ifdef WITH_ENGINE_TEMP_CONTROLLER
+	printf("%s", "line,command,value,result,engine,ac,speed,cabinet_temperature,"
+			"engine_temperature_control,engine_temperature\n");
+#else
+	printf("%s", "line,command,value,result,engine,ac,speed,cabinet_temperature\n");
+#endif
+	while (fgets(text, sizeof(text), scenario) != NULL) {
+		line++;
+		invalid = false;
+		if (strchr(text, '\n') == NULL && !feof(scenario)) {
+			invalid = true; // Line longer than the buffer, the rest is skipped
+			while ((character = fgetc(scenario)) != EOF && character != '\n') {
+			}
+		}
+		rest = ReadToken(text, command, &invalid);
+		rest = ReadToken(rest, value, &invalid);
+		ReadToken(rest, extra, &invalid);
+		if (command[0] == '\0' || command[0] == '#') {
+			continue;
+		}
+		if (extra[0] != '\0'
+				|| (value[0] != '\0'
+						&& (strcmp(command, "on") == 0 || strcmp(command, "off") == 0
+								|| strcmp(command, "reset") == 0
+								|| strcmp(command, "quit") == 0))) {
+			invalid = true; // Commands take one value at most, these none
+		}
+		if (invalid == false && strcmp(command, "quit") == 0) {
+			break;
+		}
+		result = "ok";
+		if (invalid == true) {
+			result = "invalid";
+		} else if (strcmp(command, "on") == 0) {
+			if (engineState == '1') {
+				result = "ignored";
+			} else {
+				EngineOn();
+			}
+		} else if (strcmp(command, "off") == 0) {
+			EngineOff();
+		} else if (strcmp(command, "reset") == 0) {
+			ResetVehicle();
+		} else if (strcmp(command, "light") == 0) {
+			if (engineState != '1') {
+				result = "ignored";
+			} else if (strlen(value) != 1 || SetTrafficLight(value[0]) == false) {
+				result = "invalid";
+			}
+		} else if (strcmp(command, "cabinet") == 0) {
+			if (engineState != '1') {
+				result = "ignored";
+			} else if (ReadTemperature(value, &temperature) == false
+					|| SetCabinetTemperature(temperature) == false) {
+				result = "invalid";
+			}
+#ifdef WITH_ENGINE_TEMP_CONTROLLER
+		} else if (strcmp(command, "engine") == 0) {
+			if (engineState != '1') {
+				result = "ignored";
+			} else if (ReadTemperature(value, &temperature) == false
+					|| SetEngineTemperature(temperature) == false) {
+				result = "invalid";
+			}
+#endif
+		} else {
+			result = "unknown";
+		}
+		ScenarioStatus(line, command, value, result);
+	}
+	if (scenario != stdin) {
+		fclose(scenario);
+	}
+	return 0;
+}
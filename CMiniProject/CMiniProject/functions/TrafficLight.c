@@ -2,39 +2,44 @@
 #include "..\\src\\headers\\Functions.h"
 #include "..\\src\\headers\\Globals.h"
 
+bool SetTrafficLight(char color) {
+	switch (color) {
+	case 'g':
+	case 'G':
+		vehicleSpeed = 100;
+		return true;
+	case 'o':
+	case 'O':
+		vehicleSpeed = 30;
+		if (cabinetTemperatureControl == false) {
+			cabinetTemperatureControl = true;
+			cabinetTemperature *= (5 / 4) + 1;
+		}
+		if (engineTemperatureControl == false) {
+			engineTemperatureControl = true;
+			engineTemperature *= (5 / 4) + 1;
+		}
+		return true;
+	case 'r':
+	case 'R':
+		vehicleSpeed = 0;
+		return true;
+	default:
+		return false;
+	}
+}
+
 void TrafficLight() {
 	while (true) {
-		printf("%s", "\n\tEnter 'G' for green light.\n"
+		OutputMenu("\n\tEnter 'G' for green light.\n"
 				"\tEnter 'O' for orange light.\n"
 				"\tEnter 'R' for red light.\n");
-		printf("%s", "\nYour choice: ");
-		scanf(" %c", &userInput);
-		switch (userInput) {
-		case 'g':
-		case 'G':
-			vehicleSpeed = 100;
-			VehicleStatus();
-			return;
-		case 'o':
-		case 'O':
-			vehicleSpeed = 30;
-			if (cabinetTemperatureControl == false) {
-				cabinetTemperatureControl = true;
-				cabinetTemperature *= (5 / 4) + 1;
-			}
-			if (engineTemperatureControl == false) {
-				engineTemperatureControl = true;
-				engineTemperature *= (5 / 4) + 1;
-			}
-			VehicleStatus();
-			return;
-		case 'r':
-		case 'R':
-			vehicleSpeed = 0;
+		OutputPrompt("\nYour choice: ");
+		userInput = InputChoice();
+		if (SetTrafficLight(userInput) == true) {
 			VehicleStatus();
 			return;
-		default:
-			printf("%s", "Please choose a valid option.\n");
 		}
+		printf("%s", "Please choose a valid option.\n");
 	}
 }
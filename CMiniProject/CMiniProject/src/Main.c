@@ -9,30 +9,38 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "..\\src\\headers\\Functions.h"
 #include "..\\src\\headers\\Globals.h"
 
-int main() {
-	setbuf(stdout, NULL); // Disable buffering to display output without flushing at the cost of performance
+int main(int argc, char *argv[]) {
+	int arg = 1;
+	bool quiet = false;
+	if (arg < argc && strcmp(argv[arg], "-q") == 0) {
+		quiet = true; // Quiet mode, menus & prompts are not shown
+		arg++;
+	}
+	OutputInit(quiet);
+	if (arg < argc) {
+		return RunScenario(argv[arg]); // Batch mode, "-" reads the scenario from the standard input
+	}
 	while (true) {
-		printf("%s", "Please choose what you do want:\n\n"
+		OutputMenu("Please choose what you do want:\n\n"
 				"\ta. Turn on vehicle engine.\n"
 				"\tb. Turn off vehicle engine.\n"
 				"\tc. Quit the system.\n");
-		printf("%s", "\nYour choice: ");
-		scanf(" %c", &userInput);
+		OutputPrompt("\nYour choice: ");
+		userInput = InputChoice();
 		switch (userInput) {
 		case 'a':
 		case 'A':
-			engineTemperature = 125;
-			engineState = true;
+			EngineOn();
 			printf("%s", "\nEngine turned on.\n");
 			InitialOperation();
 			break;
 		case 'b':
 		case 'B':
-			engineTemperature = 30;
-			engineState = false;
+			EngineOff();
 			printf("%s", "\nEngine turned off.\n\n");
 			break;
 		case 'c':
@@ -2,10 +2,25 @@
 #define FUNCTIONS_H_
 #define WITH_ENGINE_TEMP_CONTROLLER	// Comment to disable engine temperature control
 
+#include "Globals.h"
+
 void InitialOperation();
 void TrafficLight();
 void VehicleStatus();
 void CabinetTemperature();
 void EngineTemperature();
 
+void EngineOn();
+void EngineOff();
+bool SetTrafficLight(char color);
+bool SetCabinetTemperature(short temperature);
+bool SetEngineTemperature(short temperature);
+int RunScenario(const char *path);
+
+void OutputInit(bool quiet);
+void OutputMenu(const char *text);
+void OutputPrompt(const char *text);
+char InputChoice();
+bool InputTemperature(short *temperature);
+
 #endif
@@ -8,6 +8,30 @@
 #include "../common_macros.h"						/* For common macros usage */
 #include "../HAL/lcd.h"								/* For LCD usage */
 #include "../HAL/ultrasonic_four_terminal_sensor.h"	/* For Ultrasonic usage */
+#include "../LIB/filter.h"							/* For filtering distance readings */
+#include "../MCAL/power.h"							/* For sleeping while waiting */
+#include "../MCAL/profiler.h"						/* For measuring CPU load */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Distance smoothing, alpha = 1 / (2^shift) */
+#define DISTANCE_EMA_SHIFT			1
+/* Sensors displayed, one per LCD row */
+#define DISPLAYED_SENSORS			\
+	((ULTRASONIC_SENSORS_NUMBER < 2) ? ULTRASONIC_SENSORS_NUMBER : 2)
+/* Columns of the distance value, between "Distance:" & "cm" */
+#define DISTANCE_VALUE_COLUMN		10
+#define DISTANCE_VALUE_WIDTH		4
+/* Profiled tasks */
+#define DISTANCE_TASK_DISPLAY		0
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Filters state of distance readings of every displayed sensor */
+static Filter_MedianType g_distanceMedian[DISPLAYED_SENSORS];
+static Filter_EMAType g_distanceEMA[DISPLAYED_SENSORS];
 
 /*******************************************************************************
  *                            Functions Definitions                            *
@@ -21,19 +45,104 @@
  */
 int main(void)
 {
+	/* A variable to store filtered distance */
+	uint16 distance = 0;
+	/* Latest ranging result */
+	Ultrasonic_ResultType result;
+	/* Sequence number of the last displayed result of every sensor */
+	uint8 lastSequence[DISPLAYED_SENSORS] = { 0 };
+	/* Indicates that distance is displayed as not available for every sensor */
+	uint8 distanceMissing[DISPLAYED_SENSORS] = { FALSE };
+	/* Displayed sensor number, also it's LCD row */
+	uint8 sensorId = 0;
+	/* Indicates that display changed in this loop pass */
+	uint8 displayChanged = FALSE;
+	/* Columns written by the distance value */
+	uint8 digits = 0;
 	/* Enable global interrupt */
 	SET_BIT(SREG, 7);
 	/* Initialize LCD */
 	LCD_init();
 	/* Initialize Ultrasonic */
 	Ultrasonic_init();
-	/* Display text */
-	LCD_displayString("Distance:     cm");
+	/* Sleep while no result changes, ranging is driven by timer1 & ICU interrupts */
+	Power_init(POWER_IDLE_MODE);
+	Power_registerWakeup(POWER_WAKEUP_TIMER1);
+
+#if (PROFILER_ENABLE == TRUE)
+
+	/* Measure CPU load & tasks time */
+	Profiler_init();
+
+#endif
+
+	for (sensorId = 0; sensorId < DISPLAYED_SENSORS; sensorId++)
+	{
+		/* Initialize distance filters */
+		Filter_medianInit(&g_distanceMedian[sensorId]);
+		Filter_EMAInit(&g_distanceEMA[sensorId], DISTANCE_EMA_SHIFT);
+		/* Display text */
+		if (ULTRASONIC_SENSORS_NUMBER == 1)
+		{
+			LCD_displayStringRowColumn(sensorId, 0, "Distance:     cm");
+		}
+		else
+		{
+			LCD_displayStringRowColumn(sensorId, 0, "Sensor  :     cm");
+			LCD_moveCursor(sensorId, 7);
+			LCD_intgerToString(sensorId + 1);
+		}
+	}
 	/* Execute program loop */
 	while (TRUE)
 	{
-		LCD_moveCursor(0, 10); /* Move to row 0 column 10 */
-		LCD_intgerToString(Ultrasonic_readDistance()); /* Display calculated distance */
-		LCD_displayCharacter(' '); /* Clear numbers after displaying value */
+		/* Ranging runs in the background, update display on new results only.
+		 * Results are checked with global interrupt disabled so a result
+		 * published after the check wakes the CPU instead of being missed */
+		displayChanged = FALSE;
+		PROFILER_TASK_START(DISTANCE_TASK_DISPLAY);
+		CLEAR_BIT(SREG, 7);
+		for (sensorId = 0; sensorId < DISPLAYED_SENSORS; sensorId++)
+		{
+			Ultrasonic_getResult(sensorId, &result);
+			if (result.sequence != lastSequence[sensorId])
+			{
+				SET_BIT(SREG, 7); /* Update display with global interrupt enabled */
+				displayChanged = TRUE;
+				lastSequence[sensorId] = result.sequence;
+				distanceMissing[sensorId] = FALSE;
+				/* Remove false echoes then smooth distance */
+				distance = Filter_median(&g_distanceMedian[sensorId],
+						result.distanceCm);
+				distance = Filter_EMA(&g_distanceEMA[sensorId], distance);
+				LCD_moveCursor(sensorId, DISTANCE_VALUE_COLUMN); /* Move to sensor row value column */
+				LCD_intgerToString(distance); /* Display filtered distance */
+				/* Clear the rest of the value columns, left by "---" or longer values */
+				digits = (distance >= 1000) ? 4 :
+							(distance >= 100) ? 3 : (distance >= 10) ? 2 : 1;
+				while (digits < DISTANCE_VALUE_WIDTH)
+				{
+					LCD_displayCharacter(' ');
+					digits++;
+				}
+			}
+			else if ((result.status == ULTRASONIC_STALE)
+					&& (distanceMissing[sensorId] == FALSE))
+			{
+				SET_BIT(SREG, 7); /* Update display with global interrupt enabled */
+				displayChanged = TRUE;
+				distanceMissing[sensorId] = TRUE;
+				/* Old readings must not be mixed with the next valid ones */
+				Filter_medianInit(&g_distanceMedian[sensorId]);
+				Filter_EMAInit(&g_distanceEMA[sensorId], DISTANCE_EMA_SHIFT);
+				LCD_moveCursor(sensorId, DISTANCE_VALUE_COLUMN); /* Move to sensor row value column */
+				LCD_displayString("--- "); /* Display distance as not available */
+			}
+		}
+		PROFILER_TASK_STOP();
+		if (displayChanged == FALSE)
+		{
+			Power_sleep(); /* Nothing to display until the next interrupt */
+		}
 	}
 }
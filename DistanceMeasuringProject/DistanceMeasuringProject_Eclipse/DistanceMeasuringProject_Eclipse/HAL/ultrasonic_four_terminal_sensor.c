@@ -5,18 +5,60 @@
  * Author: Mohamed Badr
  *******************************************************************************/
 
+#include <avr/io.h>										/* For global interrupt state */
 #include <avr/delay.h>									/* For delay functions */
+#include "../common_macros.h"							/* For common macros usage */
 #include "../MCAL/gpio.h"								/* For trigger & echo pin configurations */
 #include "../MCAL/icu.h"								/* For ICU usage */
 #include "../HAL/ultrasonic_four_terminal_sensor.h"		/* For Ultrasonic prototypes */
 
+#if (ICU_TIMESTAMP_ENABLE == FALSE)
+
+#error "Ultrasonic needs ICU timestamp mode, enable it in ICU driver"
+
+#endif
+
 /*******************************************************************************
  *                         Global Variables & Pointers                         *
  *******************************************************************************/
-/* Static global variable that indicates number of detected edges */
-volatile static uint8 edgeCount = 0;
-/* Static global variable that stores most recent time between rising & falling edges */
-volatile static uint16 echoHighTime = 0;
+/* Static global array that stores most recent valid time between rising & falling edges */
+volatile static uint32 echoHighTime[ULTRASONIC_SENSORS_NUMBER];
+/* Trigger timestamp of the latest valid echo of every sensor */
+volatile static uint32 g_validTime[ULTRASONIC_SENSORS_NUMBER];
+/* Last trigger timestamp of every sensor */
+static uint32 g_triggerTime[ULTRASONIC_SENSORS_NUMBER];
+/* Sequence number of the latest valid echo of every sensor */
+volatile static uint8 g_sequence[ULTRASONIC_SENSORS_NUMBER];
+/* Status of the last ping of every sensor */
+volatile static ULTRASONIC_STATUS g_status[ULTRASONIC_SENSORS_NUMBER];
+/* Sensor that owns the ICU */
+static uint8 g_currentSensor = ULTRASONIC_SENSORS_NUMBER - 1;
+/* Indicates that the current sensor is still waiting for it's echo */
+static uint8 g_waitingEcho = FALSE;
+/* Timestamp of the next scheduled compare */
+static uint32 g_nextCompare = 0;
+
+#if (ULTRASONIC_TEMPERATURE_COMPENSATION == TRUE)
+
+/* Distance per tick at current temperature, fixed-point */
+static uint32 g_millimeterMultiplier = ULTRASONIC_MULTIPLIER(
+		ULTRASONIC_SOUND_SPEED_0C + ULTRASONIC_SOUND_SPEED_SLOPE * ULTRASONIC_TEMPERATURE,
+		ULTRASONIC_MILLIMETER, ULTRASONIC_FRACTION_BITS);
+static uint32 g_centimeterMultiplier = ULTRASONIC_MULTIPLIER(
+		ULTRASONIC_SOUND_SPEED_0C + ULTRASONIC_SOUND_SPEED_SLOPE * ULTRASONIC_TEMPERATURE,
+		ULTRASONIC_CENTIMETER, ULTRASONIC_FRACTION_BITS);
+
+#else
+
+/* Distance per tick at fixed temperature, fixed-point */
+static const uint32 g_millimeterMultiplier = ULTRASONIC_MULTIPLIER(
+		ULTRASONIC_SOUND_SPEED_0C + ULTRASONIC_SOUND_SPEED_SLOPE * ULTRASONIC_TEMPERATURE,
+		ULTRASONIC_MILLIMETER, ULTRASONIC_FRACTION_BITS);
+static const uint32 g_centimeterMultiplier = ULTRASONIC_MULTIPLIER(
+		ULTRASONIC_SOUND_SPEED_0C + ULTRASONIC_SOUND_SPEED_SLOPE * ULTRASONIC_TEMPERATURE,
+		ULTRASONIC_CENTIMETER, ULTRASONIC_FRACTION_BITS);
+
+#endif
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
@@ -24,12 +66,77 @@ volatile static uint16 echoHighTime = 0;
 /*
  * [Function Name]	: Ultrasonic_trigger
  * [Description]	:
- * 		Sets trigger pin to (LOGIC HIGH) for 10 micro-seconds.
+ * 		Routes echo of the current sensor to ICU & sets it's trigger pin to
+ * 		(LOGIC HIGH) for 10 micro-seconds.
  * [Args]	: Void.
  * [Return]	: Void.
  */
 static void Ultrasonic_trigger(void);
 
+/*
+ * [Function Name]	: Ultrasonic_schedule
+ * [Description]	:
+ * 		Sets the next timer1 compare unit B interrupt.
+ * [Args]	:
+ * [In] timestamp	: Indicates interrupt time, less than (0xFFFF) ticks from now.
+ * [Return]			: Void.
+ */
+static void Ultrasonic_schedule(uint32 timestamp);
+
+/*
+ * [Function Name]	: Ultrasonic_nextTriggerTime
+ * [Description]	:
+ * 		Returns earliest time the next sensor may be triggered, not before
+ * 		the given time & not before the end of it's sensor cycle.
+ * [Args]	:
+ * [In] earliest	: Indicates earliest time allowed by the current sensor.
+ * [Return]			: Trigger timestamp of the next sensor.
+ */
+static uint32 Ultrasonic_nextTriggerTime(uint32 earliest);
+
+/*
+ * [Function Name]	: Ultrasonic_timeout
+ * [Description]	:
+ * 		Marks the current sensor ping as unanswered, a sensor keeps
+ * 		(ULTRASONIC_NO_RESULT) until it's first valid echo.
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void Ultrasonic_timeout(void);
+
+/*
+ * [Function Name]	: Ultrasonic_slotProcessing
+ * [Description]	:
+ * 		Executed by timer1 compare unit B, times out an unanswered trigger &
+ * 		triggers the next sensor if it's allowed, otherwise waits until it is.
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void Ultrasonic_slotProcessing(void);
+
+/*
+ * [Function Name]	: Ultrasonic_echoProcessing
+ * [Description]	:
+ * 		Executed upon finding an edge, validates queued echo pulses against the
+ * 		last trigger, publishes the first valid one for the current sensor & ends
+ * 		it's slot early.
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void Ultrasonic_echoProcessing(void);
+
+/*
+ * [Function Name]	: Ultrasonic_convert
+ * [Description]	:
+ * 		Multiplies limited echo pulse width by a fixed-point multiplier & removes
+ * 		the fraction with rounding.
+ * [Args]	:
+ * [In] echoTicks	: Indicates echo pulse width in ICU ticks.
+ * [In] multiplier	: Indicates distance per tick, fixed-point.
+ * [Return]			: Distance, rounded.
+ */
+static uint16 Ultrasonic_convert(uint32 echoTicks, uint32 multiplier);
+
 /*******************************************************************************
  *                            Functions Definitions                            *
  *******************************************************************************/
@@ -37,85 +144,404 @@ static void Ultrasonic_trigger(void);
  * [Function Name]	: Ultrasonic_init
  * [Description]	:
  * 		Initialize the ultrasonic:
- * 			1. Initialize ICU.
- * 			2. Set ICU call-back function.
- * 			3. Set trigger output pin.
+ * 			1. Set trigger (& multiplexer select) output pins.
+ * 			2. Initialize ICU in timestamp mode, echo pulses start at rising edge.
+ * 			3. Schedule round-robin triggers on timer1 compare unit B.
+ * 		Global interrupt must be enabled.
  * [Args]	: Void.
  * [Return]	: Void.
  */
 void Ultrasonic_init(void)
 {
 	/* Define structure of ICU configurations */
-	ICU_ConfigType ICU_Config = { TIMER01_PRESCALER_8, RISING };
+	ICU_ConfigType ICU_Config = { ULTRASONIC_ICU_PRESCALER, RISING };
+	uint8 sensorId = 0; /* A counter variable for loops */
+	uint32 timestamp = 0; /* Current time */
+	/* Set trigger pins as output */
+	for (sensorId = 0; sensorId < ULTRASONIC_SENSORS_NUMBER; sensorId++)
+	{
+		GPIO_setupPinDirection(ULTRASONIC_TRIGGER_PORT_ID,
+				ULTRASONIC_TRIGGER_FIRST_PIN_ID + sensorId, PIN_OUTPUT);
+	}
+
+#if (ULTRASONIC_SENSORS_NUMBER > 1)
+
+	/* Set multiplexer select pins as output */
+	for (sensorId = 0; sensorId < ULTRASONIC_MUX_SELECT_BITS; sensorId++)
+	{
+		GPIO_setupPinDirection(ULTRASONIC_MUX_PORT_ID,
+				ULTRASONIC_MUX_FIRST_PIN_ID + sensorId, PIN_OUTPUT);
+	}
+
+#endif
+
 	/* Set ICU call-back function */
-	ICU_setCallBack(Ultrasonic_edgeProcessing);
-	/* Set trigger pin as output */
-	GPIO_setupPinDirection(PORTD_ID, PIN7_ID, PIN_OUTPUT);
+	ICU_setCallBack(Ultrasonic_echoProcessing);
 	/* Initialize ICU */
 	ICU_init(&ICU_Config);
+	/* All sensors may be triggered, the first one is sensor (0) */
+	timestamp = ICU_getTimestamp();
+	for (sensorId = 0; sensorId < ULTRASONIC_SENSORS_NUMBER; sensorId++)
+	{
+		g_triggerTime[sensorId] = timestamp - ULTRASONIC_SENSOR_CYCLE_TICKS;
+		g_status[sensorId] = ULTRASONIC_NO_RESULT;
+	}
+	g_currentSensor = ULTRASONIC_SENSORS_NUMBER - 1;
+	g_waitingEcho = FALSE;
+	/* First trigger after one sensor cycle, leaves time for sensors power-up */
+	Timer1_setCallBackUnitB(Ultrasonic_slotProcessing);
+	Ultrasonic_schedule(timestamp + ULTRASONIC_SENSOR_CYCLE_TICKS);
+	Timer1_enableInterruptUnitB();
 }
 
 /*
  * [Function Name]	: Ultrasonic_trigger
  * [Description]	:
- * 		Sets trigger pin to (LOGIC HIGH) for 10 micro-seconds.
+ * 		Routes echo of the current sensor to ICU & sets it's trigger pin to
+ * 		(LOGIC HIGH) for 10 micro-seconds.
  * [Args]	: Void.
  * [Return]	: Void.
  */
 static void Ultrasonic_trigger(void)
 {
+
+#if (ULTRASONIC_SENSORS_NUMBER > 1)
+
+	uint8 bit = 0; /* A counter variable for loops */
+	/* Select multiplexer channel of current sensor */
+	for (bit = 0; bit < ULTRASONIC_MUX_SELECT_BITS; bit++)
+	{
+		GPIO_writePin(ULTRASONIC_MUX_PORT_ID, ULTRASONIC_MUX_FIRST_PIN_ID + bit,
+				GET_BIT(g_currentSensor, bit));
+	}
+
+#endif
+
+	/* Remove late edges of the previous ping & switching edges */
+	ICU_flushPulses();
+	g_triggerTime[g_currentSensor] = ICU_getTimestamp();
+	g_waitingEcho = TRUE;
+	/* Keep age of old results limited, so timestamp wrap-around never makes them young */
+	if ((g_triggerTime[g_currentSensor] - g_validTime[g_currentSensor])
+			> ULTRASONIC_MAX_AGE_TICKS)
+	{
+		g_validTime[g_currentSensor] = g_triggerTime[g_currentSensor]
+				- ULTRASONIC_MAX_AGE_TICKS;
+	}
 	/* Set trigger pin as (LOGIC HIGH) */
-	GPIO_writePin(PORTD_ID, PIN7_ID, LOGIC_HIGH);
+	GPIO_writePin(ULTRASONIC_TRIGGER_PORT_ID,
+			ULTRASONIC_TRIGGER_FIRST_PIN_ID + g_currentSensor, LOGIC_HIGH);
 	/* Wait 10 micro-seconds */
 	_delay_us(10);
 	/* Set trigger pin as (LOGIC LOW) */
-	GPIO_writePin(PORTD_ID, PIN7_ID, LOGIC_LOW);
+	GPIO_writePin(ULTRASONIC_TRIGGER_PORT_ID,
+			ULTRASONIC_TRIGGER_FIRST_PIN_ID + g_currentSensor, LOGIC_LOW);
 }
 
 /*
- * [Function Name]	: Ultrasonic_trigger
+ * [Function Name]	: Ultrasonic_schedule
+ * [Description]	:
+ * 		Sets the next timer1 compare unit B interrupt.
+ * [Args]	:
+ * [In] timestamp	: Indicates interrupt time, less than (0xFFFF) ticks from now.
+ * [Return]			: Void.
+ */
+static void Ultrasonic_schedule(uint32 timestamp)
+{
+	g_nextCompare = timestamp;
+	Timer1_setCompareValueB((uint16) timestamp);
+}
+
+/*
+ * [Function Name]	: Ultrasonic_nextTriggerTime
+ * [Description]	:
+ * 		Returns earliest time the next sensor may be triggered, not before
+ * 		the given time & not before the end of it's sensor cycle.
+ * [Args]	:
+ * [In] earliest	: Indicates earliest time allowed by the current sensor.
+ * [Return]			: Trigger timestamp of the next sensor.
+ */
+static uint32 Ultrasonic_nextTriggerTime(uint32 earliest)
+{
+	uint8 nextSensor = g_currentSensor + 1; /* Sensor after current one */
+	uint32 cycleEnd = 0; /* End of next sensor cycle */
+	if (nextSensor == ULTRASONIC_SENSORS_NUMBER)
+	{
+		nextSensor = 0;
+	}
+	cycleEnd = g_triggerTime[nextSensor] + ULTRASONIC_SENSOR_CYCLE_TICKS;
+	/* Later of both times, signed difference handles timestamp wrap-around */
+	if ((sint32) (cycleEnd - earliest) > 0)
+	{
+		return cycleEnd;
+	}
+	return earliest;
+}
+
+/*
+ * [Function Name]	: Ultrasonic_timeout
  * [Description]	:
- * 		Calls Ultrasonic_readDistance and calculates distance value through
- * 		ICU timer value and returns the calculated distance.
+ * 		Marks the current sensor ping as unanswered, a sensor keeps
+ * 		(ULTRASONIC_NO_RESULT) until it's first valid echo.
  * [Args]	: Void.
- * [Return]	: Measured distance value.
+ * [Return]	: Void.
  */
-uint16 Ultrasonic_readDistance(void)
+static void Ultrasonic_timeout(void)
 {
-	/* Declare & initialize a variable that holds distance */
-	uint16 distance = 0;
-	/* Trigger ultrasonic */
-	Ultrasonic_trigger();
-	/* Calculate distance depending on ICU timer value */
-	distance = ((float) 0.01731 * echoHighTime);
-	/* Return distance calculated to upper layer */
-	return distance;
+	if (g_status[g_currentSensor] != ULTRASONIC_NO_RESULT)
+	{
+		g_status[g_currentSensor] = ULTRASONIC_TIMEOUT;
+	}
 }
 
 /*
- * [Function Name]	: Ultrasonic_edgeProcessing
+ * [Function Name]	: Ultrasonic_slotProcessing
  * [Description]	:
- * 		Executed upon finding an edge, starts counting upon detecting rising edge,
- * 		stops counting upon detecting falling edge then sets echoHighTime value
- * 		to last ICU timer value and resets number of edges detected.
+ * 		Executed by timer1 compare unit B, times out an unanswered trigger &
+ * 		triggers the next sensor if it's allowed, otherwise waits until it is.
  * [Args]	: Void.
  * [Return]	: Void.
  */
-void Ultrasonic_edgeProcessing(void)
+static void Ultrasonic_slotProcessing(void)
 {
-	/* Increase edges count */
-	edgeCount++;
-	/* If the edge detected is a rising edge */
-	if (edgeCount == 1)
+	uint32 timestamp = ICU_getTimestamp(); /* Current time */
+	uint32 triggerTime = 0; /* Trigger time of next sensor */
+	if (g_waitingEcho == TRUE)
 	{
-		ICU_clearTimerValue(); /* Clear previous ICU timer value to start again from this point */
-		ICU_setEdgeDetectionType(FALLING); /* Set edge detection to (FALLING) */
+		/* Slot ended without an echo, reflections had the whole slot to fade */
+		Ultrasonic_timeout();
+		g_waitingEcho = FALSE;
+	}
+	triggerTime = Ultrasonic_nextTriggerTime(timestamp);
+	if (triggerTime != timestamp)
+	{
+		/* Next sensor is still in it's cycle */
+		Ultrasonic_schedule(triggerTime);
 	}
 	else
 	{
-		echoHighTime = ICU_getInputCaptureValue(); /* Set the new ICU timer value to echoHighTime */
-		ICU_clearTimerValue(); /* Clear previous ICU timer value to start again from this point */
-		ICU_setEdgeDetectionType(RISING); /* Set edge detection to (RISING) */
-		edgeCount = 0; /* Reset number of detected edges */
+		g_currentSensor++;
+		if (g_currentSensor == ULTRASONIC_SENSORS_NUMBER)
+		{
+			g_currentSensor = 0;
+		}
+		Ultrasonic_trigger();
+		/* Slot end, moved earlier when the echo is received */
+		Ultrasonic_schedule(g_triggerTime[g_currentSensor] + ULTRASONIC_SLOT_TICKS);
+	}
+}
+
+/*
+ * [Function Name]	: Ultrasonic_echoProcessing
+ * [Description]	:
+ * 		Executed upon finding an edge, validates queued echo pulses against the
+ * 		last trigger, publishes the first valid one for the current sensor & ends
+ * 		it's slot early.
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void Ultrasonic_echoProcessing(void)
+{
+	ICU_PulseType echoPulse; /* Echo pulse timestamps */
+	uint32 echoTicks = 0; /* Echo pulse width */
+	uint32 triggerTime = 0; /* Trigger time of next sensor */
+	while (ICU_getPulse(&echoPulse) == TRUE)
+	{
+		/*
+		 * Pulse must start after the trigger, a pulse that started before it
+		 * gives a very large unsigned difference & is ignored.
+		 */
+		if ((g_waitingEcho == TRUE)
+				&& ((echoPulse.start - g_triggerTime[g_currentSensor])
+						< ULTRASONIC_MAX_ECHO_TICKS))
+		{
+			echoTicks = echoPulse.end - echoPulse.start;
+			if (echoTicks >= ULTRASONIC_MAX_ECHO_TICKS)
+			{
+				/* Sensor gave up waiting for an echo */
+				Ultrasonic_timeout();
+				g_waitingEcho = FALSE;
+			}
+			else if (echoTicks >= ULTRASONIC_MIN_ECHO_TICKS)
+			{
+				echoHighTime[g_currentSensor] = echoTicks;
+				g_validTime[g_currentSensor] = g_triggerTime[g_currentSensor];
+				g_sequence[g_currentSensor]++;
+				g_status[g_currentSensor] = ULTRASONIC_VALID;
+				g_waitingEcho = FALSE;
+			}
+			if (g_waitingEcho == FALSE)
+			{
+				/* End slot early, the guard is always in the future */
+				triggerTime = Ultrasonic_nextTriggerTime(
+						echoPulse.end + ULTRASONIC_GUARD_TICKS);
+				if ((sint32) (g_nextCompare - triggerTime) > 0)
+				{
+					Ultrasonic_schedule(triggerTime);
+				}
+			}
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Ultrasonic_getResult
+ * [Description]	:
+ * 		Copies the latest ranging result of a sensor, never waits for a measurement.
+ * [Args]	:
+ * [In] sensorId	: Indicates sensor number (0 to ULTRASONIC_SENSORS_NUMBER - 1).
+ * [Out] result_Ptr	: Indicates where the result is stored, status is
+ * 					  (ULTRASONIC_NO_RESULT) for a wrong sensor number.
+ * [Return]			: Void.
+ */
+void Ultrasonic_getResult(uint8 sensorId, Ultrasonic_ResultType *result_Ptr)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	uint32 echoTicks = 0; /* Local copy of latest valid echo width */
+	uint32 ageTicks = 0; /* Time since trigger of latest valid echo */
+	if (sensorId >= ULTRASONIC_SENSORS_NUMBER)
+	{
+		(*result_Ptr).distanceMm = 0;
+		(*result_Ptr).distanceCm = 0;
+		(*result_Ptr).age = 0;
+		(*result_Ptr).sequence = 0;
+		(*result_Ptr).status = ULTRASONIC_NO_RESULT;
+		return;
+	}
+	/* Copy result of one ping without being interrupted */
+	CLEAR_BIT(SREG, 7);
+	echoTicks = echoHighTime[sensorId];
+	ageTicks = ICU_getTimestamp() - g_validTime[sensorId];
+	(*result_Ptr).sequence = g_sequence[sensorId];
+	(*result_Ptr).status = g_status[sensorId];
+	SREG = interruptState;
+	/* Convert outside the critical section */
+	(*result_Ptr).distanceMm = Ultrasonic_ticksToMillimeters(echoTicks);
+	(*result_Ptr).distanceCm = Ultrasonic_ticksToCentimeters(echoTicks);
+	if ((*result_Ptr).status == ULTRASONIC_NO_RESULT)
+	{
+		(*result_Ptr).age = 0;
+		return;
+	}
+	if (ageTicks > ULTRASONIC_STALE_TICKS)
+	{
+		(*result_Ptr).status = ULTRASONIC_STALE;
+	}
+	/* Limited age keeps the product in 32 bits */
+	if (ageTicks > ULTRASONIC_MAX_AGE_TICKS)
+	{
+		ageTicks = ULTRASONIC_MAX_AGE_TICKS;
 	}
+	(*result_Ptr).age = (uint16) ((ageTicks * ULTRASONIC_AGE_MULTIPLIER
+			+ (1UL << 15)) >> 16);
 }
+
+/*
+ * [Function Name]	: Ultrasonic_readDistance
+ * [Description]	:
+ * 		Returns distance of the latest valid echo of a sensor, never waits for
+ * 		a measurement.
+ * [Args]	:
+ * [In] sensorId	: Indicates sensor number (0 to ULTRASONIC_SENSORS_NUMBER - 1).
+ * [Return]			: Measured distance value in centi-meters.
+ */
+uint16 Ultrasonic_readDistance(uint8 sensorId)
+{
+	Ultrasonic_ResultType result; /* Latest ranging result */
+	Ultrasonic_getResult(sensorId, &result);
+	return result.distanceCm;
+}
+
+/*
+ * [Function Name]	: Ultrasonic_convert
+ * [Description]	:
+ * 		Multiplies limited echo pulse width by a fixed-point multiplier & removes
+ * 		the fraction with rounding.
+ * [Args]	:
+ * [In] echoTicks	: Indicates echo pulse width in ICU ticks.
+ * [In] multiplier	: Indicates distance per tick, fixed-point.
+ * [Return]			: Distance, rounded.
+ */
+static uint16 Ultrasonic_convert(uint32 echoTicks, uint32 multiplier)
+{
+	/*
+	 * Limiting the width limits the product to maximum distance (about 6.6 meters)
+	 * multiplied by (2^ULTRASONIC_FRACTION_BITS), which fits in 32 bits.
+	 */
+	if (echoTicks > ULTRASONIC_MAX_ECHO_TICKS)
+	{
+		echoTicks = ULTRASONIC_MAX_ECHO_TICKS;
+	}
+	return (uint16) ((echoTicks * multiplier
+			+ (1UL << (ULTRASONIC_FRACTION_BITS - 1))) >> ULTRASONIC_FRACTION_BITS);
+}
+
+/*
+ * [Function Name]	: Ultrasonic_ticksToMillimeters
+ * [Description]	:
+ * 		Converts echo pulse width to distance using integer multiply & shift only,
+ * 		pulse width is limited to (ULTRASONIC_MAX_ECHO_TICKS).
+ * [Args]	:
+ * [In] echoTicks	: Indicates echo pulse width in ICU ticks.
+ * [Return]			: Distance in milli-meters, rounded.
+ */
+uint16 Ultrasonic_ticksToMillimeters(uint32 echoTicks)
+{
+	return Ultrasonic_convert(echoTicks, g_millimeterMultiplier);
+}
+
+/*
+ * [Function Name]	: Ultrasonic_ticksToCentimeters
+ * [Description]	:
+ * 		Converts echo pulse width to distance using integer multiply & shift only,
+ * 		pulse width is limited to (ULTRASONIC_MAX_ECHO_TICKS).
+ * [Args]	:
+ * [In] echoTicks	: Indicates echo pulse width in ICU ticks.
+ * [Return]			: Distance in centi-meters, rounded.
+ */
+uint16 Ultrasonic_ticksToCentimeters(uint32 echoTicks)
+{
+	return Ultrasonic_convert(echoTicks, g_centimeterMultiplier);
+}
+
+#if (ULTRASONIC_TEMPERATURE_COMPENSATION == TRUE)
+
+/*
+ * [Function Name]	: Ultrasonic_setTemperature
+ * [Description]	:
+ * 		Recalculates distance multipliers for the speed of sound at the given air
+ * 		temperature, no division is used.
+ * [Args]	:
+ * [In] temperature	: Indicates air temperature in Celsius (-40 to 85).
+ * [Return]			: Void.
+ */
+void Ultrasonic_setTemperature(sint8 temperature)
+{
+	/*
+	 * Multiplier = Multiplier at 0 Celsius + Temperature * Multiplier per Celsius,
+	 * both terms have extra fraction bits so the slope keeps it's precision.
+	 */
+	const uint32 millimeter0C = ULTRASONIC_MULTIPLIER(ULTRASONIC_SOUND_SPEED_0C,
+			ULTRASONIC_MILLIMETER,
+			ULTRASONIC_FRACTION_BITS + ULTRASONIC_TEMPERATURE_BITS);
+	const uint32 millimeterSlope = ULTRASONIC_MULTIPLIER(
+			ULTRASONIC_SOUND_SPEED_SLOPE, ULTRASONIC_MILLIMETER,
+			ULTRASONIC_FRACTION_BITS + ULTRASONIC_TEMPERATURE_BITS);
+	const uint32 centimeter0C = ULTRASONIC_MULTIPLIER(ULTRASONIC_SOUND_SPEED_0C,
+			ULTRASONIC_CENTIMETER,
+			ULTRASONIC_FRACTION_BITS + ULTRASONIC_TEMPERATURE_BITS);
+	const uint32 centimeterSlope = ULTRASONIC_MULTIPLIER(
+			ULTRASONIC_SOUND_SPEED_SLOPE, ULTRASONIC_CENTIMETER,
+			ULTRASONIC_FRACTION_BITS + ULTRASONIC_TEMPERATURE_BITS);
+	/* Signed product added in unsigned arithmetic, result is always positive */
+	g_millimeterMultiplier = (millimeter0C
+			+ (uint32) ((sint32) temperature * (sint32) millimeterSlope)
+			+ (1UL << (ULTRASONIC_TEMPERATURE_BITS - 1)))
+			>> ULTRASONIC_TEMPERATURE_BITS;
+	g_centimeterMultiplier = (centimeter0C
+			+ (uint32) ((sint32) temperature * (sint32) centimeterSlope)
+			+ (1UL << (ULTRASONIC_TEMPERATURE_BITS - 1)))
+			>> ULTRASONIC_TEMPERATURE_BITS;
+}
+
+#endif
@@ -9,6 +9,176 @@
 #define ULTRASONIC_FOUR_TERMINAL_SENSOR_H_
 
 #include "../std_types.h"		/* To use standard defined types */
+#include "../MCAL/gpio.h"		/* For trigger & multiplexer pins IDs */
+#include "../MCAL/icu.h"		/* For ICU pre-scaler definitions */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* ICU pre-scaler division used to time echo pulses (1, 8, 64, 256 or 1024) */
+#define ULTRASONIC_ICU_DIVISION			8ULL
+#define ULTRASONIC_ICU_PRESCALER							\
+	((ULTRASONIC_ICU_DIVISION == 1) ? TIMER01_PRESCALER_1 :	\
+	(ULTRASONIC_ICU_DIVISION == 8) ? TIMER01_PRESCALER_8 :	\
+	(ULTRASONIC_ICU_DIVISION == 64) ? TIMER01_PRESCALER_64 :	\
+	(ULTRASONIC_ICU_DIVISION == 256) ? TIMER01_PRESCALER_256 : TIMER01_PRESCALER_1024)
+
+/* Time in micro-seconds to ICU ticks */
+#define ULTRASONIC_US_TO_TICKS(us)		\
+	((uint32) ((us) * F_CPU / (1000000ULL * ULTRASONIC_ICU_DIVISION)))
+
+/*
+ * Sensors array:
+ * 		All sensors share the ICU, only one ping is in flight at a time & sensors
+ * 		are triggered round-robin. Sensor (n) trigger is on pin (FIRST + n) of
+ * 		the trigger port. With more than one sensor, echo pins are routed to ICP1
+ * 		(PD6) through a multiplexer (like 74HC151 or CD4051), sensor (n) echo is
+ * 		on multiplexer channel (n) selected by pins (FIRST .. FIRST + BITS - 1)
+ * 		of the multiplexer port.
+ */
+#ifndef ULTRASONIC_SENSORS_NUMBER
+#define ULTRASONIC_SENSORS_NUMBER			1
+#endif
+#define ULTRASONIC_TRIGGER_PORT_ID			PORTD_ID
+#ifndef ULTRASONIC_TRIGGER_FIRST_PIN_ID
+#define ULTRASONIC_TRIGGER_FIRST_PIN_ID		PIN7_ID
+#endif
+
+#if (ULTRASONIC_SENSORS_NUMBER < 1)
+
+#error "Number of ultrasonic sensors should be (1) at least"
+
+#endif
+
+#if ((ULTRASONIC_TRIGGER_FIRST_PIN_ID + ULTRASONIC_SENSORS_NUMBER) > NUM_OF_PINS_PER_PORT)
+
+#error "Ultrasonic trigger pins should be in the same port"
+
+#endif
+
+#if (ULTRASONIC_SENSORS_NUMBER > 1)
+
+#define ULTRASONIC_MUX_PORT_ID				PORTC_ID
+#define ULTRASONIC_MUX_FIRST_PIN_ID			PIN0_ID
+#define ULTRASONIC_MUX_SELECT_BITS			3
+
+#if (ULTRASONIC_SENSORS_NUMBER > (1 << ULTRASONIC_MUX_SELECT_BITS))
+
+#error "Ultrasonic sensors are more than multiplexer channels"
+
+#endif
+
+#endif
+
+/*
+ * Ranging schedule, triggers are sent by timer1 compare unit B:
+ * 		Slot			: Longest time a sensor owns the ICU, must cover the no echo
+ * 						  pulse (38 milli-seconds) & the delay before it.
+ * 		Guard			: Silence after an echo before the next sensor is triggered,
+ * 						  lets reflections of the last ping fade (no cross-talk).
+ * 		Sensor cycle	: Shortest time between two triggers of the same sensor (60
+ * 						  milli-seconds at least as stated by the sensor datasheet).
+ * 		A slot ends early once it's echo is received, so the aggregate rate is
+ * 		limited by real echo times instead of the worst case. All times in ticks
+ * 		must fit in (16) bits, increase pre-scaler for longer times.
+ */
+#define ULTRASONIC_SLOT_MS					40
+#define ULTRASONIC_GUARD_MS					10
+#define ULTRASONIC_SENSOR_CYCLE_MS			60
+#define ULTRASONIC_SLOT_TICKS				ULTRASONIC_US_TO_TICKS(ULTRASONIC_SLOT_MS * 1000ULL)
+#define ULTRASONIC_GUARD_TICKS				ULTRASONIC_US_TO_TICKS(ULTRASONIC_GUARD_MS * 1000ULL)
+#define ULTRASONIC_SENSOR_CYCLE_TICKS		ULTRASONIC_US_TO_TICKS(ULTRASONIC_SENSOR_CYCLE_MS * 1000ULL)
+
+#if ((ULTRASONIC_SENSOR_CYCLE_MS * 1000ULL * F_CPU / (1000000ULL * ULTRASONIC_ICU_DIVISION)) > 0xFFFF)
+
+#error "Ultrasonic sensor cycle is too long for ICU pre-scaler"
+
+#endif
+
+#if (ULTRASONIC_SLOT_MS > ULTRASONIC_SENSOR_CYCLE_MS) || (ULTRASONIC_GUARD_MS > ULTRASONIC_SENSOR_CYCLE_MS)
+
+#error "Ultrasonic slot & guard should not be longer than sensor cycle"
+
+#endif
+
+/* Echo pulse of a sensor that received no echo (38 milli-seconds) in ticks */
+#define ULTRASONIC_MAX_ECHO_TICKS		ULTRASONIC_US_TO_TICKS(38000ULL)
+/* Shortest valid echo pulse (about 2 centi-meters), shorter pulses are noise */
+#define ULTRASONIC_MIN_ECHO_TICKS		ULTRASONIC_US_TO_TICKS(100ULL)
+
+/* Result becomes stale if no valid echo is received for this time */
+#define ULTRASONIC_STALE_MS				300
+#define ULTRASONIC_STALE_TICKS			ULTRASONIC_US_TO_TICKS(ULTRASONIC_STALE_MS * 1000ULL)
+/* Result age is limited to this time (milli-seconds) */
+#define ULTRASONIC_MAX_AGE_MS			60000ULL
+#define ULTRASONIC_MAX_AGE_TICKS		ULTRASONIC_US_TO_TICKS(ULTRASONIC_MAX_AGE_MS * 1000ULL)
+/* Milli-seconds per tick with (16) fraction bits, age = (ticks * multiplier) >> 16 */
+#define ULTRASONIC_AGE_MULTIPLIER		\
+	((uint32) ((1000ULL * ULTRASONIC_ICU_DIVISION * 65536ULL + F_CPU / 2) / F_CPU))
+
+/*
+ * Speed of sound in air = 331.3 + 0.606 * Temperature (m/s).
+ * Enable temperature compensation to change temperature at run time through
+ * Ultrasonic_setTemperature, otherwise (ULTRASONIC_TEMPERATURE) is fixed.
+ */
+#define ULTRASONIC_TEMPERATURE_COMPENSATION		TRUE
+#define ULTRASONIC_TEMPERATURE					25		/* Celsius */
+#define ULTRASONIC_SOUND_SPEED_0C				331300ULL	/* Milli-meters per second */
+#define ULTRASONIC_SOUND_SPEED_SLOPE			606ULL		/* Milli-meters per second per Celsius */
+
+/* Units of distance in milli-meters */
+#define ULTRASONIC_MILLIMETER					1ULL
+#define ULTRASONIC_CENTIMETER					10ULL
+
+/* Fraction bits of distance multipliers, distance = (ticks * multiplier) >> bits */
+#define ULTRASONIC_FRACTION_BITS				16
+/* Extra fraction bits of temperature terms, removed once per temperature change */
+#define ULTRASONIC_TEMPERATURE_BITS				8
+
+/*
+ * Fixed-point distance per tick, folded by compiler into a constant:
+ * 		Echo travels twice the distance, so
+ * 		Distance per tick = Speed * Division / (2 * F_CPU * Unit)
+ */
+#define ULTRASONIC_MULTIPLIER(speed, unit, bits)						\
+	((uint32) (((speed) * ULTRASONIC_ICU_DIVISION * (1ULL << (bits))	\
+		+ (unit) * F_CPU) / (2ULL * (unit) * F_CPU)))
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+/*
+ * [Enumerate Name]	: ULTRASONIC_STATUS
+ * [Description]	:
+ * 		An enumerate that defines state of a ranging result:
+ * 			NO_RESULT	: No valid echo received since initialization.
+ * 			VALID		: Last ping received a valid echo.
+ * 			TIMEOUT		: Last ping received no echo, distance is of an older ping.
+ * 			STALE		: No valid echo for (ULTRASONIC_STALE_MS), distance is not reliable.
+ */
+typedef enum
+{
+	ULTRASONIC_NO_RESULT,
+	ULTRASONIC_VALID,
+	ULTRASONIC_TIMEOUT,
+	ULTRASONIC_STALE
+} ULTRASONIC_STATUS;
+
+/*
+ * [Structure Name]	: Ultrasonic_ResultType
+ * [Description]	:
+ * 		A structure in which it's instance holds the latest valid distance of a
+ * 		sensor, time since it's trigger in milli-seconds, a sequence number that
+ * 		increases with every valid echo & result status.
+ */
+typedef struct
+{
+	uint16 distanceMm;
+	uint16 distanceCm;
+	uint16 age;
+	uint8 sequence;
+	ULTRASONIC_STATUS status;
+} Ultrasonic_ResultType;
 
 /*******************************************************************************
  *                           Functions Prototypes                              *
@@ -17,33 +187,73 @@
  * [Function Name]	: Ultrasonic_init
  * [Description]	:
  * 		Initialize the ultrasonic:
- * 			1. Initialize ICU.
- * 			2. Set ICU call-back function.
- * 			3. Set trigger output pin.
+ * 			1. Set trigger (& multiplexer select) output pins.
+ * 			2. Initialize ICU in timestamp mode, echo pulses start at rising edge.
+ * 			3. Schedule round-robin triggers on timer1 compare unit B.
+ * 		Global interrupt must be enabled.
  * [Args]	: Void.
  * [Return]	: Void.
  */
 void Ultrasonic_init(void);
 
 /*
- * [Function Name]	: Ultrasonic_trigger
+ * [Function Name]	: Ultrasonic_getResult
  * [Description]	:
- * 		Calls Ultrasonic_readDistance and calculates distance value through
- * 		ICU timer value and returns the calculated distance.
- * [Args]	: Void.
- * [Return]	: Measured distance value.
+ * 		Copies the latest ranging result of a sensor, never waits for a measurement.
+ * [Args]	:
+ * [In] sensorId	: Indicates sensor number (0 to ULTRASONIC_SENSORS_NUMBER - 1).
+ * [Out] result_Ptr	: Indicates where the result is stored, status is
+ * 					  (ULTRASONIC_NO_RESULT) for a wrong sensor number.
+ * [Return]			: Void.
  */
-uint16 Ultrasonic_readDistance(void);
+void Ultrasonic_getResult(uint8 sensorId, Ultrasonic_ResultType *result_Ptr);
 
 /*
- * [Function Name]	: Ultrasonic_edgeProcessing
+ * [Function Name]	: Ultrasonic_readDistance
  * [Description]	:
- * 		Executed upon finding an edge, starts counting upon detecting rising edge,
- * 		stops counting upon detecting falling edge then sets echoHighTime value
- * 		to last ICU timer value and resets number of edges detected.
- * [Args]	: Void.
- * [Return]	: Void.
+ * 		Returns distance of the latest valid echo of a sensor, never waits for
+ * 		a measurement.
+ * [Args]	:
+ * [In] sensorId	: Indicates sensor number (0 to ULTRASONIC_SENSORS_NUMBER - 1).
+ * [Return]			: Measured distance value in centi-meters.
+ */
+uint16 Ultrasonic_readDistance(uint8 sensorId);
+
+/*
+ * [Function Name]	: Ultrasonic_ticksToMillimeters
+ * [Description]	:
+ * 		Converts echo pulse width to distance using integer multiply & shift only,
+ * 		pulse width is limited to (ULTRASONIC_MAX_ECHO_TICKS).
+ * [Args]	:
+ * [In] echoTicks	: Indicates echo pulse width in ICU ticks.
+ * [Return]			: Distance in milli-meters, rounded.
+ */
+uint16 Ultrasonic_ticksToMillimeters(uint32 echoTicks);
+
+/*
+ * [Function Name]	: Ultrasonic_ticksToCentimeters
+ * [Description]	:
+ * 		Converts echo pulse width to distance using integer multiply & shift only,
+ * 		pulse width is limited to (ULTRASONIC_MAX_ECHO_TICKS).
+ * [Args]	:
+ * [In] echoTicks	: Indicates echo pulse width in ICU ticks.
+ * [Return]			: Distance in centi-meters, rounded.
+ */
+uint16 Ultrasonic_ticksToCentimeters(uint32 echoTicks);
+
+#if (ULTRASONIC_TEMPERATURE_COMPENSATION == TRUE)
+
+/*
+ * [Function Name]	: Ultrasonic_setTemperature
+ * [Description]	:
+ * 		Recalculates distance multipliers for the speed of sound at the given air
+ * 		temperature, no division is used.
+ * [Args]	:
+ * [In] temperature	: Indicates air temperature in Celsius (-40 to 85).
+ * [Return]			: Void.
  */
-void Ultrasonic_edgeProcessing(void);
+void Ultrasonic_setTemperature(sint8 temperature);
+
+#endif
 
 #endif /* ULTRASONIC_FOUR_TERMINAL_SENSOR_H_ */
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Module: Filter
+ * File Name: filter.h
+ * Description: Header file for integer digital filters of sensor readings.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef FILTER_H_
+#define FILTER_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Number of samples in median window, must be odd */
+#define FILTER_MEDIAN_SIZE		5
+/* Maximum exponential moving average shift, alpha = 1 / (2^shift) */
+#define FILTER_EMA_MAX_SHIFT	8
+
+#if ((FILTER_MEDIAN_SIZE % 2) == 0)
+
+#error "Filter median window size should be odd"
+
+#endif
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Filter_MedianType
+ * [Description]	:
+ * 		A structure in which it's instance holds the state of one median filter,
+ * 		the last FILTER_MEDIAN_SIZE samples in arrival order.
+ */
+typedef struct
+{
+	uint16 samples[FILTER_MEDIAN_SIZE];
+	uint8 index;
+	uint8 count;
+} Filter_MedianType;
+
+/*
+ * [Structure Name]	: Filter_EMAType
+ * [Description]	:
+ * 		A structure in which it's instance holds the state of one exponential
+ * 		moving average filter, the output is kept scaled by (2^shift) to
+ * 		not lose the fraction between samples.
+ */
+typedef struct
+{
+	uint32 scaledOutput;
+	uint8 shift;
+	uint8 initialized;
+} Filter_EMAType;
+
+/*
+ * [Structure Name]	: Filter_RateLimitType
+ * [Description]	:
+ * 		A structure in which it's instance holds the state of one rate limiter,
+ * 		the output changes at most by maxStep per sample.
+ */
+typedef struct
+{
+	uint16 output;
+	uint16 maxStep;
+	uint8 initialized;
+} Filter_RateLimitType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Filter_medianInit
+ * [Description]	:
+ * 		Function that empties a median filter window.
+ * [Args]	:
+ * [Out] filter_Ptr	: Indicates filter state.
+ * [Return]			: Void.
+ */
+void Filter_medianInit(Filter_MedianType *filter_Ptr);
+
+/*
+ * [Function Name]	: Filter_median
+ * [Description]	:
+ * 		Function that adds a sample to a median filter window & returns the
+ * 		median of the window, until the window is full the median of the
+ * 		received samples is returned.
+ * [Args]	:
+ * [In/Out] filter_Ptr	: Indicates filter state.
+ * [In] sample			: Indicates new sample.
+ * [Return]				: Median of the window.
+ */
+uint16 Filter_median(Filter_MedianType *filter_Ptr, uint16 sample);
+
+/*
+ * [Function Name]	: Filter_EMAInit
+ * [Description]	:
+ * 		Function that resets an exponential moving average filter, the first
+ * 		sample after reset is passed as it is.
+ * [Args]	:
+ * [Out] filter_Ptr	: Indicates filter state.
+ * [In] shift		: Indicates smoothing, alpha = 1 / (2^shift).
+ * [Return]			: Void.
+ */
+void Filter_EMAInit(Filter_EMAType *filter_Ptr, uint8 shift);
+
+/*
+ * [Function Name]	: Filter_EMA
+ * [Description]	:
+ * 		Function that adds a sample to an exponential moving average filter
+ * 		using shifts only: output += (sample - output) / (2^shift).
+ * [Args]	:
+ * [In/Out] filter_Ptr	: Indicates filter state.
+ * [In] sample			: Indicates new sample.
+ * [Return]				: Filtered value, rounded.
+ */
+uint16 Filter_EMA(Filter_EMAType *filter_Ptr, uint16 sample);
+
+/*
+ * [Function Name]	: Filter_rateLimitInit
+ * [Description]	:
+ * 		Function that resets a rate limiter, the first sample after reset is
+ * 		passed as it is.
+ * [Args]	:
+ * [Out] filter_Ptr	: Indicates filter state.
+ * [In] maxStep		: Indicates maximum change of output per sample.
+ * [Return]			: Void.
+ */
+void Filter_rateLimitInit(Filter_RateLimitType *filter_Ptr, uint16 maxStep);
+
+/*
+ * [Function Name]	: Filter_rateLimit
+ * [Description]	:
+ * 		Function that moves a rate limiter output towards a sample by maxStep at most.
+ * [Args]	:
+ * [In/Out] filter_Ptr	: Indicates filter state.
+ * [In] sample			: Indicates new sample.
+ * [Return]				: Limited value.
+ */
+uint16 Filter_rateLimit(Filter_RateLimitType *filter_Ptr, uint16 sample);
+
+#endif /* FILTER_H_ */
@@ -10,6 +10,7 @@
 #include "../common_macros.h" 			/* For usage of common macros */
 #include "../MCAL/icu.h"				/* For ICU prototypes & definitions */
 #include "../MCAL/gpio.h"				/* For ICU pin configuration */
+#include "../MCAL/isr_trace.h"			/* For ICU ISR tracing */
 
 /*******************************************************************************
  *                           Global Variables                                  *
@@ -17,20 +18,93 @@
 /* A pointer that holds the address of the call-back function */
 static volatile void (*g_interruptCallBack_Ptr)(void) = NULL_PTR;
 
+#if (ICU_TIMESTAMP_ENABLE == TRUE)
+
+/* Number of timer1 overflows, high word of timestamps */
+static volatile uint16 g_ICUOverflows = 0;
+/* Edge that starts a pulse */
+static volatile ICU_EDGE_TYPE g_ICUStartEdge = RISING;
+/* Indicates that the start edge of a pulse was captured */
+static volatile uint8 g_ICUPulseStarted = FALSE;
+/* Timestamp of the start edge of current pulse */
+static volatile uint32 g_ICUPulseStart = 0;
+/* Pulse queue, written by capture interrupt only at head & read by upper layer only at tail */
+static volatile ICU_PulseType g_ICUPulseQueue[ICU_PULSE_QUEUE_SIZE];
+static volatile uint8 g_ICUQueueHead = 0;
+static volatile uint8 g_ICUQueueTail = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: ICU_timerOverflow
+ * [Description]	:
+ * 		Timer1 overflow call-back, counts high word of timestamps.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void ICU_timerOverflow(void);
+
+#endif
+
 /*******************************************************************************
  *                       Interrupt Service Routines                            *
  *******************************************************************************/
 /*
  * [Interrupt Vector]	: TIMER1_CAPT_vect
  * [Description]		:
- * 		An interrupt that acts upon detecting an edge.
+ * 		An interrupt that acts upon detecting an edge, in timestamp mode it
+ * 		stamps the edge & pairs it with the previous one into a pulse.
  */
 ISR(TIMER1_CAPT_vect)
 {
+	ISR_TRACE_ENTRY_EVENT(ICR1);
+
+#if (ICU_TIMESTAMP_ENABLE == TRUE)
+
+	uint16 captureValue = ICR1; /* Low word of the edge timestamp */
+	uint16 overflows = g_ICUOverflows; /* High word of the edge timestamp */
+	uint32 timestamp = 0; /* Edge timestamp */
+	uint8 nextHead = 0; /* Queue head after pushing a pulse */
+	/*
+	 * Capture has higher priority than overflow, if timer1 overflowed but it's
+	 * interrupt is still pending the overflow count is one behind. A small
+	 * capture value means the edge came after that overflow, a large one
+	 * means the edge came just before it.
+	 */
+	if (BIT_IS_SET(TIFR, TOV1) && (captureValue < 0x8000))
+	{
+		overflows++;
+	}
+	timestamp = ((uint32) overflows << 16) | captureValue;
+	if (g_ICUPulseStarted == FALSE)
+	{
+		g_ICUPulseStart = timestamp;
+		g_ICUPulseStarted = TRUE;
+	}
+	else
+	{
+		/* Push pulse, drop it if the queue is full */
+		nextHead = (g_ICUQueueHead + 1) & (ICU_PULSE_QUEUE_SIZE - 1);
+		if (nextHead != g_ICUQueueTail)
+		{
+			g_ICUPulseQueue[g_ICUQueueHead].start = g_ICUPulseStart;
+			g_ICUPulseQueue[g_ICUQueueHead].end = timestamp;
+			g_ICUQueueHead = nextHead;
+		}
+		g_ICUPulseStarted = FALSE;
+	}
+	/* Detect the opposite edge, changing edge may raise a false capture flag */
+	TOGGLE_BIT(TCCR1B, ICES1);
+	TIFR = (1 << ICF1);
+
+#endif
+
 	if (g_interruptCallBack_Ptr != NULL_PTR) /* If callback function pointer is not void */
 	{
 		(*g_interruptCallBack_Ptr)(); /* Execute callback function */
 	}
+	ISR_TRACE_EXIT(ISR_TRACE_TIMER1_CAPT);
 }
 
 /*******************************************************************************
@@ -61,11 +135,33 @@ void ICU_init(const ICU_ConfigType *Config_Ptr)
 			CLEAR_BIT(TCCR1B, ICES1);
 		break;
 	}
+
+#if (ICU_TIMESTAMP_ENABLE == TRUE)
+
+	/* Create an instance of Timer16Bit_initConfig to initialize timer1*/
+	Timer_initConfig Timer1_config = { TIMER16BIT_NORMAL, NORMAL_OC,
+			LOGIC_HIGH };
+	/* Start pulses from the chosen edge with an empty queue */
+	g_ICUStartEdge = (*Config_Ptr).edge;
+	g_ICUPulseStarted = FALSE;
+	g_ICUQueueHead = 0;
+	g_ICUQueueTail = 0;
+	g_ICUOverflows = 0;
+	/* Count timer1 overflows */
+	Timer1_setCallBack(ICU_timerOverflow);
+	/* Initialize timer1 and enable it's overflow interrupt */
+	Timer1_init(&Timer1_config);
+
+#else
+
 	/* Create an instance of Timer16Bit_initConfig to initialize timer1*/
 	Timer_initConfig Timer1_config = { TIMER16BIT_NORMAL, NORMAL_OC,
 			LOGIC_LOW };
 	/* Initialize timer1 and disable it's interrupt*/
 	Timer1_init(&Timer1_config);
+
+#endif
+
 	/* Initialize ICU copied value from timer1 by ZERO */
 	ICR1 = 0;
 	/* Enable ICU interrupt */
@@ -125,7 +221,8 @@ uint16 ICU_getInputCaptureValue(void)
 /*
  * [Function Name]	: ICU_clearTimerValue
  * [Description]	:
- * 		Function that resets timer1 count value to ZERO.
+ * 		Function that resets timer1 count value to ZERO, must not be used in
+ * 		timestamp mode.
  * [Args]		: Void.
  * [Return]		: Void
  */
@@ -145,3 +242,84 @@ void ICU_deInit(void)
 {
 	Timer1_deInit();
 }
+
+#if (ICU_TIMESTAMP_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: ICU_timerOverflow
+ * [Description]	:
+ * 		Timer1 overflow call-back, counts high word of timestamps.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void ICU_timerOverflow(void)
+{
+	g_ICUOverflows++;
+}
+
+/*
+ * [Function Name]	: ICU_getTimestamp
+ * [Description]	:
+ * 		Function that returns current 32-bit time of the free-running timer1.
+ * [Args]		: Void.
+ * [Return]		: Current timestamp in timer ticks.
+ */
+uint32 ICU_getTimestamp(void)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	uint16 counterValue = 0; /* Low word of the timestamp */
+	uint16 overflows = 0; /* High word of the timestamp */
+	/* Read both words without being interrupted */
+	CLEAR_BIT(SREG, 7);
+	counterValue = TCNT1;
+	overflows = g_ICUOverflows;
+	/* Same pending overflow case as the capture interrupt */
+	if (BIT_IS_SET(TIFR, TOV1) && (counterValue < 0x8000))
+	{
+		overflows++;
+	}
+	SREG = interruptState;
+	return ((uint32) overflows << 16) | counterValue;
+}
+
+/*
+ * [Function Name]	: ICU_getPulse
+ * [Description]	:
+ * 		Function that removes the oldest pulse from the pulse queue.
+ * [Args]	:
+ * [Out] pulse_Ptr	: Indicates where the pulse timestamps are stored.
+ * [Return]			: TRUE if a pulse was removed, FALSE if queue is empty.
+ */
+uint8 ICU_getPulse(ICU_PulseType *pulse_Ptr)
+{
+	uint8 tail = g_ICUQueueTail; /* Local copy of the queue tail */
+	if (tail == g_ICUQueueHead)
+	{
+		return FALSE;
+	}
+	/* Interrupt never writes the tail entry, no need to disable it */
+	(*pulse_Ptr).start = g_ICUPulseQueue[tail].start;
+	(*pulse_Ptr).end = g_ICUPulseQueue[tail].end;
+	g_ICUQueueTail = (tail + 1) & (ICU_PULSE_QUEUE_SIZE - 1);
+	return TRUE;
+}
+
+/*
+ * [Function Name]	: ICU_flushPulses
+ * [Description]	:
+ * 		Function that empties the pulse queue & waits for a new chosen edge.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void ICU_flushPulses(void)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	CLEAR_BIT(SREG, 7);
+	g_ICUQueueTail = g_ICUQueueHead;
+	g_ICUPulseStarted = FALSE;
+	ICU_setEdgeDetectionType(g_ICUStartEdge);
+	TIFR = (1 << ICF1);
+	SREG = interruptState;
+}
+
+#endif
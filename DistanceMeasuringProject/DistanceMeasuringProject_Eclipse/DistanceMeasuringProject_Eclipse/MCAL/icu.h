@@ -11,6 +11,32 @@
 #include "../std_types.h"			/* To use standard defined types */
 #include "../MCAL/timer.h"			/* To use timer1 */
 
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/*
+ * Timestamp mode:
+ * 		Timer1 is never cleared, every edge is stamped with a 32-bit time made of
+ * 		a software overflow count (high word) & ICR1 (low word). Edges are paired
+ * 		(chosen edge then it's opposite) and queued as pulses, timer1 keeps
+ * 		free-running so it's compare unit B stays usable by other modules.
+ * 		Timer1 overflow call-back (Timer1_setCallBack) is owned by ICU in this mode.
+ */
+#define ICU_TIMESTAMP_ENABLE		TRUE
+
+#if (ICU_TIMESTAMP_ENABLE == TRUE)
+
+/* Number of queued pulses, must be a power of (2) */
+#define ICU_PULSE_QUEUE_SIZE		4
+
+#if ((ICU_PULSE_QUEUE_SIZE & (ICU_PULSE_QUEUE_SIZE - 1)) != 0)
+
+#error "ICU pulse queue size should be a power of (2)"
+
+#endif
+
+#endif
+
 /*******************************************************************************
  *                         Types Declaration                                   *
  *******************************************************************************/
@@ -36,6 +62,23 @@ typedef struct
 	ICU_EDGE_TYPE edge :1;
 } ICU_ConfigType;
 
+#if (ICU_TIMESTAMP_ENABLE == TRUE)
+
+/*
+ * [Structure Name]	: ICU_PulseType
+ * [Description]	:
+ * 		A structure in which it's instance holds 32-bit timestamps of a pulse
+ * 		chosen edge (start) & the following opposite edge (end) in timer ticks,
+ * 		pulse width = end - start even across timestamp wrap-around.
+ */
+typedef struct
+{
+	uint32 start;
+	uint32 end;
+} ICU_PulseType;
+
+#endif
+
 /*******************************************************************************
  *                           Functions Prototypes                              *
  *******************************************************************************/
@@ -85,12 +128,45 @@ uint16 ICU_getInputCaptureValue(void);
 /*
  * [Function Name]	: ICU_clearTimerValue
  * [Description]	:
- * 		Function that resets timer1 count value to ZERO.
+ * 		Function that resets timer1 count value to ZERO, must not be used in
+ * 		timestamp mode.
  * [Args]		: Void.
  * [Return]		: Void
  */
 void ICU_clearTimerValue(void);
 
+#if (ICU_TIMESTAMP_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: ICU_getTimestamp
+ * [Description]	:
+ * 		Function that returns current 32-bit time of the free-running timer1.
+ * [Args]		: Void.
+ * [Return]		: Current timestamp in timer ticks.
+ */
+uint32 ICU_getTimestamp(void);
+
+/*
+ * [Function Name]	: ICU_getPulse
+ * [Description]	:
+ * 		Function that removes the oldest pulse from the pulse queue.
+ * [Args]	:
+ * [Out] pulse_Ptr	: Indicates where the pulse timestamps are stored.
+ * [Return]			: TRUE if a pulse was removed, FALSE if queue is empty.
+ */
+uint8 ICU_getPulse(ICU_PulseType *pulse_Ptr);
+
+/*
+ * [Function Name]	: ICU_flushPulses
+ * [Description]	:
+ * 		Function that empties the pulse queue & waits for a new chosen edge.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void ICU_flushPulses(void);
+
+#endif
+
 /*
  * [Function Name]	: ICU_deInit
  * [Description]	:
@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Module: ISR Trace
+ * File Name: isr_trace.h
+ * Description: Header file for interrupt latency & execution time tracer.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef ISR_TRACE_H_
+#define ISR_TRACE_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Enable ISR tracing, when disabled the trace leaves no code or RAM in the image */
+#define ISR_TRACE_ENABLE				FALSE
+
+#if (ISR_TRACE_ENABLE == TRUE)
+
+/* Latest ISR executions kept, oldest are overwritten, must be a power of 2 */
+#define ISR_TRACE_RING_SIZE				16
+
+#if ((ISR_TRACE_RING_SIZE & (ISR_TRACE_RING_SIZE - 1)) != 0)
+
+#error "ISR_TRACE_RING_SIZE must be a power of 2"
+
+#endif
+
+/*
+ * Trace clock, counts up to ISR_TRACE_CLOCK_TOP then wraps to zero. Timer1
+ * runs free in normal mode for the ICU timestamps, times are in ticks of
+ * it's pre-scaler & must be shorter than one overflow period.
+ */
+#define ISR_TRACE_CLOCK					TCNT1
+#define ISR_TRACE_CLOCK_TOP				0xFFFF
+
+#endif
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Enumerate Name]	: ISR_TRACE_VECTOR
+ * [Description]	:
+ * 		An enumerate that defines traced interrupt vectors.
+ */
+typedef enum
+{
+	ISR_TRACE_TIMER1_COMPA,
+	ISR_TRACE_TIMER1_COMPB,
+	ISR_TRACE_TIMER1_CAPT,
+	ISR_TRACE_USART_RXC,
+	ISR_TRACE_ADC,
+	ISR_TRACE_VECTORS_NUM
+} ISR_TRACE_VECTOR;
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: IsrTrace_RecordType
+ * [Description]	:
+ * 		A structure in which it's instance holds one ISR execution, times
+ * 		are in trace clock ticks.
+ */
+typedef struct
+{
+	ISR_TRACE_VECTOR vector;
+	uint16 entry; /* Clock at ISR entry */
+	uint16 latency; /* From the event that raised the interrupt to entry */
+	uint16 duration; /* From entry to exit */
+} IsrTrace_RecordType;
+
+/*
+ * [Structure Name]	: IsrTrace_StatisticsType
+ * [Description]	:
+ * 		A structure in which it's instance holds minimum, mean & maximum
+ * 		latency & duration of an interrupt vector in trace clock ticks.
+ */
+typedef struct
+{
+	uint16 count;
+	uint16 latencyMin;
+	uint16 latencyMean;
+	uint16 latencyMax;
+	uint16 durationMin;
+	uint16 durationMean;
+	uint16 durationMax;
+} IsrTrace_StatisticsType;
+
+/*******************************************************************************
+ *                                Macros                                       *
+ *******************************************************************************/
+/*
+ * ISR_TRACE_ENTRY is the first statement of a traced ISR & ISR_TRACE_EXIT is
+ * put before every return. ISR_TRACE_ENTRY_EVENT takes the timer register
+ * holding the time of the event that raised the interrupt, compare or
+ * capture value, so it's latency is measured. Other vectors have no latency.
+ */
+#if (ISR_TRACE_ENABLE == TRUE)
+
+#define ISR_TRACE_ENTRY_EVENT(eventTime)									\
+	uint16 isrTraceEntry = ISR_TRACE_CLOCK;									\
+	uint16 isrTraceEvent = (eventTime)
+
+#define ISR_TRACE_ENTRY()		ISR_TRACE_ENTRY_EVENT(isrTraceEntry)
+
+#define ISR_TRACE_EXIT(vector)												\
+	IsrTrace_record((vector), isrTraceEvent, isrTraceEntry, ISR_TRACE_CLOCK)
+
+#else
+
+#define ISR_TRACE_ENTRY_EVENT(eventTime)
+#define ISR_TRACE_ENTRY()
+#define ISR_TRACE_EXIT(vector)
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+#if (ISR_TRACE_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: IsrTrace_record
+ * [Description]	:
+ * 		Function that adds an ISR execution to the vector statistics & to
+ * 		the ring, called by ISR_TRACE_EXIT with global interrupt disabled.
+ * [Args]	:
+ * [In] vector		: Indicates traced vector.
+ * [In] eventTime	: Indicates clock when the interrupt was raised.
+ * [In] entryTime	: Indicates clock at ISR entry.
+ * [In] exitTime	: Indicates clock at ISR exit.
+ * [Return]			: Void.
+ */
+void IsrTrace_record(ISR_TRACE_VECTOR vector, uint16 eventTime,
+		uint16 entryTime, uint16 exitTime);
+
+/*
+ * [Function Name]	: IsrTrace_getStatistics
+ * [Description]	:
+ * 		Function that gets latency & duration statistics of a vector.
+ * [Args]	:
+ * [In] vector				: Indicates traced vector.
+ * [Out] statistics_Ptr		: Pointer to statistics to be filled.
+ * [Return]					: Void.
+ */
+void IsrTrace_getStatistics(ISR_TRACE_VECTOR vector,
+		IsrTrace_StatisticsType *statistics_Ptr);
+
+/*
+ * [Function Name]	: IsrTrace_getRecord
+ * [Description]	:
+ * 		Function that gets an ISR execution from the ring, oldest first.
+ * [Args]	:
+ * [In] index			: Indicates record index, (0) is the oldest.
+ * [Out] record_Ptr		: Pointer to record to be filled.
+ * [Return]				: TRUE if the record exists, FALSE otherwise.
+ */
+uint8 IsrTrace_getRecord(uint8 index, IsrTrace_RecordType *record_Ptr);
+
+/*
+ * [Function Name]	: IsrTrace_reset
+ * [Description]	:
+ * 		Function that clears statistics & ring.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void IsrTrace_reset(void);
+
+/*
+ * [Function Name]	: IsrTrace_dump
+ * [Description]	:
+ * 		Function that writes statistics of every traced vector then the ring
+ * 		as text lines, e.g. through USART_sendByte. Interrupts stay enabled
+ * 		while sending, so the ring may move on during the dump.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [Return]				: Void.
+ */
+void IsrTrace_dump(void (*Ptr2SendByte)(const uint8 data));
+
+#endif
+
+#endif /* ISR_TRACE_H_ */
@@ -10,6 +10,7 @@
 #include "../common_macros.h"			/* For common macros usage */
 #include "../MCAL/gpio.h"				/* For timer associated GPIO pins */
 #include "../MCAL/timer.h"				/* For timer prototypes & definitions */
+#include "../MCAL/isr_trace.h"			/* For timer1 compare ISRs tracing */
 
 /*******************************************************************************
  *                           Timer Useful Equations                            *
@@ -254,10 +255,12 @@ ISR(TIMER1_OVF_vect)
  */
 ISR(TIMER1_COMPA_vect)
 {
+	ISR_TRACE_ENTRY_EVENT(OCR1A);
 	if (g_timer1CallBackUnitA_Ptr != NULL_PTR) /* If callback function pointer is not void */
 	{
 		(*g_timer1CallBackUnitA_Ptr)(); /* Execute callback function */
 	}
+	ISR_TRACE_EXIT(ISR_TRACE_TIMER1_COMPA);
 }
 
 /*
@@ -267,10 +270,12 @@ ISR(TIMER1_COMPA_vect)
  */
 ISR(TIMER1_COMPB_vect)
 {
+	ISR_TRACE_ENTRY_EVENT(OCR1B);
 	if (g_timer1CallBackUnitB_Ptr != NULL_PTR) /* If callback function pointer is not void */
 	{
 		(*g_timer1CallBackUnitB_Ptr)(); /* Execute callback function */
 	}
+	ISR_TRACE_EXIT(ISR_TRACE_TIMER1_COMPB);
 }
 
 #endif
@@ -773,6 +778,47 @@ void Timer1_start(TIMER01_PRESCALER prescaler, uint16 start,
 	OVERWRITE_REG(TCCR1B, 0xF8, prescaler);
 }
 
+/*
+ * [Function Name]	: Timer1_setCompareValueB
+ * [Description]	:
+ * 		Function that changes compare unit B value without stopping or clearing
+ * 		timer1, used to schedule events on a free-running timer.
+ * [Args]	:
+ * [In] compareValue	: Indicates compare value for unit B.
+ * [Return]				: Void.
+ */
+void Timer1_setCompareValueB(uint16 compareValue)
+{
+	OCR1B = compareValue;
+}
+
+/*
+ * [Function Name]	: Timer1_enableInterruptUnitB
+ * [Description]	:
+ * 		Function that enables compare unit B interrupt after clearing it's flag,
+ * 		in any timer1 mode.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Timer1_enableInterruptUnitB(void)
+{
+	/* Flag is cleared by writing (LOGIC HIGH), write only the required flag */
+	TIFR = (1 << OCF1B);
+	SET_BIT(TIMSK, OCIE1B);
+}
+
+/*
+ * [Function Name]	: Timer1_disableInterruptUnitB
+ * [Description]	:
+ * 		Function that disables compare unit B interrupt.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Timer1_disableInterruptUnitB(void)
+{
+	CLEAR_BIT(TIMSK, OCIE1B);
+}
+
 /*
  * [Function Name]	: Timer1_stop
  * [Description]	:
@@ -229,6 +229,36 @@ void Timer1_setCallBackUnitB(void (*Ptr2Function)(void));
 void Timer1_start(TIMER01_PRESCALER prescaler, uint16 start,
 		uint16 compareValueA, uint16 compareValueB);
 
+/*
+ * [Function Name]	: Timer1_setCompareValueB
+ * [Description]	:
+ * 		Function that changes compare unit B value without stopping or clearing
+ * 		timer1, used to schedule events on a free-running timer.
+ * [Args]	:
+ * [In] compareValue	: Indicates compare value for unit B.
+ * [Return]				: Void.
+ */
+void Timer1_setCompareValueB(uint16 compareValue);
+
+/*
+ * [Function Name]	: Timer1_enableInterruptUnitB
+ * [Description]	:
+ * 		Function that enables compare unit B interrupt after clearing it's flag,
+ * 		in any timer1 mode.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Timer1_enableInterruptUnitB(void);
+
+/*
+ * [Function Name]	: Timer1_disableInterruptUnitB
+ * [Description]	:
+ * 		Function that disables compare unit B interrupt.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Timer1_disableInterruptUnitB(void);
+
 /*
  * [Function Name]	: Timer1_stop
  * [Description]	:
@@ -7,8 +7,12 @@
 #include <avr/io.h>						/* For AVR registers */
 #include <util/delay.h>					/* For delay functions */
 #include "../common_macros.h"			/* For common macros usage */
+#include "../MCAL/event_log.h"			/* For events log */
 #include "../MCAL/gpio.h"				/* For GPIO usage */
 #include "../MCAL/i2c.h"				/* For I2C usage */
+#include "../MCAL/isr_trace.h"			/* For ISR tracing */
+#include "../MCAL/power.h"				/* For sleep modes usage */
+#include "../MCAL/profiler.h"			/* For CPU load measurement */
 #include "../MCAL/timer.h"				/* For timer usage */
 #include "../MCAL/usart.h"				/* For USART usage */
 #include "../HAL/buzzer.h"				/* For Buzzer usage */
@@ -16,6 +20,12 @@
 #include "../HAL/external_eeprom.h"		/* For EEPROM usage */
 #include "../APP/DEVICE_FUNCTIONS.h"	/* For function prototypes & global variables definations */
 
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Profiled tasks, the handling of each HMI_ECU command */
+#define CONTROL_TASK_COMMAND		0
+
 /*******************************************************************************
  *                              Global Variables                               *
  *******************************************************************************/
@@ -41,11 +51,6 @@ int main(void)
 	/* Variables definations */
 	uint8 counter = 0; /* A counter variable for loops */
 	SET_BIT(SREG, 7); /* Enable global interrupt I-bit */
-	/* Create an instance of timer0 initialization structure */
-	Timer_initConfig Timer_config = { TIMER8BIT_FAST_PWM, CLEAR_OC,
-	LOGIC_LOW };
-	/* Initialize timer0 for PWM signal to control motor speed */
-	Timer0_init(&Timer_config);
 	/* Create an instance of timer1 initialization structure */
 	Timer_initConfig timerConfig =
 			{ TIMER16BIT_CTC_OCR1A, NORMAL_OC, LOGIC_HIGH };
@@ -68,6 +73,32 @@ int main(void)
 	LOGIC_LOW };
 	/* Initialize USART */
 	USART_init(&USARTConfig);
+	/* Sleep while waiting for USART bytes, timer1 & USART wake the CPU */
+	Power_init(POWER_IDLE_MODE);
+	Power_registerWakeup(POWER_WAKEUP_TIMER1);
+	Power_registerWakeup(POWER_WAKEUP_USART);
+
+#if (PROFILER_ENABLE == TRUE)
+
+	/* Measure CPU load & tasks time */
+	Profiler_init();
+
+#endif
+
+#if (EVENT_LOG_ENABLE == TRUE)
+
+	/* Stream events on USART for diagnostics */
+	EventLog_init();
+
+#endif
+
+#if (ISR_TRACE_ENABLE == TRUE)
+
+	/* Trace ISRs duration on timer2 */
+	IsrTrace_init();
+
+#endif
+
 	/* Scan for an existing password */
 	scanPassword();
 	/* Execute program loop */
@@ -75,6 +106,8 @@ int main(void)
 	{
 		/* Wait for a command for HMI_ECU */
 		USARTCommand = USART_recieveByte();
+		EVENT_LOG(CONTROL_EVENT_COMMAND, USARTCommand);
+		PROFILER_TASK_START(CONTROL_TASK_COMMAND);
 		/* Switch for incoming command */
 		switch (USARTCommand)
 		{
@@ -95,5 +128,6 @@ int main(void)
 				breachDetection();
 			break;
 		}
+		PROFILER_TASK_STOP();
 	}
 }
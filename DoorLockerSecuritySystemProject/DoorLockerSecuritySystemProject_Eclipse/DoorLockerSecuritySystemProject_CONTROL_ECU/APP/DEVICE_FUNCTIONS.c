@@ -6,6 +6,7 @@
  *******************************************************************************/
 
 #include <util/delay.h>					/* For delay functions */
+#include "../MCAL/event_log.h"			/* For events log */
 #include "../MCAL/timer.h"				/* For timer usage */
 #include "../MCAL/usart.h"				/* For USART usage */
 #include "../HAL/dc_motor.h"			/* For DC motor usage */
@@ -68,16 +69,19 @@ void timerSeconds(void)
 	seconds++; /* Increase a second each timer interrupt */
 	if (seconds == 15)
 	{
+		EVENT_LOG_FROM_ISR(CONTROL_EVENT_DOOR, seconds);
 		USART_sendByte(0x04); /* Tell HMI_ECU the states of the door*/
 		DCMotor_Rotate(STOP, 0); /* Stop motor rotation upon reaching 15 seconds */
 	}
 	else if (seconds == 18)
 	{
+		EVENT_LOG_FROM_ISR(CONTROL_EVENT_DOOR, seconds);
 		USART_sendByte(0x04); /* Tell HMI_ECU the states of the door*/
 		DCMotor_Rotate(COUNTER_CLOCKWISE, 100); /* Start motor rotation upon reaching 18 seconds */
 	}
 	else if (seconds == 33)
 	{
+		EVENT_LOG_FROM_ISR(CONTROL_EVENT_DOOR, seconds);
 		USART_sendByte(0x04); /* Tell HMI_ECU the states of the door*/
 		DCMotor_Rotate(STOP, 0); /* Stop motor rotation upon reaching 33 seconds */
 		/* Stop counting for mechanism time */
@@ -113,6 +117,7 @@ void definePassword(void)
 		/* If passwords matched or didn't, report status in either ways */
 		if (receivedPassword[counter] != receivedPasswordReenter[counter])
 		{
+			EVENT_LOG(CONTROL_EVENT_PASSWORD, 0x00);
 			_delay_ms(10);
 			USART_sendByte(0x00);
 			break;
@@ -124,6 +129,7 @@ void definePassword(void)
 			{
 				EEPROM_writeByte(0x0001 + counter, receivedPassword[counter]);
 			}
+			EVENT_LOG(CONTROL_EVENT_PASSWORD, 0x02);
 			_delay_ms(10);
 			USART_sendByte(0x02);
 		}
@@ -152,12 +158,14 @@ void checkPassword(void)
 		/* If passwords matched or didn't, report status in either ways */
 		if (receivedPassword[counter] != currentPassword[counter])
 		{
+			EVENT_LOG(CONTROL_EVENT_PASSWORD, 0x00);
 			_delay_ms(10);
 			USART_sendByte(0x00);
 			break;
 		}
 		if (counter == 4)
 		{
+			EVENT_LOG(CONTROL_EVENT_PASSWORD, 0x03);
 			USART_sendByte(0x03);
 		}
 	}
@@ -192,6 +200,7 @@ void doorUnlock(void)
 void breachDetection(void)
 {
 	uint8 counter = 0; /* A counter variable for loops */
+	EVENT_LOG(CONTROL_EVENT_BREACH, 0);
 	/* Turn on buzzer */
 	Buzzer_on();
 	/* Wait for (60) seconds*/
@@ -8,6 +8,15 @@
 #ifndef APP_DEVICE_FUNCTIONS_H_
 #define APP_DEVICE_FUNCTIONS_H_
 
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Event log identifiers, payload in comment */
+#define CONTROL_EVENT_COMMAND		1 /* Command received from HMI_ECU */
+#define CONTROL_EVENT_PASSWORD		2 /* Reply sent to HMI_ECU for a password */
+#define CONTROL_EVENT_DOOR			3 /* Door mechanism seconds */
+#define CONTROL_EVENT_BREACH		4 /* None */
+
 /*******************************************************************************
  *                              Global Variables                               *
  *******************************************************************************/
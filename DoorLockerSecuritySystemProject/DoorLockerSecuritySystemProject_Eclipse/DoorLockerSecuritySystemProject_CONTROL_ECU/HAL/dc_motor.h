@@ -14,12 +14,24 @@
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
-/* DC motor hardware ports & pins IDs */
+/* DC motor hardware ports & pins IDs, bridge enable pin is the PWM output pin
+ * chosen in PWM driver (OC0 or OC1A) */
 #define DC_MOTOR_PORT			PORTB_ID
-#define DC_MOTOR_ENABLE			PIN3_ID
 #define DC_MOTOR_IN1			PIN1_ID
 #define DC_MOTOR_IN2			PIN2_ID
 
+/*
+ * Soft-start / soft-stop:
+ * 		When enabled, speed changes ramp from the current duty-cycle to the new one
+ * 		in the PWM period interrupt, so DCMotor_Rotate only sets a target. Stopping
+ * 		ramps down to ZERO, reversing ramps down to ZERO then up in the new direction.
+ * 		(DC_MOTOR_RAMP_TIME_MS) is the time of a full (0 -> 100%) ramp, shorter
+ * 		changes take proportionally less time. S-curve ramps start & end smoothly.
+ */
+#define DC_MOTOR_RAMP_ENABLE	TRUE
+#define DC_MOTOR_RAMP_TIME_MS	500
+#define DC_MOTOR_RAMP_S_CURVE	TRUE
+
 /*******************************************************************************
  *                               Types Declaration                             *
  *******************************************************************************/
@@ -57,4 +69,17 @@ void DCMotor_init(void);
  */
 void DCMotor_Rotate(ROTATION_STATE rotation, uint8 speed);
 
+#if (DC_MOTOR_RAMP_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: DCMotor_isRamping
+ * [Description]	:
+ * 		Function that checks if the motor is still ramping to it's last target.
+ * [Args]		: Void.
+ * [Return]		: (TRUE) if ramping, (FALSE) if target is reached.
+ */
+uint8 DCMotor_isRamping(void);
+
+#endif
+
 #endif /* DC_MOTOR_H_ */
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Module: Event Log
+ * File Name: event_log.h
+ * Description: Header file for binary events log streamed over USART.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef EVENT_LOG_H_
+#define EVENT_LOG_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+#include "timer.h"				/* For timer2 used as log clock */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/*
+ * Enable the log, when disabled the log leaves no code or RAM in the image.
+ * Records are sent on the USART transmitter as whole frames before the
+ * application bytes, to a PC decoding them (HostSimulation/tools). Enable
+ * it on both ECUs when they are linked: USART_recieveByte drops the frames
+ * of the other ECU, the applications never send EVENT_LOG_SYNC.
+ */
+#define EVENT_LOG_ENABLE				FALSE
+
+#if (EVENT_LOG_ENABLE == TRUE)
+
+#include <avr/io.h>						/* For timer2 & USART registers */
+#include "../common_macros.h"			/* For common macros usage */
+
+#if (TIMER2_ENABLE == FALSE)
+
+#error "Event log counts time with timer2, set TIMER2_ENABLE in timer.h"
+
+#endif
+
+/* Records waiting to be sent, a new record is dropped when full, must be a
+ * power of 2 up to 128 */
+#define EVENT_LOG_RING_SIZE				16
+
+#if ((EVENT_LOG_RING_SIZE & (EVENT_LOG_RING_SIZE - 1)) != 0) || (EVENT_LOG_RING_SIZE > 128)
+
+#error "EVENT_LOG_RING_SIZE must be a power of 2 up to 128"
+
+#endif
+
+/* Log clock, (1024) cycles per tick is (128) us at (8) MHz & wraps every (8.4) s */
+#define EVENT_LOG_PRESCALER				TIMER2_PRESCALER_1024
+
+#endif
+
+/* Events identifiers from (1) to (254) are given by the application, the log
+ * sends (0) with the number of records dropped while the ring was full & (255)
+ * with the number of log clock wraps each time the clock wraps, so a decoder
+ * keeps the time across gaps longer than one clock period */
+#define EVENT_LOG_DROPPED				0
+#define EVENT_LOG_EPOCH					255
+
+/*
+ * Frame on the wire: sync byte, identifier, time & payload least significant
+ * byte first then the sum of the (5) bytes after the sync byte.
+ */
+#define EVENT_LOG_SYNC					0xA5
+#define EVENT_LOG_FRAME_SIZE			7
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: EventLog_RecordType
+ * [Description]	:
+ * 		A structure in which it's instance holds one event waiting to be sent.
+ */
+typedef struct
+{
+	uint8 id;
+	uint16 time; /* Log clock ticks */
+	uint16 payload;
+} EventLog_RecordType;
+
+#if (EVENT_LOG_ENABLE == TRUE)
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Written in place by EVENT_LOG_FROM_ISR, see event_log.c */
+extern volatile uint8 g_eventLogOverflows;
+extern volatile EventLog_RecordType g_eventLogRing[EVENT_LOG_RING_SIZE];
+extern volatile uint8 g_eventLogHead;
+extern volatile uint8 g_eventLogTail;
+extern volatile uint16 g_eventLogDropped;
+
+#endif
+
+/*******************************************************************************
+ *                                Macros                                       *
+ *******************************************************************************/
+/*
+ * EVENT_LOG is used by the main loop & EVENT_LOG_FROM_ISR inside ISRs where
+ * global interrupt is already disabled. EVENT_LOG_FROM_ISR is expanded in
+ * place, no call & no registers saved for it, whatever the optimization
+ * level: a ring full check, a clock read & five stores. They expand to
+ * nothing when the log is disabled.
+ */
+#if (EVENT_LOG_ENABLE == TRUE)
+
+#define EVENT_LOG(id, payload)				EventLog_write((id), (payload))
+
+/*
+ * Reads the log clock in timer2 ticks with global interrupt disabled. When
+ * timer2 overflowed but it's interrupt is still pending, a small count was
+ * read after that overflow.
+ */
+#define EVENT_LOG_READ_CLOCK(time)												\
+	do																			\
+	{																			\
+		uint8 eventLogCount = TCNT2;											\
+		(time) = ((uint16) g_eventLogOverflows << 8) | eventLogCount;			\
+		if (BIT_IS_SET(TIFR, TOV2) && (eventLogCount < 0x80))					\
+		{																		\
+			(time) += 0x100;													\
+		}																		\
+	} while (0)
+
+#define EVENT_LOG_FROM_ISR(eventId, eventData)									\
+	do																			\
+	{																			\
+		uint8 eventLogHead = g_eventLogHead;									\
+		uint8 eventLogNext = (eventLogHead + 1) & (EVENT_LOG_RING_SIZE - 1);	\
+		if (eventLogNext == g_eventLogTail)										\
+		{																		\
+			/* Ring full, the count is sent once it empties */					\
+			if (g_eventLogDropped != 0xFFFF)									\
+			{																	\
+				g_eventLogDropped++;											\
+			}																	\
+		}																		\
+		else																	\
+		{																		\
+			g_eventLogRing[eventLogHead].id = (eventId);						\
+			EVENT_LOG_READ_CLOCK(g_eventLogRing[eventLogHead].time);			\
+			g_eventLogRing[eventLogHead].payload = (eventData);					\
+			g_eventLogHead = eventLogNext;										\
+		}																		\
+	} while (0)
+
+#else
+
+#define EVENT_LOG(id, payload)
+#define EVENT_LOG_FROM_ISR(id, payload)
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+#if (EVENT_LOG_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: EventLog_init
+ * [Description]	:
+ * 		Function that starts timer2 as log clock & empties the ring. Timer2
+ * 		overflows wake the CPU, so it registers timer2 as a wake-up source,
+ * 		call it after USART_init & Power_init.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void EventLog_init(void);
+
+/*
+ * [Function Name]	: EventLog_write
+ * [Description]	:
+ * 		Function that adds an event to the ring, it's sent before the next
+ * 		application byte.
+ * [Args]	:
+ * [In] id			: Indicates event identifier.
+ * [In] payload		: Indicates event data.
+ * [Return]			: Void.
+ */
+void EventLog_write(uint8 id, uint16 payload);
+
+/*
+ * [Function Name]	: EventLog_drain
+ * [Description]	:
+ * 		Function that sends the next byte of the log, the rest of the frame
+ * 		being sent then the frames of the waiting records. Called by
+ * 		USART_sendByte with USART data register empty & global interrupt
+ * 		disabled, the application byte is sent once it returns FALSE.
+ * [Args]		: Void.
+ * [Return]		: TRUE if a log byte was sent, FALSE if the log is empty.
+ */
+uint8 EventLog_drain(void);
+
+#endif
+
+#endif /* EVENT_LOG_H_ */
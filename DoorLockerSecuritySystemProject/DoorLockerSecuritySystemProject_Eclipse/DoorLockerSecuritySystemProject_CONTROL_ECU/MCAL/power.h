@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Module: Power
+ * File Name: power.h
+ * Description: Header file for sleep modes power management driver.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Enumerate Name]	: POWER_SLEEP_MODE
+ * [Description]	:
+ * 		An enumerate that defines sleep modes the CPU enters while there is no work.
+ * 		POWER_IDLE_MODE stops the CPU clock only, every interrupt wakes it up.
+ * 		POWER_ADC_NOISE_REDUCTION_MODE also stops the I/O clock, which removes
+ * 		digital noise from ADC conversions but most peripherals stop with it.
+ */
+typedef enum
+{
+	POWER_IDLE_MODE, POWER_ADC_NOISE_REDUCTION_MODE
+} POWER_SLEEP_MODE;
+
+/*
+ * [Enumerate Name]	: POWER_WAKEUP_SOURCE
+ * [Description]	:
+ * 		An enumerate that defines interrupt sources the application waits for,
+ * 		the registered sources decide which sleep mode can be entered.
+ */
+typedef enum
+{
+	POWER_WAKEUP_EXT_INT_EDGE, /* INT0/INT1 edges */
+	POWER_WAKEUP_EXT_INT_LEVEL, /* INT0/INT1 low level & INT2 */
+	POWER_WAKEUP_TIMER0,
+	POWER_WAKEUP_TIMER1,
+	POWER_WAKEUP_TIMER2,
+	POWER_WAKEUP_TIMER2_ASYNC, /* Timer2 clocked from TOSC1 crystal */
+	POWER_WAKEUP_USART,
+	POWER_WAKEUP_SPI,
+	POWER_WAKEUP_TWI,
+	POWER_WAKEUP_ADC,
+	POWER_WAKEUP_EEPROM
+} POWER_WAKEUP_SOURCE;
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/*
+ * Wake-up sources that still work in ADC noise reduction mode, the rest need
+ * the I/O clock. Registering any other source makes the driver fall back to
+ * idle mode, so an event is never slept through.
+ */
+#define POWER_ADC_NOISE_REDUCTION_WAKEUPS					\
+	((1u << POWER_WAKEUP_EXT_INT_LEVEL) | (1u << POWER_WAKEUP_TIMER2_ASYNC) |	\
+	(1u << POWER_WAKEUP_ADC) | (1u << POWER_WAKEUP_EEPROM))
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Power_init
+ * [Description]	:
+ * 		Function that sets the preferred sleep mode & empties wake-up sources registry.
+ * [Args]	:
+ * [In] mode	: Indicates preferred sleep mode.
+ * [Return]		: Void.
+ */
+void Power_init(POWER_SLEEP_MODE mode);
+
+/*
+ * [Function Name]	: Power_registerWakeup
+ * [Description]	:
+ * 		Function that adds an interrupt source the application waits for to
+ * 		the registry.
+ * [Args]	:
+ * [In] source	: Indicates wake-up source.
+ * [Return]		: Void.
+ */
+void Power_registerWakeup(POWER_WAKEUP_SOURCE source);
+
+/*
+ * [Function Name]	: Power_unregisterWakeup
+ * [Description]	:
+ * 		Function that removes an interrupt source from the registry.
+ * [Args]	:
+ * [In] source	: Indicates wake-up source.
+ * [Return]		: Void.
+ */
+void Power_unregisterWakeup(POWER_WAKEUP_SOURCE source);
+
+/*
+ * [Function Name]	: Power_getSleepMode
+ * [Description]	:
+ * 		Function that gets the sleep mode Power_sleep enters, the preferred
+ * 		mode if every registered source can wake the CPU from it, otherwise
+ * 		idle mode.
+ * [Args]		: Void.
+ * [Return]		: Sleep mode.
+ */
+POWER_SLEEP_MODE Power_getSleepMode(void);
+
+/*
+ * [Function Name]	: Power_sleep
+ * [Description]	:
+ * 		Function that sleeps until the next interrupt. Call it with global
+ * 		interrupt disabled right after finding no work, the I-bit is set by the
+ * 		instruction before sleeping so an interrupt raised after the check wakes
+ * 		the CPU instead of being slept through. Returns without sleeping if no
+ * 		wake-up source is registered.
+ * [Args]		: Void.
+ * [Return]		: Void, global interrupt is enabled on return.
+ */
+void Power_sleep(void);
+
+#endif /* POWER_H_ */
@@ -10,6 +10,7 @@
 #include "../common_macros.h"			/* For common macros usage */
 #include "../MCAL/gpio.h"				/* For timer associated GPIO pins */
 #include "../MCAL/timer.h"				/* For timer prototypes & definitions */
+#include "../MCAL/isr_trace.h"			/* For timer1 compare ISRs tracing */
 
 /*******************************************************************************
  *                           Timer Useful Equations                            *
@@ -254,10 +255,12 @@ ISR(TIMER1_OVF_vect)
  */
 ISR(TIMER1_COMPA_vect)
 {
+	ISR_TRACE_ENTRY_EVENT(OCR1A);
 	if (g_timer1CallBackUnitA_Ptr != NULL_PTR) /* If callback function pointer is not void */
 	{
 		(*g_timer1CallBackUnitA_Ptr)(); /* Execute callback function */
 	}
+	ISR_TRACE_EXIT(ISR_TRACE_TIMER1_COMPA);
 }
 
 /*
@@ -267,10 +270,12 @@ ISR(TIMER1_COMPA_vect)
  */
 ISR(TIMER1_COMPB_vect)
 {
+	ISR_TRACE_ENTRY_EVENT(OCR1B);
 	if (g_timer1CallBackUnitB_Ptr != NULL_PTR) /* If callback function pointer is not void */
 	{
 		(*g_timer1CallBackUnitB_Ptr)(); /* Execute callback function */
 	}
+	ISR_TRACE_EXIT(ISR_TRACE_TIMER1_COMPB);
 }
 
 #endif
@@ -18,6 +18,14 @@
 #define USART_INTERRUPT_ENABLE					FALSE
 #define USART_SYNCHRONOUS_MODE_ENABLE			FALSE
 #define USART_9BIT_MODE_ENABLE					FALSE
+/* Sleep while waiting for a received byte, the receive complete interrupt wakes the CPU */
+#define USART_RECEIVE_SLEEP_ENABLE				TRUE
+
+#if (USART_RECEIVE_SLEEP_ENABLE == TRUE) && (USART_INTERRUPT_ENABLE == TRUE)
+
+#error "USART receive sleep uses receive complete interrupt, disable USART interrupts"
+
+#endif
 
 #if (USART_SYNCHRONOUS_MODE_ENABLE == TRUE)
 
@@ -129,7 +137,8 @@ void USART_UDREsetCallBack(void (*Ptr2Function)(void));
 /*
  * [Function Name]	: USART_sendByte
  * [Description]	:
- * 		Function that sends data through USART.
+ * 		Function that sends data through USART, after the waiting event log
+ * 		frames when the log is enabled.
  * [Args] data	: Indicates data to be sent.
  * [Return]		: Void.
  */
@@ -147,7 +156,8 @@ void USART_sendByte(const uint8 data);
 /*
  * [Function Name]	: USART_recieveByte
  * [Description]	:
- * 		Function that receives data through USART.
+ * 		Function that receives data through USART, event log frames of the
+ * 		other ECU are dropped when the log is enabled.
  * [Args] 		: Void.
  * [Return]		: Data existing in UDR.
  */
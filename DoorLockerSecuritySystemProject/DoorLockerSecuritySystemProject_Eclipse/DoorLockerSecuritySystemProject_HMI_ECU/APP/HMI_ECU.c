@@ -7,6 +7,11 @@
 #include <avr/io.h>						/* For AVR registers */
 #include <util/delay.h>					/* For delay functions */
 #include "../common_macros.h"			/* For common macros usage */
+#include "../MCAL/event_log.h"			/* For events log */
+#include "../MCAL/isr_trace.h"			/* For ISR tracing */
+#include "../MCAL/mem.h"				/* For stack usage monitor */
+#include "../MCAL/power.h"				/* For sleep modes usage */
+#include "../MCAL/profiler.h"			/* For CPU load measurement */
 #include "../MCAL/timer.h"				/* For timer usage */
 #include "../MCAL/usart.h"				/* For USART usage */
 #include "../HAL/keypad.h"				/* For keypad usage */
@@ -15,6 +20,17 @@
 #include "../APP/DEVICE_GLOBALS.h"		/* For global variables usage */
 #include "../APP/DEVICE_SCREENS.h"		/* For device screens prototypes */
 
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Profiled tasks, the key handling after each key press */
+#define HMI_TASK_KEY				0
+/* Event log identifiers, payload in comment */
+#define HMI_EVENT_KEY				1 /* Key class, digits are never logged */
+#define HMI_EVENT_BREACH			2 /* None */
+/* Key class payload of HMI_EVENT_KEY, other keys are logged as their character */
+#define HMI_KEY_CLASS_DIGIT			0
+
 /*******************************************************************************
  *                              Global Variables                               *
  *******************************************************************************/
@@ -39,6 +55,8 @@ int main(void)
 {
 	/* Variables definations */
 	uint8 failCount = 0; /* Variable indicating number of password entries failure */
+	/* Paint free SRAM to measure stack usage */
+	Mem_init();
 	/* Enable global interrupt */
 	SET_BIT(SREG, 7);
 	/* Initialize LCD */
@@ -55,6 +73,32 @@ int main(void)
 	LOGIC_LOW };
 	/* Initialize USART */
 	USART_init(&USARTConfig);
+	/* Sleep while waiting for USART bytes, timer1 & USART wake the CPU */
+	Power_init(POWER_IDLE_MODE);
+	Power_registerWakeup(POWER_WAKEUP_TIMER1);
+	Power_registerWakeup(POWER_WAKEUP_USART);
+
+#if (PROFILER_ENABLE == TRUE)
+
+	/* Measure CPU load & tasks time */
+	Profiler_init();
+
+#endif
+
+#if (EVENT_LOG_ENABLE == TRUE)
+
+	/* Stream events on USART for diagnostics */
+	EventLog_init();
+
+#endif
+
+#if (ISR_TRACE_ENABLE == TRUE)
+
+	/* Trace ISRs duration on timer2 */
+	IsrTrace_init();
+
+#endif
+
 	/* Display text on LCD */
 	LCD_displayString("Enter Password: ");
 	/* Move to row 0 column 10 */
@@ -71,6 +115,9 @@ int main(void)
 	{
 		/* Wait for user to press a key */
 		key = Keypad_getPressedKey();
+		/* Log the key class only, a digit is part of the password */
+		EVENT_LOG(HMI_EVENT_KEY, (key <= 9) ? HMI_KEY_CLASS_DIGIT : key);
+		PROFILER_TASK_START(HMI_TASK_KEY);
 		if ((key <= 9) && (key >= 0))
 		{
 			/* Enter the password on the screen */
@@ -150,6 +197,7 @@ int main(void)
 						/* If maximum number of wrong entries reached */
 						if (failCount == 3)
 						{
+							EVENT_LOG(HMI_EVENT_BREACH, 0);
 							/* Execute breach detection protocol */
 							breachDetection();
 							/* Reset failure times */
@@ -159,5 +207,6 @@ int main(void)
 				}
 			}
 		}
+		PROFILER_TASK_STOP();
 	}
 }
@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Module: Event Log
+ * File Name: event_log.c
+ * Description: Source file for binary events log streamed over USART.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "event_log.h"					/* For event log prototypes & definitions */
+
+#if (EVENT_LOG_ENABLE == TRUE)
+
+#include <avr/io.h>						/* For timer2 & USART registers */
+#include "../common_macros.h"			/* For common macros usage */
+#include "power.h"						/* For timer2 wake-up source */
+#include "profiler.h"					/* For timer2 owner check */
+#include "usart.h"						/* For USART 9-bit mode check */
+
+#if (PROFILER_ENABLE == TRUE)
+
+#error "Event log & profiler both use timer2, enable one of them"
+
+#endif
+
+#if (USART_9BIT_MODE_ENABLE == TRUE)
+
+#error "Event log sends 8-bit frames, disable USART_9BIT_MODE_ENABLE"
+
+#endif
+
+/*******************************************************************************
+ *                          Event Log Useful Notes                             *
+ *******************************************************************************/
+/*
+ * 		Time = (Overflows * 256) + TCNT2 ticks, Cycles = Ticks * Pre-scaler
+ *
+ * 		Time wraps after (65536) ticks, the overflow that wraps it queues an
+ * 		EVENT_LOG_EPOCH record holding the wraps count since EventLog_init,
+ * 		stamped at the start of the new period.
+ *
+ * 		Writers are ISRs, which never nest, or the main loop with global
+ * 		interrupt disabled for the few instructions of the write, so the
+ * 		ring takes no lock. Only writers move the head & only EventLog_drain
+ * 		moves the tail.
+ *
+ * 		Records are sent by USART_sendByte before each application byte, one
+ * 		frame byte per call of EventLog_drain with global interrupt disabled,
+ * 		until the ring is empty. The other ECU is waiting for that byte, so
+ * 		it reads & drops the frames instead of overrunning it's receiver,
+ * 		which a background transmission would do while it's busy. Records
+ * 		wait in the ring between application bytes, a full ring drops them.
+ */
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Timer2 overflows, high byte of the log clock */
+volatile uint8 g_eventLogOverflows = 0;
+/* Log clock wraps, sent in the epoch records */
+static volatile uint16 g_eventLogEpoch = 0;
+/* Records waiting to be sent, written at head & sent from tail */
+volatile EventLog_RecordType g_eventLogRing[EVENT_LOG_RING_SIZE];
+volatile uint8 g_eventLogHead = 0;
+volatile uint8 g_eventLogTail = 0;
+/* Records dropped while the ring was full, saturates */
+volatile uint16 g_eventLogDropped = 0;
+/* Frame being sent & index of it's next byte */
+static volatile uint8 g_eventLogFrame[EVENT_LOG_FRAME_SIZE];
+static volatile uint8 g_eventLogFrameIndex = EVENT_LOG_FRAME_SIZE;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: EventLog_overflow
+ * [Description]	:
+ * 		Timer2 overflow call-back, extends the clock & logs it's wraps.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void EventLog_overflow(void);
+
+/*
+ * [Function Name]	: EventLog_frame
+ * [Description]	:
+ * 		Function that builds the frame of the next record to be sent.
+ * [Args]	:
+ * [In] id			: Indicates event identifier.
+ * [In] time		: Indicates event time.
+ * [In] payload		: Indicates event data.
+ * [Return]			: Void.
+ */
+static void EventLog_frame(uint8 id, uint16 time, uint16 payload);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: EventLog_init
+ * [Description]	:
+ * 		Function that starts timer2 as log clock & empties the ring. Timer2
+ * 		overflows wake the CPU, so it registers timer2 as a wake-up source,
+ * 		call it after USART_init & Power_init.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void EventLog_init(void)
+{
+	Timer_initConfig timerConfig = { TIMER8BIT_NORMAL, NORMAL_OC, LOGIC_HIGH };
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	CLEAR_BIT(SREG, 7);
+	g_eventLogOverflows = 0;
+	g_eventLogEpoch = 0;
+	g_eventLogHead = 0;
+	g_eventLogTail = 0;
+	g_eventLogDropped = 0;
+	g_eventLogFrameIndex = EVENT_LOG_FRAME_SIZE;
+	Timer2_init(&timerConfig);
+	Timer2_setCallBack(EventLog_overflow);
+	Timer2_start(EVENT_LOG_PRESCALER, 0, 0);
+	Power_registerWakeup(POWER_WAKEUP_TIMER2);
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: EventLog_write
+ * [Description]	:
+ * 		Function that adds an event to the ring, it's sent before the next
+ * 		application byte.
+ * [Args]	:
+ * [In] id			: Indicates event identifier.
+ * [In] payload		: Indicates event data.
+ * [Return]			: Void.
+ */
+void EventLog_write(uint8 id, uint16 payload)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	CLEAR_BIT(SREG, 7);
+	EVENT_LOG_FROM_ISR(id, payload);
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: EventLog_overflow
+ * [Description]	:
+ * 		Timer2 overflow call-back, extends the clock & logs it's wraps.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void EventLog_overflow(void)
+{
+	g_eventLogOverflows++;
+	if (g_eventLogOverflows == 0)
+	{
+		g_eventLogEpoch++;
+		EVENT_LOG_FROM_ISR(EVENT_LOG_EPOCH, g_eventLogEpoch);
+	}
+}
+
+/*
+ * [Function Name]	: EventLog_frame
+ * [Description]	:
+ * 		Function that builds the frame of the next record to be sent.
+ * [Args]	:
+ * [In] id			: Indicates event identifier.
+ * [In] time		: Indicates event time.
+ * [In] payload		: Indicates event data.
+ * [Return]			: Void.
+ */
+static void EventLog_frame(uint8 id, uint16 time, uint16 payload)
+{
+	g_eventLogFrame[0] = EVENT_LOG_SYNC;
+	g_eventLogFrame[1] = id;
+	g_eventLogFrame[2] = (uint8) time;
+	g_eventLogFrame[3] = (uint8) (time >> 8);
+	g_eventLogFrame[4] = (uint8) payload;
+	g_eventLogFrame[5] = (uint8) (payload >> 8);
+	g_eventLogFrame[6] = (uint8) (g_eventLogFrame[1] + g_eventLogFrame[2]
+			+ g_eventLogFrame[3] + g_eventLogFrame[4] + g_eventLogFrame[5]);
+	g_eventLogFrameIndex = 0;
+}
+
+/*
+ * [Function Name]	: EventLog_drain
+ * [Description]	:
+ * 		Function that sends the next byte of the log, the rest of the frame
+ * 		being sent then the frames of the waiting records. Called by
+ * 		USART_sendByte with USART data register empty & global interrupt
+ * 		disabled, the application byte is sent once it returns FALSE.
+ * [Args]		: Void.
+ * [Return]		: TRUE if a log byte was sent, FALSE if the log is empty.
+ */
+uint8 EventLog_drain(void)
+{
+	uint8 tail = g_eventLogTail;
+	uint16 time;
+	if (g_eventLogFrameIndex == EVENT_LOG_FRAME_SIZE)
+	{
+		if (tail != g_eventLogHead)
+		{
+			EventLog_frame(g_eventLogRing[tail].id, g_eventLogRing[tail].time,
+					g_eventLogRing[tail].payload);
+			g_eventLogTail = (tail + 1) & (EVENT_LOG_RING_SIZE - 1);
+		}
+		else if (g_eventLogDropped != 0)
+		{
+			EVENT_LOG_READ_CLOCK(time);
+			EventLog_frame(EVENT_LOG_DROPPED, time, g_eventLogDropped);
+			g_eventLogDropped = 0;
+		}
+		else
+		{
+			return FALSE;
+		}
+	}
+	UDR = g_eventLogFrame[g_eventLogFrameIndex];
+	g_eventLogFrameIndex++;
+	return TRUE;
+}
+
+#endif
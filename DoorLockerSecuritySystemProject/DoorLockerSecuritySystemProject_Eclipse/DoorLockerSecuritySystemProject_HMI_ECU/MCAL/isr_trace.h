@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Module: ISR Trace
+ * File Name: isr_trace.h
+ * Description: Header file for interrupt latency & execution time tracer.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef ISR_TRACE_H_
+#define ISR_TRACE_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+#include "timer.h"				/* For timer2 used as trace clock */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Enable ISR tracing, when disabled the trace leaves no code or RAM in the image */
+#define ISR_TRACE_ENABLE				FALSE
+
+#if (ISR_TRACE_ENABLE == TRUE)
+
+/* Latest ISR executions kept, oldest are overwritten, must be a power of 2 */
+#define ISR_TRACE_RING_SIZE				16
+
+#if ((ISR_TRACE_RING_SIZE & (ISR_TRACE_RING_SIZE - 1)) != 0)
+
+#error "ISR_TRACE_RING_SIZE must be a power of 2"
+
+#endif
+
+#if (TIMER2_ENABLE == FALSE)
+
+#error "ISR trace counts time with timer2, set TIMER2_ENABLE in timer.h"
+
+#endif
+
+/*
+ * Trace clock, timer2 free-running from IsrTrace_init, counts up to
+ * ISR_TRACE_CLOCK_TOP then wraps to zero. Timer1 runs at F_CPU/256 for the
+ * door timing & is stopped between operations, so it can't be the clock.
+ * At 8 MHz F_CPU/8 gives 1 us ticks & durations up to 255 us, a longer ISR
+ * reads modulo 256 us, use a larger pre-scaler to trace it.
+ */
+#define ISR_TRACE_PRESCALER				TIMER2_PRESCALER_8
+#define ISR_TRACE_CLOCK					TCNT2
+#define ISR_TRACE_CLOCK_TOP				0xFF
+
+#endif
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Enumerate Name]	: ISR_TRACE_VECTOR
+ * [Description]	:
+ * 		An enumerate that defines traced interrupt vectors.
+ */
+typedef enum
+{
+	ISR_TRACE_TIMER1_COMPA,
+	ISR_TRACE_TIMER1_COMPB,
+	ISR_TRACE_TIMER1_CAPT,
+	ISR_TRACE_USART_RXC,
+	ISR_TRACE_ADC,
+	ISR_TRACE_VECTORS_NUM
+} ISR_TRACE_VECTOR;
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: IsrTrace_RecordType
+ * [Description]	:
+ * 		A structure in which it's instance holds one ISR execution, times
+ * 		are in trace clock ticks.
+ */
+typedef struct
+{
+	ISR_TRACE_VECTOR vector;
+	uint16 entry; /* Clock at ISR entry */
+	uint16 latency; /* From the event that raised the interrupt to entry */
+	uint16 duration; /* From entry to exit */
+} IsrTrace_RecordType;
+
+/*
+ * [Structure Name]	: IsrTrace_StatisticsType
+ * [Description]	:
+ * 		A structure in which it's instance holds minimum, mean & maximum
+ * 		latency & duration of an interrupt vector in trace clock ticks.
+ */
+typedef struct
+{
+	uint16 count;
+	uint16 latencyMin;
+	uint16 latencyMean;
+	uint16 latencyMax;
+	uint16 durationMin;
+	uint16 durationMean;
+	uint16 durationMax;
+} IsrTrace_StatisticsType;
+
+/*******************************************************************************
+ *                                Macros                                       *
+ *******************************************************************************/
+/*
+ * ISR_TRACE_ENTRY is the first statement of a traced ISR & ISR_TRACE_EXIT is
+ * put before every return. ISR_TRACE_ENTRY_EVENT takes the timer register
+ * holding the time of the event that raised the interrupt, on this ECU it
+ * is a timer1 compare value in timer1 ticks, not in trace clock ticks, so
+ * it's ignored & every vector has no latency, only duration.
+ */
+#if (ISR_TRACE_ENABLE == TRUE)
+
+#define ISR_TRACE_ENTRY_EVENT(eventTime)									\
+	uint16 isrTraceEntry = ISR_TRACE_CLOCK;									\
+	uint16 isrTraceEvent = isrTraceEntry
+
+#define ISR_TRACE_ENTRY()		ISR_TRACE_ENTRY_EVENT(0)
+
+#define ISR_TRACE_EXIT(vector)												\
+	IsrTrace_record((vector), isrTraceEvent, isrTraceEntry, ISR_TRACE_CLOCK)
+
+#else
+
+#define ISR_TRACE_ENTRY_EVENT(eventTime)
+#define ISR_TRACE_ENTRY()
+#define ISR_TRACE_EXIT(vector)
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+#if (ISR_TRACE_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: IsrTrace_init
+ * [Description]	:
+ * 		Function that starts timer2 as free-running trace clock without
+ * 		interrupt & clears statistics & ring.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void IsrTrace_init(void);
+
+/*
+ * [Function Name]	: IsrTrace_record
+ * [Description]	:
+ * 		Function that adds an ISR execution to the vector statistics & to
+ * 		the ring, called by ISR_TRACE_EXIT with global interrupt disabled.
+ * [Args]	:
+ * [In] vector		: Indicates traced vector.
+ * [In] eventTime	: Indicates clock when the interrupt was raised.
+ * [In] entryTime	: Indicates clock at ISR entry.
+ * [In] exitTime	: Indicates clock at ISR exit.
+ * [Return]			: Void.
+ */
+void IsrTrace_record(ISR_TRACE_VECTOR vector, uint16 eventTime,
+		uint16 entryTime, uint16 exitTime);
+
+/*
+ * [Function Name]	: IsrTrace_getStatistics
+ * [Description]	:
+ * 		Function that gets latency & duration statistics of a vector.
+ * [Args]	:
+ * [In] vector				: Indicates traced vector.
+ * [Out] statistics_Ptr		: Pointer to statistics to be filled.
+ * [Return]					: Void.
+ */
+void IsrTrace_getStatistics(ISR_TRACE_VECTOR vector,
+		IsrTrace_StatisticsType *statistics_Ptr);
+
+/*
+ * [Function Name]	: IsrTrace_getRecord
+ * [Description]	:
+ * 		Function that gets an ISR execution from the ring, oldest first.
+ * [Args]	:
+ * [In] index			: Indicates record index, (0) is the oldest.
+ * [Out] record_Ptr		: Pointer to record to be filled.
+ * [Return]				: TRUE if the record exists, FALSE otherwise.
+ */
+uint8 IsrTrace_getRecord(uint8 index, IsrTrace_RecordType *record_Ptr);
+
+/*
+ * [Function Name]	: IsrTrace_reset
+ * [Description]	:
+ * 		Function that clears statistics & ring.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void IsrTrace_reset(void);
+
+/*
+ * [Function Name]	: IsrTrace_dump
+ * [Description]	:
+ * 		Function that writes statistics of every traced vector then the ring
+ * 		as text lines, e.g. through USART_sendByte with the ECU wired to a
+ * 		PC, the other ECU would take them as commands. Interrupts stay
+ * 		enabled while sending, so the ring may move on during the dump.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [Return]				: Void.
+ */
+void IsrTrace_dump(void (*Ptr2SendByte)(const uint8 data));
+
+#endif
+
+#endif /* ISR_TRACE_H_ */
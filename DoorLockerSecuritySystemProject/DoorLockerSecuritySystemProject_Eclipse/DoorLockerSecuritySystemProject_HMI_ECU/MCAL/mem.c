@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Module: Memory
+ * File Name: mem.c
+ * Description: Source file for SRAM usage & stack high-water mark monitor.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "mem.h"						/* For memory prototypes & definitions */
+#include <avr/io.h>						/* For stack pointer & SRAM limits */
+
+/*******************************************************************************
+ *                            Memory Useful Notes                              *
+ *******************************************************************************/
+/*
+ * 		RAMSTART                _end                     SP          RAMEND
+ * 		| .data & .bss (static) | free, painted at boot -> | <- stack |
+ *
+ * 		No heap is used, so every byte between _end & the stack belongs to
+ * 		the stack. The deepest stack is where the paint is first found
+ * 		overwritten scanning up from _end.
+ */
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* First byte after static variables, set by the linker */
+extern uint8 _end;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Mem_stackLowest
+ * [Description]	:
+ * 		Function that finds the lowest byte the stack ever reached.
+ * [Args]		: Void.
+ * [Return]		: Address of the lowest painted byte overwritten, top of
+ * 				  SRAM if the painted area is out of SRAM.
+ */
+static uint8* Mem_stackLowest(void);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Mem_init
+ * [Description]	:
+ * 		Function that paints SRAM from the end of static variables up to the
+ * 		stack pointer, call it first in main before enabling interrupts.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Mem_init(void)
+{
+	uint8 *byte_Ptr = &_end;
+	/* Bytes below the stack pointer are free, the current frame is above it */
+	while ((byte_Ptr < (uint8*) SP) && (byte_Ptr <= (uint8*) RAMEND))
+	{
+		*byte_Ptr = MEM_STACK_PAINT;
+		byte_Ptr++;
+	}
+}
+
+/*
+ * [Function Name]	: Mem_stackLowest
+ * [Description]	:
+ * 		Function that finds the lowest byte the stack ever reached.
+ * [Args]		: Void.
+ * [Return]		: Address of the lowest painted byte overwritten, top of
+ * 				  SRAM if the painted area is out of SRAM.
+ */
+static uint8* Mem_stackLowest(void)
+{
+	uint8 *byte_Ptr = &_end;
+	if (byte_Ptr > (uint8*) RAMEND)
+	{
+		return ((uint8*) RAMEND) + 1;
+	}
+	while ((byte_Ptr <= (uint8*) RAMEND) && (*byte_Ptr == MEM_STACK_PAINT))
+	{
+		byte_Ptr++;
+	}
+	return byte_Ptr;
+}
+
+/*
+ * [Function Name]	: Mem_stackHighWater
+ * [Description]	:
+ * 		Function that gets the deepest stack since Mem_init, ISR frames
+ * 		included.
+ * [Args]		: Void.
+ * [Return]		: Stack high-water mark in bytes.
+ */
+uint16 Mem_stackHighWater(void)
+{
+	return (uint16) ((((uint8*) RAMEND) + 1) - Mem_stackLowest());
+}
+
+/*
+ * [Function Name]	: Mem_getUsage
+ * [Description]	:
+ * 		Function that gets static, stack & never used SRAM sizes.
+ * [Args]	:
+ * [Out] usage_Ptr		: Pointer to usage to be filled.
+ * [Return]				: Void.
+ */
+void Mem_getUsage(Mem_UsageType *usage_Ptr)
+{
+	uint8 *lowest_Ptr = Mem_stackLowest();
+	if (&_end > (uint8*) RAMEND)
+	{
+		/* Static variables out of SRAM, e.g. on the host simulation */
+		(*usage_Ptr).staticBytes = 0;
+		(*usage_Ptr).unusedBytes = 0;
+	}
+	else
+	{
+		(*usage_Ptr).staticBytes = (uint16) (&_end - (uint8*) RAMSTART);
+		(*usage_Ptr).unusedBytes = (uint16) (lowest_Ptr - &_end);
+	}
+	(*usage_Ptr).stackMaxBytes = (uint16) ((((uint8*) RAMEND) + 1) - lowest_Ptr);
+}
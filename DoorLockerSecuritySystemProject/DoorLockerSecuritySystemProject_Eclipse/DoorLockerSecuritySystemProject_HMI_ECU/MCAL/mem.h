@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Module: Memory
+ * File Name: mem.h
+ * Description: Header file for SRAM usage & stack high-water mark monitor.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef MEM_H_
+#define MEM_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/*
+ * Value painted over free SRAM at boot, a stack byte holding the same value
+ * is taken as never used, so the high-water mark may be a few bytes short.
+ */
+#define MEM_STACK_PAINT					0xC5
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Mem_UsageType
+ * [Description]	:
+ * 		A structure in which it's instance holds how SRAM is split in bytes,
+ * 		static variables, the deepest stack since boot & the bytes between
+ * 		them never touched.
+ */
+typedef struct
+{
+	uint16 staticBytes; /* .data & .bss */
+	uint16 stackMaxBytes; /* Stack high-water mark */
+	uint16 unusedBytes; /* Never used by the stack, free for buffers */
+} Mem_UsageType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Mem_init
+ * [Description]	:
+ * 		Function that paints SRAM from the end of static variables up to the
+ * 		stack pointer, call it first in main before enabling interrupts.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Mem_init(void);
+
+/*
+ * [Function Name]	: Mem_stackHighWater
+ * [Description]	:
+ * 		Function that gets the deepest stack since Mem_init, ISR frames
+ * 		included.
+ * [Args]		: Void.
+ * [Return]		: Stack high-water mark in bytes.
+ */
+uint16 Mem_stackHighWater(void);
+
+/*
+ * [Function Name]	: Mem_getUsage
+ * [Description]	:
+ * 		Function that gets static, stack & never used SRAM sizes.
+ * [Args]	:
+ * [Out] usage_Ptr		: Pointer to usage to be filled.
+ * [Return]				: Void.
+ */
+void Mem_getUsage(Mem_UsageType *usage_Ptr);
+
+#endif /* MEM_H_ */
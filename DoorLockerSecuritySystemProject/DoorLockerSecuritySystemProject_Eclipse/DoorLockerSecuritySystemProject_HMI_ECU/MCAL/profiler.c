@@ -0,0 +1,421 @@
+/******************************************************************************
+ * Module: Profiler
+ * File Name: profiler.c
+ * Description: Source file for CPU load meter & tasks profiler.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "profiler.h"					/* For profiler prototypes & definitions */
+
+#if (PROFILER_ENABLE == TRUE)
+
+#include <avr/io.h>						/* For timer2 registers */
+#include "../common_macros.h"			/* For common macros usage */
+#include "power.h"						/* For timer2 wake-up source */
+
+#if (PROFILER_WINDOW_OVERFLOWS > 255)
+
+#error "PROFILER_WINDOW_OVERFLOWS must fit the 16-bit profiler clock"
+
+#endif
+
+/*******************************************************************************
+ *                          Profiler Useful Notes                              *
+ *******************************************************************************/
+/*
+ * 		Time = (Overflows * 256) + TCNT2 ticks, Cycles = Ticks * Pre-scaler
+ *
+ * 		Time is charged to one account at a time: a task, idle or the rest of
+ * 		the application. Starting a task charges the time since the last
+ * 		event to the running account then switches to the task, stopping it
+ * 		switches back. Idle is the time spent in Power_sleep, the ISRs that
+ * 		wake the CPU included unless their call-backs are profiled tasks.
+ *
+ * 		CPU load = 100 - ((Idle ticks * 100) / Window ticks)
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Accounts after the application tasks */
+#define PROFILER_IDLE					PROFILER_TASKS_NUM
+#define PROFILER_OTHER					(PROFILER_TASKS_NUM + 1)
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Timer2 overflows, high byte of the profiler clock */
+static volatile uint8 g_profilerOverflows = 0;
+/* Clock when time was last charged & when the load window started */
+static volatile uint16 g_profilerLastTime = 0;
+static volatile uint16 g_profilerWindowStart = 0;
+/* Overflows & idle ticks counted in the current window */
+static volatile uint8 g_profilerWindowOverflows = 0;
+static volatile uint16 g_profilerIdleTicks = 0;
+/* CPU load percentage of the last window */
+static volatile uint8 g_profilerLoad = 0;
+/* Account time is charged to & accounts of the tasks it interrupted */
+static volatile uint8 g_profilerCurrent = PROFILER_OTHER;
+static volatile uint8 g_profilerStack[PROFILER_NESTING_MAX];
+static volatile uint8 g_profilerDepth = 0;
+/* Counters of each task */
+static volatile uint16 g_profilerCalls[PROFILER_TASKS_NUM];
+static volatile uint32 g_profilerTicks[PROFILER_TASKS_NUM];
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Profiler_now
+ * [Description]	:
+ * 		Function that reads the profiler clock, called with global interrupt
+ * 		disabled.
+ * [Args]		: Void.
+ * [Return]		: Clock in timer2 ticks.
+ */
+static uint16 Profiler_now(void);
+
+/*
+ * [Function Name]	: Profiler_charge
+ * [Description]	:
+ * 		Function that charges the time since the last call to the running
+ * 		account, called with global interrupt disabled.
+ * [Args]		: Void.
+ * [Return]		: Current clock.
+ */
+static uint16 Profiler_charge(void);
+
+/*
+ * [Function Name]	: Profiler_overflow
+ * [Description]	:
+ * 		Timer2 overflow call-back, extends the clock & closes load windows.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void Profiler_overflow(void);
+
+/*
+ * [Function Name]	: Profiler_sendString
+ * [Description]	:
+ * 		Function that sends a string through the write function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] string			: Indicates null terminated string.
+ * [Return]				: Void.
+ */
+static void Profiler_sendString(void (*Ptr2SendByte)(const uint8 data),
+		const char *string);
+
+/*
+ * [Function Name]	: Profiler_sendDecimal
+ * [Description]	:
+ * 		Function that sends a number in decimal through the write function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] value			: Indicates number.
+ * [Return]				: Void.
+ */
+static void Profiler_sendDecimal(void (*Ptr2SendByte)(const uint8 data),
+		uint32 value);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Profiler_init
+ * [Description]	:
+ * 		Function that starts timer2 as profiler clock & clears the counters.
+ * 		Timer2 overflows wake the CPU, so it registers timer2 as a wake-up
+ * 		source, call it after Power_init.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Profiler_init(void)
+{
+	Timer_initConfig timerConfig = { TIMER8BIT_NORMAL, NORMAL_OC, LOGIC_HIGH };
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	CLEAR_BIT(SREG, 7);
+	g_profilerOverflows = 0;
+	g_profilerLastTime = 0;
+	g_profilerWindowStart = 0;
+	g_profilerWindowOverflows = 0;
+	g_profilerIdleTicks = 0;
+	g_profilerLoad = 0;
+	g_profilerCurrent = PROFILER_OTHER;
+	g_profilerDepth = 0;
+	Profiler_reset();
+	Timer2_init(&timerConfig);
+	Timer2_setCallBack(Profiler_overflow);
+	Timer2_start(PROFILER_PRESCALER, 0, 0);
+	Power_registerWakeup(POWER_WAKEUP_TIMER2);
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: Profiler_taskStart
+ * [Description]	:
+ * 		Function that charges time from now on to a task until it stops.
+ * [Args]	:
+ * [In] task	: Indicates task identifier, (PROFILER_TASKS_NUM) is idle time.
+ * [Return]		: Void.
+ */
+void Profiler_taskStart(uint8 task)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	CLEAR_BIT(SREG, 7);
+	Profiler_charge();
+	/* Tasks nested deeper than the stack are charged to their parent */
+	if (g_profilerDepth < PROFILER_NESTING_MAX)
+	{
+		g_profilerStack[g_profilerDepth] = g_profilerCurrent;
+		g_profilerCurrent = task;
+	}
+	g_profilerDepth++;
+	if (task < PROFILER_TASKS_NUM)
+	{
+		g_profilerCalls[task]++;
+	}
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: Profiler_taskStop
+ * [Description]	:
+ * 		Function that charges time from now on to the task that was running
+ * 		when the current one started.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Profiler_taskStop(void)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	CLEAR_BIT(SREG, 7);
+	Profiler_charge();
+	if (g_profilerDepth > 0)
+	{
+		g_profilerDepth--;
+		if (g_profilerDepth < PROFILER_NESTING_MAX)
+		{
+			g_profilerCurrent = g_profilerStack[g_profilerDepth];
+		}
+	}
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: Profiler_getLoad
+ * [Description]	:
+ * 		Function that gets CPU load of the last window, the time not spent
+ * 		sleeping in Power_sleep.
+ * [Args]		: Void.
+ * [Return]		: CPU load percentage.
+ */
+uint8 Profiler_getLoad(void)
+{
+	return g_profilerLoad;
+}
+
+/*
+ * [Function Name]	: Profiler_getTask
+ * [Description]	:
+ * 		Function that gets executions & CPU cycles of a task.
+ * [Args]	:
+ * [In] task			: Indicates task identifier.
+ * [Out] task_Ptr		: Pointer to task counters to be filled.
+ * [Return]				: Void.
+ */
+void Profiler_getTask(uint8 task, Profiler_TaskType *task_Ptr)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	CLEAR_BIT(SREG, 7);
+	Profiler_charge(); /* Include the running task up to now */
+	(*task_Ptr).calls = g_profilerCalls[task];
+	(*task_Ptr).cycles = g_profilerTicks[task] * PROFILER_CYCLES_PER_TICK;
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: Profiler_reset
+ * [Description]	:
+ * 		Function that clears tasks counters.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Profiler_reset(void)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	uint8 task = 0;
+	CLEAR_BIT(SREG, 7);
+	for (task = 0; task < PROFILER_TASKS_NUM; task++)
+	{
+		g_profilerCalls[task] = 0;
+		g_profilerTicks[task] = 0;
+	}
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: Profiler_writeLoad
+ * [Description]	:
+ * 		Function that writes CPU load as "CPU 12%", short enough for an LCD
+ * 		row, e.g. through LCD_displayCharacter.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [Return]				: Void.
+ */
+void Profiler_writeLoad(void (*Ptr2SendByte)(const uint8 data))
+{
+	Profiler_sendString(Ptr2SendByte, "CPU ");
+	Profiler_sendDecimal(Ptr2SendByte, Profiler_getLoad());
+	(*Ptr2SendByte)('%');
+}
+
+/*
+ * [Function Name]	: Profiler_dump
+ * [Description]	:
+ * 		Function that writes a status page, CPU load then a line for each
+ * 		task, e.g. through USART_sendByte.
+ *
+ * 			CPU 12%
+ * 			T0 n=CALLS c=CYCLES
+ *
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [Return]				: Void.
+ */
+void Profiler_dump(void (*Ptr2SendByte)(const uint8 data))
+{
+	Profiler_TaskType task;
+	uint8 taskId = 0;
+	Profiler_writeLoad(Ptr2SendByte);
+	Profiler_sendString(Ptr2SendByte, "\r\n");
+	for (taskId = 0; taskId < PROFILER_TASKS_NUM; taskId++)
+	{
+		Profiler_getTask(taskId, &task);
+		(*Ptr2SendByte)('T');
+		Profiler_sendDecimal(Ptr2SendByte, taskId);
+		Profiler_sendString(Ptr2SendByte, " n=");
+		Profiler_sendDecimal(Ptr2SendByte, task.calls);
+		Profiler_sendString(Ptr2SendByte, " c=");
+		Profiler_sendDecimal(Ptr2SendByte, task.cycles);
+		Profiler_sendString(Ptr2SendByte, "\r\n");
+	}
+}
+
+/*
+ * [Function Name]	: Profiler_now
+ * [Description]	:
+ * 		Function that reads the profiler clock, called with global interrupt
+ * 		disabled.
+ * [Args]		: Void.
+ * [Return]		: Clock in timer2 ticks.
+ */
+static uint16 Profiler_now(void)
+{
+	uint8 count = TCNT2;
+	uint8 overflows = g_profilerOverflows;
+	/* Timer2 overflowed but it's interrupt is still pending, a small count
+	 * was read after that overflow */
+	if (BIT_IS_SET(TIFR, TOV2) && (count < 0x80))
+	{
+		overflows++;
+	}
+	return ((uint16) overflows << 8) | count;
+}
+
+/*
+ * [Function Name]	: Profiler_charge
+ * [Description]	:
+ * 		Function that charges the time since the last call to the running
+ * 		account, called with global interrupt disabled.
+ * [Args]		: Void.
+ * [Return]		: Current clock.
+ */
+static uint16 Profiler_charge(void)
+{
+	uint16 now = Profiler_now();
+	uint16 elapsed = now - g_profilerLastTime;
+	g_profilerLastTime = now;
+	if (g_profilerCurrent < PROFILER_TASKS_NUM)
+	{
+		g_profilerTicks[g_profilerCurrent] += elapsed;
+	}
+	else if (g_profilerCurrent == PROFILER_IDLE)
+	{
+		g_profilerIdleTicks += elapsed;
+	}
+	return now;
+}
+
+/*
+ * [Function Name]	: Profiler_overflow
+ * [Description]	:
+ * 		Timer2 overflow call-back, extends the clock & closes load windows.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void Profiler_overflow(void)
+{
+	uint16 now = 0;
+	uint16 windowTicks = 0;
+	g_profilerOverflows++;
+	now = Profiler_charge();
+	g_profilerWindowOverflows++;
+	if (g_profilerWindowOverflows == PROFILER_WINDOW_OVERFLOWS)
+	{
+		windowTicks = now - g_profilerWindowStart;
+		g_profilerLoad = (uint8) (100
+				- (((uint32) g_profilerIdleTicks * 100) / windowTicks));
+		g_profilerWindowStart = now;
+		g_profilerWindowOverflows = 0;
+		g_profilerIdleTicks = 0;
+	}
+}
+
+/*
+ * [Function Name]	: Profiler_sendString
+ * [Description]	:
+ * 		Function that sends a string through the write function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] string			: Indicates null terminated string.
+ * [Return]				: Void.
+ */
+static void Profiler_sendString(void (*Ptr2SendByte)(const uint8 data),
+		const char *string)
+{
+	while (*string != '\0')
+	{
+		(*Ptr2SendByte)((uint8) *string);
+		string++;
+	}
+}
+
+/*
+ * [Function Name]	: Profiler_sendDecimal
+ * [Description]	:
+ * 		Function that sends a number in decimal through the write function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] value			: Indicates number.
+ * [Return]				: Void.
+ */
+static void Profiler_sendDecimal(void (*Ptr2SendByte)(const uint8 data),
+		uint32 value)
+{
+	char digits[10]; /* Largest 32-bit number has 10 digits */
+	uint8 digitsNum = 0;
+	do
+	{
+		digits[digitsNum] = (char) ('0' + (value % 10));
+		digitsNum++;
+		value /= 10;
+	} while (value != 0);
+	while (digitsNum > 0)
+	{
+		digitsNum--;
+		(*Ptr2SendByte)((uint8) digits[digitsNum]);
+	}
+}
+
+#endif
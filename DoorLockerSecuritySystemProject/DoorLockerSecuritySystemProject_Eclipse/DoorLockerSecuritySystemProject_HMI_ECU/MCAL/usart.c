@@ -8,10 +8,18 @@
 #include "../MCAL/usart.h"					/* For USART prototypes & definitions */
 #include <avr/io.h>							/* For USART registers usage */
 #include "../common_macros.h"				/* For common macros usage */
+#include "../MCAL/event_log.h"				/* For event log sharing UDR */
 
-#if (USART_INTERRUPT_ENABLE == TRUE)
+#if (USART_INTERRUPT_ENABLE == TRUE) || (USART_RECEIVE_SLEEP_ENABLE == TRUE)
 
 #include <avr/interrupt.h>					/* For ISR of USART */
+#include "../MCAL/isr_trace.h"				/* For receive ISR tracing */
+
+#endif
+
+#if (USART_RECEIVE_SLEEP_ENABLE == TRUE)
+
+#include "../MCAL/power.h"					/* For sleeping while receiving */
 
 #endif
 
@@ -156,10 +164,12 @@ static volatile void (*g_USART_UDRECCallBack_Ptr)(void) = NULL_PTR;
  */
 ISR(USART_RXC_vect)
 {
+	ISR_TRACE_ENTRY();
 	if (g_USART_RXCCallBack_Ptr != NULL_PTR) /* If callback function pointer is not void */
 	{
 		(*g_USART_RXCCallBack_Ptr)(); /* Execute callback function */
 	}
+	ISR_TRACE_EXIT(ISR_TRACE_USART_RXC);
 }
 
 /*
@@ -190,9 +200,59 @@ ISR(USART_UDRE_vect)
 
 #endif
 
+#if (USART_RECEIVE_SLEEP_ENABLE == TRUE)
+
+/*
+ * [Interrupt Vector]	: USART_RXC_vect
+ * [Description]		:
+ * 		An interrupt that wakes the CPU up upon USART receive complete, it
+ * 		disables itself & leaves the byte in UDR to be read by USART_recieveByte.
+ */
+ISR(USART_RXC_vect)
+{
+	ISR_TRACE_ENTRY();
+	CLEAR_BIT(UCSRB, RXCIE);
+	ISR_TRACE_EXIT(ISR_TRACE_USART_RXC);
+}
+
+#endif
+
 /*******************************************************************************
  *                          Functions Definitions                              *
  *******************************************************************************/
+
+#if (USART_RECEIVE_SLEEP_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: USART_sleepUntilReceive
+ * [Description]	:
+ * 		Function that sleeps until a byte is received, other interrupts wake the
+ * 		CPU too so the flag is checked again after every wake-up. It waits
+ * 		without sleeping if global interrupt is disabled.
+ * [Args] 		: Void.
+ * [Return]		: Void.
+ */
+static void USART_sleepUntilReceive(void)
+{
+	if (BIT_IS_CLEAR(SREG, 7))
+	{
+		return; /* Nothing could wake the CPU up */
+	}
+	/* Flag is checked with global interrupt disabled, a byte received after
+	 * the check wakes the CPU instead of being slept through */
+	CLEAR_BIT(SREG, 7);
+	while (BIT_IS_CLEAR(UCSRA, RXC))
+	{
+		SET_BIT(UCSRB, RXCIE);
+		Power_sleep();
+		CLEAR_BIT(SREG, 7);
+	}
+	CLEAR_BIT(UCSRB, RXCIE);
+	SET_BIT(SREG, 7);
+}
+
+#endif
+
 /*
  * [Function Name]	: USART_init
  * [Description]	:
@@ -337,7 +397,8 @@ void USART_UDREsetCallBack(void (*Ptr2Function)(void))
 /*
  * [Function Name]	: USART_sendByte
  * [Description]	:
- * 		Function that sends data through USART.
+ * 		Function that sends data through USART, after the waiting event log
+ * 		frames when the log is enabled.
  * [Args] data	: Indicates data to be sent.
  * [Return]		: Void.
  */
@@ -363,6 +424,24 @@ void USART_sendByte(const uint8 data)
 	/* Put the data in the UDR, flag is automatically cleared */
 	UDR = (data & 0xFF);
 
+#elif (EVENT_LOG_ENABLE == TRUE)
+
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	uint8 sent = FALSE;
+	/* The waiting event log frames are sent first, one byte per try with
+	 * global interrupt disabled, other ISRs may run between tries */
+	while (sent == FALSE)
+	{
+		CLEAR_BIT(SREG, 7);
+		if (BIT_IS_SET(UCSRA, UDRE) && (EventLog_drain() == FALSE))
+		{
+			/* Put the data in the UDR, flag is automatically cleared */
+			UDR = data;
+			sent = TRUE;
+		}
+		SREG = interruptState;
+	}
+
 #else
 
 	/* Wait for data register empty flag to be raised indicating UDR is ready */
@@ -382,7 +461,8 @@ void USART_sendByte(const uint8 data)
 /*
  * [Function Name]	: USART_recieveByte
  * [Description]	:
- * 		Function that receives data through USART.
+ * 		Function that receives data through USART, event log frames of the
+ * 		other ECU are dropped when the log is enabled.
  * [Args] 		: Void.
  * [Return]		: Data existing in UDR.
  */
@@ -403,6 +483,13 @@ uint8 USART_recieveByte(void)
 
 	/* Define a variable to be returned */
 	uint16 UDRValue = 0;
+
+#if (USART_RECEIVE_SLEEP_ENABLE == TRUE)
+
+	USART_sleepUntilReceive();
+
+#endif
+
 	/* Wait for receive complete flag to be raised indicating UDR is ready */
 	while (BIT_IS_CLEAR(UCSRA, RXC));
 	/* Get ninth bit */
@@ -412,8 +499,49 @@ uint8 USART_recieveByte(void)
 	/* Return the variable */
 	return UDRValue;
 
+#elif (EVENT_LOG_ENABLE == TRUE)
+
+	/* Define a variable to be returned */
+	uint8 UDRValue = 0;
+	/* Bytes left of an event log frame sent by the other ECU */
+	uint8 frameBytes = 0;
+	while (TRUE)
+	{
+
+#if (USART_RECEIVE_SLEEP_ENABLE == TRUE)
+
+		USART_sleepUntilReceive();
+
+#endif
+
+		/* Wait for receive complete flag to be raised indicating UDR is ready */
+		while (BIT_IS_CLEAR(UCSRA, RXC));
+		/* Read received data from UDR, flag is automatically cleared */
+		UDRValue = UDR;
+		if (frameBytes != 0)
+		{
+			frameBytes--;
+		}
+		else if (UDRValue == EVENT_LOG_SYNC)
+		{
+			/* Drop the frame, the applications never send the sync byte */
+			frameBytes = EVENT_LOG_FRAME_SIZE - 1;
+		}
+		else
+		{
+			/* Return the variable */
+			return UDRValue;
+		}
+	}
+
 #else
 
+#if (USART_RECEIVE_SLEEP_ENABLE == TRUE)
+
+	USART_sleepUntilReceive();
+
+#endif
+
 	/* Wait for receive complete flag to be raised indicating UDR is ready */
 	while (BIT_IS_CLEAR(UCSRA, RXC));
 	/* Read received data from UDR, flag is automatically cleared */
@@ -4,16 +4,56 @@
  * Author: Mohamed Badr
  *******************************************************************************/
 
+#include <avr/io.h>									/* Enable global interrupt */
+#include "fan_controller_project.h"					/* Fan controller tuning */
+#include "../common_macros.h"						/* For common macros usage */
 #include "../MCAL/adc.h"							/* Initialize ADC */
 #include "../HAL/dc_motor.h"						/* Use DC motor*/
 #include "../HAL/lcd.h"								/* Use LCD */
 #include "../HAL/lm35_three_terminal_sensor.h"		/* Use sensor */
+#include "../LIB/filter.h"							/* Filter sensor readings */
+#include "../LIB/pid.h"								/* Control fan speed */
+#include "../MCAL/power.h"							/* Sleep while waiting */
+#include "../MCAL/profiler.h"						/* Measure CPU load */
 #include "../MCAL/timer.h"							/* Initialize timers */
 
 /*******************************************************************************
  *                                Definitions                                  *
  *******************************************************************************/
 #define LCD_COMMON_COLUMN_INDEX		10
+/* Sensor sampling period in timer1 ticks, (1) milli-second at (1) MHz with pre-scaler (8) */
+#define SENSOR_SAMPLING_TICKS		124
+/* Profiled tasks */
+#define FAN_TASK_CONTROL			0
+#define FAN_TASK_TICK				1
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Filters state of temperature sensor readings */
+static Filter_MedianType g_tempMedian;
+static Filter_EMAType g_tempEMA;
+/* Fan speed controller */
+static const Pid_ConfigType g_fanPidConfig = { FAN_PID_KP, FAN_PID_KI, 0,
+FAN_MIN_SPEED, FAN_MAX_SPEED, PID_REVERSE_ACTION };
+static Pid_ControllerType g_fanPid;
+/* Milli-seconds counted since last control sample */
+static volatile uint8 g_controlTicks = 0;
+/* Flag raised every control sample period */
+static volatile uint8 g_controlDue = FALSE;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Fan_controlTick
+ * [Description]	:
+ * 		Timer1 compare unit A call-back executed every milli-second, raises
+ * 		control flag every (CONTROL_PERIOD_MS).
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void Fan_controlTick(void);
 
 /*******************************************************************************
  *                            Functions Definitions                            *
@@ -29,66 +69,137 @@ int main(void)
 {
 	/* A variable to store temperature value */
 	uint8 tempValue = 0;
+	/* A variable to store filtered temperature in tenths of degree */
+	uint16 tempTenths = 0;
+	/* Fan state with hysteresis */
+	uint8 fanOn = FALSE;
+	/* Required & last applied fan speed percentage */
+	uint8 speed = 0;
+	uint8 lastSpeed = 0;
+	/* Channels converted by the ADC */
+	const uint8 sensorChannels[] = { SENSOR_CHANNEL_ID };
+	/* Enable global interrupt */
+	SET_BIT(SREG, 7);
 	/* Create an instance of ADC configurations*/
 	ADC_ConfigType configType = { ADC_INT_REF_ENABLE, ADC_PRESCALER_8 };
 	/* Initialize ADC */
 	ADC_init(&configType);
-	/* Create an instance of timer configurations*/
-	Timer_initConfig Timer_config = { TIMER8BIT_FAST_PWM, CLEAR_OC,
-	LOGIC_LOW };
-	/* Initialize timer for PWM signal to control motor speed */
-	Timer0_init(&Timer_config);
+	/* Create an instance of timer1 configurations*/
+	Timer_initConfig samplingTimerConfig = { TIMER16BIT_CTC_OCR1A, NORMAL_OC,
+	LOGIC_HIGH };
+	/* Initialize timer1 to trigger sensor sampling with compare unit B &
+	 * to tick fan control with compare unit A interrupt */
+	Timer1_init(&samplingTimerConfig);
+	Timer1_setCallBack(Fan_controlTick);
+	/* Sample sensor channel on every compare unit B match */
+	ADC_startScan(sensorChannels, sizeof(sensorChannels),
+			ADC_TRIG_TIMER1_CTC_B);
+	Timer1_start(TIMER01_PRESCALER_8, 0, SENSOR_SAMPLING_TICKS,
+			SENSOR_SAMPLING_TICKS);
+	/* Initialize temperature filters */
+	Filter_medianInit(&g_tempMedian);
+	Filter_EMAInit(&g_tempEMA, SENSOR_EMA_SHIFT);
+	/* Initialize fan speed controller */
+	Pid_init(&g_fanPid, &g_fanPidConfig, FAN_TEMP_SETPOINT);
 	/* Initialize LCD */
 	LCD_init();
 	/* Initialize DC motor */
 	DCMotor_init();
+	/* Sleep between control samples, timer1 ticks & ADC results wake the CPU */
+	Power_init(POWER_IDLE_MODE);
+	Power_registerWakeup(POWER_WAKEUP_TIMER1);
+	Power_registerWakeup(POWER_WAKEUP_ADC);
+
+#if (PROFILER_ENABLE == TRUE)
+
+	/* Measure CPU load & tasks time */
+	Profiler_init();
+
+#endif
+
 	/* Display text in the middle of LCD screen */
 	LCD_moveCursor(0, 4); /* Move to row 0 column 4 */
-	LCD_displayString("Fan is "); /* Write the string */
+	LCD_displayString("Fan is OFF"); /* Write the string */
 	LCD_moveCursor(1, 2); /* Move to row 1 column 3 */
 	LCD_displayString("Temp =      C"); /* Write the string */
 	/* Execute program loop */
 	while (TRUE)
 	{
-		/* Get temperature reading */
-		tempValue = LM35_getTemperature();
-		/* Check if temperature is in OFF condition */
-		if (tempValue < 30)
+		/* Wait for next control sample, the flag is checked with global
+		 * interrupt disabled so the tick raising it always wakes the CPU */
+		CLEAR_BIT(SREG, 7);
+		if (g_controlDue == FALSE)
+		{
+			Power_sleep();
+			continue;
+		}
+		g_controlDue = FALSE;
+		SET_BIT(SREG, 7);
+		PROFILER_TASK_START(FAN_TASK_CONTROL);
+		/* Get temperature reading, remove spikes then smooth it */
+		tempTenths = Filter_median(&g_tempMedian, LM35_getTemperatureTenths());
+		tempTenths = Filter_EMA(&g_tempEMA, tempTenths);
+		tempValue = (uint8) (tempTenths / 10);
+		/* Turn fan ON or OFF with hysteresis around (FAN_ON_TEMP) */
+		if ((fanOn == FALSE) && (tempTenths >= FAN_ON_TEMP))
+		{
+			fanOn = TRUE;
+			Pid_reset(&g_fanPid, FAN_MIN_SPEED); /* Start from minimum speed */
+			LCD_moveCursor(0, 11); /* Move to row 0 and common column */
+			LCD_displayString("ON "); /* Write the string */
+		}
+		else if ((fanOn == TRUE)
+				&& (tempTenths < (FAN_ON_TEMP - FAN_HYSTERESIS)))
 		{
+			fanOn = FALSE;
 			LCD_moveCursor(0, 11); /* Move to row 0 and common column */
 			LCD_displayString("OFF"); /* Write the string */
-			DCMotor_Rotate(STOP, 0); /* Stop the motor */
-			LCD_moveCursor(1, LCD_COMMON_COLUMN_INDEX); /* Move to row 1 and common column */
-			LCD_intgerToString(tempValue); /* Write the value */
-			LCD_displayCharacter(' '); /* Clear numbers after displaying value */
+		}
+		/* Get continuous speed from controller while fan is ON */
+		if (fanOn == TRUE)
+		{
+			speed = (uint8) Pid_update(&g_fanPid, (sint16) tempTenths);
 		}
 		else
 		{
-			LCD_moveCursor(0, 11); /* Move to row 0 and common column */
-			LCD_displayString("ON "); /* Write the string */
-			LCD_moveCursor(1, LCD_COMMON_COLUMN_INDEX); /* Move to row 1 and common column */
-			/* If temperature is between 30C and 60C */
-			if (tempValue >= 30 && tempValue < 60)
-			{
-				DCMotor_Rotate(CLOCKWISE, 25); /* Start the motor at 25% speed */
-			}
-			/* If temperature is between 60C and 90C */
-			else if (tempValue >= 60 && tempValue < 90)
-			{
-				DCMotor_Rotate(CLOCKWISE, 50); /* Start the motor at 50% speed */
-			}
-			/* If temperature is between 90C and 120C */
-			else if (tempValue >= 90 && tempValue < 120)
+			speed = 0;
+		}
+		/* Command the motor only when speed changes */
+		if (speed != lastSpeed)
+		{
+			if (speed == 0)
 			{
-				DCMotor_Rotate(CLOCKWISE, 75); /* Start the motor at 75% speed */
+				DCMotor_Rotate(STOP, 0); /* Stop the motor */
 			}
-			/* If temperature is larger than 120C */
-			else if (tempValue >= 120)
+			else
 			{
-				DCMotor_Rotate(CLOCKWISE, 100); /* Start the motor at 100% speed */
+				DCMotor_Rotate(CLOCKWISE, speed); /* Rotate at required speed */
 			}
-			LCD_intgerToString(tempValue); /* Write the value */
-			LCD_displayCharacter(' '); /* Clear numbers after displaying value */
+			lastSpeed = speed;
 		}
+		LCD_moveCursor(1, LCD_COMMON_COLUMN_INDEX); /* Move to row 1 and common column */
+		LCD_intgerToString(tempValue); /* Write the value */
+		LCD_displayCharacter(' '); /* Clear numbers after displaying value */
+		PROFILER_TASK_STOP();
+	}
+}
+
+/*
+ * [Function Name]	: Fan_controlTick
+ * [Description]	:
+ * 		Timer1 compare unit A call-back executed every milli-second, raises
+ * 		control flag every (CONTROL_PERIOD_MS).
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void Fan_controlTick(void)
+{
+	PROFILER_TASK_START(FAN_TASK_TICK);
+	g_controlTicks++;
+	if (g_controlTicks == CONTROL_PERIOD_MS)
+	{
+		g_controlTicks = 0;
+		g_controlDue = TRUE;
 	}
+	PROFILER_TASK_STOP();
 }
@@ -0,0 +1,32 @@
+/******************************************************************************
+ * File Name: fan_controller_project.h
+ * Description: Header file for fan controller tuning, shared with the host
+ * 				plant simulation (HostSimulation/tools/fan_plant.c).
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef APP_FAN_CONTROLLER_PROJECT_H_
+#define APP_FAN_CONTROLLER_PROJECT_H_
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Temperature smoothing, alpha = 1 / (2^shift) */
+#define SENSOR_EMA_SHIFT			2
+/* Fan control sample period in milli-seconds, controller gains are per sample */
+#define CONTROL_PERIOD_MS			250
+
+/* Fan setpoints in tenths of degree, fan turns ON at or above (FAN_ON_TEMP) and
+ * turns OFF below (FAN_ON_TEMP - FAN_HYSTERESIS) */
+#define FAN_TEMP_SETPOINT			300
+#define FAN_ON_TEMP					300
+#define FAN_HYSTERESIS				20
+/* Fan speed range in percentage while ON */
+#define FAN_MIN_SPEED				25
+#define FAN_MAX_SPEED				100
+/* PI gains per sample (gain = value / 256): (0.25%) per tenth of degree error &
+ * (0.5%) per tenth of degree error every (64) samples */
+#define FAN_PID_KP					64
+#define FAN_PID_KI					2
+
+#endif /* APP_FAN_CONTROLLER_PROJECT_H_ */
@@ -6,7 +6,96 @@
  *******************************************************************************/
 
 #include "dc_motor.h"			/* For prototypes & definitions */
-#include "../MCAL/timer.h"		/* For timer usage */
+#include "../MCAL/pwm.h"		/* For PWM usage */
+
+#if (DC_MOTOR_RAMP_ENABLE == TRUE)
+
+#if (PWM_INTERRUPT_ENABLE == FALSE)
+
+#error "DC motor ramps require PWM interrupt to be enabled"
+
+#endif
+
+/*******************************************************************************
+ *                           Ramp Useful Equations                             *
+ *******************************************************************************/
+/*
+ * 		Ramp Ticks (Full Scale) = PWM Frequency * Ramp Time
+ * 		Progress is a 16-bit fraction of the ramp (0 -> 65535), increased every
+ * 		PWM period by: Increment = 65535 * 255 / ( Ramp Ticks * |Target - Start| )
+ *
+ * 		p = Progress / 256 (0 -> 255)
+ * 		Linear Shape	= p
+ * 		S-Curve Shape	= 255 * (3x^2 - 2x^3), x = p / 256 (Smooth-step), taken from a
+ * 						  17 points table with linear interpolation between points
+ * 		Duty = Start + (Target - Start) * Shape / 256
+ */
+#define DC_MOTOR_RAMP_TICKS			\
+	((uint32) PWM_FREQUENCY * DC_MOTOR_RAMP_TIME_MS / 1000UL)
+#define DC_MOTOR_RAMP_RATE			\
+	((DC_MOTOR_RAMP_TICKS == 0) ? 0xFFFFFFFFUL : \
+	(65535UL * 255UL / DC_MOTOR_RAMP_TICKS))
+#define DC_MOTOR_RAMP_DONE			0xFFFF
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Direction currently applied to the bridge */
+static volatile ROTATION_STATE g_motorDirection = STOP;
+/* Direction & duty-cycle required by upper layer */
+static volatile ROTATION_STATE g_motorTargetDirection = STOP;
+static volatile uint8 g_motorTargetDuty = 0;
+/* Duty-cycle currently applied to PWM */
+static volatile uint8 g_motorDuty = 0;
+/* Current ramp start, end, progress & progress increment per PWM period */
+static volatile uint8 g_rampStart = 0;
+static volatile uint8 g_rampEnd = 0;
+static volatile uint16 g_rampProgress = DC_MOTOR_RAMP_DONE;
+static volatile uint16 g_rampIncrement = 0;
+
+#if (DC_MOTOR_RAMP_S_CURVE == TRUE)
+
+/* Smooth-step shape at every (1/16) of the ramp */
+static const uint8 g_rampSCurve[17] = { 0, 3, 11, 24, 40, 59, 81, 104, 128, 151,
+		174, 196, 215, 231, 244, 252, 255 };
+
+#endif
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: DCMotor_setDirection
+ * [Description]	:
+ * 		Function that applies rotation direction to bridge pins.
+ * [Args]	:
+ * [In] rotation	: Indicates rotation direction of the motor.
+ * [Return]			: Void.
+ */
+static void DCMotor_setDirection(ROTATION_STATE rotation);
+
+/*
+ * [Function Name]	: DCMotor_startRamp
+ * [Description]	:
+ * 		Function that starts a ramp from current duty-cycle to a new one, must
+ * 		be called while PWM interrupt is disabled.
+ * [Args]	:
+ * [In] duty	: Indicates duty-cycle at the end of the ramp.
+ * [Return]		: Void.
+ */
+static void DCMotor_startRamp(uint8 duty);
+
+/*
+ * [Function Name]	: DCMotor_rampTick
+ * [Description]	:
+ * 		PWM period call-back that advances the ramp & applies the target
+ * 		direction when the ramp reaches ZERO.
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void DCMotor_rampTick(void);
+
+#endif
 
 /*******************************************************************************
  *                            Functions Definitions                            *
@@ -21,16 +110,231 @@
  */
 void DCMotor_init(void)
 {
-	/* Configure bridge enable pin as output pin */
-	GPIO_setupPinDirection(DC_MOTOR_PORT, DC_MOTOR_ENABLE, PIN_OUTPUT);
 	/* Configure bridge direction pins as output pin */
 	GPIO_setupPinDirection(DC_MOTOR_PORT, DC_MOTOR_IN1, PIN_OUTPUT);
 	GPIO_setupPinDirection(DC_MOTOR_PORT, DC_MOTOR_IN2, PIN_OUTPUT);
 	/* Stop the motor initially */
 	GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN1, LOGIC_LOW);
 	GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN2, LOGIC_LOW);
+	/* Initialize PWM speed control on bridge enable pin (Set as output) */
+	PWM_init();
+
+#if (DC_MOTOR_RAMP_ENABLE == TRUE)
+
+	/* Advance ramps at the end of every PWM period */
+	PWM_setCallBack(DCMotor_rampTick);
+
+#endif
+
+}
+
+#if (DC_MOTOR_RAMP_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: DCMotor_Rotate
+ * [Description]	:
+ * 		Function that sets motor target rotation & speed, the motor ramps to
+ * 		the target in the background.
+ * [Args]	:
+ * [In] rotation	: Indicates rotation direction of the motor.
+ * [In] speed		: Indicates speed percentage of the motor.
+ * [Return]		: Void.
+ */
+void DCMotor_Rotate(ROTATION_STATE rotation, uint8 speed)
+{
+	uint8 dutyCycle = 0;	/* Initialize duty-cycle value */
+	/* Convert recieved percentage into duty-cycle value */
+	if (rotation != STOP)
+	{
+		dutyCycle = (uint8) ((uint16) (speed * 250) / 100) + 5;
+	}
+	/* Stop ramp updates while changing it's state */
+	PWM_disableInterrupt();
+	g_motorTargetDirection = rotation;
+	g_motorTargetDuty = dutyCycle;
+	if (g_motorDirection == STOP && rotation == STOP)
+	{
+		/* Already stopped, PWM is not running */
+		return;
+	}
+	else if (g_motorDirection == STOP)
+	{
+		/* Start from ZERO in the new direction */
+		DCMotor_setDirection(rotation);
+		PWM_setDuty(0);
+		PWM_enable();
+		g_motorDuty = 0;
+		DCMotor_startRamp(dutyCycle);
+	}
+	else if (g_motorDirection == rotation)
+	{
+		/* Same direction, ramp to new speed */
+		DCMotor_startRamp(dutyCycle);
+	}
+	else
+	{
+		/* Stopping or reversing, ramp down to ZERO first */
+		DCMotor_startRamp(0);
+	}
+	PWM_enableInterrupt();
+}
+
+/*
+ * [Function Name]	: DCMotor_isRamping
+ * [Description]	:
+ * 		Function that checks if the motor is still ramping to it's last target.
+ * [Args]		: Void.
+ * [Return]		: (TRUE) if ramping, (FALSE) if target is reached.
+ */
+uint8 DCMotor_isRamping(void)
+{
+	return ((g_rampProgress != DC_MOTOR_RAMP_DONE) ? TRUE : FALSE);
+}
+
+/*
+ * [Function Name]	: DCMotor_setDirection
+ * [Description]	:
+ * 		Function that applies rotation direction to bridge pins.
+ * [Args]	:
+ * [In] rotation	: Indicates rotation direction of the motor.
+ * [Return]			: Void.
+ */
+static void DCMotor_setDirection(ROTATION_STATE rotation)
+{
+	switch (rotation)
+	{
+		case STOP:
+			/* Stop motor rotation */
+			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN1, LOGIC_LOW);
+			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN2, LOGIC_LOW);
+		break;
+		case CLOCKWISE:
+			/* Rotate motor clock-wise direction */
+			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN1, LOGIC_HIGH);
+			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN2, LOGIC_LOW);
+		break;
+		case COUNTER_CLOCKWISE:
+			/* Rotate motor counter clock-wise direction */
+			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN1, LOGIC_LOW);
+			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN2, LOGIC_HIGH);
+		break;
+	}
+	g_motorDirection = rotation;
+}
+
+/*
+ * [Function Name]	: DCMotor_startRamp
+ * [Description]	:
+ * 		Function that starts a ramp from current duty-cycle to a new one, must
+ * 		be called while PWM interrupt is disabled.
+ * [Args]	:
+ * [In] duty	: Indicates duty-cycle at the end of the ramp.
+ * [Return]		: Void.
+ */
+static void DCMotor_startRamp(uint8 duty)
+{
+	uint8 distance = 0; /* Duty-cycle change of the ramp */
+	uint32 increment = 0; /* Progress increment per PWM period */
+	g_rampStart = g_motorDuty;
+	g_rampEnd = duty;
+	distance = (duty > g_motorDuty) ? (duty - g_motorDuty) : (g_motorDuty - duty);
+	if (distance == 0)
+	{
+		increment = DC_MOTOR_RAMP_DONE;
+	}
+	else
+	{
+		/* The only division, done once per ramp not every period */
+		increment = DC_MOTOR_RAMP_RATE / distance;
+	}
+	if (increment == 0)
+	{
+		increment = 1;
+	}
+	else if (increment > DC_MOTOR_RAMP_DONE)
+	{
+		increment = DC_MOTOR_RAMP_DONE;
+	}
+	g_rampIncrement = (uint16) increment;
+	g_rampProgress = 0;
 }
 
+/*
+ * [Function Name]	: DCMotor_rampTick
+ * [Description]	:
+ * 		PWM period call-back that advances the ramp & applies the target
+ * 		direction when the ramp reaches ZERO.
+ * [Args]	: Void.
+ * [Return]	: Void.
+ */
+static void DCMotor_rampTick(void)
+{
+	uint8 progress = 0; /* Ramp progress (0 -> 255) */
+	uint8 shape = 0; /* Ramp shape (0 -> 255) */
+	uint8 change = 0; /* Duty-cycle change from ramp start */
+	uint16 remaining = DC_MOTOR_RAMP_DONE - g_rampProgress; /* Progress left */
+	/* Advance progress, saturate at the end of the ramp */
+	if (remaining <= g_rampIncrement)
+	{
+		g_rampProgress = DC_MOTOR_RAMP_DONE;
+		g_motorDuty = g_rampEnd;
+	}
+	else
+	{
+		g_rampProgress += g_rampIncrement;
+		progress = (uint8) (g_rampProgress >> 8);
+
+#if (DC_MOTOR_RAMP_S_CURVE == TRUE)
+
+		/* Interpolate between table points, (progress / 16) & (progress % 16) */
+		shape = g_rampSCurve[progress >> 4];
+		shape += (uint8) (((uint16) (g_rampSCurve[(progress >> 4) + 1] - shape)
+				* (progress & 0x0F)) >> 4);
+
+#else
+
+		shape = progress;
+
+#endif
+
+		if (g_rampEnd > g_rampStart)
+		{
+			change = (uint8) (((uint16) (g_rampEnd - g_rampStart) * shape) >> 8);
+			g_motorDuty = g_rampStart + change;
+		}
+		else
+		{
+			change = (uint8) (((uint16) (g_rampStart - g_rampEnd) * shape) >> 8);
+			g_motorDuty = g_rampStart - change;
+		}
+	}
+	PWM_setDuty(g_motorDuty);
+	if (g_rampProgress != DC_MOTOR_RAMP_DONE)
+	{
+		return;
+	}
+	/* Ramp finished */
+	if (g_motorDirection != g_motorTargetDirection)
+	{
+		/* Reached ZERO while stopping or reversing */
+		if (g_motorTargetDirection == STOP)
+		{
+			PWM_disable(); /* Stop PWM speed control */
+			DCMotor_setDirection(STOP);
+		}
+		else
+		{
+			DCMotor_setDirection(g_motorTargetDirection);
+			DCMotor_startRamp(g_motorTargetDuty);
+			return;
+		}
+	}
+	/* Target reached, no more work in PWM interrupt */
+	PWM_disableInterrupt();
+}
+
+#else
+
 /*
  * [Function Name]	: DCMotor_Rotate
  * [Description]	:
@@ -49,22 +353,26 @@ void DCMotor_Rotate(ROTATION_STATE rotation, uint8 speed)
 	switch (rotation)
 	{
 		case STOP:
-			Timer0_stop(); /* Stop PWM speed control */
+			PWM_disable(); /* Stop PWM speed control */
 			/* Stop motor rotation */
 			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN1, LOGIC_LOW);
 			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN2, LOGIC_LOW);
 			return;
 		case CLOCKWISE:
-			Timer0_start(TIMER01_PRESCALER_8, 5, dutyCycle); /* Start timer & generate PWM */
+			PWM_setDuty(dutyCycle); /* Change speed at next PWM period */
+			PWM_enable(); /* Generate PWM if stopped */
 			/* Rotate motor clock-wise direction */
 			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN1, LOGIC_HIGH);
 			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN2, LOGIC_LOW);
 			return;
 		case COUNTER_CLOCKWISE:
-			Timer0_start(TIMER01_PRESCALER_8, 5, dutyCycle); /* Start timer & generate PWM */
+			PWM_setDuty(dutyCycle); /* Change speed at next PWM period */
+			PWM_enable(); /* Generate PWM if stopped */
 			/* Rotate motor counter clock-wise direction */
 			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN1, LOGIC_LOW);
 			GPIO_writePin(DC_MOTOR_PORT, DC_MOTOR_IN2, LOGIC_HIGH);
 			return;
 	}
 }
+
+#endif
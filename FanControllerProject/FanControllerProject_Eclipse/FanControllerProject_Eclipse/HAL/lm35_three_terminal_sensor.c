@@ -8,18 +8,59 @@
 #include "lm35_three_terminal_sensor.h"	/* For sensor prototypes & definitions */
 
 /*******************************************************************************
- *                           Timer Useful Equations                            *
+ *                          Sensor Useful Equations                            *
  *******************************************************************************/
 /*
  * 	Sensor Value = ( ADC Analog Channel Value * Sensor Maximum Value
  * 											* ADC Reference Voltage Value )
  * 				   /
  * 				   ( ADC Maximum Bit Value * Sensor Maximum Voltage Value )
+ *
+ * 				 = ( ADC Analog Channel Value * Sensor Full Scale Value )
+ * 				   /
+ * 				   ( 2^(ADC Result Bits) - 1 )
+ *
+ * 	Division by (2^N - 1) for X < 2^(3N) without a divide instruction:
+ *
+ * 		X / (2^N - 1) = ( X + (X >> N) + (X >> 2N) + 1 ) >> N
+ *
+ * 	Results are identical to the floating point equation for all ADC values.
  */
 
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: LM35_scaleReading
+ * [Description]	:
+ * 		Function that scales an ADC reading to a temperature using integer math.
+ * [Args]	:
+ * [In] ADCRead		: Indicates ADC conversion value.
+ * [In] fullScale	: Indicates temperature at ADC full scale.
+ * [Return]			: Temperature in units of full scale value.
+ */
+static uint16 LM35_scaleReading(uint16 ADCRead, uint16 fullScale);
+
 /*******************************************************************************
  *                            Functions Definitions                            *
  *******************************************************************************/
+/*
+ * [Function Name]	: LM35_scaleReading
+ * [Description]	:
+ * 		Function that scales an ADC reading to a temperature using integer math.
+ * [Args]	:
+ * [In] ADCRead		: Indicates ADC conversion value.
+ * [In] fullScale	: Indicates temperature at ADC full scale.
+ * [Return]			: Temperature in units of full scale value.
+ */
+static uint16 LM35_scaleReading(uint16 ADCRead, uint16 fullScale)
+{
+	uint32 product = (uint32) ADCRead * fullScale; /* Numerator of the equation */
+	/* Divide by ADC maximum value (2^N - 1) using shifts */
+	return (uint16) ((product + (product >> ADC_RESULT_BITS)
+			+ (product >> (2 * ADC_RESULT_BITS)) + 1) >> ADC_RESULT_BITS);
+}
+
 /*
  * [Function Name]	: LM35_getTemp
  * [Description]	:
@@ -31,31 +72,48 @@
  */
 uint8 LM35_getTemperature(void)
 {
-
-	uint8 LM35TempValue = 0; /* Hold temperature value */
+	uint16 ADCRead = 0; /* Hold ADC conversion value */
 
 #if (ADC_INTERRUPT_ENABLE == TRUE)
 
-	/* Read ADC channel where the sensor is connected */
-	ADC_readChannel(SENSOR_CHANNEL_ID);
-	/* Calculate the temperature from the ADC value*/
-	LM35TempValue = (uint8) (((uint32) g_ADCValue
-				* SENSOR_MAX_TEMPERATURE * ADC_REF_VOLT_VALUE)
-				/ (ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_VALUE));
+	/* Get last conversion value of the sensor channel from the channels scan */
+	ADC_getChannelResult(SENSOR_CHANNEL_ID, &ADCRead);
 
 #else
 
-	uint16 ADCRead = 0; /* Hold ADC conversion value */
 	/* Get ADC conversion value */
 	ADCRead = ADC_readChannel(SENSOR_CHANNEL_ID);
-	/* Calculate the temperature from the ADC value*/
-	LM35TempValue =
-			(uint8) (((uint32) ADCRead * SENSOR_MAX_TEMPERATURE
-					* ADC_REF_VOLT_VALUE)
-					/ (ADC_MAXIMUM_VALUE * SENSOR_MAX_VOLT_VALUE));
 
 #endif
 
-	return LM35TempValue;
+	/* Calculate the temperature from the ADC value */
+	return (uint8) LM35_scaleReading(ADCRead, SENSOR_FULL_SCALE_DEGREES);
 }
 
+/*
+ * [Function Name]	: LM35_getTemperatureTenths
+ * [Description]	:
+ * 		Function that calculates sensor reading in tenths of degree using it's
+ * 		governing equation in integer math only.
+ * [Args]	: Void.
+ * [Return]	: Temperature in tenths of degree.
+ */
+uint16 LM35_getTemperatureTenths(void)
+{
+	uint16 ADCRead = 0; /* Hold ADC conversion value */
+
+#if (ADC_INTERRUPT_ENABLE == TRUE)
+
+	/* Get last conversion value of the sensor channel from the channels scan */
+	ADC_getChannelResult(SENSOR_CHANNEL_ID, &ADCRead);
+
+#else
+
+	/* Get ADC conversion value */
+	ADCRead = ADC_readChannel(SENSOR_CHANNEL_ID);
+
+#endif
+
+	/* Calculate the temperature from the ADC value */
+	return LM35_scaleReading(ADCRead, SENSOR_FULL_SCALE_TENTHS);
+}
@@ -18,6 +18,15 @@
 #define SENSOR_MAX_VOLT_VALUE     1.5
 #define SENSOR_MAX_TEMPERATURE    150
 
+/* Temperature at ADC full scale in degrees & tenths of degree, folded to integers
+ * at compile time (256 & 2560 for 2.56 volts reference) */
+#define SENSOR_FULL_SCALE_DEGREES	\
+	((uint16) ((SENSOR_MAX_TEMPERATURE * ADC_REF_VOLT_VALUE \
+			/ SENSOR_MAX_VOLT_VALUE) + 0.5))
+#define SENSOR_FULL_SCALE_TENTHS	\
+	((uint16) ((SENSOR_MAX_TEMPERATURE * 10 * ADC_REF_VOLT_VALUE \
+			/ SENSOR_MAX_VOLT_VALUE) + 0.5))
+
 /*******************************************************************************
  *                            Functions Prototypes                             *
  *******************************************************************************/
@@ -32,4 +41,14 @@
  */
 uint8 LM35_getTemperature(void);
 
+/*
+ * [Function Name]	: LM35_getTemperatureTenths
+ * [Description]	:
+ * 		Function that calculates sensor reading in tenths of degree using it's
+ * 		governing equation in integer math only.
+ * [Args]	: Void.
+ * [Return]	: Temperature in tenths of degree.
+ */
+uint16 LM35_getTemperatureTenths(void);
+
 #endif /* LM35_THREE_TERMINAL_SENSOR_H_ */
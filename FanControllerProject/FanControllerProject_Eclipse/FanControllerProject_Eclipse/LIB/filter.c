@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Module: Filter
+ * File Name: filter.c
+ * Description: Source file for integer digital filters of sensor readings.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "filter.h"					/* For filter prototypes & definitions */
+
+/*******************************************************************************
+ *                           Filter Useful Equations                           *
+ *******************************************************************************/
+/*
+ * 		Median = Middle value of the sorted window, removes single spikes.
+ *
+ * 		EMA: Output(n) = Output(n-1) + ( Sample(n) - Output(n-1) ) / (2^shift)
+ * 		     Kept as Scaled = Output * (2^shift):
+ * 		     Scaled(n) = Scaled(n-1) - Output(n-1) + Sample(n)
+ *
+ * 		Rate Limit: Output(n) = Output(n-1) +/- min( |Sample(n) - Output(n-1)|, Max Step )
+ */
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Filter_medianInit
+ * [Description]	:
+ * 		Function that empties a median filter window.
+ * [Args]	:
+ * [Out] filter_Ptr	: Indicates filter state.
+ * [Return]			: Void.
+ */
+void Filter_medianInit(Filter_MedianType *filter_Ptr)
+{
+	(*filter_Ptr).index = 0;
+	(*filter_Ptr).count = 0;
+}
+
+/*
+ * [Function Name]	: Filter_median
+ * [Description]	:
+ * 		Function that adds a sample to a median filter window & returns the
+ * 		median of the window, until the window is full the median of the
+ * 		received samples is returned.
+ * [Args]	:
+ * [In/Out] filter_Ptr	: Indicates filter state.
+ * [In] sample			: Indicates new sample.
+ * [Return]				: Median of the window.
+ */
+uint16 Filter_median(Filter_MedianType *filter_Ptr, uint16 sample)
+{
+	uint16 sorted[FILTER_MEDIAN_SIZE]; /* Sorted copy of the window */
+	uint16 value = 0; /* Value being inserted in the sorted copy */
+	uint8 counter = 0; /* A counter variable for loops */
+	uint8 position = 0; /* Insertion position in the sorted copy */
+	/* Replace the oldest sample */
+	(*filter_Ptr).samples[(*filter_Ptr).index] = sample;
+	(*filter_Ptr).index++;
+	if ((*filter_Ptr).index == FILTER_MEDIAN_SIZE)
+	{
+		(*filter_Ptr).index = 0;
+	}
+	if ((*filter_Ptr).count < FILTER_MEDIAN_SIZE)
+	{
+		(*filter_Ptr).count++;
+	}
+	/* Insertion sort of the received samples, fast for small windows */
+	for (counter = 0; counter < (*filter_Ptr).count; counter++)
+	{
+		value = (*filter_Ptr).samples[counter];
+		position = counter;
+		while ((position > 0) && (sorted[position - 1] > value))
+		{
+			sorted[position] = sorted[position - 1];
+			position--;
+		}
+		sorted[position] = value;
+	}
+	return sorted[(*filter_Ptr).count / 2];
+}
+
+/*
+ * [Function Name]	: Filter_EMAInit
+ * [Description]	:
+ * 		Function that resets an exponential moving average filter, the first
+ * 		sample after reset is passed as it is.
+ * [Args]	:
+ * [Out] filter_Ptr	: Indicates filter state.
+ * [In] shift		: Indicates smoothing, alpha = 1 / (2^shift).
+ * [Return]			: Void.
+ */
+void Filter_EMAInit(Filter_EMAType *filter_Ptr, uint8 shift)
+{
+	if (shift > FILTER_EMA_MAX_SHIFT)
+	{
+		shift = FILTER_EMA_MAX_SHIFT;
+	}
+	(*filter_Ptr).shift = shift;
+	(*filter_Ptr).scaledOutput = 0;
+	(*filter_Ptr).initialized = FALSE;
+}
+
+/*
+ * [Function Name]	: Filter_EMA
+ * [Description]	:
+ * 		Function that adds a sample to an exponential moving average filter
+ * 		using shifts only: output += (sample - output) / (2^shift).
+ * [Args]	:
+ * [In/Out] filter_Ptr	: Indicates filter state.
+ * [In] sample			: Indicates new sample.
+ * [Return]				: Filtered value, rounded.
+ */
+uint16 Filter_EMA(Filter_EMAType *filter_Ptr, uint16 sample)
+{
+	uint8 shift = (*filter_Ptr).shift; /* Local copy of the shift */
+	/* Half of the scale, used for rounding */
+	uint32 half = (shift == 0) ? 0 : (1UL << (shift - 1));
+	if ((*filter_Ptr).initialized == FALSE)
+	{
+		/* Start from the first sample instead of ZERO */
+		(*filter_Ptr).scaledOutput = (uint32) sample << shift;
+		(*filter_Ptr).initialized = TRUE;
+	}
+	else
+	{
+		/*
+		 * Subtract the rounded output not the truncated one, so the output
+		 * settles exactly on a constant input from both directions.
+		 */
+		(*filter_Ptr).scaledOutput -= ((*filter_Ptr).scaledOutput + half)
+				>> shift;
+		(*filter_Ptr).scaledOutput += sample;
+	}
+	/* Remove the scale with rounding */
+	return (uint16) (((*filter_Ptr).scaledOutput + half) >> shift);
+}
+
+/*
+ * [Function Name]	: Filter_rateLimitInit
+ * [Description]	:
+ * 		Function that resets a rate limiter, the first sample after reset is
+ * 		passed as it is.
+ * [Args]	:
+ * [Out] filter_Ptr	: Indicates filter state.
+ * [In] maxStep		: Indicates maximum change of output per sample.
+ * [Return]			: Void.
+ */
+void Filter_rateLimitInit(Filter_RateLimitType *filter_Ptr, uint16 maxStep)
+{
+	(*filter_Ptr).output = 0;
+	(*filter_Ptr).maxStep = maxStep;
+	(*filter_Ptr).initialized = FALSE;
+}
+
+/*
+ * [Function Name]	: Filter_rateLimit
+ * [Description]	:
+ * 		Function that moves a rate limiter output towards a sample by maxStep at most.
+ * [Args]	:
+ * [In/Out] filter_Ptr	: Indicates filter state.
+ * [In] sample			: Indicates new sample.
+ * [Return]				: Limited value.
+ */
+uint16 Filter_rateLimit(Filter_RateLimitType *filter_Ptr, uint16 sample)
+{
+	if ((*filter_Ptr).initialized == FALSE)
+	{
+		(*filter_Ptr).output = sample;
+		(*filter_Ptr).initialized = TRUE;
+	}
+	else if (sample > (*filter_Ptr).output)
+	{
+		/* Rising, compare differences to avoid overflow */
+		if ((sample - (*filter_Ptr).output) > (*filter_Ptr).maxStep)
+		{
+			(*filter_Ptr).output += (*filter_Ptr).maxStep;
+		}
+		else
+		{
+			(*filter_Ptr).output = sample;
+		}
+	}
+	else
+	{
+		/* Falling */
+		if (((*filter_Ptr).output - sample) > (*filter_Ptr).maxStep)
+		{
+			(*filter_Ptr).output -= (*filter_Ptr).maxStep;
+		}
+		else
+		{
+			(*filter_Ptr).output = sample;
+		}
+	}
+	return (*filter_Ptr).output;
+}
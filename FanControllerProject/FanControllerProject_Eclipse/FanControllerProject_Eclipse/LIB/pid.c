@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Module: PID
+ * File Name: pid.c
+ * Description: Source file for fixed-point PID controller.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "pid.h"					/* For PID prototypes & definitions */
+
+/*******************************************************************************
+ *                           PID Useful Equations                              *
+ *******************************************************************************/
+/*
+ * 		Error = Setpoint - Measurement 	(Direct action)
+ * 		Error = Measurement - Setpoint 	(Reverse action)
+ *
+ * 		Integral(n) = Integral(n-1) + Ki * Error(n)
+ * 		Output(n) = ( Kp * Error(n) + Integral(n) - Kd * Change of Measurement ) / 256
+ *
+ * 		Derivative is taken on measurement not error, so setpoint changes
+ * 		do not kick the output.
+ */
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Pid_init
+ * [Description]	:
+ * 		Function that attaches configurations & setpoint to a controller and
+ * 		resets it.
+ * [Args]	:
+ * [Out] controller_Ptr	: Indicates controller state.
+ * [In] Config_Ptr		: Indicates controller configurations, must stay allocated.
+ * [In] setpoint		: Indicates required measurement value.
+ * [Return]				: Void.
+ */
+void Pid_init(Pid_ControllerType *controller_Ptr,
+		const Pid_ConfigType *Config_Ptr, sint16 setpoint)
+{
+	(*controller_Ptr).config_Ptr = Config_Ptr;
+	(*controller_Ptr).setpoint = setpoint;
+	Pid_reset(controller_Ptr, (*Config_Ptr).outputMin);
+}
+
+/*
+ * [Function Name]	: Pid_setSetpoint
+ * [Description]	:
+ * 		Function that changes controller setpoint without resetting it.
+ * [Args]	:
+ * [In/Out] controller_Ptr	: Indicates controller state.
+ * [In] setpoint			: Indicates required measurement value.
+ * [Return]					: Void.
+ */
+void Pid_setSetpoint(Pid_ControllerType *controller_Ptr, sint16 setpoint)
+{
+	(*controller_Ptr).setpoint = setpoint;
+}
+
+/*
+ * [Function Name]	: Pid_reset
+ * [Description]	:
+ * 		Function that resets a controller, the next output starts from the
+ * 		given output value without a bump.
+ * [Args]	:
+ * [In/Out] controller_Ptr	: Indicates controller state.
+ * [In] output				: Indicates output to start from.
+ * [Return]					: Void.
+ */
+void Pid_reset(Pid_ControllerType *controller_Ptr, sint16 output)
+{
+	(*controller_Ptr).integral = (sint32) output << PID_GAIN_SHIFT;
+	(*controller_Ptr).initialized = FALSE;
+}
+
+/*
+ * [Function Name]	: Pid_update
+ * [Description]	:
+ * 		Function that runs one controller sample, must be called at a fixed
+ * 		sample rate as gains are per sample. Integration stops while output
+ * 		is saturated in the same direction (anti-windup).
+ * [Args]	:
+ * [In/Out] controller_Ptr	: Indicates controller state.
+ * [In] measurement			: Indicates new measurement.
+ * [Return]					: Controller output limited to configured limits.
+ */
+sint16 Pid_update(Pid_ControllerType *controller_Ptr, sint16 measurement)
+{
+	const Pid_ConfigType *Config_Ptr = (*controller_Ptr).config_Ptr;
+	/* Scaled limits of the output */
+	sint32 outputMax = (sint32) (*Config_Ptr).outputMax << PID_GAIN_SHIFT;
+	sint32 outputMin = (sint32) (*Config_Ptr).outputMin << PID_GAIN_SHIFT;
+	sint32 error = 0; /* Error in controller direction */
+	sint32 change = 0; /* Change of measurement in controller direction */
+	sint32 integral = 0; /* Integral candidate of this sample */
+	sint32 output = 0; /* Scaled output */
+	if ((*controller_Ptr).initialized == FALSE)
+	{
+		/* No derivative on the first sample */
+		(*controller_Ptr).lastMeasurement = measurement;
+		(*controller_Ptr).initialized = TRUE;
+	}
+	if ((*Config_Ptr).action == PID_DIRECT_ACTION)
+	{
+		error = (sint32) (*controller_Ptr).setpoint - measurement;
+		change = (sint32) measurement - (*controller_Ptr).lastMeasurement;
+	}
+	else
+	{
+		error = (sint32) measurement - (*controller_Ptr).setpoint;
+		change = (sint32) (*controller_Ptr).lastMeasurement - measurement;
+	}
+	(*controller_Ptr).lastMeasurement = measurement;
+	/* Integrate & keep the integral inside the output limits */
+	integral = (*controller_Ptr).integral + (sint32) (*Config_Ptr).ki * error;
+	if (integral > outputMax)
+	{
+		integral = outputMax;
+	}
+	else if (integral < outputMin)
+	{
+		integral = outputMin;
+	}
+	output = (sint32) (*Config_Ptr).kp * error + integral
+			- (sint32) (*Config_Ptr).kd * change;
+	/* Limit output, keep the old integral if it pushes further into saturation */
+	if (output > outputMax)
+	{
+		output = outputMax;
+		if (integral > (*controller_Ptr).integral)
+		{
+			integral = (*controller_Ptr).integral;
+		}
+	}
+	else if (output < outputMin)
+	{
+		output = outputMin;
+		if (integral < (*controller_Ptr).integral)
+		{
+			integral = (*controller_Ptr).integral;
+		}
+	}
+	(*controller_Ptr).integral = integral;
+	/* Remove the scale with rounding */
+	return (sint16) ((output + (1L << (PID_GAIN_SHIFT - 1))) >> PID_GAIN_SHIFT);
+}
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Module: PID
+ * File Name: pid.h
+ * Description: Header file for fixed-point PID controller.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef PID_H_
+#define PID_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Gains are fixed-point with (PID_GAIN_SHIFT) fraction bits, gain = value / 256 */
+#define PID_GAIN_SHIFT		8
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Enumerate Name]	: PID_ACTION
+ * [Description]	:
+ * 		An enumerate that defines controller action, direct action increases
+ * 		output when measurement is below setpoint (heating), reverse action
+ * 		increases output when measurement is above setpoint (cooling).
+ */
+typedef enum
+{
+	PID_DIRECT_ACTION, PID_REVERSE_ACTION
+} PID_ACTION;
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Pid_ConfigType
+ * [Description]	:
+ * 		A structure in which it's instance holds controller gains per sample,
+ * 		output limits & action to be used in Pid_init.
+ */
+typedef struct
+{
+	sint16 kp;
+	sint16 ki;
+	sint16 kd;
+	sint16 outputMin;
+	sint16 outputMax;
+	PID_ACTION action;
+} Pid_ConfigType;
+
+/*
+ * [Structure Name]	: Pid_ControllerType
+ * [Description]	:
+ * 		A structure in which it's instance holds the state of one controller,
+ * 		the integral is kept scaled by (2^PID_GAIN_SHIFT).
+ */
+typedef struct
+{
+	const Pid_ConfigType *config_Ptr;
+	sint16 setpoint;
+	sint16 lastMeasurement;
+	sint32 integral;
+	uint8 initialized;
+} Pid_ControllerType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Pid_init
+ * [Description]	:
+ * 		Function that attaches configurations & setpoint to a controller and
+ * 		resets it.
+ * [Args]	:
+ * [Out] controller_Ptr	: Indicates controller state.
+ * [In] Config_Ptr		: Indicates controller configurations, must stay allocated.
+ * [In] setpoint		: Indicates required measurement value.
+ * [Return]				: Void.
+ */
+void Pid_init(Pid_ControllerType *controller_Ptr,
+		const Pid_ConfigType *Config_Ptr, sint16 setpoint);
+
+/*
+ * [Function Name]	: Pid_setSetpoint
+ * [Description]	:
+ * 		Function that changes controller setpoint without resetting it.
+ * [Args]	:
+ * [In/Out] controller_Ptr	: Indicates controller state.
+ * [In] setpoint			: Indicates required measurement value.
+ * [Return]					: Void.
+ */
+void Pid_setSetpoint(Pid_ControllerType *controller_Ptr, sint16 setpoint);
+
+/*
+ * [Function Name]	: Pid_reset
+ * [Description]	:
+ * 		Function that resets a controller, the next output starts from the
+ * 		given output value without a bump.
+ * [Args]	:
+ * [In/Out] controller_Ptr	: Indicates controller state.
+ * [In] output				: Indicates output to start from.
+ * [Return]					: Void.
+ */
+void Pid_reset(Pid_ControllerType *controller_Ptr, sint16 output);
+
+/*
+ * [Function Name]	: Pid_update
+ * [Description]	:
+ * 		Function that runs one controller sample, must be called at a fixed
+ * 		sample rate as gains are per sample. Integration stops while output
+ * 		is saturated in the same direction (anti-windup).
+ * [Args]	:
+ * [In/Out] controller_Ptr	: Indicates controller state.
+ * [In] measurement			: Indicates new measurement.
+ * [Return]					: Controller output limited to configured limits.
+ */
+sint16 Pid_update(Pid_ControllerType *controller_Ptr, sint16 measurement);
+
+#endif /* PID_H_ */
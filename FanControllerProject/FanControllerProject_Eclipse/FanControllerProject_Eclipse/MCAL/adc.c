@@ -11,6 +11,13 @@
 #if (ADC_INTERRUPT_ENABLE == TRUE)
 
 #include <avr/interrupt.h> 			/* For ADC ISR */
+#include "isr_trace.h"				/* For ADC ISR tracing */
+
+#if (ADC_NOISE_REDUCTION_ENABLE == TRUE)
+
+#include <avr/sleep.h> 				/* For ADC noise reduction sleep mode */
+
+#endif
 
 #endif
 
@@ -22,6 +29,32 @@
 /* A global variable that stores the value of ADC conversion */
 volatile uint16 g_ADCValue = 0;
 
+#if (ADC_INTERRUPT_ENABLE == TRUE)
+
+/* Last conversion result of each channel */
+static volatile uint16 g_ADCResults[ADC_CHANNELS_NUM];
+
+#if (ADC_OVERSAMPLING_BITS > 0)
+
+/* Sum of samples of each channel, (64) samples of (1023) fit in 16-bit */
+static volatile uint16 g_ADCAccumulators[ADC_CHANNELS_NUM];
+/* Number of samples in each channel sum */
+static volatile uint8 g_ADCSamplesCount[ADC_CHANNELS_NUM];
+
+#endif
+/* Number of results written to each channel slot */
+static volatile uint8 g_ADCSequence[ADC_CHANNELS_NUM];
+/* Channels converted in round-robin, (0) channels means single conversions */
+static uint8 g_ADCScanList[ADC_SCAN_MAX_CHANNELS];
+static volatile uint8 g_ADCScanChannelsNum = 0;
+/* Index of the channel written in ADMUX & index of the converted channel */
+static volatile uint8 g_ADCScanMuxIndex = 0;
+static volatile uint8 g_ADCScanConvIndex = 0;
+/* Auto-trigger source of the scan */
+static volatile uint8 g_ADCScanTrigSource = ADC_TRIG_FREE;
+
+#endif
+
 /*******************************************************************************
  *                          Interrupt Service Routines                         *
  *******************************************************************************/
@@ -35,7 +68,87 @@ volatile uint16 g_ADCValue = 0;
  */
 ISR(ADC_vect)
 {
-	g_ADCValue = ADC; /* Store ADC conversion value in the global variable */
+	ISR_TRACE_ENTRY();
+	uint16 ADCValue = ADC; /* Read conversion value once */
+	uint8 channelNum = 0; /* Channel the value belongs to */
+	g_ADCValue = ADCValue; /* Store ADC conversion value in the global variable */
+	if (g_ADCScanChannelsNum == 0)
+	{
+		/* Single conversion, the channel is still in ADMUX */
+		channelNum = ADMUX & (ADC_CHANNELS_NUM - 1);
+	}
+	else
+	{
+		channelNum = g_ADCScanList[g_ADCScanConvIndex];
+		/* In free running mode the next conversion already started with the
+		 * channel in ADMUX, otherwise it starts on the next trigger */
+		if (g_ADCScanTrigSource == ADC_TRIG_FREE)
+		{
+			g_ADCScanConvIndex = g_ADCScanMuxIndex;
+		}
+		/* Write the next channel of the list in ADMUX */
+		g_ADCScanMuxIndex++;
+		if (g_ADCScanMuxIndex == g_ADCScanChannelsNum)
+		{
+			g_ADCScanMuxIndex = 0;
+		}
+		if (g_ADCScanTrigSource != ADC_TRIG_FREE)
+		{
+			g_ADCScanConvIndex = g_ADCScanMuxIndex;
+		}
+		OVERWRITE_REG(ADMUX, 0xE0, g_ADCScanList[g_ADCScanMuxIndex]);
+		/* An auto-trigger is a rising edge of the source flag, clear the flag
+		 * if it's interrupt does not */
+		switch (g_ADCScanTrigSource)
+		{
+			case ADC_ANALOG_COMP:
+				SET_BIT(ACSR, ACI);
+			break;
+			case ADC_EXT_INT_0:
+				GIFR = (1 << INTF0);
+			break;
+			case ADC_TRIG_TIMER0_CTC:
+				TIFR = (1 << OCF0);
+			break;
+			case ADC_TRIG_TIMER0_OVF:
+				TIFR = (1 << TOV0);
+			break;
+			case ADC_TRIG_TIMER1_CTC_B:
+				TIFR = (1 << OCF1B);
+			break;
+			case ADC_TRIG_TIMER1_OVF:
+				TIFR = (1 << TOV1);
+			break;
+			case ADC_TRIG_TIMER1_CAPTURE:
+				TIFR = (1 << ICF1);
+			break;
+		}
+	}
+
+#if (ADC_OVERSAMPLING_BITS > 0)
+
+	/* Accumulate samples until the channel has (4^bits) of them */
+	g_ADCAccumulators[channelNum] += ADCValue;
+	g_ADCSamplesCount[channelNum]++;
+	if (g_ADCSamplesCount[channelNum] == ADC_OVERSAMPLING_SAMPLES)
+	{
+		/* Decimate the sum to (10 + bits) resolution */
+		ADCValue = g_ADCAccumulators[channelNum] >> ADC_OVERSAMPLING_BITS;
+		g_ADCAccumulators[channelNum] = 0;
+		g_ADCSamplesCount[channelNum] = 0;
+	}
+	else
+	{
+		ISR_TRACE_EXIT(ISR_TRACE_ADC);
+		return; /* Result is not ready yet */
+	}
+
+#endif
+
+	/* Store the value in it's channel slot then publish it */
+	g_ADCResults[channelNum] = ADCValue;
+	g_ADCSequence[channelNum]++;
+	ISR_TRACE_EXIT(ISR_TRACE_ADC);
 }
 
 #endif
@@ -130,7 +243,7 @@ void ADC_init(const ADC_ConfigType *ADCControl_Ptr)
 #endif
 
 	/* Set pre-scaler bits */
-	OVERWRITE_REG(ADCSRA, 0xF8, 0x00); /* Set ADPS2:0 values */
+	OVERWRITE_REG(ADCSRA, 0xF8, (*ADCControl_Ptr).prescaler); /* Set ADPS2:0 values */
 
 	/* SFIOR register bits description:
 	 * 		REFS2:0 = (000) to (111) to choose auto-trigger source.
@@ -260,6 +373,146 @@ uint16 ADC_readChannel(uint8 channelNum)
 
 }
 
+#if (ADC_INTERRUPT_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: ADC_startScan
+ * [Description]	:
+ * 		Function that starts converting a list of channels in round-robin from
+ * 		the ADC interrupt, each result is placed in it's channel slot.
+ * 		Conversions are either free running or started by the chosen
+ * 		auto-trigger source, whose flag is cleared by the ADC interrupt.
+ * [Args]	:
+ * [In] channelList_Ptr	: Indicates channels to be converted (0 to 7).
+ * [In] channelsNum		: Indicates number of channels in the list.
+ * [In] trigSource		: Indicates auto-trigger source.
+ * [Return]				: Void.
+ */
+void ADC_startScan(const uint8 *channelList_Ptr, uint8 channelsNum,
+		ADC_AUTOTRIG_MODE trigSource)
+{
+	uint8 counter = 0; /* A counter variable for loops */
+	/* Stop any running scan before changing the list */
+	ADC_stopScan();
+	if (channelsNum > ADC_SCAN_MAX_CHANNELS)
+	{
+		channelsNum = ADC_SCAN_MAX_CHANNELS;
+	}
+	/* Copy the list, only single ended channels own a slot */
+	for (counter = 0; counter < channelsNum; counter++)
+	{
+		g_ADCScanList[counter] = channelList_Ptr[counter]
+				& (ADC_CHANNELS_NUM - 1);
+	}
+	g_ADCScanMuxIndex = 0;
+	g_ADCScanConvIndex = 0;
+	g_ADCScanTrigSource = trigSource;
+
+#if (ADC_OVERSAMPLING_BITS > 0)
+
+	/* Drop partial sums of the previous scan */
+	for (counter = 0; counter < ADC_CHANNELS_NUM; counter++)
+	{
+		g_ADCAccumulators[counter] = 0;
+		g_ADCSamplesCount[counter] = 0;
+	}
+
+#endif
+
+	g_ADCScanChannelsNum = channelsNum;
+	if (channelsNum != 0)
+	{
+		/* Select the first channel of the list */
+		OVERWRITE_REG(ADMUX, 0xE0, g_ADCScanList[0]);
+		/* Enable auto-trigger with the chosen source */
+		ADC_setAutoTrig(LOGIC_HIGH, trigSource);
+		if (trigSource == ADC_TRIG_FREE)
+		{
+			SET_BIT(ADCSRA, ADSC); /* Start the first conversion */
+		}
+	}
+}
+
+/*
+ * [Function Name]	: ADC_stopScan
+ * [Description]	:
+ * 		Function that stops channels scan & disables auto-trigger,
+ * 		channel slots keep their last results.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void ADC_stopScan(void)
+{
+	/* Stop new conversions from being triggered */
+	ADC_setAutoTrig(LOGIC_LOW, ADC_TRIG_FREE);
+	/* Wait for a running conversion to complete */
+	while (BIT_IS_SET(ADCSRA, ADSC));
+	g_ADCScanChannelsNum = 0;
+}
+
+/*
+ * [Function Name]	: ADC_getChannelResult
+ * [Description]	:
+ * 		Function that reads the last conversion result of a channel from it's slot,
+ * 		the result is read again if a conversion completed while reading.
+ * [Args]	:
+ * [In] channelNum	: Indicates channel number.
+ * [Out] value_Ptr	: Holds last conversion result of the channel.
+ * [Return]			: Sequence counter of the channel, increases on every new result.
+ */
+uint8 ADC_getChannelResult(uint8 channelNum, uint16 *value_Ptr)
+{
+	uint8 sequence = 0; /* Sequence counter before reading the result */
+	channelNum &= (ADC_CHANNELS_NUM - 1); /* Set channel = (111) if it is larger */
+	/* 16-bit result is read in two instructions, repeat if the ISR wrote it in between */
+	do
+	{
+		sequence = g_ADCSequence[channelNum];
+		*value_Ptr = g_ADCResults[channelNum];
+	} while (sequence != g_ADCSequence[channelNum]);
+	return sequence;
+}
+
+#if (ADC_NOISE_REDUCTION_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: ADC_readChannelNoiseReduced
+ * [Description]	:
+ * 		Function that converts a channel in ADC noise reduction sleep mode, the CPU
+ * 		& I/O clocks stop during each conversion & the ADC interrupt wakes it up.
+ * 		Channels scan must be stopped before calling it.
+ * [Args]	:
+ * [In] channelNum	: Indicates channel number.
+ * [Return]			: Conversion result after oversampling.
+ */
+uint16 ADC_readChannelNoiseReduced(uint8 channelNum)
+{
+	uint16 result = 0; /* Hold conversion result */
+	uint8 sequence = 0; /* Sequence counter before conversion */
+	channelNum &= (ADC_CHANNELS_NUM - 1); /* Set channel = (111) if it is larger */
+	/* Clear previous channel value & set new analog channel */
+	OVERWRITE_REG(ADMUX, 0xE0, channelNum);
+	sequence = g_ADCSequence[channelNum];
+	set_sleep_mode(SLEEP_MODE_ADC);
+	/* Entering the sleep mode starts a conversion, repeat until a result is published */
+	while (sequence == g_ADCSequence[channelNum])
+	{
+		/* Another interrupt may wake the CPU while converting, do not start a new one */
+		if (BIT_IS_CLEAR(ADCSRA, ADSC))
+		{
+			sleep_enable();
+			sleep_cpu();
+			sleep_disable();
+		}
+	}
+	ADC_getChannelResult(channelNum, &result);
+	return result;
+}
+
+#endif
+
+#endif
+
 /*
  * [Function Name]	: ADC_deInit
  * [Description]	:
@@ -273,6 +526,13 @@ uint16 ADC_readChannel(uint8 channelNum)
  */
 void ADC_deInit(void)
 {
+
+#if (ADC_INTERRUPT_ENABLE == TRUE)
+
+	g_ADCScanChannelsNum = 0; /* Remove channels scan list */
+
+#endif
+
 	CLEAR_REG(ADMUX); /* Clear ADMUX register */
 	CLEAR_REG(ADCSRA); /* Clear ADCSRA register */
 	SET_BIT(ADCSRA, ADIF); /* Clear ADC flag */
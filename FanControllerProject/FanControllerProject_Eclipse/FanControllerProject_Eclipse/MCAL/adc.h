@@ -13,11 +13,45 @@
 /*******************************************************************************
  *                                  Definitions                                *
  *******************************************************************************/
-#define ADC_INTERRUPT_ENABLE		FALSE
+#define ADC_INTERRUPT_ENABLE		TRUE
 #define ADC_MAXIMUM_VALUE    		1023
 #define ADC_LCD_VALUE_ADJUSTMENT	1000
 #define ADC_REF_VOLT_VALUE  		2.56
 
+#if (ADC_INTERRUPT_ENABLE == TRUE)
+
+/* Number of single ended channels that own a result slot */
+#define ADC_CHANNELS_NUM			8
+/* Maximum number of channels in a scan list */
+#define ADC_SCAN_MAX_CHANNELS		8
+/* Extra resolution bits (0 to 3), each result is decimated from (4^bits) samples,
+ * may be given by the build as the host tests do */
+#ifndef ADC_OVERSAMPLING_BITS
+#define ADC_OVERSAMPLING_BITS		2
+#endif
+/* Enable ADC_readChannelNoiseReduced, converting while the CPU sleeps */
+#define ADC_NOISE_REDUCTION_ENABLE	FALSE
+
+#if (ADC_OVERSAMPLING_BITS > 3)
+
+#error "ADC oversampling bits should be from (0) to (3)"
+
+#endif
+
+#define ADC_OVERSAMPLING_SAMPLES	(1 << (2 * ADC_OVERSAMPLING_BITS))
+/* Resolution & maximum value of a result in a channel slot */
+#define ADC_RESULT_BITS				(10 + ADC_OVERSAMPLING_BITS)
+#define ADC_RESULT_MAXIMUM_VALUE	\
+	((((uint32) ADC_MAXIMUM_VALUE + 1) << ADC_OVERSAMPLING_BITS) - 1)
+
+#else
+
+/* Resolution & maximum value of a conversion result */
+#define ADC_RESULT_BITS				10
+#define ADC_RESULT_MAXIMUM_VALUE	ADC_MAXIMUM_VALUE
+
+#endif
+
 /*******************************************************************************
  *                               Global Variables                              *
  *******************************************************************************/
@@ -54,7 +88,7 @@ typedef enum
  */
 typedef enum
 {
-	ADC_PRESCALER_2,
+	ADC_PRESCALER_2 = 1,
 	ADC_PRESCALER_4,
 	ADC_PRESCALER_8,
 	ADC_PRESCALER_16,
@@ -170,6 +204,65 @@ void ADC_setPrescaler(const ADC_ConfigType *ADCControl_Ptr);
  */
 uint16 ADC_readChannel(uint8 channelNum);
 
+#if (ADC_INTERRUPT_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: ADC_startScan
+ * [Description]	:
+ * 		Function that starts converting a list of channels in round-robin from
+ * 		the ADC interrupt, each result is placed in it's channel slot.
+ * 		Conversions are either free running or started by the chosen
+ * 		auto-trigger source, whose flag is cleared by the ADC interrupt.
+ * [Args]	:
+ * [In] channelList_Ptr	: Indicates channels to be converted (0 to 7).
+ * [In] channelsNum		: Indicates number of channels in the list.
+ * [In] trigSource		: Indicates auto-trigger source.
+ * [Return]				: Void.
+ */
+void ADC_startScan(const uint8 *channelList_Ptr, uint8 channelsNum,
+		ADC_AUTOTRIG_MODE trigSource);
+
+/*
+ * [Function Name]	: ADC_stopScan
+ * [Description]	:
+ * 		Function that stops channels scan & disables auto-trigger,
+ * 		channel slots keep their last results.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void ADC_stopScan(void);
+
+/*
+ * [Function Name]	: ADC_getChannelResult
+ * [Description]	:
+ * 		Function that reads the last conversion result of a channel from it's slot,
+ * 		the result is read again if a conversion completed while reading.
+ * 		Results range from (0) to ADC_RESULT_MAXIMUM_VALUE.
+ * [Args]	:
+ * [In] channelNum	: Indicates channel number.
+ * [Out] value_Ptr	: Holds last conversion result of the channel.
+ * [Return]			: Sequence counter of the channel, increases on every new result.
+ */
+uint8 ADC_getChannelResult(uint8 channelNum, uint16 *value_Ptr);
+
+#if (ADC_NOISE_REDUCTION_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: ADC_readChannelNoiseReduced
+ * [Description]	:
+ * 		Function that converts a channel in ADC noise reduction sleep mode, the CPU
+ * 		& I/O clocks stop during each conversion & the ADC interrupt wakes it up.
+ * 		Channels scan must be stopped before calling it.
+ * [Args]	:
+ * [In] channelNum	: Indicates channel number.
+ * [Return]			: Conversion result after oversampling.
+ */
+uint16 ADC_readChannelNoiseReduced(uint8 channelNum);
+
+#endif
+
+#endif
+
 /*
  * [Function Name]	: ADC_deInit
  * [Description]	:
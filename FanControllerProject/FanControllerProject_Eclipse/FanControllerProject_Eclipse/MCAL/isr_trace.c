@@ -0,0 +1,382 @@
+/******************************************************************************
+ * Module: ISR Trace
+ * File Name: isr_trace.c
+ * Description: Source file for interrupt latency & execution time tracer.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "isr_trace.h"					/* For ISR trace prototypes & definitions */
+
+#if (ISR_TRACE_ENABLE == TRUE)
+
+#include <avr/io.h>						/* For trace clock registers */
+#include "../common_macros.h"			/* For common macros usage */
+
+/*******************************************************************************
+ *                          ISR Trace Useful Notes                             *
+ *******************************************************************************/
+/*
+ * 		Latency = Entry - Event, Duration = Exit - Entry, both modulo
+ * 		(ISR_TRACE_CLOCK_TOP + 1) ticks.
+ *
+ * 		Latency includes the ISR prologue, duration includes the call-backs
+ * 		& excludes the epilogue. Reading the clock in an ISR uses the 16-bit
+ * 		TEMP register, so code writing 16-bit registers with global interrupt
+ * 		enabled may be corrupted while tracing.
+ *
+ * 		Mean values are kept as sums, when a count reaches it's maximum the
+ * 		count & sums are halved so the mean keeps following the vector.
+ */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: IsrTrace_SumsType
+ * [Description]	:
+ * 		A structure in which it's instance accumulates executions of a vector.
+ */
+typedef struct
+{
+	uint16 count;
+	uint16 latencyMin;
+	uint16 latencyMax;
+	uint32 latencySum;
+	uint16 durationMin;
+	uint16 durationMax;
+	uint32 durationSum;
+} IsrTrace_SumsType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Executions of each vector */
+static volatile IsrTrace_SumsType g_isrTraceSums[ISR_TRACE_VECTORS_NUM];
+/* Latest executions, written at head, full once count reaches ring size */
+static volatile IsrTrace_RecordType g_isrTraceRing[ISR_TRACE_RING_SIZE];
+static volatile uint8 g_isrTraceRingHead = 0;
+static volatile uint8 g_isrTraceRingCount = 0;
+/* Vector names in the dump */
+static const char *const g_isrTraceNames[ISR_TRACE_VECTORS_NUM] =
+{ "T1A", "T1B", "ICP", "RXC", "ADC" };
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: IsrTrace_elapsed
+ * [Description]	:
+ * 		Function that gets ticks between two clock values, the clock wraps
+ * 		once at most between them.
+ * [Args]	:
+ * [In] from	: Indicates first clock value.
+ * [In] to		: Indicates second clock value.
+ * [Return]		: Ticks from first to second value.
+ */
+static uint16 IsrTrace_elapsed(uint16 from, uint16 to);
+
+/*
+ * [Function Name]	: IsrTrace_sendString
+ * [Description]	:
+ * 		Function that sends a string through the dump function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] string			: Indicates null terminated string.
+ * [Return]				: Void.
+ */
+static void IsrTrace_sendString(void (*Ptr2SendByte)(const uint8 data),
+		const char *string);
+
+/*
+ * [Function Name]	: IsrTrace_sendDecimal
+ * [Description]	:
+ * 		Function that sends a number in decimal through the dump function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] value			: Indicates number.
+ * [Return]				: Void.
+ */
+static void IsrTrace_sendDecimal(void (*Ptr2SendByte)(const uint8 data),
+		uint16 value);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: IsrTrace_record
+ * [Description]	:
+ * 		Function that adds an ISR execution to the vector statistics & to
+ * 		the ring, called by ISR_TRACE_EXIT with global interrupt disabled.
+ * [Args]	:
+ * [In] vector		: Indicates traced vector.
+ * [In] eventTime	: Indicates clock when the interrupt was raised.
+ * [In] entryTime	: Indicates clock at ISR entry.
+ * [In] exitTime	: Indicates clock at ISR exit.
+ * [Return]			: Void.
+ */
+void IsrTrace_record(ISR_TRACE_VECTOR vector, uint16 eventTime,
+		uint16 entryTime, uint16 exitTime)
+{
+	volatile IsrTrace_SumsType *sums_Ptr = &g_isrTraceSums[vector];
+	volatile IsrTrace_RecordType *record_Ptr = &g_isrTraceRing[g_isrTraceRingHead];
+	uint16 latency = IsrTrace_elapsed(eventTime, entryTime);
+	uint16 duration = IsrTrace_elapsed(entryTime, exitTime);
+
+	if ((*sums_Ptr).count == 0)
+	{
+		(*sums_Ptr).latencyMin = latency;
+		(*sums_Ptr).latencyMax = latency;
+		(*sums_Ptr).durationMin = duration;
+		(*sums_Ptr).durationMax = duration;
+	}
+	else if ((*sums_Ptr).count == 0xFFFF)
+	{
+		/* Keep the mean with half the weight instead of overflowing */
+		(*sums_Ptr).count >>= 1;
+		(*sums_Ptr).latencySum >>= 1;
+		(*sums_Ptr).durationSum >>= 1;
+	}
+	if (latency < (*sums_Ptr).latencyMin)
+	{
+		(*sums_Ptr).latencyMin = latency;
+	}
+	if (latency > (*sums_Ptr).latencyMax)
+	{
+		(*sums_Ptr).latencyMax = latency;
+	}
+	if (duration < (*sums_Ptr).durationMin)
+	{
+		(*sums_Ptr).durationMin = duration;
+	}
+	if (duration > (*sums_Ptr).durationMax)
+	{
+		(*sums_Ptr).durationMax = duration;
+	}
+	(*sums_Ptr).latencySum += latency;
+	(*sums_Ptr).durationSum += duration;
+	(*sums_Ptr).count++;
+
+	/* Push to the ring, overwriting the oldest execution when full */
+	(*record_Ptr).vector = vector;
+	(*record_Ptr).entry = entryTime;
+	(*record_Ptr).latency = latency;
+	(*record_Ptr).duration = duration;
+	g_isrTraceRingHead = (g_isrTraceRingHead + 1) & (ISR_TRACE_RING_SIZE - 1);
+	if (g_isrTraceRingCount < ISR_TRACE_RING_SIZE)
+	{
+		g_isrTraceRingCount++;
+	}
+}
+
+/*
+ * [Function Name]	: IsrTrace_getStatistics
+ * [Description]	:
+ * 		Function that gets latency & duration statistics of a vector.
+ * [Args]	:
+ * [In] vector				: Indicates traced vector.
+ * [Out] statistics_Ptr		: Pointer to statistics to be filled.
+ * [Return]					: Void.
+ */
+void IsrTrace_getStatistics(ISR_TRACE_VECTOR vector,
+		IsrTrace_StatisticsType *statistics_Ptr)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	IsrTrace_SumsType sums;
+	/* Copy with global interrupt disabled, the ISR must not write meanwhile */
+	CLEAR_BIT(SREG, 7);
+	sums = g_isrTraceSums[vector];
+	SREG = interruptState;
+
+	(*statistics_Ptr).count = sums.count;
+	if (sums.count == 0)
+	{
+		(*statistics_Ptr).latencyMin = 0;
+		(*statistics_Ptr).latencyMean = 0;
+		(*statistics_Ptr).latencyMax = 0;
+		(*statistics_Ptr).durationMin = 0;
+		(*statistics_Ptr).durationMean = 0;
+		(*statistics_Ptr).durationMax = 0;
+	}
+	else
+	{
+		(*statistics_Ptr).latencyMin = sums.latencyMin;
+		(*statistics_Ptr).latencyMean = (uint16) (sums.latencySum / sums.count);
+		(*statistics_Ptr).latencyMax = sums.latencyMax;
+		(*statistics_Ptr).durationMin = sums.durationMin;
+		(*statistics_Ptr).durationMean = (uint16) (sums.durationSum / sums.count);
+		(*statistics_Ptr).durationMax = sums.durationMax;
+	}
+}
+
+/*
+ * [Function Name]	: IsrTrace_getRecord
+ * [Description]	:
+ * 		Function that gets an ISR execution from the ring, oldest first.
+ * [Args]	:
+ * [In] index			: Indicates record index, (0) is the oldest.
+ * [Out] record_Ptr		: Pointer to record to be filled.
+ * [Return]				: TRUE if the record exists, FALSE otherwise.
+ */
+uint8 IsrTrace_getRecord(uint8 index, IsrTrace_RecordType *record_Ptr)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	uint8 found = FALSE;
+	CLEAR_BIT(SREG, 7);
+	if (index < g_isrTraceRingCount)
+	{
+		*record_Ptr = g_isrTraceRing[(g_isrTraceRingHead - g_isrTraceRingCount
+				+ index) & (ISR_TRACE_RING_SIZE - 1)];
+		found = TRUE;
+	}
+	SREG = interruptState;
+	return found;
+}
+
+/*
+ * [Function Name]	: IsrTrace_reset
+ * [Description]	:
+ * 		Function that clears statistics & ring.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void IsrTrace_reset(void)
+{
+	uint8 interruptState = SREG; /* Global interrupt state to be restored */
+	uint8 vector = 0;
+	CLEAR_BIT(SREG, 7);
+	for (vector = 0; vector < ISR_TRACE_VECTORS_NUM; vector++)
+	{
+		g_isrTraceSums[vector].count = 0;
+		g_isrTraceSums[vector].latencySum = 0;
+		g_isrTraceSums[vector].durationSum = 0;
+	}
+	g_isrTraceRingHead = 0;
+	g_isrTraceRingCount = 0;
+	SREG = interruptState;
+}
+
+/*
+ * [Function Name]	: IsrTrace_dump
+ * [Description]	:
+ * 		Function that writes statistics of every traced vector then the ring
+ * 		as text lines, e.g. through USART_sendByte. Interrupts stay enabled
+ * 		while sending, so the ring may move on during the dump.
+ *
+ * 			T1A n=COUNT lat=MIN/MEAN/MAX dur=MIN/MEAN/MAX
+ * 			T1A @ENTRY lat=LATENCY dur=DURATION
+ *
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [Return]				: Void.
+ */
+void IsrTrace_dump(void (*Ptr2SendByte)(const uint8 data))
+{
+	IsrTrace_StatisticsType statistics;
+	IsrTrace_RecordType record;
+	uint8 index = 0;
+
+	for (index = 0; index < ISR_TRACE_VECTORS_NUM; index++)
+	{
+		IsrTrace_getStatistics(index, &statistics);
+		if (statistics.count == 0)
+		{
+			continue; /* Vector not traced in this application */
+		}
+		IsrTrace_sendString(Ptr2SendByte, g_isrTraceNames[index]);
+		IsrTrace_sendString(Ptr2SendByte, " n=");
+		IsrTrace_sendDecimal(Ptr2SendByte, statistics.count);
+		IsrTrace_sendString(Ptr2SendByte, " lat=");
+		IsrTrace_sendDecimal(Ptr2SendByte, statistics.latencyMin);
+		(*Ptr2SendByte)('/');
+		IsrTrace_sendDecimal(Ptr2SendByte, statistics.latencyMean);
+		(*Ptr2SendByte)('/');
+		IsrTrace_sendDecimal(Ptr2SendByte, statistics.latencyMax);
+		IsrTrace_sendString(Ptr2SendByte, " dur=");
+		IsrTrace_sendDecimal(Ptr2SendByte, statistics.durationMin);
+		(*Ptr2SendByte)('/');
+		IsrTrace_sendDecimal(Ptr2SendByte, statistics.durationMean);
+		(*Ptr2SendByte)('/');
+		IsrTrace_sendDecimal(Ptr2SendByte, statistics.durationMax);
+		IsrTrace_sendString(Ptr2SendByte, "\r\n");
+	}
+
+	for (index = 0; IsrTrace_getRecord(index, &record) == TRUE; index++)
+	{
+		IsrTrace_sendString(Ptr2SendByte, g_isrTraceNames[record.vector]);
+		IsrTrace_sendString(Ptr2SendByte, " @");
+		IsrTrace_sendDecimal(Ptr2SendByte, record.entry);
+		IsrTrace_sendString(Ptr2SendByte, " lat=");
+		IsrTrace_sendDecimal(Ptr2SendByte, record.latency);
+		IsrTrace_sendString(Ptr2SendByte, " dur=");
+		IsrTrace_sendDecimal(Ptr2SendByte, record.duration);
+		IsrTrace_sendString(Ptr2SendByte, "\r\n");
+	}
+}
+
+/*
+ * [Function Name]	: IsrTrace_elapsed
+ * [Description]	:
+ * 		Function that gets ticks between two clock values, the clock wraps
+ * 		once at most between them.
+ * [Args]	:
+ * [In] from	: Indicates first clock value.
+ * [In] to		: Indicates second clock value.
+ * [Return]		: Ticks from first to second value.
+ */
+static uint16 IsrTrace_elapsed(uint16 from, uint16 to)
+{
+	if (to >= from)
+	{
+		return to - from;
+	}
+	/* Wrapped at top, 16-bit arithmetic also covers a (0xFFFF) top */
+	return (uint16) (to - from + ISR_TRACE_CLOCK_TOP + 1);
+}
+
+/*
+ * [Function Name]	: IsrTrace_sendString
+ * [Description]	:
+ * 		Function that sends a string through the dump function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] string			: Indicates null terminated string.
+ * [Return]				: Void.
+ */
+static void IsrTrace_sendString(void (*Ptr2SendByte)(const uint8 data),
+		const char *string)
+{
+	while (*string != '\0')
+	{
+		(*Ptr2SendByte)((uint8) *string);
+		string++;
+	}
+}
+
+/*
+ * [Function Name]	: IsrTrace_sendDecimal
+ * [Description]	:
+ * 		Function that sends a number in decimal through the dump function.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [In] value			: Indicates number.
+ * [Return]				: Void.
+ */
+static void IsrTrace_sendDecimal(void (*Ptr2SendByte)(const uint8 data),
+		uint16 value)
+{
+	char digits[5]; /* Largest 16-bit number has 5 digits */
+	uint8 digitsNum = 0;
+	do
+	{
+		digits[digitsNum] = (char) ('0' + (value % 10));
+		digitsNum++;
+		value /= 10;
+	} while (value != 0);
+	while (digitsNum > 0)
+	{
+		digitsNum--;
+		(*Ptr2SendByte)((uint8) digits[digitsNum]);
+	}
+}
+
+#endif
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Module: Profiler
+ * File Name: profiler.h
+ * Description: Header file for CPU load meter & tasks profiler.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+#include "timer.h"				/* For timer2 used as profiler clock */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Enable profiling, when disabled the profiler leaves no code or RAM in the image */
+#define PROFILER_ENABLE					FALSE
+
+#if (PROFILER_ENABLE == TRUE)
+
+#if (TIMER2_ENABLE == FALSE)
+
+#error "Profiler counts time with timer2, set TIMER2_ENABLE in timer.h"
+
+#endif
+
+/* Application tasks profiled, identifiers from (0) to (PROFILER_TASKS_NUM - 1) */
+#define PROFILER_TASKS_NUM				2
+/* Tasks started inside other tasks, e.g. an ISR call-back inside a main loop task */
+#define PROFILER_NESTING_MAX			4
+/*
+ * Profiler clock, timer2 overflows every (256) ticks & the overflow ISR must
+ * not be delayed more than that. (64) cycles per tick overflow every (16) ms
+ * at (1) MHz.
+ */
+#define PROFILER_PRESCALER				TIMER2_PRESCALER_64
+#define PROFILER_CYCLES_PER_TICK		64
+/* CPU load is measured over windows of timer2 overflows, about (0.5) second */
+#define PROFILER_WINDOW_OVERFLOWS		32
+
+#endif
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Profiler_TaskType
+ * [Description]	:
+ * 		A structure in which it's instance holds the number of executions of
+ * 		a task & the CPU cycles spent in them, both wrap around.
+ */
+typedef struct
+{
+	uint16 calls;
+	uint32 cycles;
+} Profiler_TaskType;
+
+/*******************************************************************************
+ *                                Macros                                       *
+ *******************************************************************************/
+/*
+ * Task markers, time between PROFILER_TASK_START & PROFILER_TASK_STOP is
+ * charged to the task, except the time of tasks started inside it. They
+ * expand to nothing when profiling is disabled.
+ */
+#if (PROFILER_ENABLE == TRUE)
+
+#define PROFILER_TASK_START(task)		Profiler_taskStart(task)
+#define PROFILER_TASK_STOP()			Profiler_taskStop()
+#define PROFILER_IDLE_START()			Profiler_taskStart(PROFILER_TASKS_NUM)
+#define PROFILER_IDLE_STOP()			Profiler_taskStop()
+
+#else
+
+#define PROFILER_TASK_START(task)
+#define PROFILER_TASK_STOP()
+#define PROFILER_IDLE_START()
+#define PROFILER_IDLE_STOP()
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+#if (PROFILER_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: Profiler_init
+ * [Description]	:
+ * 		Function that starts timer2 as profiler clock & clears the counters.
+ * 		Timer2 overflows wake the CPU, so it registers timer2 as a wake-up
+ * 		source, call it after Power_init.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Profiler_init(void);
+
+/*
+ * [Function Name]	: Profiler_taskStart
+ * [Description]	:
+ * 		Function that charges time from now on to a task until it stops.
+ * [Args]	:
+ * [In] task	: Indicates task identifier, (PROFILER_TASKS_NUM) is idle time.
+ * [Return]		: Void.
+ */
+void Profiler_taskStart(uint8 task);
+
+/*
+ * [Function Name]	: Profiler_taskStop
+ * [Description]	:
+ * 		Function that charges time from now on to the task that was running
+ * 		when the current one started.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Profiler_taskStop(void);
+
+/*
+ * [Function Name]	: Profiler_getLoad
+ * [Description]	:
+ * 		Function that gets CPU load of the last window, the time not spent
+ * 		sleeping in Power_sleep.
+ * [Args]		: Void.
+ * [Return]		: CPU load percentage.
+ */
+uint8 Profiler_getLoad(void);
+
+/*
+ * [Function Name]	: Profiler_getTask
+ * [Description]	:
+ * 		Function that gets executions & CPU cycles of a task.
+ * [Args]	:
+ * [In] task			: Indicates task identifier.
+ * [Out] task_Ptr		: Pointer to task counters to be filled.
+ * [Return]				: Void.
+ */
+void Profiler_getTask(uint8 task, Profiler_TaskType *task_Ptr);
+
+/*
+ * [Function Name]	: Profiler_reset
+ * [Description]	:
+ * 		Function that clears tasks counters.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Profiler_reset(void);
+
+/*
+ * [Function Name]	: Profiler_writeLoad
+ * [Description]	:
+ * 		Function that writes CPU load as "CPU 12%", short enough for an LCD
+ * 		row, e.g. through LCD_displayCharacter.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [Return]				: Void.
+ */
+void Profiler_writeLoad(void (*Ptr2SendByte)(const uint8 data));
+
+/*
+ * [Function Name]	: Profiler_dump
+ * [Description]	:
+ * 		Function that writes a status page, CPU load then a line for each
+ * 		task, e.g. through USART_sendByte.
+ * [Args]	:
+ * [In] Ptr2SendByte	: Indicates function sending one byte.
+ * [Return]				: Void.
+ */
+void Profiler_dump(void (*Ptr2SendByte)(const uint8 data));
+
+#endif
+
+#endif /* PROFILER_H_ */
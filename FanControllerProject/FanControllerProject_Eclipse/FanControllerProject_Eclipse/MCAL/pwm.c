@@ -0,0 +1,345 @@
+/******************************************************************************
+ * Module: PWM
+ * File Name: pwm.c
+ * Description: Source file for timer0/timer1 PWM driver.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <avr/interrupt.h>				/* For ISR of PWM period */
+#include <avr/io.h>						/* For timers registers usage */
+#include "../common_macros.h"			/* For common macros usage */
+#include "../MCAL/gpio.h"				/* For PWM output pin */
+#include "../MCAL/timer.h"				/* For checking timers used by timer driver */
+#include "pwm.h"						/* For PWM prototypes & definitions */
+
+#if (PWM_TIMER == PWM_TIMER0) && (TIMER0_ENABLE == TRUE)
+
+#error "Timer0 is used by PWM driver, disable it in timer driver"
+
+#elif (PWM_TIMER == PWM_TIMER1) && (TIMER1_ENABLE == TRUE)
+
+#error "Timer1 is used by PWM driver, disable it in timer driver"
+
+#endif
+
+/*******************************************************************************
+ *                            PWM Hardware Registers                           *
+ *******************************************************************************/
+/*
+ * TCCR0 register bits description:
+ *
+ * 		WGM01:00 = (11) Fast PWM, TOP = 0xFF.
+ * 				   (01) Phase correct PWM, TOP = 0xFF.
+ *
+ * 		COM01:00 = (00) OC0 disconnected, pin is driven by PORTB.
+ * 				   (10) Non-inverting, clear OC0 on compare match (up-counting).
+ *
+ * 		CS02:00	 = (000) No clock source (timer stopped).
+ * 				   (xxx) Pre-scaler as PWM_PRESCALER.
+ *
+ * TCCR1A/TCCR1B registers bits description:
+ *
+ * 		WGM13:10 = (1110) Fast PWM, TOP = ICR1.
+ * 				   (1010) Phase correct PWM, TOP = ICR1.
+ *
+ * 		COM1A1:0 = (00) OC1A disconnected, pin is driven by PORTD.
+ * 				   (10) Non-inverting, clear OC1A on compare match (up-counting).
+ *
+ * 		CS12:10	 = Same as CS02:00.
+ *
+ * TIMSK register bits description:
+ *
+ * 		TOIE0/TOIE1 = (1) Interrupt enable on timer overflow, once every PWM period.
+ *
+ * OCR0/OCR1A registers description:
+ *
+ * 		In PWM modes compare registers are double buffered, a written value is
+ * 		copied to the compare register at TOP only, so a new duty-cycle never
+ * 		cuts a period.
+ */
+
+#if (PWM_INTERRUPT_ENABLE == TRUE)
+
+/*******************************************************************************
+ *                            Global Pointers                                  *
+ *******************************************************************************/
+/* Pointer that holds the address of the call-back function */
+static volatile void (*g_PWMCallBack_Ptr)(void) = NULL_PTR;
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+/*
+ * [Interrupt Vector]	: TIMER0_OVF_vect
+ * [Description]		:
+ * 		An interrupt that acts once every PWM period.
+ */
+ISR(TIMER0_OVF_vect)
+
+#else
+
+/*
+ * [Interrupt Vector]	: TIMER1_OVF_vect
+ * [Description]		:
+ * 		An interrupt that acts once every PWM period.
+ */
+ISR(TIMER1_OVF_vect)
+
+#endif
+
+{
+	if (g_PWMCallBack_Ptr != NULL_PTR) /* If callback function pointer is not void */
+	{
+		(*g_PWMCallBack_Ptr)(); /* Execute callback function */
+	}
+}
+
+#endif
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: PWM_init
+ * [Description]	:
+ * 		Function that initialize chosen timer in chosen PWM mode, the output is
+ * 		left disabled with zero duty-cycle until PWM_enable is called.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_init(void)
+{
+	/* Set PWM pin as output driven (LOGIC LOW) while disconnected */
+	GPIO_setupPinDirection(PWM_PORT_ID, PWM_PIN_ID, PIN_OUTPUT);
+	GPIO_writePin(PWM_PORT_ID, PWM_PIN_ID, LOGIC_LOW);
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+	/* Chosen PWM mode, OC0 disconnected & timer stopped */
+
+#if (PWM_PHASE_CORRECT == TRUE)
+
+	TCCR0 = (1 << WGM00);
+
+#else
+
+	TCCR0 = (1 << WGM01) | (1 << WGM00);
+
+#endif
+
+	TCNT0 = 0;
+	OCR0 = 0;
+
+#else
+
+	/* Chosen PWM mode with TOP in ICR1, OC1A disconnected & timer stopped */
+	TCCR1A = (1 << WGM11);
+
+#if (PWM_PHASE_CORRECT == TRUE)
+
+	TCCR1B = (1 << WGM13);
+
+#else
+
+	TCCR1B = (1 << WGM13) | (1 << WGM12);
+
+#endif
+
+	TCNT1 = 0;
+	ICR1 = PWM_TOP;
+	OCR1A = 0;
+
+#endif
+
+}
+
+/*
+ * [Function Name]	: PWM_setDuty
+ * [Description]	:
+ * 		Function that changes duty-cycle without stopping or restarting the timer,
+ * 		the new value takes effect at the next PWM period.
+ * [Args]	:
+ * [In] duty	: Indicates duty-cycle out of (255), scaled to (PWM_TOP).
+ * [Return]		: Void.
+ */
+void PWM_setDuty(uint8 duty)
+{
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+	/* Double buffered by hardware, updated at TOP */
+	OCR0 = duty;
+
+#else
+
+	/* Scale to TOP, full duty-cycle maps to TOP exactly */
+	if (duty == 0xFF)
+	{
+		OCR1A = PWM_TOP;
+	}
+	else
+	{
+		OCR1A = (uint16) (((uint32) duty * (PWM_TOP + 1UL)) >> 8);
+	}
+
+#endif
+
+}
+
+/*
+ * [Function Name]	: PWM_setCompareValue
+ * [Description]	:
+ * 		Function that changes duty-cycle in full timer resolution, the new value
+ * 		takes effect at the next PWM period.
+ * [Args]	:
+ * [In] compareValue	: Indicates duty-cycle out of (PWM_TOP), limited to (PWM_TOP).
+ * [Return]				: Void.
+ */
+void PWM_setCompareValue(uint16 compareValue)
+{
+	if (compareValue > PWM_TOP)
+	{
+		compareValue = PWM_TOP;
+	}
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+	OCR0 = (uint8) compareValue;
+
+#else
+
+	OCR1A = compareValue;
+
+#endif
+
+}
+
+/*
+ * [Function Name]	: PWM_enable
+ * [Description]	:
+ * 		Function that connects PWM output pin & starts the timer if stopped.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_enable(void)
+{
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+	/* Non-inverting output */
+	SET_BIT(TCCR0, COM01);
+	/* Start timer only if stopped, a running timer is never restarted */
+	if ((TCCR0 & 0x07) == PWM_NO_CLOCK)
+	{
+		OVERWRITE_REG(TCCR0, 0xF8, PWM_CLOCK_PRESCALER);
+	}
+
+#else
+
+	/* Non-inverting output */
+	SET_BIT(TCCR1A, COM1A1);
+	/* Start timer only if stopped, a running timer is never restarted */
+	if ((TCCR1B & 0x07) == PWM_NO_CLOCK)
+	{
+		OVERWRITE_REG(TCCR1B, 0xF8, PWM_CLOCK_PRESCALER);
+	}
+
+#endif
+
+}
+
+/*
+ * [Function Name]	: PWM_disable
+ * [Description]	:
+ * 		Function that disconnects PWM output pin leaving it (LOGIC LOW) & stops the timer.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_disable(void)
+{
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+	/* Disconnect OC0, pin returns to it's PORTB value (LOGIC LOW) */
+	CLEAR_BIT(TCCR0, COM01);
+	/* Stop timer */
+	OVERWRITE_REG(TCCR0, 0xF8, PWM_NO_CLOCK);
+
+#else
+
+	/* Disconnect OC1A, pin returns to it's PORTD value (LOGIC LOW) */
+	CLEAR_BIT(TCCR1A, COM1A1);
+	/* Stop timer */
+	OVERWRITE_REG(TCCR1B, 0xF8, PWM_NO_CLOCK);
+
+#endif
+
+}
+
+#if (PWM_INTERRUPT_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: PWM_setCallBack
+ * [Description]	:
+ * 		Function that sets the call-back function address executed once every
+ * 		PWM period for the upper layer.
+ * [Args]	:
+ * [In] Ptr2Function	: Indicates call-back function address.
+ * [Return]				: Void.
+ */
+void PWM_setCallBack(void (*Ptr2Function)(void))
+{
+	g_PWMCallBack_Ptr = Ptr2Function;
+}
+
+/*
+ * [Function Name]	: PWM_enableInterrupt
+ * [Description]	:
+ * 		Function that enables PWM period interrupt after clearing it's flag.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_enableInterrupt(void)
+{
+	/* Flag is cleared by writing (LOGIC HIGH), write only the required flag */
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+	TIFR = (1 << TOV0);
+	SET_BIT(TIMSK, TOIE0);
+
+#else
+
+	TIFR = (1 << TOV1);
+	SET_BIT(TIMSK, TOIE1);
+
+#endif
+
+}
+
+/*
+ * [Function Name]	: PWM_disableInterrupt
+ * [Description]	:
+ * 		Function that disables PWM period interrupt.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_disableInterrupt(void)
+{
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+	CLEAR_BIT(TIMSK, TOIE0);
+
+#else
+
+	CLEAR_BIT(TIMSK, TOIE1);
+
+#endif
+
+}
+
+#endif
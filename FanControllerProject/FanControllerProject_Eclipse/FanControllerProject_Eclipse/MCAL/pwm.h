@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Module: PWM
+ * File Name: pwm.h
+ * Description: Header file for timer0/timer1 PWM driver.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef PWM_H_
+#define PWM_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Enumerate Name]	: PWM_PRESCALER
+ * [Description]	:
+ * 		An enumerate that defines PWM timer clock pre-scaler.
+ */
+typedef enum
+{
+	PWM_NO_CLOCK,
+	PWM_PRESCALER_1,
+	PWM_PRESCALER_8,
+	PWM_PRESCALER_64,
+	PWM_PRESCALER_256,
+	PWM_PRESCALER_1024
+} PWM_PRESCALER;
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* PWM timers IDs */
+#define PWM_TIMER0				0
+#define PWM_TIMER1				1
+
+/*
+ * PWM configurations:
+ * 		PWM_TIMER0: 8-bit resolution on OC0 (PB3).
+ * 			Fast PWM frequency			= F_CPU / (Pre-scaler * 256)
+ * 			Phase correct frequency		= F_CPU / (Pre-scaler * 510)
+ * 		PWM_TIMER1: TOP is held in ICR1 on OC1A (PD5), so frequency & resolution
+ * 		are chosen together by (PWM_TIMER1_FREQUENCY).
+ * 			Fast PWM TOP				= F_CPU / (Pre-scaler * Frequency) - 1
+ * 			Phase correct TOP			= F_CPU / (Pre-scaler * Frequency * 2)
+ * 			Resolution					= log2(TOP + 1) bits
+ * 			Example: (1) MHz, pre-scaler (1), (4) KHz phase correct -> TOP = 125 (~7 bits, rejected),
+ * 					 (8) MHz, pre-scaler (1), (4) KHz phase correct -> TOP = 1000 (~10 bits).
+ * 		Phase correct PWM runs at half the frequency of fast PWM for the same TOP,
+ * 		but it's pulses are centered in the period which gives smoother motor current.
+ * 		The chosen timer must be disabled in the timer driver. The pre-scaler is
+ * 		given as it's division (1, 8, 64, 256 or 1024), so TOP is checked here.
+ */
+#define PWM_TIMER				PWM_TIMER0
+#define PWM_PHASE_CORRECT		FALSE
+#define PWM_CLOCK_DIVISION		8UL
+#define PWM_TIMER1_FREQUENCY	4000UL
+
+/* Enable PWM period (overflow) interrupt call-back, disable if never used to decrease code size */
+#define PWM_INTERRUPT_ENABLE	TRUE
+
+#if (PWM_CLOCK_DIVISION == 1)
+#define PWM_CLOCK_PRESCALER		PWM_PRESCALER_1
+#elif (PWM_CLOCK_DIVISION == 8)
+#define PWM_CLOCK_PRESCALER		PWM_PRESCALER_8
+#elif (PWM_CLOCK_DIVISION == 64)
+#define PWM_CLOCK_PRESCALER		PWM_PRESCALER_64
+#elif (PWM_CLOCK_DIVISION == 256)
+#define PWM_CLOCK_PRESCALER		PWM_PRESCALER_256
+#elif (PWM_CLOCK_DIVISION == 1024)
+#define PWM_CLOCK_PRESCALER		PWM_PRESCALER_1024
+#else
+
+#error "PWM_CLOCK_DIVISION should be 1, 8, 64, 256 or 1024"
+
+#endif
+
+#if (PWM_TIMER == PWM_TIMER0)
+
+/* Compare value at full duty-cycle */
+#define PWM_TOP					255UL
+
+#if (PWM_PHASE_CORRECT == TRUE)
+
+#define PWM_FREQUENCY			(F_CPU / (PWM_CLOCK_DIVISION * 510UL))
+
+#else
+
+#define PWM_FREQUENCY			(F_CPU / (PWM_CLOCK_DIVISION * 256UL))
+
+#endif
+
+/* PWM hardware port & pin IDs (OC0) */
+#define PWM_PORT_ID				PORTB_ID
+#define PWM_PIN_ID				PIN3_ID
+
+#elif (PWM_TIMER == PWM_TIMER1)
+
+#if (PWM_PHASE_CORRECT == TRUE)
+
+/* Compare value at full duty-cycle */
+#define PWM_TOP					\
+	(F_CPU / (PWM_CLOCK_DIVISION * PWM_TIMER1_FREQUENCY * 2UL))
+#define PWM_FREQUENCY			(F_CPU / (PWM_CLOCK_DIVISION * PWM_TOP * 2UL))
+
+#else
+
+/* Compare value at full duty-cycle */
+#define PWM_TOP					\
+	(F_CPU / (PWM_CLOCK_DIVISION * PWM_TIMER1_FREQUENCY) - 1UL)
+#define PWM_FREQUENCY			(F_CPU / (PWM_CLOCK_DIVISION * (PWM_TOP + 1UL)))
+
+#endif
+
+#if (PWM_TOP > 0xFFFF) || (PWM_TOP < 255)
+
+#error "Timer1 PWM TOP should fit ICR1 & give 8 bits of duty, change PWM_TIMER1_FREQUENCY or PWM_CLOCK_DIVISION"
+
+#endif
+
+/* PWM hardware port & pin IDs (OC1A) */
+#define PWM_PORT_ID				PORTD_ID
+#define PWM_PIN_ID				PIN5_ID
+
+#else
+
+#error "PWM timer should be PWM_TIMER0 or PWM_TIMER1"
+
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: PWM_init
+ * [Description]	:
+ * 		Function that initialize chosen timer in chosen PWM mode, the output is
+ * 		left disabled with zero duty-cycle until PWM_enable is called.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_init(void);
+
+/*
+ * [Function Name]	: PWM_setDuty
+ * [Description]	:
+ * 		Function that changes duty-cycle without stopping or restarting the timer,
+ * 		the new value takes effect at the next PWM period.
+ * [Args]	:
+ * [In] duty	: Indicates duty-cycle out of (255), scaled to (PWM_TOP).
+ * [Return]		: Void.
+ */
+void PWM_setDuty(uint8 duty);
+
+/*
+ * [Function Name]	: PWM_setCompareValue
+ * [Description]	:
+ * 		Function that changes duty-cycle in full timer resolution, the new value
+ * 		takes effect at the next PWM period.
+ * [Args]	:
+ * [In] compareValue	: Indicates duty-cycle out of (PWM_TOP), limited to (PWM_TOP).
+ * [Return]				: Void.
+ */
+void PWM_setCompareValue(uint16 compareValue);
+
+/*
+ * [Function Name]	: PWM_enable
+ * [Description]	:
+ * 		Function that connects PWM output pin & starts the timer if stopped.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_enable(void);
+
+/*
+ * [Function Name]	: PWM_disable
+ * [Description]	:
+ * 		Function that disconnects PWM output pin leaving it (LOGIC LOW) & stops the timer.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_disable(void);
+
+#if (PWM_INTERRUPT_ENABLE == TRUE)
+
+/*
+ * [Function Name]	: PWM_setCallBack
+ * [Description]	:
+ * 		Function that sets the call-back function address executed once every
+ * 		PWM period for the upper layer.
+ * [Args]	:
+ * [In] Ptr2Function	: Indicates call-back function address.
+ * [Return]				: Void.
+ */
+void PWM_setCallBack(void (*Ptr2Function)(void));
+
+/*
+ * [Function Name]	: PWM_enableInterrupt
+ * [Description]	:
+ * 		Function that enables PWM period interrupt after clearing it's flag.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_enableInterrupt(void);
+
+/*
+ * [Function Name]	: PWM_disableInterrupt
+ * [Description]	:
+ * 		Function that disables PWM period interrupt.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void PWM_disableInterrupt(void);
+
+#endif
+
+#endif /* PWM_H_ */
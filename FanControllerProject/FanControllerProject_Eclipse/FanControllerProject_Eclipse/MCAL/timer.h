@@ -14,8 +14,8 @@
  *                                Definitions                                  *
  *******************************************************************************/
 /* Choose timers to enable, disable never used timers to decrease code size */
-#define TIMER0_ENABLE			TRUE
-#define TIMER1_ENABLE			FALSE
+#define TIMER0_ENABLE			FALSE
+#define TIMER1_ENABLE			TRUE
 #define TIMER2_ENABLE			FALSE
 
 /*******************************************************************************
@@ -0,0 +1,182 @@
+################################################################################
+# Module: Host Simulation
+# File Name: avr.sh
+# Description: AVR build options & stack depth functions, sourced by stack.sh
+# 		& bench.sh.
+# Author: Mohamed Badr
+################################################################################
+
+AVR_OPT=${AVR_OPT:--O0}
+# Same options as the AVR Debug configurations
+AVR_FLAGS="$AVR_OPT -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32"
+# ATmega32 SRAM size in bytes
+SRAM_SIZE=2048
+
+# Frames of the compiled objects: "NAME BYTES" lines of the .su files
+avr_frames()
+{
+	# .su lines are "file:line:column:function<TAB>bytes<TAB>qualifier"
+	cat "$@" | awk -F '\t' '{ n = split($1, f, ":"); print f[n], $2 }' | LC_ALL=C sort
+}
+
+# Call graph of the objects: "call CALLER CALLEE", "indirect CALLER" for
+# icall & "address FUNCTION" for functions whose address is taken
+avr_calls()
+{
+	for object in "$@"; do
+		avr-objdump -dr "$object"
+	done | awk '
+		# Function sections are disassembled one by one, "00000000 <name>:"
+		/^[0-9a-f]+ <[^>]+>:$/ {
+			current = $2
+			gsub(/[<>:]/, "", current)
+			next
+		}
+		# Calls & jumps to other sections are relocated, local jumps are not
+		$2 ~ /^R_AVR_(CALL|13_PCREL)$/ {
+			target = $3
+			sub(/^\.text\./, "", target)
+			sub(/\+.*$/, "", target)
+			if (target != current) {
+				print "call", current, target
+			}
+			next
+		}
+		# Function pointers, e.g. call-backs passed to the drivers
+		$2 ~ /^R_AVR_(LO8_LDI_GS|LO8_LDI_PM|16_PM)$/ {
+			target = $3
+			sub(/^\.text\./, "", target)
+			sub(/\+.*$/, "", target)
+			print "address", target
+			next
+		}
+		$0 ~ /\t(e?icall|e?ijmp)/ {
+			print "indirect", current
+		}
+	' | LC_ALL=C sort -u
+}
+
+# Deepest chain from main & each ISR, "FRAMES" holds "NAME BYTES" lines,
+# "CALLS" the call graph & "STATIC" the static variables bytes. With
+# "STATIC" given as depths, prints "NAME BYTES" of the deepest chain from
+# every function instead
+stack_chains()
+{
+	awk -v sram="$SRAM_SIZE" -v static="$3" '
+		BEGIN {
+			split("INT0 INT1 INT2 TIMER2_COMP TIMER2_OVF TIMER1_CAPT TIMER1_COMPA " \
+				"TIMER1_COMPB TIMER1_OVF TIMER0_COMP TIMER0_OVF SPI_STC USART_RXC " \
+				"USART_UDRE USART_TXC ADC EE_RDY ANA_COMP TWI SPM_RDY", vectors, " ")
+		}
+		FNR == NR {
+			frame[$1] = $2
+			next
+		}
+		$1 == "call" { calls[$2] = calls[$2] " " $3 }
+		$1 == "indirect" { indirect[$2] = 1 }
+		$1 == "address" { pointers = pointers " " $2 }
+
+		function name(f,    n)
+		{
+			if (f ~ /^__vector_[0-9]+$/) {
+				n = substr(f, 10) + 0
+				return vectors[n] "_vect"
+			}
+			return f
+		}
+
+		# Bytes of the deepest chain from f, the .su frame includes the
+		# return address & saved registers, library functions written in
+		# assembly have no .su & are charged their return address
+		function depth(f,    own, n, i, list, callees, callee, d, best, bestCallee)
+		{
+			if (f in memo) {
+				return memo[f]
+			}
+			if (f in visiting) {
+				recursive = recursive " " name(f)
+				return 0
+			}
+			visiting[f] = 1
+			own = (f in frame) ? frame[f] : 2
+			if (!(f in frame)) {
+				library[f] = 1
+			}
+			best = 0
+			bestCallee = ""
+			list = calls[f]
+			if (f in indirect) {
+				list = list pointers
+			}
+			n = split(list, callees, " ")
+			for (i = 1; i <= n; i++) {
+				callee = callees[i]
+				d = depth(callee)
+				if (d > best) {
+					best = d
+					bestCallee = callee
+				}
+			}
+			delete visiting[f]
+			memo[f] = own + best
+			deepest[f] = bestCallee
+			return memo[f]
+		}
+
+		function chain(f,    text)
+		{
+			text = ""
+			while (f != "") {
+				text = text (text == "" ? "" : " > ") name(f) ((f in indirect) ? "*" : "") \
+					"(" ((f in frame) ? frame[f] : "2?") ")"
+				f = deepest[f]
+			}
+			return text
+		}
+
+		END {
+			if (static == "depths") {
+				for (f in frame) {
+					print name(f), depth(f)
+				}
+				exit
+			}
+			printf "%-20s %6s  %s\n", "ROOT", "BYTES", "DEEPEST CHAIN (FRAME BYTES)"
+			mainDepth = depth("main")
+			printf "%-20s %6d  %s\n", "main", mainDepth, chain("main")
+			isrDepth = 0
+			for (n = 1; n in vectors; n++) {
+				f = "__vector_" n
+				if (!(f in frame)) {
+					continue
+				}
+				d = depth(f)
+				printf "%-20s %6d  %s\n", name(f), d, chain(f)
+				if (d > isrDepth) {
+					isrDepth = d
+					isr = name(f)
+				}
+			}
+			print ""
+			# ISRs run with global interrupt disabled, one ISR at most nests in main
+			printf "worst case stack %d bytes (main %d + %s %d)\n", mainDepth + isrDepth,
+				mainDepth, (isr == "" ? "no ISR" : isr), isrDepth
+			if (static != "") {
+				printf "static variables %d bytes, never used %d of %d bytes SRAM\n", static,
+					sram - static - mainDepth - isrDepth, sram
+			}
+			if (pointers != "") {
+				print "* indirect calls are taken as calling the deepest of:" pointers
+			}
+			for (f in library) {
+				libraries = libraries " " f
+			}
+			if (libraries != "") {
+				print "2? no .su, return address only:" libraries
+			}
+			if (recursive != "") {
+				print "recursion not followed:" recursive
+			}
+		}
+	' "$1" "$2"
+}
@@ -0,0 +1,115 @@
+#!/bin/sh
+################################################################################
+# Module: Host Simulation
+# File Name: bench.sh
+# Description: Runs the drivers benchmarks & writes one report for all of them.
+# Author: Mohamed Badr
+#
+# Usage: HostSimulation/bench.sh [IMAGE ...]
+# 		IMAGE is one of: fan distance door_hmi door_control, all of them by
+# 		default. The report is written to HostSimulation/build/bench_report.jsonl,
+# 		one JSON object per operation. When avr-gcc is installed the drivers
+# 		are also compiled for the ATmega32 to fill flash (function size in
+# 		bytes) & stack (deepest call chain from the function in bytes, like
+# 		stack.sh), AVR_OPT selects the optimization level, -O0 like the Debug
+# 		builds. When simavr is installed too, the benchmark itself is built
+# 		for the ATmega32 & run on simavr to fill cpu_cycles, SIMAVR_CFLAGS &
+# 		SIMAVR_LIBS override the simavr library options found by pkg-config.
+################################################################################
+
+set -e
+
+SIM_DIR=$(cd "$(dirname "$0")" && pwd)
+REPO_DIR=$(dirname "$SIM_DIR")
+BUILD_DIR="$SIM_DIR/build"
+REPORT="$BUILD_DIR/bench_report.jsonl"
+
+. "$SIM_DIR/images.sh"
+. "$SIM_DIR/avr.sh"
+
+# Function size & deepest call chain of an AVR build: one "NAME FLASH STACK"
+# line per function
+avr_sizes()
+{
+	project=$1
+	fcpu=$2
+	out=$3
+	rm -rf "$out"
+	mkdir -p "$out"
+	find "$project" -name '*.c' -not -path '*/Debug/*' -not -path '*/APP/*' | while read -r source; do
+		object="$out/$(echo "${source#$project/}" | tr '/' '_' | sed 's/\.c$//').o"
+		avr-gcc $AVR_FLAGS -DF_CPU=$fcpu -fstack-usage -c "$source" -o "$object"
+	done
+	avr_frames "$out"/*.su > "$out/frames.txt"
+	avr_calls "$out"/*.o > "$out/calls.txt"
+	stack_chains "$out/frames.txt" "$out/calls.txt" depths | LC_ALL=C sort > "$out/stack.txt"
+	avr-nm --size-sort --radix=d -S "$out"/*.o | awk '$3 ~ /^[tT]$/ { print $4, $2 + 0 }' \
+		| LC_ALL=C sort > "$out/flash.txt"
+	LC_ALL=C join -a 1 -e null -o 0,1.2,2.2 "$out/flash.txt" "$out/stack.txt"
+}
+
+# CPU cycles of the benchmark on simavr, linked with the drivers objects of
+# avr_sizes: one "MIN MEAN MAX" line per operation, in the report order
+avr_cycles()
+{
+	project=$1
+	fcpu=$2
+	board=$3
+	out=$4
+	for source in "$SIM_DIR/bench/bench_avr.c" "$SIM_DIR/bench/$(echo "$board" | sed 's/^board_/bench_/')"; do
+		avr-gcc $AVR_FLAGS -DF_CPU=$fcpu -DBENCH_SIMAVR -I "$SIM_DIR/bench" -I "$project" \
+			-I "$project/HAL" -I "$project/MCAL" -I "$project/LIB" \
+			-c "$source" -o "$out/$(basename "$source" .c).bench.o"
+	done
+	avr-gcc -mmcu=atmega32 -Wl,--gc-sections -o "$out/bench.elf" "$out"/*.o
+	# An operation waiting for a board model stops the run, later ones stay null
+	"$BUILD_DIR/bench_simavr" "$out/bench.elf" "${fcpu%UL}" || true
+}
+
+mkdir -p "$BUILD_DIR"
+simavr=""
+if command -v avr-gcc > /dev/null 2>&1 && command -v simavr > /dev/null 2>&1; then
+	SIMAVR_CFLAGS=${SIMAVR_CFLAGS:-$(pkg-config --cflags simavr 2> /dev/null || echo "-I/usr/include/simavr")}
+	SIMAVR_LIBS=${SIMAVR_LIBS:-$(pkg-config --libs simavr 2> /dev/null || echo "-lsimavr") -lelf}
+	cc -std=gnu99 -O2 $SIMAVR_CFLAGS -o "$BUILD_DIR/bench_simavr" "$SIM_DIR/bench/bench_simavr.c" \
+		$SIMAVR_LIBS
+	simavr=yes
+fi
+if [ $# -eq 0 ]; then
+	set -- fan distance door_hmi door_control
+fi
+: > "$REPORT"
+for image in "$@"; do
+	"$SIM_DIR/build.sh" "bench_$image"
+	SIM_BENCH_REPORT="$BUILD_DIR/bench_$image.jsonl" "$BUILD_DIR/bench_$image" > "$BUILD_DIR/bench_$image.log"
+	if command -v avr-gcc > /dev/null 2>&1; then
+		info=$(image_info "$image")
+		project="$REPO_DIR/$(echo "$info" | cut -d ' ' -f 1)"
+		fcpu=$(echo "$info" | cut -d ' ' -f 2)
+		avr_sizes "$project" "$fcpu" "$BUILD_DIR/bench_$image.avr" > "$BUILD_DIR/bench_$image.sizes"
+		: > "$BUILD_DIR/bench_$image.cycles"
+		if [ -n "$simavr" ]; then
+			avr_cycles "$project" "$fcpu" "$(echo "$info" | cut -d ' ' -f 3)" \
+				"$BUILD_DIR/bench_$image.avr" > "$BUILD_DIR/bench_$image.cycles"
+		fi
+		operation=0
+		while read -r line; do
+			operation=$((operation + 1))
+			function=$(echo "$line" | sed 's/.*"function":"\([^"]*\)".*/\1/')
+			sizes=$(awk -v f="$function" '$1 == f { print "\"flash\":" $2 ",\"stack\":" $3; exit }' \
+				"$BUILD_DIR/bench_$image.sizes")
+			if [ -n "$sizes" ]; then
+				line=$(echo "$line" | sed "s/\"flash\":null,\"stack\":null/$sizes/")
+			fi
+			cycles=$(awk -v n=$operation 'NR == n { print "{\"min\":" $1 ",\"mean\":" $2 ",\"max\":" $3 "}" }' \
+				"$BUILD_DIR/bench_$image.cycles")
+			if [ -n "$cycles" ]; then
+				line=$(echo "$line" | sed "s/\"cpu_cycles\":null/\"cpu_cycles\":$cycles/")
+			fi
+			echo "$line"
+		done < "$BUILD_DIR/bench_$image.jsonl" >> "$REPORT"
+	else
+		cat "$BUILD_DIR/bench_$image.jsonl" >> "$REPORT"
+	fi
+done
+echo "report $REPORT"
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench.c
+ * Description: Source file for the drivers benchmark harness.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include <util/delay.h>
+
+/*******************************************************************************
+ *                           Benchmark Useful Notes                            *
+ *******************************************************************************/
+/*
+ * 		Each operation is called with the register file & the board models
+ * 		in the state left by the previous calls. A report line holds minimum,
+ * 		mean & maximum per call of:
+ * 			wait_cycles	: simulated time, register accesses, delays, sleep &
+ * 						  interrupts taken during the call, not the CPU
+ * 						  cycles of the driver instructions.
+ * 			accesses	: register accesses.
+ * 		Code between two accesses costs nothing in the simulator, so wait_cycles
+ * 		measure what the driver waits for & how much it touches the hardware.
+ * 		cpu_cycles, flash & stack are null, bench.sh fills them from an AVR
+ * 		build when avr-gcc (& simavr for cpu_cycles) is installed.
+ */
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static FILE *g_report = NULL;
+static const char *g_image = "";
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Bench_writeString(const char *string);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Bench_open
+ * [Description]	:
+ * 		Function that opens the report, (SIM_BENCH_REPORT) or the standard
+ * 		output, one JSON object is written per operation.
+ */
+void Bench_open(const char *image)
+{
+	const char *path = Sim_getOption("SIM_BENCH_REPORT", NULL);
+	g_image = image;
+	g_report = (path == NULL) ? stdout : fopen(path, "w");
+	if (g_report == NULL)
+	{
+		Sim_fatal("SIM_BENCH_REPORT %s: cannot open", path);
+	}
+}
+
+/*
+ * [Function Name]	: Bench_run
+ * [Description]	:
+ * 		Function that calls an operation a number of times & reports cycles,
+ * 		register accesses & interrupts of each call.
+ */
+void Bench_run(const char *operation, const char *function, Bench_Operation body,
+		uint16_t iterations)
+{
+	Sim_Statistics before;
+	Sim_Statistics after;
+	uint64_t cycles;
+	uint64_t accesses;
+	uint64_t minCycles = UINT64_MAX;
+	uint64_t maxCycles = 0;
+	uint64_t sumCycles = 0;
+	uint64_t minAccesses = UINT64_MAX;
+	uint64_t maxAccesses = 0;
+	uint64_t sumAccesses = 0;
+	uint64_t interrupts = 0;
+	uint16_t iteration;
+
+	for (iteration = 0; iteration < iterations; iteration++)
+	{
+		/* Repeated calls are not a polling loop, the body may change the board */
+		Sim_restartIdleDetection();
+		Sim_getStatistics(&before);
+		body();
+		Sim_getStatistics(&after);
+		cycles = after.cycles - before.cycles;
+		accesses = after.accesses - before.accesses;
+		minCycles = (cycles < minCycles) ? cycles : minCycles;
+		maxCycles = (cycles > maxCycles) ? cycles : maxCycles;
+		sumCycles += cycles;
+		minAccesses = (accesses < minAccesses) ? accesses : minAccesses;
+		maxAccesses = (accesses > maxAccesses) ? accesses : maxAccesses;
+		sumAccesses += accesses;
+		interrupts += after.interrupts - before.interrupts;
+	}
+
+	Sim_log("BENCH", "%s: %.1f wait cycles, %.1f accesses", operation,
+			(double) sumCycles / iterations, (double) sumAccesses / iterations);
+	fputs("{\"image\":", g_report);
+	Bench_writeString(g_image);
+	fputs(",\"operation\":", g_report);
+	Bench_writeString(operation);
+	fputs(",\"function\":", g_report);
+	Bench_writeString(function);
+	fprintf(g_report, ",\"f_cpu\":%lu,\"iterations\":%u", (unsigned long) F_CPU, iterations);
+	fprintf(g_report, ",\"wait_cycles\":{\"min\":%llu,\"mean\":%.1f,\"max\":%llu}",
+			(unsigned long long) minCycles, (double) sumCycles / iterations,
+			(unsigned long long) maxCycles);
+	fprintf(g_report, ",\"accesses\":{\"min\":%llu,\"mean\":%.1f,\"max\":%llu}",
+			(unsigned long long) minAccesses, (double) sumAccesses / iterations,
+			(unsigned long long) maxAccesses);
+	fprintf(g_report, ",\"interrupts\":%llu", (unsigned long long) interrupts);
+	fputs(",\"cpu_cycles\":null,\"flash\":null,\"stack\":null}\n", g_report);
+}
+
+/*
+ * [Function Name]	: Bench_waitEvent
+ * [Description]	:
+ * 		Function that lets time pass until the next simulator event.
+ */
+void Bench_waitEvent(void)
+{
+	uint64_t next = Sim_nextEventTime();
+	if (next == SIM_NEVER)
+	{
+		Sim_fatal("benchmark waits for an event that never comes");
+	}
+	Sim_delayCycles((next > Sim_cycles) ? (next - Sim_cycles) : 1);
+}
+
+/*
+ * [Function Name]	: Bench_close
+ * [Description]	:
+ * 		Function that closes the report.
+ */
+void Bench_close(void)
+{
+	if (g_report != stdout)
+	{
+		fclose(g_report);
+	}
+	g_report = NULL;
+}
+
+/*
+ * [Function Name]	: Bench_writeString
+ * [Description]	:
+ * 		Function that writes a JSON string.
+ */
+static void Bench_writeString(const char *string)
+{
+	fputc('"', g_report);
+	for (; *string != '\0'; string++)
+	{
+		if ((*string == '"') || (*string == '\\'))
+		{
+			fputc('\\', g_report);
+		}
+		fputc(*string, g_report);
+	}
+	fputc('"', g_report);
+}
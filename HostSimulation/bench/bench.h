@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench.h
+ * Description: Header file for the drivers benchmark harness.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#ifdef BENCH_SIMAVR
+
+#include <stdint.h>
+
+/* No board models on simavr, see bench_avr.c */
+void Sim_runCommand(const char *command);
+
+#else
+
+#include "models.h"
+
+#endif
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Calls measured per operation */
+#define BENCH_ITERATIONS			16
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/* One call of the measured operation */
+typedef void (*Bench_Operation)(void);
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Bench_open
+ * [Description]	:
+ * 		Function that opens the report, (SIM_BENCH_REPORT) or the standard
+ * 		output, one JSON object is written per operation.
+ * [Args]	:
+ * [In] image	: Indicates image name written in the report.
+ * [Return]		: Void.
+ */
+void Bench_open(const char *image);
+
+/*
+ * [Function Name]	: Bench_run
+ * [Description]	:
+ * 		Function that calls an operation a number of times & reports cycles,
+ * 		register accesses & interrupts of each call.
+ * [Args]	:
+ * [In] operation	: Indicates operation description.
+ * [In] function	: Indicates measured driver function, used to find it's
+ * 					  flash & stack size on target.
+ * [In] body		: Indicates one call of the operation.
+ * [In] iterations	: Indicates number of calls.
+ * [Return]			: Void.
+ */
+void Bench_run(const char *operation, const char *function, Bench_Operation body,
+		uint16_t iterations);
+
+/*
+ * [Function Name]	: Bench_waitEvent
+ * [Description]	:
+ * 		Function that lets time pass until the next simulator event with
+ * 		interrupts taken, for operations that wait on variables changed by
+ * 		ISRs. Code of the benchmark itself takes no time.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Bench_waitEvent(void);
+
+/*
+ * [Function Name]	: Bench_close
+ * [Description]	:
+ * 		Function that closes the report.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Bench_close(void);
+
+#endif /* BENCH_H_ */
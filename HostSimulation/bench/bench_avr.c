@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench_avr.c
+ * Description: Source file for the drivers benchmark harness on simavr.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <avr/io.h>
+#include "bench.h"
+
+/*******************************************************************************
+ *                           Benchmark Useful Notes                            *
+ *******************************************************************************/
+/*
+ * 		Replaces bench.c when a benchmark is compiled for the ATmega32 &
+ * 		run by bench_simavr (BENCH_SIMAVR defined). Every call is surrounded
+ * 		by writes to (BENCH_MARKER), the runner reads the CPU cycle counter
+ * 		of simavr on each write, so the cycles include the driver instructions.
+ * 		The operation names stay in the host report, the runner prints one
+ * 		line per Bench_run in the same order.
+ * 		simavr has no board models: nothing drives the inputs, a benchmark
+ * 		waiting for a key or an echo never returns & the runner stops it.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* On-chip debug register, only read by a debugger, never used by the drivers */
+#define BENCH_MARKER				OCDR
+#define BENCH_MARK_START			1
+#define BENCH_MARK_STOP				2
+#define BENCH_MARK_END				3
+#define BENCH_MARK_CALIBRATE		4
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Bench_nothing(void);
+
+static void Bench_measure(Bench_Operation body, uint16_t iterations);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Bench_open
+ * [Description]	:
+ * 		Function that measures an empty operation, the runner removes it's
+ * 		cycles (marker writes & the indirect call) from every operation.
+ */
+void Bench_open(const char *image)
+{
+	(void) image;
+	Bench_measure(Bench_nothing, BENCH_ITERATIONS);
+	BENCH_MARKER = BENCH_MARK_CALIBRATE;
+}
+
+/*
+ * [Function Name]	: Bench_run
+ * [Description]	:
+ * 		Function that calls an operation a number of times between markers.
+ */
+void Bench_run(const char *operation, const char *function, Bench_Operation body,
+		uint16_t iterations)
+{
+	(void) operation;
+	(void) function;
+	Bench_measure(body, iterations);
+	BENCH_MARKER = BENCH_MARK_END;
+}
+
+/*
+ * [Function Name]	: Bench_waitEvent
+ * [Description]	:
+ * 		simavr runs the peripherals with the CPU, polling is enough.
+ */
+void Bench_waitEvent(void)
+{
+}
+
+/*
+ * [Function Name]	: Bench_close
+ * [Description]	:
+ * 		Nothing to close, the runner stops when main returns.
+ */
+void Bench_close(void)
+{
+}
+
+/*
+ * [Function Name]	: Sim_runCommand
+ * [Description]	:
+ * 		No board models on simavr, commands are ignored.
+ */
+void Sim_runCommand(const char *command)
+{
+	(void) command;
+}
+
+/*
+ * [Function Name]	: Bench_nothing
+ * [Description]	:
+ * 		Empty operation of the calibration.
+ */
+static void Bench_nothing(void)
+{
+}
+
+/*
+ * [Function Name]	: Bench_measure
+ * [Description]	:
+ * 		Function that calls an operation a number of times, each call between
+ * 		a start & a stop marker.
+ */
+static void Bench_measure(Bench_Operation body, uint16_t iterations)
+{
+	uint16_t iteration;
+	for (iteration = 0; iteration < iterations; iteration++)
+	{
+		BENCH_MARKER = BENCH_MARK_START;
+		body();
+		BENCH_MARKER = BENCH_MARK_STOP;
+	}
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench_distance_measuring.c
+ * Description: Source file for the distance measuring drivers benchmark.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "bench.h"
+#include <avr/interrupt.h>
+#include "lcd.h"
+#include "ultrasonic_four_terminal_sensor.h"
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Bench_lcdDisplayString(void);
+static void Bench_ultrasonicReadDistance(void);
+static void Bench_ultrasonicNextResult(void);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Initializes the drivers like the distance measuring application &
+ * 		measures the LCD & ultrasonic operations, the board places the
+ * 		obstacle at 100 cm.
+ */
+int main(void)
+{
+	Bench_open("distance");
+	sei();
+	LCD_init();
+	Bench_run("LCD_displayString, 16 characters", "LCD_displayString",
+			Bench_lcdDisplayString, BENCH_ITERATIONS);
+	Ultrasonic_init();
+	Bench_run("Ultrasonic ranging until the next result", "Ultrasonic_getResult",
+			Bench_ultrasonicNextResult, BENCH_ITERATIONS);
+	Bench_run("Ultrasonic_readDistance", "Ultrasonic_readDistance",
+			Bench_ultrasonicReadDistance, BENCH_ITERATIONS);
+	Bench_close();
+	return 0;
+}
+
+/*
+ * [Function Name]	: Bench_lcdDisplayString
+ * [Description]	:
+ * 		One full LCD row.
+ */
+static void Bench_lcdDisplayString(void)
+{
+	LCD_displayString((const uint8 *) "Distance: 100 cm");
+}
+
+/*
+ * [Function Name]	: Bench_ultrasonicReadDistance
+ * [Description]	:
+ * 		Latest distance of the first sensor.
+ */
+static void Bench_ultrasonicReadDistance(void)
+{
+	Ultrasonic_readDistance(0);
+}
+
+/*
+ * [Function Name]	: Bench_ultrasonicNextResult
+ * [Description]	:
+ * 		Waits for the next ranging result of the first sensor, the
+ * 		pings are driven by timer1 & ICU interrupts.
+ */
+static void Bench_ultrasonicNextResult(void)
+{
+	Ultrasonic_ResultType result;
+	uint8 sequence;
+	Ultrasonic_getResult(0, &result);
+	sequence = result.sequence;
+	do
+	{
+		Bench_waitEvent();
+		Ultrasonic_getResult(0, &result);
+	} while (result.sequence == sequence);
+}
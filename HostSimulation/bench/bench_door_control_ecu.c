@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench_door_control_ecu.c
+ * Description: Source file for the door locker CONTROL ECU drivers benchmark.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "bench.h"
+#include "external_eeprom.h"
+#include "i2c.h"
+#include "usart.h"
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Bench_eepromWriteByte(void);
+static void Bench_eepromReadByte(void);
+static void Bench_usartSendByte(void);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Initializes the drivers like the CONTROL ECU application & measures
+ * 		the EEPROM & USART operations.
+ */
+int main(void)
+{
+	I2C_initConfig I2CConfig = { 2, 2, I2C_PRESCALER_1, LOGIC_LOW, LOGIC_LOW };
+	USART_initConfig USARTConfig = { 9600, USART_DATA_8BIT, PARITY_EVEN, LOGIC_LOW };
+	Bench_open("door_control");
+	I2C_init(&I2CConfig);
+	USART_init(&USARTConfig);
+	Bench_run("EEPROM_writeByte", "EEPROM_writeByte", Bench_eepromWriteByte,
+			BENCH_ITERATIONS);
+	Bench_run("EEPROM_readByte", "EEPROM_readByte", Bench_eepromReadByte, BENCH_ITERATIONS);
+	Bench_run("USART_sendByte, 9600 baud", "USART_sendByte", Bench_usartSendByte,
+			BENCH_ITERATIONS);
+	Bench_close();
+	return 0;
+}
+
+/*
+ * [Function Name]	: Bench_eepromWriteByte
+ * [Description]	:
+ * 		One byte written to the 24C16 EEPROM, the write cycle of the
+ * 		EEPROM itself is not modelled.
+ */
+static void Bench_eepromWriteByte(void)
+{
+	EEPROM_writeByte(0x0123, 0x5A);
+}
+
+/*
+ * [Function Name]	: Bench_eepromReadByte
+ * [Description]	:
+ * 		One byte read from the 24C16 EEPROM.
+ */
+static void Bench_eepromReadByte(void)
+{
+	uint8 data;
+	EEPROM_readByte(0x0123, &data);
+}
+
+/*
+ * [Function Name]	: Bench_usartSendByte
+ * [Description]	:
+ * 		One frame sent at 9600 baud, waits for the previous one.
+ */
+static void Bench_usartSendByte(void)
+{
+	USART_sendByte(0x55);
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench_door_hmi_ecu.c
+ * Description: Source file for the door locker HMI ECU drivers benchmark.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "bench.h"
+#include "keypad.h"
+#include "lcd.h"
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Bench_lcdDisplayString(void);
+static void Bench_lcdMoveCursor(void);
+static void Bench_keypadFirstKey(void);
+static void Bench_keypadLastKey(void);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Measures the LCD & keypad operations, keys are pressed just before
+ * 		Keypad_getPressedKey is called.
+ */
+int main(void)
+{
+	Bench_open("door_hmi");
+	LCD_init();
+	Bench_run("LCD_displayString, 16 characters", "LCD_displayString",
+			Bench_lcdDisplayString, BENCH_ITERATIONS);
+	Bench_run("LCD_moveCursor", "LCD_moveCursor", Bench_lcdMoveCursor, BENCH_ITERATIONS);
+	Bench_run("Keypad_getPressedKey, first key scanned", "Keypad_getPressedKey",
+			Bench_keypadFirstKey, BENCH_ITERATIONS);
+	Bench_run("Keypad_getPressedKey, last key scanned", "Keypad_getPressedKey",
+			Bench_keypadLastKey, BENCH_ITERATIONS);
+	Bench_close();
+	return 0;
+}
+
+/*
+ * [Function Name]	: Bench_lcdDisplayString
+ * [Description]	:
+ * 		One full LCD row.
+ */
+static void Bench_lcdDisplayString(void)
+{
+	LCD_displayString((const uint8 *) "Enter Password: ");
+}
+
+/*
+ * [Function Name]	: Bench_lcdMoveCursor
+ * [Description]	:
+ * 		Cursor to the password field.
+ */
+static void Bench_lcdMoveCursor(void)
+{
+	LCD_moveCursor(1, 0);
+}
+
+/*
+ * [Function Name]	: Bench_keypadFirstKey
+ * [Description]	:
+ * 		Key found by the first row & column scanned.
+ */
+static void Bench_keypadFirstKey(void)
+{
+	Sim_runCommand("key=7");
+	Keypad_getPressedKey();
+}
+
+/*
+ * [Function Name]	: Bench_keypadLastKey
+ * [Description]	:
+ * 		Key found by the last row & column scanned.
+ */
+static void Bench_keypadLastKey(void)
+{
+	Sim_runCommand("key=+");
+	Keypad_getPressedKey();
+}
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench_fan_controller.c
+ * Description: Source file for the fan controller drivers benchmark.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "bench.h"
+#include <avr/interrupt.h>
+#include "adc.h"
+#include "lcd.h"
+#include "lm35_three_terminal_sensor.h"
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Bench_lcdInit(void);
+static void Bench_lcdDisplayString(void);
+static void Bench_lcdMoveCursor(void);
+static void Bench_lcdIntegerToString(void);
+static void Bench_adcReadChannel(void);
+static void Bench_adcScanResult(void);
+static void Bench_lm35GetTemperature(void);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Initializes the drivers like the fan controller application & measures
+ * 		the LCD, ADC & LM35 operations.
+ */
+int main(void)
+{
+	ADC_ConfigType adcConfig = { ADC_INT_REF_ENABLE, ADC_PRESCALER_8 };
+	Bench_open("fan");
+	sei();
+	ADC_init(&adcConfig);
+	Bench_run("LCD_init", "LCD_init", Bench_lcdInit, 4);
+	Bench_run("LCD_displayString, 16 characters", "LCD_displayString",
+			Bench_lcdDisplayString, BENCH_ITERATIONS);
+	Bench_run("LCD_moveCursor", "LCD_moveCursor", Bench_lcdMoveCursor, BENCH_ITERATIONS);
+	Bench_run("LCD_intgerToString, 5 digits", "LCD_intgerToString",
+			Bench_lcdIntegerToString, BENCH_ITERATIONS);
+	Bench_run("ADC_readChannel until the conversion ends",
+			"ADC_readChannel", Bench_adcReadChannel, BENCH_ITERATIONS);
+	Bench_run("ADC_startScan until the first result", "ADC_startScan",
+			Bench_adcScanResult, BENCH_ITERATIONS);
+	Bench_run("LM35_getTemperatureTenths", "LM35_getTemperatureTenths",
+			Bench_lm35GetTemperature, BENCH_ITERATIONS);
+	Bench_close();
+	return 0;
+}
+
+/*
+ * [Function Name]	: Bench_lcdInit
+ * [Description]	:
+ * 		LCD initialization, power on delay included.
+ */
+static void Bench_lcdInit(void)
+{
+	LCD_init();
+}
+
+/*
+ * [Function Name]	: Bench_lcdDisplayString
+ * [Description]	:
+ * 		One full LCD row.
+ */
+static void Bench_lcdDisplayString(void)
+{
+	LCD_displayString((const uint8 *) "Temp =  25 C    ");
+}
+
+/*
+ * [Function Name]	: Bench_lcdMoveCursor
+ * [Description]	:
+ * 		Cursor to the temperature field.
+ */
+static void Bench_lcdMoveCursor(void)
+{
+	LCD_moveCursor(1, 2);
+}
+
+/*
+ * [Function Name]	: Bench_lcdIntegerToString
+ * [Description]	:
+ * 		Largest value the LCD driver displays.
+ */
+static void Bench_lcdIntegerToString(void)
+{
+	LCD_intgerToString(65535);
+}
+
+/*
+ * [Function Name]	: Bench_adcReadChannel
+ * [Description]	:
+ * 		With ADC_INTERRUPT_ENABLE the call only starts a conversion, it is
+ * 		measured until the conversion ends.
+ */
+static void Bench_adcReadChannel(void)
+{
+	ADC_readChannel(SENSOR_CHANNEL_ID);
+	while (ADCSRA & (1 << ADSC))
+	{
+		Bench_waitEvent();
+	}
+}
+
+/*
+ * [Function Name]	: Bench_adcScanResult
+ * [Description]	:
+ * 		Free running scan of the sensor channel until it's slot is updated.
+ */
+static void Bench_adcScanResult(void)
+{
+	const uint8 channels[] = { SENSOR_CHANNEL_ID };
+	uint16 value;
+	uint8 sequence = ADC_getChannelResult(SENSOR_CHANNEL_ID, &value);
+	ADC_startScan(channels, sizeof(channels), ADC_TRIG_FREE);
+	while (ADC_getChannelResult(SENSOR_CHANNEL_ID, &value) == sequence)
+	{
+		Bench_waitEvent();
+	}
+	ADC_stopScan();
+}
+
+/*
+ * [Function Name]	: Bench_lm35GetTemperature
+ * [Description]	:
+ * 		Latest sensor reading from it's ADC slot.
+ */
+static void Bench_lm35GetTemperature(void)
+{
+	LM35_getTemperatureTenths();
+}
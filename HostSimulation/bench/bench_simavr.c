@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: bench_simavr.c
+ * Description: Runs an ATmega32 benchmark image on simavr & prints it's cycles.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+
+/*******************************************************************************
+ *                           Benchmark Useful Notes                            *
+ *******************************************************************************/
+/*
+ * 		Usage: bench_simavr IMAGE.elf F_CPU
+ * 		Loads a benchmark built with bench_avr.c & counts the CPU cycles
+ * 		between the start & stop markers it writes to OCDR. Prints one
+ * 		"MIN MEAN MAX" line per Bench_run, in the order of the host report,
+ * 		after removing the cycles of the empty operation measured first.
+ * 		Stops with failure when no marker is written for (BENCH_LIMIT_SECONDS)
+ * 		of simulated time, e.g. an operation waiting for a key, the lines
+ * 		already printed are kept.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* OCDR data space address, see bench_avr.c */
+#define BENCH_MARKER_ADDRESS		0x51
+#define BENCH_MARK_START			1
+#define BENCH_MARK_STOP				2
+#define BENCH_MARK_END				3
+#define BENCH_MARK_CALIBRATE		4
+#define BENCH_LIMIT_SECONDS			10
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static avr_cycle_count_t g_start = 0;
+static avr_cycle_count_t g_lastMark = 0;
+static uint64_t g_min = UINT64_MAX;
+static uint64_t g_max = 0;
+static uint64_t g_sum = 0;
+static uint64_t g_calls = 0;
+static uint64_t g_overhead = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Bench_reset(void);
+
+static void Bench_marker(avr_t *avr, avr_io_addr_t address, uint8_t value, void *param);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Bench_reset
+ * [Description]	:
+ * 		Function that empties the statistics for the next operation.
+ */
+static void Bench_reset(void)
+{
+	g_min = UINT64_MAX;
+	g_max = 0;
+	g_sum = 0;
+	g_calls = 0;
+}
+
+/*
+ * [Function Name]	: Bench_marker
+ * [Description]	:
+ * 		Call-back of the marker register writes.
+ */
+static void Bench_marker(avr_t *avr, avr_io_addr_t address, uint8_t value, void *param)
+{
+	uint64_t cycles;
+	(void) address;
+	(void) param;
+	g_lastMark = avr->cycle;
+	switch (value)
+	{
+		case BENCH_MARK_START:
+			g_start = avr->cycle;
+			break;
+		case BENCH_MARK_STOP:
+			cycles = avr->cycle - g_start;
+			cycles = (cycles > g_overhead) ? (cycles - g_overhead) : 0;
+			g_min = (cycles < g_min) ? cycles : g_min;
+			g_max = (cycles > g_max) ? cycles : g_max;
+			g_sum += cycles;
+			g_calls++;
+			break;
+		case BENCH_MARK_END:
+			if (g_calls != 0)
+			{
+				printf("%llu %.1f %llu\n", (unsigned long long) g_min,
+						(double) g_sum / g_calls, (unsigned long long) g_max);
+				fflush(stdout);
+			}
+			Bench_reset();
+			break;
+		case BENCH_MARK_CALIBRATE:
+			g_overhead = (g_calls != 0) ? g_min : 0;
+			Bench_reset();
+			break;
+	}
+}
+
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Runs the image until main returns, it crashes or stops writing markers.
+ */
+int main(int argc, char *argv[])
+{
+	elf_firmware_t firmware;
+	avr_t *avr;
+	avr_cycle_count_t limit;
+	int state = cpu_Running;
+
+	if (argc != 3)
+	{
+		fprintf(stderr, "usage: %s IMAGE.elf F_CPU\n", argv[0]);
+		return 1;
+	}
+	memset(&firmware, 0, sizeof(firmware));
+	if (elf_read_firmware(argv[1], &firmware) != 0)
+	{
+		fprintf(stderr, "%s: cannot read\n", argv[1]);
+		return 1;
+	}
+	avr = avr_make_mcu_by_name("atmega32");
+	if (avr == NULL)
+	{
+		fprintf(stderr, "simavr has no atmega32\n");
+		return 1;
+	}
+	avr_init(avr);
+	firmware.frequency = strtoul(argv[2], NULL, 10);
+	avr_load_firmware(avr, &firmware);
+	avr_register_io_write(avr, BENCH_MARKER_ADDRESS, Bench_marker, NULL);
+	limit = (avr_cycle_count_t) firmware.frequency * BENCH_LIMIT_SECONDS;
+
+	while ((state != cpu_Done) && (state != cpu_Crashed))
+	{
+		state = avr_run(avr);
+		if (avr->cycle - g_lastMark > limit)
+		{
+			fprintf(stderr, "%s: no marker for %d s at cycle %llu, stopped\n", argv[1],
+					BENCH_LIMIT_SECONDS, (unsigned long long) avr->cycle);
+			return 2;
+		}
+	}
+	return (state == cpu_Done) ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: board_distance_measuring.c
+ * Description: Source file for the simulated distance measuring board.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "models.h"
+#include "lcd.h"
+#include "ultrasonic_four_terminal_sensor.h"
+
+/*
+ * [Function Name]	: Sim_boardInit
+ * [Description]	:
+ * 		Function that connects the LCD & the ultrasonic sensors, echo goes to
+ * 		ICP1 (PD6).
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_boardInit(void)
+{
+	Model_LcdConfig lcdConfig = { LCD_RS_PORT_ID, LCD_RS_PIN_ID, LCD_E_PORT_ID,
+			LCD_E_PIN_ID, MODEL_NO_PIN, MODEL_NO_PIN, LCD_DATA_PORT_ID,
+			LCD_DATA_BITS_MODE, 0, 2 };
+	Model_UltrasonicConfig ultrasonicConfig = { ULTRASONIC_SENSORS_NUMBER,
+			ULTRASONIC_TRIGGER_PORT_ID, ULTRASONIC_TRIGGER_FIRST_PIN_ID, SIM_PORTD, 6,
+			MODEL_NO_PIN, 0, 0 };
+
+#if (LCD_RW_GROUND == FALSE)
+
+	lcdConfig.rwPort = LCD_RW_PORT_ID;
+	lcdConfig.rwPin = LCD_RW_PIN_ID;
+
+#endif
+
+#if (LCD_DATA_BITS_MODE == 4)
+
+	lcdConfig.db4Pin = LCD_DB4_PIN_ID;
+
+#endif
+
+#if (ULTRASONIC_SENSORS_NUMBER > 1)
+
+	ultrasonicConfig.muxPort = ULTRASONIC_MUX_PORT_ID;
+	ultrasonicConfig.firstMuxPin = ULTRASONIC_MUX_FIRST_PIN_ID;
+	ultrasonicConfig.muxBits = ULTRASONIC_MUX_SELECT_BITS;
+
+#endif
+
+	Model_lcdInit(&lcdConfig);
+	Model_ultrasonicInit(&ultrasonicConfig, 100.0);
+}
@@ -0,0 +1,25 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: board_door_control_ecu.c
+ * Description: Source file for the simulated door locker CONTROL ECU board.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "models.h"
+#include "buzzer.h"
+#include "dc_motor.h"
+
+/*
+ * [Function Name]	: Sim_boardInit
+ * [Description]	:
+ * 		Function that connects the 24C16 EEPROM, the buzzer & the door motor,
+ * 		the USART goes to the HMI ECU through SIM_UART.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_boardInit(void)
+{
+	Model_eepromInit();
+	Model_pinInit("buzzer", BUZZER_PORT_ID, BUZZER_PIN_ID);
+	Model_motorInit(DC_MOTOR_PORT, DC_MOTOR_IN1, DC_MOTOR_IN2);
+}
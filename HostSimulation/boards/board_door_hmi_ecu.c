@@ -0,0 +1,47 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: board_door_hmi_ecu.c
+ * Description: Source file for the simulated door locker HMI ECU board.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "models.h"
+#include "lcd.h"
+#include "keypad.h"
+
+/*
+ * [Function Name]	: Sim_boardInit
+ * [Description]	:
+ * 		Function that connects the LCD & the keypad, the USART goes to the
+ * 		CONTROL ECU through SIM_UART.
+ * 		Keypad driver returns key (column * 4 + row + 1) after adjustment,
+ * 		so labels are the adjust table read column after column. The ON/C
+ * 		key (13) is labeled 'c'.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_boardInit(void)
+{
+	Model_LcdConfig lcdConfig = { LCD_RS_PORT_ID, LCD_RS_PIN_ID, LCD_E_PORT_ID,
+			LCD_E_PIN_ID, MODEL_NO_PIN, MODEL_NO_PIN, LCD_DATA_PORT_ID,
+			LCD_DATA_BITS_MODE, 0, 2 };
+	const Model_KeypadConfig keypadConfig = { KEYPAD_ROW_PORT_ID,
+			KEYPAD_FIRST_ROW_PIN_ID, KEYPAD_COL_PORT_ID, KEYPAD_FIRST_COL_PIN_ID,
+			KEYPAD_NUM_ROWS, KEYPAD_NUM_COLS, "741c" "8520" "963=" "%*-+" };
+
+#if (LCD_RW_GROUND == FALSE)
+
+	lcdConfig.rwPort = LCD_RW_PORT_ID;
+	lcdConfig.rwPin = LCD_RW_PIN_ID;
+
+#endif
+
+#if (LCD_DATA_BITS_MODE == 4)
+
+	lcdConfig.db4Pin = LCD_DB4_PIN_ID;
+
+#endif
+
+	Model_lcdInit(&lcdConfig);
+	Model_keypadInit(&keypadConfig);
+}
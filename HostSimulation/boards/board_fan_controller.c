@@ -0,0 +1,42 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: board_fan_controller.c
+ * Description: Source file for the simulated fan controller board.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "models.h"
+#include "lcd.h"
+#include "dc_motor.h"
+#include "lm35_three_terminal_sensor.h"
+
+/*
+ * [Function Name]	: Sim_boardInit
+ * [Description]	:
+ * 		Function that connects the LCD, the LM35 sensor & the fan motor.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_boardInit(void)
+{
+	Model_LcdConfig lcdConfig = { LCD_RS_PORT_ID, LCD_RS_PIN_ID, LCD_E_PORT_ID,
+			LCD_E_PIN_ID, MODEL_NO_PIN, MODEL_NO_PIN, LCD_DATA_PORT_ID,
+			LCD_DATA_BITS_MODE, 0, 2 };
+
+#if (LCD_RW_GROUND == FALSE)
+
+	lcdConfig.rwPort = LCD_RW_PORT_ID;
+	lcdConfig.rwPin = LCD_RW_PIN_ID;
+
+#endif
+
+#if (LCD_DATA_BITS_MODE == 4)
+
+	lcdConfig.db4Pin = LCD_DB4_PIN_ID;
+
+#endif
+
+	Model_lcdInit(&lcdConfig);
+	Model_lm35Init(SENSOR_CHANNEL_ID, 25.0);
+	Model_motorInit(DC_MOTOR_PORT, DC_MOTOR_IN1, DC_MOTOR_IN2);
+}
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: board_stop_watch.c
+ * Description: Source file for the simulated stop watch board.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "models.h"
+
+/*
+ * [Function Name]	: Sim_boardInit
+ * [Description]	:
+ * 		Function that connects the 6 digits display (anodes PA0 .. PA5 &
+ * 		7447 decoder on PC0 .. PC3) & the buttons:
+ * 			reset	: INT0 (PD2) to ground, internal pull-up.
+ * 			pause	: INT1 (PD3) to VCC, external pull-down.
+ * 			resume	: INT2 (PB2) to ground, internal pull-up.
+ * 			lap		: ICP1 (PD6) to ground, internal pull-up.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_boardInit(void)
+{
+	Model_sevenSegmentInit(SIM_PORTA, 0, 6, SIM_PORTC, 0);
+	Sim_gpioSetPull(SIM_PORTD, 3, SIM_PULL_DOWN);
+	Model_buttonInit("reset", SIM_PORTD, 2, 0);
+	Model_buttonInit("pause", SIM_PORTD, 3, 1);
+	Model_buttonInit("resume", SIM_PORTB, 2, 0);
+	Model_buttonInit("lap", SIM_PORTD, 6, 0);
+}
@@ -0,0 +1,148 @@
+#!/bin/sh
+################################################################################
+# Module: Host Simulation
+# File Name: build.sh
+# Description: Builds the firmware images as Linux x86-64 programs.
+# Author: Mohamed Badr
+#
+# Usage: HostSimulation/build.sh [IMAGE ...]
+# 		IMAGE is one of: fan distance stopwatch door_hmi door_control, all of
+# 		them by default. Programs are written to HostSimulation/build/IMAGE.
+# 		bench_fan bench_distance bench_door_hmi bench_door_control replace the
+# 		application of a project by it's drivers benchmark (bench/).
+# 		event_log_decode builds the host decoder of the firmware event log
+# 		(tools/), fan_plant the thermal plant comparing the fan controllers
+# 		(tools/). test_* build the host tests of firmware modules (tests/),
+# 		test.sh builds & runs all of them.
+################################################################################
+
+set -e
+
+SIM_DIR=$(cd "$(dirname "$0")" && pwd)
+REPO_DIR=$(dirname "$SIM_DIR")
+BUILD_DIR="$SIM_DIR/build"
+CC=${CC:-gcc}
+
+# Same language options as the AVR Debug configurations, warnings are left to
+# the AVR build. Structures are not packed because the firmware & the C library
+# share them on the host
+FIRMWARE_FLAGS="-std=gnu99 -O0 -g -w -funsigned-char -funsigned-bitfields -fshort-enums"
+SIM_FLAGS="-std=gnu99 -O2 -g -Wall -Wextra -funsigned-char"
+# uint32 & sint32 are long, 64 bits on the host: include/std_types.h is read
+# first by the firmware & by everything including the project headers
+TYPES_FLAGS="-include $SIM_DIR/include/std_types.h"
+
+. "$SIM_DIR/images.sh"
+
+build_image()
+{
+	set -- "$1" $(image_info "${1#bench_}")
+	image=$1
+	project="$REPO_DIR/$2"
+	fcpu=$3
+	board=$4
+	out="$BUILD_DIR/$image"
+	rm -rf "$out.obj"
+	mkdir -p "$out.obj"
+
+	# A benchmark replaces the application, it's main calls the drivers
+	app_filter="-false"
+	bench_sources=""
+	if [ "$image" != "${image#bench_}" ]; then
+		app_filter="-path */APP/*"
+		bench_sources="$SIM_DIR/bench/bench.c $SIM_DIR/bench/$(echo "$board" | sed 's/^board_/bench_/')"
+	fi
+
+	# Firmware sources, Eclipse Debug output is skipped
+	find "$project" -name '*.c' -not -path '*/Debug/*' -not \( $app_filter \) | while read -r source; do
+		object="$out.obj/fw_$(echo "${source#$project/}" | tr '/' '_').o"
+		$CC $FIRMWARE_FLAGS $TYPES_FLAGS -isystem "$SIM_DIR/include" -DF_CPU=$fcpu \
+			-c "$source" -o "$object"
+	done
+
+	# Simulator, models & board, board includes the project headers
+	for source in "$SIM_DIR"/sim/*.c "$SIM_DIR"/sim/*.S "$SIM_DIR"/models/*.c \
+			"$SIM_DIR/boards/$board" $bench_sources; do
+		object="$out.obj/sim_$(basename "$source").o"
+		$CC $SIM_FLAGS $TYPES_FLAGS -isystem "$SIM_DIR/include" -I "$SIM_DIR/sim" \
+			-I "$SIM_DIR/models" -I "$SIM_DIR/bench" -I "$project" -I "$project/HAL" \
+			-I "$project/MCAL" \
+			-DF_CPU=$fcpu -c "$source" -o "$object"
+	done
+
+	$CC -no-pie -o "$out" "$out.obj"/*.o -lm
+	echo "built $out"
+}
+
+# Host program linking some firmware sources: image of the project, program
+# source without extension & the sources relative to the project
+program_info()
+{
+	case "$1" in
+		test_lm35|test_lm35_10bit)
+			echo "fan tests/test_lm35 HAL/lm35_three_terminal_sensor.c" ;;
+		test_filter)
+			echo "fan tests/test_filter LIB/filter.c" ;;
+		test_ultrasonic|test_ultrasonic_array)
+			echo "distance tests/test_ultrasonic HAL/ultrasonic_four_terminal_sensor.c" ;;
+		fan_plant)
+			echo "fan tools/fan_plant HAL/lm35_three_terminal_sensor.c LIB/filter.c LIB/pid.c" ;;
+		*)
+			echo "unknown program '$1'" >&2
+			exit 1 ;;
+	esac
+}
+
+# Configuration of a program build, given to the program & firmware sources
+program_defines()
+{
+	case "$1" in
+		test_lm35_10bit)
+			echo "-DADC_OVERSAMPLING_BITS=0" ;;
+		test_ultrasonic_array)
+			echo "-DULTRASONIC_SENSORS_NUMBER=4 -DULTRASONIC_TRIGGER_FIRST_PIN_ID=PIN2_ID" ;;
+	esac
+}
+
+build_program()
+{
+	program=$1
+	defines=$(program_defines "$program")
+	set -- $(program_info "$program")
+	project="$REPO_DIR/$(image_info "$1" | cut -d ' ' -f 1)"
+	fcpu=$(image_info "$1" | cut -d ' ' -f 2)
+	main=$2
+	shift 2
+	out="$BUILD_DIR/$program"
+	rm -rf "$out.obj"
+	mkdir -p "$out.obj"
+	for source in "$@"; do
+		object="$out.obj/fw_$(echo "$source" | tr '/' '_').o"
+		$CC $FIRMWARE_FLAGS $TYPES_FLAGS -isystem "$SIM_DIR/include" -DF_CPU=$fcpu \
+			$defines -c "$project/$source" -o "$object"
+	done
+	# The program shares structures & enumerates with the firmware objects
+	$CC $SIM_FLAGS -fshort-enums -funsigned-bitfields $TYPES_FLAGS -isystem "$SIM_DIR/include" \
+		-I "$project" -I "$project/APP" -I "$project/HAL" -I "$project/MCAL" \
+		-I "$project/LIB" \
+		-DF_CPU=$fcpu -DTEST_DIR="\"$SIM_DIR/tests\"" $defines \
+		-c "$SIM_DIR/$main.c" -o "$out.obj/$program.o"
+	$CC -o "$out" "$out.obj"/*.o -lm
+	echo "built $out"
+}
+
+mkdir -p "$BUILD_DIR"
+if [ $# -eq 0 ]; then
+	set -- fan distance stopwatch door_hmi door_control event_log_decode fan_plant
+fi
+for image in "$@"; do
+	case "$image" in
+		event_log_decode)
+			$CC $SIM_FLAGS -o "$BUILD_DIR/$image" "$SIM_DIR/tools/$image.c"
+			echo "built $BUILD_DIR/$image" ;;
+		test_*|fan_plant)
+			build_program "$image" ;;
+		*)
+			build_image "$image" ;;
+	esac
+done
@@ -0,0 +1,26 @@
+################################################################################
+# Module: Host Simulation
+# File Name: images.sh
+# Description: Firmware images table, sourced by build.sh & bench.sh.
+# Author: Mohamed Badr
+################################################################################
+
+# Image name, project directory, F_CPU & board source
+image_info()
+{
+	case "$1" in
+		fan)
+			echo "FanControllerProject/FanControllerProject_Eclipse/FanControllerProject_Eclipse 1000000UL board_fan_controller.c" ;;
+		distance)
+			echo "DistanceMeasuringProject/DistanceMeasuringProject_Eclipse/DistanceMeasuringProject_Eclipse 8000000UL board_distance_measuring.c" ;;
+		stopwatch)
+			echo "StopWatchProject/StopWatchProject_Eclipse/StopWatchProject_Eclipse 1000000UL board_stop_watch.c" ;;
+		door_hmi)
+			echo "DoorLockerSecuritySystemProject/DoorLockerSecuritySystemProject_Eclipse/DoorLockerSecuritySystemProject_HMI_ECU 8000000UL board_door_hmi_ecu.c" ;;
+		door_control)
+			echo "DoorLockerSecuritySystemProject/DoorLockerSecuritySystemProject_Eclipse/DoorLockerSecuritySystemProject_CONTROL_ECU 8000000UL board_door_control_ecu.c" ;;
+		*)
+			echo "unknown image '$1'" >&2
+			exit 1 ;;
+	esac
+}
@@ -0,0 +1,13 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: delay.h
+ * Description: Deprecated location of delay functions.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef SIM_AVR_DELAY_H_
+#define SIM_AVR_DELAY_H_
+
+#include <util/delay.h>
+
+#endif /* SIM_AVR_DELAY_H_ */
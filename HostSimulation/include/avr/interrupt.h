@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: interrupt.h
+ * Description: ATmega32 interrupt vectors & global interrupt control.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef SIM_AVR_INTERRUPT_H_
+#define SIM_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Interrupt vectors numbers, a lower number has a higher priority */
+#define INT0_vect_num			1
+#define INT1_vect_num			2
+#define INT2_vect_num			3
+#define TIMER2_COMP_vect_num	4
+#define TIMER2_OVF_vect_num		5
+#define TIMER1_CAPT_vect_num	6
+#define TIMER1_COMPA_vect_num	7
+#define TIMER1_COMPB_vect_num	8
+#define TIMER1_OVF_vect_num		9
+#define TIMER0_COMP_vect_num	10
+#define TIMER0_OVF_vect_num		11
+#define SPI_STC_vect_num		12
+#define USART_RXC_vect_num		13
+#define USART_UDRE_vect_num		14
+#define USART_TXC_vect_num		15
+#define ADC_vect_num			16
+#define EE_RDY_vect_num			17
+#define ANA_COMP_vect_num		18
+#define TWI_vect_num			19
+#define SPM_RDY_vect_num		20
+#define SIM_VECTORS_NUM			21
+
+/*
+ * An ISR is a normal function registered in the simulator vector table before
+ * main, the simulator calls it when the interrupt is taken. Defining the same
+ * vector twice stops the simulation like a duplicate symbol stops the linker.
+ */
+#define ISR(vector, ...)												\
+	static void Sim_isr_##vector(void);									\
+	__attribute__((constructor)) static void Sim_isrVector_##vector(void)	\
+	{																	\
+		Sim_setVector(vector##_num, Sim_isr_##vector, #vector);			\
+	}																	\
+	static void Sim_isr_##vector(void)
+
+/* Global interrupt enable/disable, SEI takes effect after the next instruction */
+#define sei()		Sim_enableInterrupts()
+#define cli()		Sim_disableInterrupts()
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+void Sim_setVector(int vector, void (*handler)(void), const char *name);
+void Sim_enableInterrupts(void);
+void Sim_disableInterrupts(void);
+
+#endif /* SIM_AVR_INTERRUPT_H_ */
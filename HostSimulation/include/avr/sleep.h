@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sleep.h
+ * Description: ATmega32 sleep modes on the simulated MCUCR register.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef SIM_AVR_SLEEP_H_
+#define SIM_AVR_SLEEP_H_
+
+#include <avr/io.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Sleep modes values of SM2:0 bits in MCUCR */
+#define SLEEP_MODE_IDLE			(0)
+#define SLEEP_MODE_ADC			(1 << SM0)
+#define SLEEP_MODE_PWR_DOWN		(1 << SM1)
+#define SLEEP_MODE_PWR_SAVE		((1 << SM0) | (1 << SM1))
+#define SLEEP_MODE_STANDBY		((1 << SM1) | (1 << SM2))
+#define SLEEP_MODE_EXT_STANDBY	((1 << SM0) | (1 << SM1) | (1 << SM2))
+
+#define set_sleep_mode(mode)												\
+	do																		\
+	{																		\
+		MCUCR = (MCUCR & ~((1 << SM2) | (1 << SM1) | (1 << SM0))) | (mode);	\
+	} while (0)
+
+#define sleep_enable()		do { MCUCR |= (1 << SE); } while (0)
+#define sleep_disable()		do { MCUCR &= ~(1 << SE); } while (0)
+
+/* SLEEP instruction, does nothing unless SE bit is set */
+#define sleep_cpu()			Sim_sleep()
+
+#define sleep_mode()		\
+	do						\
+	{						\
+		sleep_enable();		\
+		sleep_cpu();		\
+		sleep_disable();	\
+	} while (0)
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+void Sim_sleep(void);
+
+#endif /* SIM_AVR_SLEEP_H_ */
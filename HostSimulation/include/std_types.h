@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: std_types.h
+ * Description: AVR sizes of the firmware platform types on the x86-64 host,
+ * 				forced in every firmware compile before the project std_types.h.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef STD_TYPES_H_
+#define STD_TYPES_H_
+
+#ifndef __ASSEMBLER__
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Boolean Values */
+#ifndef FALSE
+#define FALSE       (0u)
+#endif
+#ifndef TRUE
+#define TRUE        (1u)
+#endif
+/* Logic values */
+#define LOGIC_HIGH        (1u)
+#define LOGIC_LOW         (0u)
+/* Null value for pointers initialization */
+#define NULL_PTR    ((void*)0)
+/* Common data types, long is 64 bits on the host so the 32-bit types are int */
+typedef unsigned char         uint8;          /*           0 .. 255              */
+typedef signed char           sint8;          /*        -128 .. +127             */
+typedef unsigned short        uint16;         /*           0 .. 65535            */
+typedef signed short          sint16;         /*      -32768 .. +32767           */
+typedef unsigned int          uint32;         /*           0 .. 4294967295       */
+typedef signed int            sint32;         /* -2147483648 .. +2147483647      */
+typedef unsigned long long    uint64;         /*       0 .. 18446744073709551615  */
+typedef signed long long      sint64;         /* -9223372036854775808 .. 9223372036854775807 */
+typedef float                 float32;
+typedef double                float64;
+/* Boolean Data Type */
+typedef unsigned char boolean;
+
+/* Fails the build on a host where the types do not have the AVR sizes */
+typedef char Sim_StdTypesSizeCheck[((sizeof(uint16) == 2) && (sizeof(uint32) == 4)
+		&& (sizeof(uint64) == 8)) ? 1 : -1];
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* STD_TYPES_H_ */
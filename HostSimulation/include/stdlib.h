@@ -0,0 +1,19 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: stdlib.h
+ * Description: Host C library with the avr-libc extensions used by firmware.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef SIM_STDLIB_H_
+#define SIM_STDLIB_H_
+
+#include_next <stdlib.h>
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/* Integer to string in the given radix, as in avr-libc */
+char *itoa(int value, char *string, int radix);
+
+#endif /* SIM_STDLIB_H_ */
@@ -0,0 +1,37 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: delay.h
+ * Description: Busy wait delays counted in simulated CPU cycles.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef SIM_UTIL_DELAY_H_
+#define SIM_UTIL_DELAY_H_
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#warning "F_CPU not defined for <util/delay.h>"
+#define F_CPU 1000000UL
+#endif
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+void Sim_delayCycles(uint64_t cycles);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/* Interrupts taken during a delay are serviced at their time, like on target */
+static inline void _delay_ms(double ms)
+{
+	Sim_delayCycles((uint64_t) (ms * ((double) F_CPU / 1e3)));
+}
+
+static inline void _delay_us(double us)
+{
+	Sim_delayCycles((uint64_t) (us * ((double) F_CPU / 1e6)));
+}
+
+#endif /* SIM_UTIL_DELAY_H_ */
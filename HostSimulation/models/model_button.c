@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_button.c
+ * Description: Source file for the simulated push buttons.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define MODEL_BUTTON_HOLD_MS		100
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	const char *name;
+	uint8_t port;
+	uint8_t pin;
+	uint8_t pressedLevel;
+	Sim_Event releaseEvent;
+} Model_Button;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Model_Button g_buttons[MODEL_BUTTONS_MAX];
+static uint8_t g_buttonsNum = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_buttonRelease(void *arg);
+static void Model_buttonCommandPress(const char *value);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_buttonInit
+ * [Description]	:
+ * 		Function that connects a button between a pin & a supply rail, the
+ * 		pull resistor of the pin is set by the board or the firmware.
+ * [Args]	:
+ * [In] name			: Indicates button name for commands.
+ * [In] port			: Indicates port ID.
+ * [In] pin				: Indicates pin number.
+ * [In] pressedLevel	: Indicates pin level while pressed.
+ * [Return]				: Void.
+ */
+void Model_buttonInit(const char *name, uint8_t port, uint8_t pin, uint8_t pressedLevel)
+{
+	Model_Button *button;
+	if (g_buttonsNum == MODEL_BUTTONS_MAX)
+	{
+		Sim_fatal("too many buttons");
+	}
+	button = &g_buttons[g_buttonsNum];
+	(*button).name = name;
+	(*button).port = port;
+	(*button).pin = pin;
+	(*button).pressedLevel = pressedLevel;
+	Sim_eventInit(&(*button).releaseEvent, Model_buttonRelease, button);
+	if (g_buttonsNum++ == 0)
+	{
+		Sim_addCommand("press", Model_buttonCommandPress,
+				"NAME or NAME:MS, press a button for 100 ms or MS");
+	}
+}
+
+/*
+ * [Function Name]	: Model_buttonRelease
+ * [Description]	:
+ * 		Event call-back that releases a button.
+ */
+static void Model_buttonRelease(void *arg)
+{
+	Model_Button *button = (Model_Button *) arg;
+	Sim_log("BUTTON", "release %s", (*button).name);
+	Sim_gpioDrive((*button).port, (*button).pin, SIM_DRIVE_NONE);
+}
+
+/*
+ * [Function Name]	: Model_buttonCommandPress
+ * [Description]	:
+ * 		Command "press=NAME" or "press=NAME:MS".
+ */
+static void Model_buttonCommandPress(const char *value)
+{
+	size_t length = strcspn(value, ":");
+	double holdMs = (value[length] == ':') ? atof(value + length + 1) : MODEL_BUTTON_HOLD_MS;
+	uint8_t index;
+
+	for (index = 0; index < g_buttonsNum; index++)
+	{
+		Model_Button *button = &g_buttons[index];
+		if ((strlen((*button).name) == length) && (strncmp((*button).name, value, length) == 0))
+		{
+			Sim_log("BUTTON", "press %s", (*button).name);
+			Sim_gpioDrive((*button).port, (*button).pin, (*button).pressedLevel);
+			Sim_eventSchedule(&(*button).releaseEvent,
+					Sim_cycles + Sim_cyclesFromSeconds(holdMs / 1000.0));
+			return;
+		}
+	}
+	Sim_log("BUTTON", "no button '%s'", value);
+}
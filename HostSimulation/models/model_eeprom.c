@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_eeprom.c
+ * Description: Source file for the simulated 24C16 serial EEPROM.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <string.h>
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* 8 blocks of 256 bytes, block (n) answers to address (0x50 + n) */
+#define MODEL_EEPROM_ADDRESS		0x50
+#define MODEL_EEPROM_BLOCKS			8
+#define MODEL_EEPROM_SIZE			2048
+#define MODEL_EEPROM_PAGE_SIZE		16
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static uint8_t g_memory[MODEL_EEPROM_SIZE];
+static Sim_TwiDevice g_blocks[MODEL_EEPROM_BLOCKS];
+static uint16_t g_address = 0;
+/* The first written byte after addressing is the word address */
+static uint8_t g_wordAddressNext = FALSE;
+static uint8_t g_written = FALSE;
+static const char *g_fileName = NULL;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static uint8_t Model_eepromStart(Sim_TwiDevice *device, uint8_t isRead);
+static uint8_t Model_eepromWrite(Sim_TwiDevice *device, uint8_t data);
+static uint8_t Model_eepromRead(Sim_TwiDevice *device, uint8_t ack);
+static void Model_eepromStop(Sim_TwiDevice *device);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_eepromInit
+ * [Description]	:
+ * 		Function that connects the EEPROM, erased (0xFF) or loaded from the
+ * 		file named by SIM_EEPROM_FILE. The write cycle time is not modelled.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Model_eepromInit(void)
+{
+	uint8_t block;
+	FILE *file;
+
+	memset(g_memory, 0xFF, sizeof(g_memory));
+	g_fileName = Sim_getOption("SIM_EEPROM_FILE", NULL);
+	if ((g_fileName != NULL) && ((file = fopen(g_fileName, "rb")) != NULL))
+	{
+		if (fread(g_memory, 1, sizeof(g_memory), file) != sizeof(g_memory))
+		{
+			Sim_log("EEPROM", "%s is short, the rest is erased", g_fileName);
+		}
+		fclose(file);
+	}
+	for (block = 0; block < MODEL_EEPROM_BLOCKS; block++)
+	{
+		g_blocks[block].address = MODEL_EEPROM_ADDRESS + block;
+		g_blocks[block].start = Model_eepromStart;
+		g_blocks[block].write = Model_eepromWrite;
+		g_blocks[block].read = Model_eepromRead;
+		g_blocks[block].stop = Model_eepromStop;
+		Sim_twiAttach(&g_blocks[block]);
+	}
+}
+
+/*
+ * [Function Name]	: Model_eepromStart
+ * [Description]	:
+ * 		TWI call-back when a block is addressed, the block number gives the
+ * 		3 most significant bits of the address.
+ */
+static uint8_t Model_eepromStart(Sim_TwiDevice *device, uint8_t isRead)
+{
+	uint16_t block = (uint16_t) ((*device).address - MODEL_EEPROM_ADDRESS);
+	g_address = (uint16_t) ((block << 8) | (g_address & 0xFF));
+	g_wordAddressNext = !isRead;
+	return TRUE;
+}
+
+/*
+ * [Function Name]	: Model_eepromWrite
+ * [Description]	:
+ * 		TWI call-back of a written byte, data wraps inside a 16 bytes page.
+ */
+static uint8_t Model_eepromWrite(Sim_TwiDevice *device, uint8_t data)
+{
+	(void) device;
+	if (g_wordAddressNext)
+	{
+		g_address = (uint16_t) ((g_address & 0x700) | data);
+		g_wordAddressNext = FALSE;
+		return TRUE;
+	}
+	g_memory[g_address] = data;
+	g_written = TRUE;
+	Sim_log("EEPROM", "write [0x%03X] = 0x%02X", g_address, data);
+	g_address = (uint16_t) ((g_address & ~(MODEL_EEPROM_PAGE_SIZE - 1))
+			| ((g_address + 1) & (MODEL_EEPROM_PAGE_SIZE - 1)));
+	return TRUE;
+}
+
+/*
+ * [Function Name]	: Model_eepromRead
+ * [Description]	:
+ * 		TWI call-back of a read byte, sequential reads cross pages.
+ */
+static uint8_t Model_eepromRead(Sim_TwiDevice *device, uint8_t ack)
+{
+	uint8_t data = g_memory[g_address];
+	(void) device;
+	(void) ack;
+	g_address = (g_address + 1) % MODEL_EEPROM_SIZE;
+	return data;
+}
+
+/*
+ * [Function Name]	: Model_eepromStop
+ * [Description]	:
+ * 		TWI call-back at stop condition, written data is saved to the file.
+ */
+static void Model_eepromStop(Sim_TwiDevice *device)
+{
+	FILE *file;
+	(void) device;
+	if (g_written && (g_fileName != NULL) && ((file = fopen(g_fileName, "wb")) != NULL))
+	{
+		fwrite(g_memory, 1, sizeof(g_memory), file);
+		fclose(file);
+	}
+	g_written = FALSE;
+}
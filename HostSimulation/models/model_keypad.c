@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_keypad.c
+ * Description: Source file for the simulated matrix keypad.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <string.h>
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* A key is held for MODEL_KEY_HOLD_MS, "keys" presses one each MODEL_KEY_PERIOD_MS */
+#define MODEL_KEY_HOLD_MS			100
+#define MODEL_KEY_PERIOD_MS			600
+#define MODEL_KEYS_MAX				64
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Model_KeypadConfig g_config;
+static int8_t g_pressedRow = -1;
+static int8_t g_pressedCol = -1;
+static char g_queue[MODEL_KEYS_MAX + 1];
+static uint8_t g_queueIndex = 0;
+static Sim_Event g_releaseEvent;
+static Sim_Event g_nextEvent;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_keypadListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels);
+static void Model_keypadConnect(void);
+static void Model_keypadPress(char label);
+static void Model_keypadRelease(void *arg);
+static void Model_keypadNext(void *arg);
+static void Model_keypadCommandKey(const char *value);
+static void Model_keypadCommandKeys(const char *value);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_keypadInit
+ * [Description]	:
+ * 		Function that connects the keypad, rows & columns have external
+ * 		pull-up resistors so a row driven low shows on a pressed key column.
+ * [Args]	:
+ * [In] config	: Indicates keypad wiring & labels.
+ * [Return]		: Void.
+ */
+void Model_keypadInit(const Model_KeypadConfig *config)
+{
+	uint8_t index;
+	g_config = *config;
+	for (index = 0; index < g_config.rows; index++)
+	{
+		Sim_gpioSetPull(g_config.rowPort, g_config.firstRowPin + index, SIM_PULL_UP);
+	}
+	for (index = 0; index < g_config.cols; index++)
+	{
+		Sim_gpioSetPull(g_config.colPort, g_config.firstColPin + index, SIM_PULL_UP);
+	}
+	Sim_eventInit(&g_releaseEvent, Model_keypadRelease, NULL);
+	Sim_eventInit(&g_nextEvent, Model_keypadNext, NULL);
+	Sim_gpioAddListener(g_config.rowPort, Model_keypadListener, NULL);
+	Sim_addCommand("key", Model_keypadCommandKey, "X, press a key for 100 ms");
+	Sim_addCommand("keys", Model_keypadCommandKeys, "XYZ, press keys one each 600 ms");
+}
+
+/*
+ * [Function Name]	: Model_keypadListener
+ * [Description]	:
+ * 		GPIO call-back of the rows port.
+ */
+static void Model_keypadListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels)
+{
+	(void) arg;
+	(void) port;
+	(void) oldLevels;
+	(void) newLevels;
+	Model_keypadConnect();
+}
+
+/*
+ * [Function Name]	: Model_keypadConnect
+ * [Description]	:
+ * 		Function that pulls the pressed key column low while the MCU drives
+ * 		it's row low.
+ */
+static void Model_keypadConnect(void)
+{
+	uint8_t col;
+	for (col = 0; col < g_config.cols; col++)
+	{
+		uint8_t pin = g_config.firstColPin + col;
+		uint8_t connected = (col == g_pressedCol)
+				&& Sim_gpioIsDrivenLow(g_config.rowPort,
+						g_config.firstRowPin + (uint8_t) g_pressedRow);
+		uint8_t low = !Sim_gpioLevel(g_config.colPort, pin);
+		/* Drive only on changes, levels resolve again after each drive */
+		if (connected && !low)
+		{
+			Sim_gpioDrive(g_config.colPort, pin, 0);
+		}
+		else if (!connected && low && !Sim_gpioIsDrivenLow(g_config.colPort, pin))
+		{
+			Sim_gpioDrive(g_config.colPort, pin, SIM_DRIVE_NONE);
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Model_keypadPress
+ * [Description]	:
+ * 		Function that presses the key with a label.
+ */
+static void Model_keypadPress(char label)
+{
+	const char *position = strchr(g_config.labels, label);
+	if ((label == '\0') || (position == NULL))
+	{
+		Sim_log("KEYPAD", "no key '%c'", label);
+		return;
+	}
+	g_pressedRow = (int8_t) ((position - g_config.labels) / g_config.cols);
+	g_pressedCol = (int8_t) ((position - g_config.labels) % g_config.cols);
+	Sim_log("KEYPAD", "press '%c'", label);
+	Model_keypadConnect();
+	Sim_eventSchedule(&g_releaseEvent,
+			Sim_cycles + Sim_cyclesFromSeconds(MODEL_KEY_HOLD_MS / 1000.0));
+}
+
+/*
+ * [Function Name]	: Model_keypadRelease
+ * [Description]	:
+ * 		Event call-back that releases the pressed key.
+ */
+static void Model_keypadRelease(void *arg)
+{
+	(void) arg;
+	g_pressedRow = -1;
+	g_pressedCol = -1;
+	Model_keypadConnect();
+}
+
+/*
+ * [Function Name]	: Model_keypadNext
+ * [Description]	:
+ * 		Event call-back that presses the next queued key.
+ */
+static void Model_keypadNext(void *arg)
+{
+	(void) arg;
+	if (g_queue[g_queueIndex] != '\0')
+	{
+		Model_keypadPress(g_queue[g_queueIndex++]);
+		Sim_eventSchedule(&g_nextEvent,
+				Sim_cycles + Sim_cyclesFromSeconds(MODEL_KEY_PERIOD_MS / 1000.0));
+	}
+}
+
+/*
+ * [Function Name]	: Model_keypadCommandKey
+ * [Description]	:
+ * 		Command "key=X".
+ */
+static void Model_keypadCommandKey(const char *value)
+{
+	Model_keypadPress(value[0]);
+}
+
+/*
+ * [Function Name]	: Model_keypadCommandKeys
+ * [Description]	:
+ * 		Command "keys=XYZ", replaces keys not pressed yet.
+ */
+static void Model_keypadCommandKeys(const char *value)
+{
+	strncpy(g_queue, value, MODEL_KEYS_MAX);
+	g_queue[MODEL_KEYS_MAX] = '\0';
+	g_queueIndex = 0;
+	Model_keypadNext(NULL);
+}
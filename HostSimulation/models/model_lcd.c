@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_lcd.c
+ * Description: Source file for the simulated HD44780 character LCD.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <string.h>
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define MODEL_LCD_COLUMNS			16
+#define MODEL_LCD_DDRAM_SIZE		0x80
+/* Text is printed once it did not change for this time */
+#define MODEL_LCD_STABLE_MS			20
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Model_LcdConfig g_config;
+static char g_ddram[MODEL_LCD_DDRAM_SIZE];
+static uint8_t g_address = 0;
+static uint8_t g_increment = TRUE;
+static uint8_t g_cgram = FALSE;
+static uint8_t g_displayOn = FALSE;
+/* Starts with an 8-bit interface, 4-bit wiring sends nibbles after function set */
+static uint8_t g_interface8Bit = TRUE;
+static uint8_t g_highNibble = TRUE;
+static uint8_t g_nibble;
+static Sim_Event g_printEvent;
+static char g_printed[4 * (MODEL_LCD_COLUMNS + 3) + 1];
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_lcdListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels);
+static void Model_lcdExecute(uint8_t isData, uint8_t value);
+static void Model_lcdPrint(void *arg);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_lcdInit
+ * [Description]	:
+ * 		Function that connects the LCD, data is latched at E falling edge.
+ * [Args]	:
+ * [In] config	: Indicates LCD wiring.
+ * [Return]		: Void.
+ */
+void Model_lcdInit(const Model_LcdConfig *config)
+{
+	g_config = *config;
+	memset(g_ddram, ' ', sizeof(g_ddram));
+	Sim_eventInit(&g_printEvent, Model_lcdPrint, NULL);
+	Sim_gpioAddListener(g_config.ePort, Model_lcdListener, NULL);
+}
+
+/*
+ * [Function Name]	: Model_lcdListener
+ * [Description]	:
+ * 		GPIO call-back that latches the data bus at E falling edge, read
+ * 		cycles (RW high) are ignored.
+ */
+static void Model_lcdListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels)
+{
+	uint8_t bus;
+	(void) arg;
+	(void) port;
+
+	if (!((oldLevels >> g_config.ePin) & 1) || ((newLevels >> g_config.ePin) & 1))
+	{
+		return;
+	}
+	if ((g_config.rwPort != MODEL_NO_PIN) && Sim_gpioLevel(g_config.rwPort, g_config.rwPin))
+	{
+		return;
+	}
+	bus = Sim_gpioPortLevels(g_config.dataPort);
+	if (g_config.dataBits == 8)
+	{
+		Model_lcdExecute(Sim_gpioLevel(g_config.rsPort, g_config.rsPin), bus);
+		return;
+	}
+	bus = (bus >> g_config.db4Pin) & 0x0F;
+	if (g_interface8Bit)
+	{
+		/* DB0 .. DB3 are not connected */
+		Model_lcdExecute(Sim_gpioLevel(g_config.rsPort, g_config.rsPin), bus << 4);
+	}
+	else if (g_highNibble)
+	{
+		g_nibble = bus;
+		g_highNibble = FALSE;
+	}
+	else
+	{
+		g_highNibble = TRUE;
+		Model_lcdExecute(Sim_gpioLevel(g_config.rsPort, g_config.rsPin),
+				(g_nibble << 4) | bus);
+	}
+}
+
+/*
+ * [Function Name]	: Model_lcdExecute
+ * [Description]	:
+ * 		Function that executes an instruction or writes a character, CGRAM
+ * 		contents & display shift are not modelled.
+ */
+static void Model_lcdExecute(uint8_t isData, uint8_t value)
+{
+	if (isData)
+	{
+		if (!g_cgram)
+		{
+			g_ddram[g_address] = (char) value;
+			g_address = (g_address + (g_increment ? 1 : MODEL_LCD_DDRAM_SIZE - 1))
+					% MODEL_LCD_DDRAM_SIZE;
+		}
+	}
+	else if (value & 0x80)
+	{
+		g_address = value & 0x7F;
+		g_cgram = FALSE;
+	}
+	else if (value & 0x40)
+	{
+		g_cgram = TRUE;
+	}
+	else if (value & 0x20)
+	{
+		g_interface8Bit = (value & 0x10) != 0;
+		g_highNibble = TRUE;
+	}
+	else if (value & 0x10)
+	{
+		/* Cursor move, display shift is ignored */
+		if (!(value & 0x08))
+		{
+			g_address = (g_address + ((value & 0x04) ? 1 : MODEL_LCD_DDRAM_SIZE - 1))
+					% MODEL_LCD_DDRAM_SIZE;
+		}
+	}
+	else if (value & 0x08)
+	{
+		g_displayOn = (value & 0x04) != 0;
+	}
+	else if (value & 0x04)
+	{
+		g_increment = (value & 0x02) != 0;
+	}
+	else if (value & 0x02)
+	{
+		g_address = 0;
+	}
+	else if (value & 0x01)
+	{
+		memset(g_ddram, ' ', sizeof(g_ddram));
+		g_address = 0;
+		g_increment = TRUE;
+	}
+	/* Print after the firmware stops changing the display */
+	Sim_eventSchedule(&g_printEvent,
+			Sim_cycles + Sim_cyclesFromSeconds(MODEL_LCD_STABLE_MS / 1000.0));
+}
+
+/*
+ * [Function Name]	: Model_lcdPrint
+ * [Description]	:
+ * 		Event call-back that prints the visible text if it changed, rows
+ * 		start at addresses 0x00, 0x40, 0x10 & 0x50.
+ */
+static void Model_lcdPrint(void *arg)
+{
+	static const uint8_t rowAddress[4] = { 0x00, 0x40, 0x10, 0x50 };
+	char text[sizeof(g_printed)];
+	char *cursor = text;
+	uint8_t row;
+	uint8_t column;
+	(void) arg;
+
+	for (row = 0; row < g_config.rows; row++)
+	{
+		*cursor++ = '|';
+		for (column = 0; column < MODEL_LCD_COLUMNS; column++)
+		{
+			char character = g_ddram[rowAddress[row] + column];
+			*cursor++ = (g_displayOn && (character >= ' ') && (character <= '~')) ?
+					character : ' ';
+		}
+		*cursor++ = '|';
+		*cursor++ = ' ';
+	}
+	*(cursor - 1) = '\0';
+	if (strcmp(text, g_printed) != 0)
+	{
+		strcpy(g_printed, text);
+		Sim_log("LCD", "%s", text);
+	}
+}
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_lm35.c
+ * Description: Source file for the simulated LM35 temperature sensor.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdlib.h>
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* LM35 output is 10 mV per degree */
+#define MODEL_LM35_VOLTS_PER_C		0.01
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static uint8_t g_channel;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_lm35CommandTemp(const char *value);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_lm35Init
+ * [Description]	:
+ * 		Function that connects the sensor output to an ADC channel.
+ * [Args]	:
+ * [In] channel	: Indicates ADC channel.
+ * [In] celsius	: Indicates initial temperature.
+ * [Return]		: Void.
+ */
+void Model_lm35Init(uint8_t channel, double celsius)
+{
+	g_channel = channel;
+	Sim_adcSetVoltage(g_channel, celsius * MODEL_LM35_VOLTS_PER_C);
+	Sim_addCommand("temp", Model_lm35CommandTemp, "C, set LM35 temperature");
+}
+
+/*
+ * [Function Name]	: Model_lm35CommandTemp
+ * [Description]	:
+ * 		Command "temp=C".
+ */
+static void Model_lm35CommandTemp(const char *value)
+{
+	double celsius = atof(value);
+	Sim_log("LM35", "temperature %.1f C", celsius);
+	Sim_adcSetVoltage(g_channel, celsius * MODEL_LM35_VOLTS_PER_C);
+}
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_motor.c
+ * Description: Source file for the simulated H-bridge DC motor.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* State is sampled each period while the motor runs & logged once stable */
+#define MODEL_MOTOR_SAMPLE_MS		50
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+	MODEL_MOTOR_STOP, MODEL_MOTOR_CW, MODEL_MOTOR_ACW
+} Model_MotorDirection;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static uint8_t g_port;
+static uint8_t g_in1Pin;
+static uint8_t g_in2Pin;
+static Model_MotorDirection g_direction = MODEL_MOTOR_STOP;
+static uint8_t g_speed = 0;
+/* Last sampled state, logged when two samples agree */
+static Model_MotorDirection g_sampledDirection = MODEL_MOTOR_STOP;
+static uint8_t g_sampledSpeed = 0;
+static Sim_Event g_sampleEvent;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_motorListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels);
+static void Model_motorSample(void *arg);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_motorInit
+ * [Description]	:
+ * 		Function that connects the motor driver inputs, the enable input is
+ * 		OC0 so the speed is the duty cycle of timer0 PWM while OC0 is
+ * 		connected or full speed otherwise.
+ * [Args]	:
+ * [In] port	: Indicates port of the direction inputs.
+ * [In] in1Pin	: Indicates IN1 pin.
+ * [In] in2Pin	: Indicates IN2 pin.
+ * [Return]		: Void.
+ */
+void Model_motorInit(uint8_t port, uint8_t in1Pin, uint8_t in2Pin)
+{
+	g_port = port;
+	g_in1Pin = in1Pin;
+	g_in2Pin = in2Pin;
+	Sim_eventInit(&g_sampleEvent, Model_motorSample, NULL);
+	Sim_gpioAddListener(port, Model_motorListener, NULL);
+}
+
+/*
+ * [Function Name]	: Model_motorListener
+ * [Description]	:
+ * 		GPIO call-back of the direction inputs port.
+ */
+static void Model_motorListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels)
+{
+	uint8_t mask = (1 << g_in1Pin) | (1 << g_in2Pin);
+	(void) arg;
+	(void) port;
+	if (((oldLevels ^ newLevels) & mask) && !g_sampleEvent.pending)
+	{
+		Sim_eventSchedule(&g_sampleEvent,
+				Sim_cycles + Sim_cyclesFromSeconds(MODEL_MOTOR_SAMPLE_MS / 1000.0));
+	}
+}
+
+/*
+ * [Function Name]	: Model_motorSample
+ * [Description]	:
+ * 		Event call-back that samples direction & speed.
+ */
+static void Model_motorSample(void *arg)
+{
+	uint8_t in1 = Sim_gpioLevel(g_port, g_in1Pin);
+	uint8_t in2 = Sim_gpioLevel(g_port, g_in2Pin);
+	Model_MotorDirection direction = (in1 == in2) ? MODEL_MOTOR_STOP :
+										in1 ? MODEL_MOTOR_CW : MODEL_MOTOR_ACW;
+	uint8_t speed = 100;
+	(void) arg;
+
+	/* OC0 is connected in a PWM mode (WGM00 set) with COM01 set */
+	if ((TCCR0 & (1 << WGM00)) && (TCCR0 & (1 << COM01)))
+	{
+		speed = (uint8_t) ((OCR0 * 100U + 127U) / 255U);
+		if (TCCR0 & (1 << COM00))
+		{
+			speed = 100 - speed;
+		}
+	}
+	if (direction == MODEL_MOTOR_STOP)
+	{
+		speed = 0;
+	}
+	if ((direction == g_sampledDirection) && (speed == g_sampledSpeed)
+			&& ((direction != g_direction) || (speed != g_speed)))
+	{
+		static const char *const names[] = { "stop", "clockwise", "anti-clockwise" };
+		g_direction = direction;
+		g_speed = speed;
+		Sim_log("MOTOR", "%s %u%%", names[direction], speed);
+	}
+	g_sampledDirection = direction;
+	g_sampledSpeed = speed;
+	if ((direction != MODEL_MOTOR_STOP) || (direction != g_direction))
+	{
+		Sim_eventSchedule(&g_sampleEvent,
+				Sim_cycles + Sim_cyclesFromSeconds(MODEL_MOTOR_SAMPLE_MS / 1000.0));
+	}
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_pin.c
+ * Description: Source file for the simulated output indicators.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "models.h"
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	const char *name;
+	uint8_t port;
+	uint8_t pin;
+} Model_Pin;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Model_Pin g_pins[MODEL_PINS_MAX];
+static uint8_t g_pinsNum = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_pinListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_pinInit
+ * [Description]	:
+ * 		Function that logs level changes of a pin.
+ * [Args]	:
+ * [In] name	: Indicates name printed with the level.
+ * [In] port	: Indicates port ID.
+ * [In] pin		: Indicates pin number.
+ * [Return]		: Void.
+ */
+void Model_pinInit(const char *name, uint8_t port, uint8_t pin)
+{
+	if (g_pinsNum == MODEL_PINS_MAX)
+	{
+		Sim_fatal("too many monitored pins");
+	}
+	g_pins[g_pinsNum].name = name;
+	g_pins[g_pinsNum].port = port;
+	g_pins[g_pinsNum].pin = pin;
+	Sim_gpioAddListener(port, Model_pinListener, &g_pins[g_pinsNum]);
+	g_pinsNum++;
+}
+
+/*
+ * [Function Name]	: Model_pinListener
+ * [Description]	:
+ * 		GPIO call-back of the pin port.
+ */
+static void Model_pinListener(void *arg, uint8_t port, uint8_t oldLevels, uint8_t newLevels)
+{
+	Model_Pin *pin = (Model_Pin *) arg;
+	(void) port;
+	if ((oldLevels ^ newLevels) & (1 << (*pin).pin))
+	{
+		Sim_log("PIN", "%s %s", (*pin).name, ((newLevels >> (*pin).pin) & 1) ? "on" : "off");
+	}
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_seven_segment.c
+ * Description: Source file for the simulated multiplexed seven-segment display.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define MODEL_SEGMENT_DIGITS_MAX	8
+/* Default print period, the display may change each refresh */
+#define MODEL_SEGMENT_PERIOD_MS		"1000"
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static uint8_t g_anodePort;
+static uint8_t g_firstAnodePin;
+static uint8_t g_digitsNum;
+static uint8_t g_bcdPort;
+static uint8_t g_firstBcdPin;
+/* Digit 0 is the right most one, '-' before it was ever enabled */
+static char g_scan[MODEL_SEGMENT_DIGITS_MAX + 1];
+/* Digits of the last complete refresh cycle */
+static char g_digits[MODEL_SEGMENT_DIGITS_MAX + 1];
+static char g_printed[MODEL_SEGMENT_DIGITS_MAX + 1];
+static uint64_t g_period;
+static uint64_t g_printTime = 0;
+static Sim_Event g_printEvent;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_sevenSegmentListener(void *arg, uint8_t port, uint8_t oldLevels,
+		uint8_t newLevels);
+static void Model_sevenSegmentPrint(void *arg);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_sevenSegmentInit
+ * [Description]	:
+ * 		Function that connects the display, one digit is shown while it's
+ * 		anode pin is high & the BCD pins hold it's value. Digits of complete
+ * 		refresh cycles are printed at most once each SIM_SEGMENT_PERIOD_MS.
+ * [Args]	:
+ * [In] anodePort		: Indicates port of the anode pins.
+ * [In] firstAnodePin	: Indicates anode pin of the right most digit.
+ * [In] digits			: Indicates number of digits.
+ * [In] bcdPort			: Indicates port of the decoder inputs.
+ * [In] firstBcdPin		: Indicates decoder input A pin.
+ * [Return]				: Void.
+ */
+void Model_sevenSegmentInit(uint8_t anodePort, uint8_t firstAnodePin, uint8_t digits,
+		uint8_t bcdPort, uint8_t firstBcdPin)
+{
+	g_anodePort = anodePort;
+	g_firstAnodePin = firstAnodePin;
+	g_digitsNum = (digits > MODEL_SEGMENT_DIGITS_MAX) ? MODEL_SEGMENT_DIGITS_MAX : digits;
+	g_bcdPort = bcdPort;
+	g_firstBcdPin = firstBcdPin;
+	memset(g_scan, '-', g_digitsNum);
+	g_period = Sim_cyclesFromSeconds(
+			atof(Sim_getOption("SIM_SEGMENT_PERIOD_MS", MODEL_SEGMENT_PERIOD_MS)) / 1000.0);
+	Sim_eventInit(&g_printEvent, Model_sevenSegmentPrint, NULL);
+	Sim_gpioAddListener(anodePort, Model_sevenSegmentListener, NULL);
+}
+
+/*
+ * [Function Name]	: Model_sevenSegmentListener
+ * [Description]	:
+ * 		GPIO call-back of the anodes port, a digit takes the BCD value when
+ * 		it is enabled alone.
+ */
+static void Model_sevenSegmentListener(void *arg, uint8_t port, uint8_t oldLevels,
+		uint8_t newLevels)
+{
+	uint8_t anodes = (newLevels >> g_firstAnodePin) & ((1 << g_digitsNum) - 1);
+	uint8_t digit;
+	uint8_t value;
+	(void) arg;
+	(void) port;
+	(void) oldLevels;
+
+	if ((anodes == 0) || (anodes & (anodes - 1)))
+	{
+		return;
+	}
+	for (digit = 0; !(anodes & (1 << digit)); digit++)
+	{
+	}
+	value = (Sim_gpioPortLevels(g_bcdPort) >> g_firstBcdPin) & 0x0F;
+	/* A 7447 decoder shows values above 9 as symbols, blank is enough */
+	g_scan[g_digitsNum - 1 - digit] = (value <= 9) ? (char) ('0' + value) : ' ';
+	/* The left most digit ends a refresh cycle */
+	if (digit != g_digitsNum - 1)
+	{
+		return;
+	}
+	strcpy(g_digits, g_scan);
+	if (!g_printEvent.pending && (strcmp(g_digits, g_printed) != 0))
+	{
+		Sim_eventSchedule(&g_printEvent,
+				((g_printed[0] == '\0') || (Sim_cycles > g_printTime + g_period)) ?
+						Sim_cycles : g_printTime + g_period);
+	}
+}
+
+/*
+ * [Function Name]	: Model_sevenSegmentPrint
+ * [Description]	:
+ * 		Event call-back that prints the digits if they changed.
+ */
+static void Model_sevenSegmentPrint(void *arg)
+{
+	(void) arg;
+	if (strcmp(g_digits, g_printed) != 0)
+	{
+		g_printTime = Sim_cycles;
+		strcpy(g_printed, g_digits);
+		Sim_log("7SEG", "%s", g_printed);
+	}
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: model_ultrasonic.c
+ * Description: Source file for the simulated HC-SR04 ultrasonic sensors.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdlib.h>
+#include "models.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Trigger pulse width, burst time before the echo & echo time per cm */
+#define MODEL_ULTRASONIC_TRIGGER_US		10.0
+#define MODEL_ULTRASONIC_BURST_US		250.0
+#define MODEL_ULTRASONIC_US_PER_CM		58.0
+/* Out of range echo width */
+#define MODEL_ULTRASONIC_MIN_CM			2.0
+#define MODEL_ULTRASONIC_MAX_CM			400.0
+#define MODEL_ULTRASONIC_TIMEOUT_US		38000.0
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	double centimeters;
+	uint64_t triggerTime;
+	uint8_t echo;
+	Sim_Event echoEvent;
+} Model_Ultrasonic;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Model_UltrasonicConfig g_config;
+static Model_Ultrasonic g_sensors[MODEL_ULTRASONIC_MAX];
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Model_ultrasonicTriggerListener(void *arg, uint8_t port, uint8_t oldLevels,
+		uint8_t newLevels);
+static void Model_ultrasonicMuxListener(void *arg, uint8_t port, uint8_t oldLevels,
+		uint8_t newLevels);
+static void Model_ultrasonicEcho(void *arg);
+static void Model_ultrasonicRoute(void);
+static void Model_ultrasonicCommandDistance(const char *value);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Model_ultrasonicInit
+ * [Description]	:
+ * 		Function that connects the sensors.
+ * [Args]	:
+ * [In] config		: Indicates sensors wiring.
+ * [In] centimeters	: Indicates initial distance of all sensors.
+ * [Return]			: Void.
+ */
+void Model_ultrasonicInit(const Model_UltrasonicConfig *config, double centimeters)
+{
+	uint8_t sensor;
+	g_config = *config;
+	if (g_config.sensors > MODEL_ULTRASONIC_MAX)
+	{
+		Sim_fatal("too many ultrasonic sensors");
+	}
+	for (sensor = 0; sensor < g_config.sensors; sensor++)
+	{
+		g_sensors[sensor].centimeters = centimeters;
+		Sim_eventInit(&g_sensors[sensor].echoEvent, Model_ultrasonicEcho,
+				&g_sensors[sensor]);
+	}
+	Sim_gpioAddListener(g_config.triggerPort, Model_ultrasonicTriggerListener, NULL);
+	if (g_config.muxPort != MODEL_NO_PIN)
+	{
+		Sim_gpioAddListener(g_config.muxPort, Model_ultrasonicMuxListener, NULL);
+	}
+	Model_ultrasonicRoute();
+	Sim_addCommand("distance", Model_ultrasonicCommandDistance,
+			"CM or N:CM, set distance of all sensors or sensor N");
+}
+
+/*
+ * [Function Name]	: Model_ultrasonicTriggerListener
+ * [Description]	:
+ * 		GPIO call-back of the trigger port, a pulse of 10 us at least starts
+ * 		a ping at it's falling edge.
+ */
+static void Model_ultrasonicTriggerListener(void *arg, uint8_t port, uint8_t oldLevels,
+		uint8_t newLevels)
+{
+	uint8_t sensor;
+	(void) arg;
+	(void) port;
+
+	for (sensor = 0; sensor < g_config.sensors; sensor++)
+	{
+		uint8_t pin = g_config.firstTriggerPin + sensor;
+		Model_Ultrasonic *ultrasonic = &g_sensors[sensor];
+		uint8_t wasHigh = (oldLevels >> pin) & 1;
+		uint8_t isHigh = (newLevels >> pin) & 1;
+
+		if (!wasHigh && isHigh)
+		{
+			(*ultrasonic).triggerTime = Sim_cycles;
+		}
+		else if (wasHigh && !isHigh && !(*ultrasonic).echo
+				&& !(*ultrasonic).echoEvent.pending
+				&& (Sim_cycles - (*ultrasonic).triggerTime
+						>= Sim_cyclesFromSeconds(MODEL_ULTRASONIC_TRIGGER_US / 1e6)))
+		{
+			Sim_eventSchedule(&(*ultrasonic).echoEvent,
+					Sim_cycles + Sim_cyclesFromSeconds(MODEL_ULTRASONIC_BURST_US / 1e6));
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Model_ultrasonicMuxListener
+ * [Description]	:
+ * 		GPIO call-back of the multiplexer port.
+ */
+static void Model_ultrasonicMuxListener(void *arg, uint8_t port, uint8_t oldLevels,
+		uint8_t newLevels)
+{
+	(void) arg;
+	(void) port;
+	(void) oldLevels;
+	(void) newLevels;
+	Model_ultrasonicRoute();
+}
+
+/*
+ * [Function Name]	: Model_ultrasonicEcho
+ * [Description]	:
+ * 		Event call-back that starts or ends an echo pulse.
+ */
+static void Model_ultrasonicEcho(void *arg)
+{
+	Model_Ultrasonic *ultrasonic = (Model_Ultrasonic *) arg;
+	double widthUs;
+
+	(*ultrasonic).echo = !(*ultrasonic).echo;
+	if ((*ultrasonic).echo)
+	{
+		widthUs = (((*ultrasonic).centimeters < MODEL_ULTRASONIC_MIN_CM)
+				|| ((*ultrasonic).centimeters > MODEL_ULTRASONIC_MAX_CM)) ?
+				MODEL_ULTRASONIC_TIMEOUT_US :
+				(*ultrasonic).centimeters * MODEL_ULTRASONIC_US_PER_CM;
+		Sim_eventSchedule(&(*ultrasonic).echoEvent,
+				Sim_cycles + Sim_cyclesFromSeconds(widthUs / 1e6));
+	}
+	Model_ultrasonicRoute();
+}
+
+/*
+ * [Function Name]	: Model_ultrasonicRoute
+ * [Description]	:
+ * 		Function that drives the echo pin by the selected sensor.
+ */
+static void Model_ultrasonicRoute(void)
+{
+	uint8_t selected = 0;
+	uint8_t bit;
+
+	if (g_config.muxPort != MODEL_NO_PIN)
+	{
+		for (bit = 0; bit < g_config.muxBits; bit++)
+		{
+			selected |= Sim_gpioLevel(g_config.muxPort, g_config.firstMuxPin + bit) << bit;
+		}
+	}
+	/* Unused multiplexer channels are grounded */
+	Sim_gpioDrive(g_config.echoPort, g_config.echoPin,
+			(selected < g_config.sensors) && g_sensors[selected].echo);
+}
+
+/*
+ * [Function Name]	: Model_ultrasonicCommandDistance
+ * [Description]	:
+ * 		Command "distance=CM" or "distance=N:CM".
+ */
+static void Model_ultrasonicCommandDistance(const char *value)
+{
+	char *end;
+	double number = strtod(value, &end);
+	uint8_t sensor;
+
+	if (*end == ':')
+	{
+		sensor = (uint8_t) number;
+		if (sensor < g_config.sensors)
+		{
+			g_sensors[sensor].centimeters = atof(end + 1);
+			Sim_log("SONAR", "sensor %u at %.1f cm", sensor, g_sensors[sensor].centimeters);
+		}
+		return;
+	}
+	for (sensor = 0; sensor < g_config.sensors; sensor++)
+	{
+		g_sensors[sensor].centimeters = number;
+	}
+	Sim_log("SONAR", "distance %.1f cm", number);
+}
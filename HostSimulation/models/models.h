@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: models.h
+ * Description: Header file for the simulated board components.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef MODELS_H_
+#define MODELS_H_
+
+#include "sim.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Pin not connected to the MCU, like a grounded LCD RW pin */
+#define MODEL_NO_PIN				0xFF
+
+#define MODEL_KEYPAD_ROWS_MAX		4
+#define MODEL_KEYPAD_COLS_MAX		4
+#define MODEL_ULTRASONIC_MAX		8
+#define MODEL_BUTTONS_MAX			8
+#define MODEL_PINS_MAX				8
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Model_LcdConfig
+ * [Description]	:
+ * 		A structure that describes the wiring of an HD44780 character LCD.
+ * 		rwPort		: (MODEL_NO_PIN) when RW is grounded.
+ * 		dataBits	: 8 uses the whole data port, 4 uses pins db4Pin .. db4Pin + 3.
+ * 		rows		: 2 or 4 rows of 16 characters.
+ */
+typedef struct
+{
+	uint8_t rsPort;
+	uint8_t rsPin;
+	uint8_t ePort;
+	uint8_t ePin;
+	uint8_t rwPort;
+	uint8_t rwPin;
+	uint8_t dataPort;
+	uint8_t dataBits;
+	uint8_t db4Pin;
+	uint8_t rows;
+} Model_LcdConfig;
+
+/*
+ * [Structure Name]	: Model_KeypadConfig
+ * [Description]	:
+ * 		A structure that describes a passive matrix keypad, a pressed key
+ * 		connects it's row & column pins. labels holds one character per key,
+ * 		row after row, used by the "key" & "keys" commands.
+ */
+typedef struct
+{
+	uint8_t rowPort;
+	uint8_t firstRowPin;
+	uint8_t colPort;
+	uint8_t firstColPin;
+	uint8_t rows;
+	uint8_t cols;
+	const char *labels;
+} Model_KeypadConfig;
+
+/*
+ * [Structure Name]	: Model_UltrasonicConfig
+ * [Description]	:
+ * 		A structure that describes HC-SR04 sensors with consecutive trigger
+ * 		pins & echo outputs routed to one pin through a multiplexer.
+ * 		muxPort		: (MODEL_NO_PIN) without a multiplexer.
+ */
+typedef struct
+{
+	uint8_t sensors;
+	uint8_t triggerPort;
+	uint8_t firstTriggerPin;
+	uint8_t echoPort;
+	uint8_t echoPin;
+	uint8_t muxPort;
+	uint8_t firstMuxPin;
+	uint8_t muxBits;
+} Model_UltrasonicConfig;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/* HD44780 LCD, prints it's text once it is stable */
+void Model_lcdInit(const Model_LcdConfig *config);
+
+/* Matrix keypad, commands "key=X" & "keys=XYZ" */
+void Model_keypadInit(const Model_KeypadConfig *config);
+
+/* 24C16 serial EEPROM on the TWI bus, kept in SIM_EEPROM_FILE if set */
+void Model_eepromInit(void);
+
+/* LM35 temperature sensor on an ADC channel, command "temp=C" */
+void Model_lm35Init(uint8_t channel, double celsius);
+
+/* HC-SR04 ultrasonic sensors, commands "distance=CM" & "distanceN=CM" */
+void Model_ultrasonicInit(const Model_UltrasonicConfig *config, double centimeters);
+
+/* Multiplexed seven-segment display through a BCD decoder */
+void Model_sevenSegmentInit(uint8_t anodePort, uint8_t firstAnodePin, uint8_t digits,
+		uint8_t bcdPort, uint8_t firstBcdPin);
+
+/* Push button, command "press=name" */
+void Model_buttonInit(const char *name, uint8_t port, uint8_t pin, uint8_t pressedLevel);
+
+/* H-bridge DC motor, speed is OCR0 duty cycle when fast PWM is on OC0 */
+void Model_motorInit(uint8_t port, uint8_t in1Pin, uint8_t in2Pin);
+
+/* Output pin that logs it's level changes, like a buzzer or a LED */
+void Model_pinInit(const char *name, uint8_t port, uint8_t pin);
+
+#endif /* MODELS_H_ */
@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim.h
+ * Description: Header file for the simulator core, peripherals & models API.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef SIM_H_
+#define SIM_H_
+
+/* Simulator sources access registers through the unprotected view */
+#if defined(SIM_AVR_IO_H_) && !defined(SIM_INTERNAL)
+
+#error "sim.h should be included before avr/io.h"
+
+#endif
+
+#define SIM_INTERNAL
+
+#include <stdint.h>
+#include <stdio.h>
+#include <avr/io.h>
+
+#ifndef F_CPU
+#error "F_CPU should be defined for the simulated image"
+#endif
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#ifndef TRUE
+#define TRUE					1
+#endif
+#ifndef FALSE
+#define FALSE					0
+#endif
+
+/* Time value that never comes */
+#define SIM_NEVER				UINT64_MAX
+
+/* Data space address of a register name */
+#define SIM_ADDR(reg)			((uint16_t) (&(reg) - Sim_io))
+
+/* Ports IDs, same values as PORTA_ID .. PORTD_ID of the GPIO drivers */
+#define SIM_PORTA				0
+#define SIM_PORTB				1
+#define SIM_PORTC				2
+#define SIM_PORTD				3
+#define SIM_PORTS_NUM			4
+
+/* External drive & resistors of a pin */
+#define SIM_DRIVE_NONE			(-1)
+#define SIM_PULL_NONE			0
+#define SIM_PULL_UP				1
+#define SIM_PULL_DOWN			2
+
+/* ADC auto-trigger sources, same values as ADTS2:0 */
+#define SIM_ADC_TRIG_FREE			0
+#define SIM_ADC_TRIG_ANALOG_COMP	1
+#define SIM_ADC_TRIG_INT0			2
+#define SIM_ADC_TRIG_TIMER0_COMP	3
+#define SIM_ADC_TRIG_TIMER0_OVF		4
+#define SIM_ADC_TRIG_TIMER1_COMPB	5
+#define SIM_ADC_TRIG_TIMER1_OVF		6
+#define SIM_ADC_TRIG_TIMER1_CAPT	7
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Sim_Event
+ * [Description]	:
+ * 		A structure that holds a call-back executed at a simulated time, owned
+ * 		by the caller so it can be cancelled or moved without allocation.
+ */
+typedef struct Sim_Event
+{
+	uint64_t time;
+	void (*handler)(void *arg);
+	void *arg;
+	struct Sim_Event *next;
+	uint8_t pending;
+} Sim_Event;
+
+/*
+ * [Type Name]	: Sim_AccessHook
+ * [Description]	:
+ * 		Call-back executed after the firmware read or wrote a register, it gets
+ * 		the two bytes at the address as they were before the access.
+ */
+typedef void (*Sim_AccessHook)(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+
+/*
+ * [Type Name]	: Sim_GpioListener
+ * [Description]	:
+ * 		Call-back executed when the levels of a port pins change.
+ */
+typedef void (*Sim_GpioListener)(void *arg, uint8_t port, uint8_t oldLevels,
+		uint8_t newLevels);
+
+/*
+ * [Structure Name]	: Sim_TwiDevice
+ * [Description]	:
+ * 		A structure that defines a slave device on the TWI bus.
+ * 		start: addressed with it's 7-bit address, returns ACK.
+ * 		write: byte from master, returns ACK.
+ * 		read : byte to master, ack tells if the master wants more.
+ * 		stop : stop condition or repeated start.
+ */
+typedef struct Sim_TwiDevice
+{
+	uint8_t address;
+	uint8_t (*start)(struct Sim_TwiDevice *device, uint8_t isRead);
+	uint8_t (*write)(struct Sim_TwiDevice *device, uint8_t data);
+	uint8_t (*read)(struct Sim_TwiDevice *device, uint8_t ack);
+	void (*stop)(struct Sim_TwiDevice *device);
+	struct Sim_TwiDevice *next;
+} Sim_TwiDevice;
+
+/*
+ * [Structure Name]	: Sim_Statistics
+ * [Description]	:
+ * 		A structure that holds the run counters since reset, sleepCycles,
+ * 		delayCycles & skippedCycles are parts of cycles.
+ */
+typedef struct
+{
+	uint64_t cycles;
+	uint64_t accesses;
+	uint64_t interrupts;
+	uint64_t sleepCycles;
+	uint64_t delayCycles;
+	uint64_t skippedCycles;
+} Sim_Statistics;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Simulator view of the register file */
+extern uint8_t *Sim_io;
+/* CPU cycles since reset */
+extern uint64_t Sim_cycles;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * Core (sim_core.c)
+ */
+/* Board specific models, defined once per image */
+void Sim_boardInit(void);
+/* Events scheduling */
+void Sim_eventInit(Sim_Event *event, void (*handler)(void *arg), void *arg);
+void Sim_eventSchedule(Sim_Event *event, uint64_t time);
+void Sim_eventCancel(Sim_Event *event);
+/* Register access side effects */
+void Sim_setAccessHook(uint16_t addr, Sim_AccessHook hook);
+/* Time */
+void Sim_advanceTo(uint64_t time);
+uint64_t Sim_nextEventTime(void);
+uint64_t Sim_cyclesFromSeconds(double seconds);
+double Sim_seconds(uint64_t cycles);
+void Sim_restartIdleDetection(void);
+/* Interrupts */
+uint8_t Sim_interruptsEnabled(void);
+void Sim_serviceInterrupt(long vector);
+/* Scripted commands, "name=value" at a time or from the console */
+void Sim_addCommand(const char *name, void (*handler)(const char *value),
+		const char *help);
+void Sim_runCommand(const char *command);
+/* Run counters */
+void Sim_getStatistics(Sim_Statistics *statistics_Ptr);
+/* Output */
+void Sim_log(const char *source, const char *format, ...)
+		__attribute__((format(printf, 2, 3)));
+void Sim_fatal(const char *format, ...)
+		__attribute__((format(printf, 1, 2), noreturn));
+const char *Sim_getOption(const char *name, const char *defaultValue);
+
+/*
+ * GPIO & external interrupts (sim_gpio.c)
+ */
+void Sim_gpioInit(void);
+void Sim_gpioDrive(uint8_t port, uint8_t pin, int level);
+void Sim_gpioSetPull(uint8_t port, uint8_t pin, uint8_t pull);
+uint8_t Sim_gpioLevel(uint8_t port, uint8_t pin);
+uint8_t Sim_gpioPortLevels(uint8_t port);
+uint8_t Sim_gpioIsDrivenLow(uint8_t port, uint8_t pin);
+void Sim_gpioAddListener(uint8_t port, Sim_GpioListener listener, void *arg);
+void Sim_gpioUpdate(void);
+uint8_t Sim_gpioParsePin(const char *name, uint8_t *port, uint8_t *pin);
+
+/*
+ * Timers (sim_timers.c)
+ */
+void Sim_timersInit(void);
+void Sim_timersSync(uint64_t now);
+uint64_t Sim_timersNextEvent(void);
+void Sim_timersSetClockStopped(uint8_t stopped);
+void Sim_timer1Capture(void);
+
+/*
+ * ADC (sim_adc.c)
+ */
+void Sim_adcInit(void);
+void Sim_adcTrigger(uint8_t source);
+void Sim_adcSleepStart(void);
+void Sim_adcSetVoltage(uint8_t channel, double volts);
+void Sim_adcSetReference(double arefVolts, double avccVolts);
+
+/*
+ * USART (sim_usart.c)
+ */
+void Sim_usartInit(void);
+void Sim_usartReceive(uint8_t data);
+void Sim_usartSetTransmitHandler(void (*handler)(uint8_t data));
+uint8_t Sim_usartReceiverEnabled(void);
+uint64_t Sim_usartFrameCycles(void);
+
+/*
+ * TWI master (sim_twi.c)
+ */
+void Sim_twiInit(void);
+void Sim_twiAttach(Sim_TwiDevice *device);
+
+/*
+ * USART link between processes (sim_link.c)
+ */
+void Sim_linkInit(void);
+uint8_t Sim_linkConnected(void);
+/* Time before which the peer ECU will not send anything */
+uint64_t Sim_linkPeerTime(void);
+/* Tells the peer this CPU can not transmit before (busyFrom) & waits for it */
+void Sim_linkSync(uint64_t busyFrom);
+
+#endif /* SIM_H_ */
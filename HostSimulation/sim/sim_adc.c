@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim_adc.c
+ * Description: Source file for the simulated ADC.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_ADC_CHANNELS_NUM		8
+#define SIM_ADC_MAXIMUM				1023
+#define SIM_ADC_FIRST_CLOCKS		25
+#define SIM_ADC_CLOCKS				13
+#define SIM_ADC_BANDGAP_CHANNEL		0x1E
+#define SIM_ADC_GROUND_CHANNEL		0x1F
+#define SIM_ADC_BANDGAP_VOLTS		1.22
+#define SIM_ADC_INTERNAL_VOLTS		2.56
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static double g_channelVolts[SIM_ADC_CHANNELS_NUM];
+static double g_arefVolts = 5.0;
+static double g_avccVolts = 5.0;
+static uint8_t g_firstConversion = TRUE;
+static uint8_t g_converting = FALSE;
+static uint16_t g_sample = 0;
+static Sim_Event g_conversionEvent;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Sim_adcStart(void);
+static void Sim_adcComplete(void *arg);
+static void Sim_adcControlHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_adcInit
+ * [Description]	:
+ * 		Function that resets the ADC & installs hooks.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_adcInit(void)
+{
+	Sim_eventInit(&g_conversionEvent, Sim_adcComplete, NULL);
+	Sim_setAccessHook(SIM_ADDR(ADCSRA), Sim_adcControlHook);
+}
+
+/*
+ * [Function Name]	: Sim_adcSetVoltage
+ * [Description]	:
+ * 		Function that sets the input voltage of a single ended channel.
+ * [Args]	:
+ * [In] channel	: Indicates channel 0 .. 7.
+ * [In] volts	: Indicates voltage.
+ * [Return]		: Void.
+ */
+void Sim_adcSetVoltage(uint8_t channel, double volts)
+{
+	if (channel < SIM_ADC_CHANNELS_NUM)
+	{
+		g_channelVolts[channel] = volts;
+	}
+}
+
+/*
+ * [Function Name]	: Sim_adcSetReference
+ * [Description]	:
+ * 		Function that sets the board voltages on the AREF & AVCC pins.
+ */
+void Sim_adcSetReference(double arefVolts, double avccVolts)
+{
+	g_arefVolts = arefVolts;
+	g_avccVolts = avccVolts;
+}
+
+/*
+ * [Function Name]	: Sim_adcTrigger
+ * [Description]	:
+ * 		Function that starts a conversion on the selected auto trigger source.
+ * [Args]	:
+ * [In] source	: Indicates trigger source, one of (SIM_ADC_TRIG_*).
+ * [Return]		: Void.
+ */
+void Sim_adcTrigger(uint8_t source)
+{
+	if ((ADCSRA & (1 << ADEN)) && (ADCSRA & (1 << ADATE))
+			&& (((SFIOR >> ADTS0) & 0x07) == source) && !g_converting)
+	{
+		Sim_adcStart();
+	}
+}
+
+/*
+ * [Function Name]	: Sim_adcSleepStart
+ * [Description]	:
+ * 		Function that starts a conversion on entering ADC noise reduction mode.
+ */
+void Sim_adcSleepStart(void)
+{
+	if ((ADCSRA & (1 << ADEN)) && !g_converting)
+	{
+		Sim_adcStart();
+	}
+}
+
+/*
+ * [Function Name]	: Sim_adcStart
+ * [Description]	:
+ * 		Function that samples the selected input & schedules the result after
+ * 		13 ADC clocks, 25 for the first conversion after enable.
+ */
+static void Sim_adcStart(void)
+{
+	uint8_t channel = ADMUX & 0x1F;
+	uint8_t divisionFactor = ADCSRA & 0x07;
+	uint32_t prescaler = (divisionFactor == 0) ? 2 : (1UL << divisionFactor);
+	double input;
+	double reference;
+	double result;
+
+	switch ((ADMUX >> REFS0) & 0x03)
+	{
+		case 0:
+			reference = g_arefVolts;
+		break;
+		case 1:
+			reference = g_avccVolts;
+		break;
+		default:
+			reference = SIM_ADC_INTERNAL_VOLTS;
+		break;
+	}
+	if (channel < SIM_ADC_CHANNELS_NUM)
+	{
+		input = g_channelVolts[channel];
+	}
+	else if (channel == SIM_ADC_BANDGAP_CHANNEL)
+	{
+		input = SIM_ADC_BANDGAP_VOLTS;
+	}
+	else
+	{
+		/* Ground & differential channels */
+		input = 0.0;
+	}
+	result = (reference > 0.0) ? (input * 1024.0 / reference) : 0.0;
+	g_sample = (result >= SIM_ADC_MAXIMUM) ? SIM_ADC_MAXIMUM :
+				(result <= 0.0) ? 0 : (uint16_t) result;
+
+	g_converting = TRUE;
+	ADCSRA |= (1 << ADSC);
+	Sim_eventSchedule(&g_conversionEvent,
+			Sim_cycles
+					+ prescaler
+							* (g_firstConversion ? SIM_ADC_FIRST_CLOCKS : SIM_ADC_CLOCKS));
+	g_firstConversion = FALSE;
+}
+
+/*
+ * [Function Name]	: Sim_adcComplete
+ * [Description]	:
+ * 		Event call-back at the end of a conversion, free running mode starts
+ * 		the next one.
+ */
+static void Sim_adcComplete(void *arg)
+{
+	uint16_t result = g_sample;
+	(void) arg;
+
+	if (ADMUX & (1 << ADLAR))
+	{
+		result <<= 6;
+	}
+	ADCL = (uint8_t) result;
+	ADCH = (uint8_t) (result >> 8);
+	g_converting = FALSE;
+	ADCSRA = (ADCSRA & ~(1 << ADSC)) | (1 << ADIF);
+	Sim_adcTrigger(SIM_ADC_TRIG_FREE);
+}
+
+/*
+ * [Function Name]	: Sim_adcControlHook
+ * [Description]	:
+ * 		Side effects of ADCSRA accesses: ADSC starts a conversion & stays set
+ * 		until it ends, writing one clears ADIF, clearing ADEN aborts.
+ */
+static void Sim_adcControlHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	uint8_t written = Sim_io[addr];
+	uint8_t old = (uint8_t) oldValue;
+	(void) addr;
+
+	if (!isWrite)
+	{
+		return;
+	}
+	ADCSRA = (written & ~((1 << ADIF) | (1 << ADSC)))
+			| (old & ~written & (1 << ADIF));
+	if (!(written & (1 << ADEN)))
+	{
+		Sim_eventCancel(&g_conversionEvent);
+		g_converting = FALSE;
+		g_firstConversion = TRUE;
+	}
+	else if (g_converting)
+	{
+		ADCSRA |= (1 << ADSC);
+	}
+	else if (written & (1 << ADSC))
+	{
+		Sim_adcStart();
+	}
+}
@@ -0,0 +1,1277 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim_core.c
+ * Description: Source file for the simulator core, register traps, time,
+ *              events & interrupts.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "sim.h"
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+/*******************************************************************************
+ *                          Simulator Useful Notes                             *
+ *******************************************************************************/
+/*
+ * 		Register file:
+ * 			One page mapped twice, at (SIM_IO_BASE) with no access for the
+ * 			firmware & read/write at (Sim_io) for the simulator. A firmware
+ * 			access faults, the fault handler brings peripherals up to date,
+ * 			opens the page & single steps the instruction, the trap handler
+ * 			closes the page again & applies the access side effects.
+ *
+ * 		Time:
+ * 			Simulated time is counted in CPU cycles. Firmware code between two
+ * 			register accesses costs nothing, every access costs
+ * 			(SIM_ACCESS_CYCLES), delays & sleep advance time exactly.
+ *
+ * 		Interrupts:
+ * 			Taken after a register access, on SEI + SLEEP or during a delay.
+ * 			After an access the handler pushes the vector on the firmware stack
+ * 			& resumes into a trampoline that saves every call-clobbered register
+ * 			& calls the ISR, like the vector table & prologue on target.
+ *
+ * 		Idle loops:
+ * 			A loop that repeats the same accesses with the same values is polling
+ * 			for something that only an event can change, time jumps to that event.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_TRAP_FLAG				0x100		/* RFLAGS.TF */
+#define SIM_PAGE_FAULT_WRITE		0x02		/* Page fault error code, write access */
+#define SIM_LOOP_HISTORY			256
+#define SIM_LOOP_MIN_REPEATS		4
+/* Identical driver calls in a row, like pins set up one by one, are not polling */
+#define SIM_LOOP_MIN_ACCESSES		64
+#define SIM_INTERRUPT_CYCLES		4			/* Interrupt response & RETI */
+#define SIM_WAKEUP_CYCLES			4
+#define SIM_COMMANDS_MAX			32
+#define SIM_ALT_STACK_SIZE			(64 * 1024)
+#define SIM_CONSOLE_POLL_NS			10000000LL
+
+/* Interrupt vectors allowed to wake the CPU in each sleep mode */
+#define SIM_VECTOR_BIT(vector)		(1UL << (vector))
+#define SIM_WAKE_IDLE				0xFFFFFFFEUL
+#define SIM_WAKE_ADC_NOISE_REDUCTION							\
+	(SIM_VECTOR_BIT(INT0_vect_num) | SIM_VECTOR_BIT(INT1_vect_num) |	\
+	SIM_VECTOR_BIT(INT2_vect_num) | SIM_VECTOR_BIT(TWI_vect_num) |		\
+	SIM_VECTOR_BIT(ADC_vect_num) | SIM_VECTOR_BIT(EE_RDY_vect_num) |	\
+	SIM_VECTOR_BIT(SPM_RDY_vect_num))
+#define SIM_WAKE_POWER_DOWN										\
+	(SIM_VECTOR_BIT(INT0_vect_num) | SIM_VECTOR_BIT(INT1_vect_num) |	\
+	SIM_VECTOR_BIT(INT2_vect_num) | SIM_VECTOR_BIT(TWI_vect_num))
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	const char *name;
+	void (*handler)(const char *value);
+	const char *help;
+} Sim_Command;
+
+typedef struct
+{
+	Sim_Event event;
+	char command[64];
+} Sim_ScriptEntry;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+uint8_t *Sim_io = NULL;
+uint64_t Sim_cycles = 0;
+
+/* Firmware view of the register file */
+static void *g_firmwareIo = NULL;
+/* Access in progress between the fault & the trap */
+static volatile uint8_t g_accessActive = 0;
+static uint16_t g_accessAddr = 0;
+static uint8_t g_accessWrite = 0;
+static uint16_t g_accessOld = 0;
+static uint64_t g_accessRip = 0;
+static uint64_t g_accessCycles = 4;
+static Sim_AccessHook g_hooks[SIM_IO_SIZE];
+
+/* Events sorted by time */
+static Sim_Event *g_events = NULL;
+
+/* Interrupt vectors */
+static void (*g_vectors[SIM_VECTORS_NUM])(void);
+static const char *g_vectorNames[SIM_VECTORS_NUM];
+/* SEI delays interrupts by one instruction */
+static uint8_t g_seiShadow = 0;
+static uint8_t g_interruptDepth = 0;
+
+/* Idle loops detection */
+static uint64_t g_loopHistory[SIM_LOOP_HISTORY];
+static uint32_t g_loopCount = 0;
+static uint32_t g_loopPeriod = 0;
+static uint32_t g_loopRun = 0;
+
+/* Run control */
+static uint64_t g_timeLimit = SIM_NEVER;
+static uint8_t g_realTime = FALSE;
+static struct timespec g_hostStart;
+
+/* Scripted & console commands */
+static Sim_Command g_commands[SIM_COMMANDS_MAX];
+static uint8_t g_commandsNum = 0;
+static uint64_t g_scriptLastTime = 0;
+static int64_t g_consoleNextPoll = 0;
+
+/* Statistics */
+static uint64_t g_statAccesses = 0;
+static uint64_t g_statInterrupts = 0;
+static uint64_t g_statVectorCount[SIM_VECTORS_NUM];
+static uint64_t g_statSleepCycles = 0;
+static uint64_t g_statSkippedCycles = 0;
+static uint64_t g_statDelayCycles = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+void Sim_interruptTrampoline(void);
+static void Sim_faultHandler(int signalNum, siginfo_t *info, void *context);
+static void Sim_trapHandler(int signalNum, siginfo_t *info, void *context);
+static int Sim_pendingVector(uint32_t allowMask);
+static void Sim_dispatchInterrupts(void);
+static void Sim_step(uint64_t limit, uint64_t idleUntil);
+static void Sim_stop(const char *reason);
+static void Sim_printStatistics(void);
+static void Sim_parseScript(const char *script);
+static void Sim_pollConsole(uint8_t block);
+
+/*******************************************************************************
+ *                       Register File & Initialization                        *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_init
+ * [Description]	:
+ * 		Constructor that prepares the register file, peripherals, board models
+ * 		& traps before the firmware main function.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+__attribute__((constructor(101))) static void Sim_init(void)
+{
+	int fd;
+	stack_t altStack;
+	struct sigaction action;
+	const char *option;
+
+	clock_gettime(CLOCK_MONOTONIC, &g_hostStart);
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	/* Same page, two views */
+	fd = memfd_create("sim_io", 0);
+	if ((fd < 0) || (ftruncate(fd, SIM_IO_SIZE) != 0))
+	{
+		Sim_fatal("register file: %s", strerror(errno));
+	}
+	Sim_io = mmap(NULL, SIM_IO_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	g_firmwareIo = mmap((void *) SIM_IO_BASE, SIM_IO_SIZE, PROT_NONE,
+	MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+	if ((Sim_io == MAP_FAILED) || (g_firmwareIo != (void *) SIM_IO_BASE))
+	{
+		Sim_fatal("cannot map register file at 0x%lx", SIM_IO_BASE);
+	}
+	close(fd);
+
+	/* Options */
+	g_accessCycles = strtoull(Sim_getOption("SIM_ACCESS_CYCLES", "4"), NULL, 0);
+	option = Sim_getOption("SIM_TIME_LIMIT", NULL);
+	g_realTime = (atoi(Sim_getOption("SIM_REALTIME", "0")) != 0);
+	if (option != NULL)
+	{
+		g_timeLimit = Sim_cyclesFromSeconds(atof(option));
+	}
+	else if (!g_realTime)
+	{
+		g_timeLimit = Sim_cyclesFromSeconds(10.0);
+	}
+
+	/* Peripherals reset state */
+	Sim_gpioInit();
+	Sim_timersInit();
+	Sim_adcInit();
+	Sim_usartInit();
+	Sim_twiInit();
+	Sim_linkInit();
+	Sim_boardInit();
+
+	/* Scripted events */
+	option = Sim_getOption("SIM_SCRIPT", NULL);
+	if (option != NULL)
+	{
+		FILE *file = fopen(option, "r");
+		char *text;
+		long size;
+		if (file == NULL)
+		{
+			Sim_fatal("SIM_SCRIPT %s: %s", option, strerror(errno));
+		}
+		fseek(file, 0, SEEK_END);
+		size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		text = calloc(1, size + 1);
+		if (fread(text, 1, size, file) != (size_t) size)
+		{
+			Sim_fatal("SIM_SCRIPT %s: read error", option);
+		}
+		fclose(file);
+		Sim_parseScript(text);
+		free(text);
+	}
+	option = Sim_getOption("SIM_EVENTS", NULL);
+	if (option != NULL)
+	{
+		Sim_parseScript(option);
+	}
+
+	/* Traps */
+	altStack.ss_sp = malloc(SIM_ALT_STACK_SIZE);
+	altStack.ss_size = SIM_ALT_STACK_SIZE;
+	altStack.ss_flags = 0;
+	sigaltstack(&altStack, NULL);
+	memset(&action, 0, sizeof(action));
+	action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+	sigemptyset(&action.sa_mask);
+	action.sa_sigaction = Sim_faultHandler;
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = Sim_trapHandler;
+	sigaction(SIGTRAP, &action, NULL);
+
+	atexit(Sim_printStatistics);
+	Sim_log("SIM", "ATmega32 @ %lu Hz", (unsigned long) F_CPU);
+}
+
+/*
+ * [Function Name]	: Sim_setAccessHook
+ * [Description]	:
+ * 		Function that sets the side effects call-back of a register address.
+ * [Args]	:
+ * [In] addr	: Indicates register data space address.
+ * [In] hook	: Indicates call-back function address.
+ * [Return]		: Void.
+ */
+void Sim_setAccessHook(uint16_t addr, Sim_AccessHook hook)
+{
+	g_hooks[addr] = hook;
+}
+
+/*******************************************************************************
+ *                            Register Access Traps                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_faultHandler
+ * [Description]	:
+ * 		SIGSEGV handler, first half of a register access: time advances to the
+ * 		access & the page opens for one instruction.
+ */
+static void Sim_faultHandler(int signalNum, siginfo_t *info, void *context)
+{
+	ucontext_t *userContext = (ucontext_t *) context;
+	uintptr_t addr = (uintptr_t) info->si_addr;
+	(void) signalNum;
+
+	if ((addr < SIM_IO_BASE) || (addr >= SIM_IO_BASE + SIM_IO_SIZE)
+			|| g_accessActive)
+	{
+		/* A real crash, fault again with the default action */
+		signal(SIGSEGV, SIG_DFL);
+		return;
+	}
+	g_accessAddr = (uint16_t) (addr - SIM_IO_BASE);
+	g_accessWrite = ((userContext->uc_mcontext.gregs[REG_ERR]
+			& SIM_PAGE_FAULT_WRITE) != 0);
+	g_accessRip = (uint64_t) userContext->uc_mcontext.gregs[REG_RIP];
+	g_accessActive = TRUE;
+	g_statAccesses++;
+
+	/* Peripherals are up to date when the instruction executes */
+	Sim_advanceTo(Sim_cycles + g_accessCycles);
+
+	g_accessOld = Sim_io[g_accessAddr];
+	if (g_accessAddr + 1UL < SIM_IO_SIZE)
+	{
+		g_accessOld |= (uint16_t) Sim_io[g_accessAddr + 1] << 8;
+	}
+	mprotect(g_firmwareIo, SIM_IO_SIZE, PROT_READ | PROT_WRITE);
+	userContext->uc_mcontext.gregs[REG_EFL] |= SIM_TRAP_FLAG;
+}
+
+/*
+ * [Function Name]	: Sim_trapHandler
+ * [Description]	:
+ * 		SIGTRAP handler, second half of a register access: the page closes,
+ * 		side effects apply, idle loops jump in time & pending interrupts are
+ * 		taken.
+ */
+static void Sim_trapHandler(int signalNum, siginfo_t *info, void *context)
+{
+	ucontext_t *userContext = (ucontext_t *) context;
+	greg_t *registers = userContext->uc_mcontext.gregs;
+	uint64_t signature;
+	uint32_t period;
+	int vector;
+	(void) signalNum;
+	(void) info;
+
+	if (!g_accessActive)
+	{
+		signal(SIGTRAP, SIG_DFL);
+		return;
+	}
+	registers[REG_EFL] &= ~SIM_TRAP_FLAG;
+	mprotect(g_firmwareIo, SIM_IO_SIZE, PROT_NONE);
+	g_accessActive = FALSE;
+
+	if (g_hooks[g_accessAddr] != NULL)
+	{
+		g_hooks[g_accessAddr](g_accessAddr, g_accessWrite, g_accessOld);
+	}
+
+	/* The instruction after SEI has executed */
+	g_seiShadow = FALSE;
+
+	/* Idle loop detection on (instruction, register, direction, value) */
+	signature = (g_accessRip * 0x9E3779B97F4A7C15ULL)
+			^ ((uint64_t) g_accessAddr << 48) ^ ((uint64_t) g_accessWrite << 40)
+			^ ((uint64_t) Sim_io[g_accessAddr] << 32);
+	if ((g_loopPeriod != 0)
+			&& (g_loopHistory[(g_loopCount - g_loopPeriod) % SIM_LOOP_HISTORY]
+					== signature))
+	{
+		g_loopRun++;
+	}
+	else
+	{
+		g_loopPeriod = 0;
+		g_loopRun = 0;
+		for (period = 1; (period <= SIM_LOOP_HISTORY / 2) && (period <= g_loopCount);
+				period++)
+		{
+			if (g_loopHistory[(g_loopCount - period) % SIM_LOOP_HISTORY]
+					== signature)
+			{
+				g_loopPeriod = period;
+				g_loopRun = 1;
+				break;
+			}
+		}
+	}
+	g_loopHistory[g_loopCount % SIM_LOOP_HISTORY] = signature;
+	g_loopCount++;
+
+	vector = Sim_pendingVector(SIM_WAKE_IDLE);
+	if ((g_loopPeriod != 0) && (g_loopRun >= SIM_LOOP_MIN_ACCESSES)
+			&& (g_loopRun >= SIM_LOOP_MIN_REPEATS * g_loopPeriod)
+			&& !((vector != 0) && Sim_interruptsEnabled()))
+	{
+		/* Nothing changes until the next event */
+		uint64_t start = Sim_cycles;
+		Sim_step(SIM_NEVER, SIM_NEVER);
+		g_statSkippedCycles += Sim_cycles - start;
+		g_loopRun = 0;
+		vector = Sim_pendingVector(SIM_WAKE_IDLE);
+	}
+
+	if ((vector != 0) && Sim_interruptsEnabled())
+	{
+		/* Call the trampoline as if the interrupted instruction did, below
+		 * the red zone of the interrupted function */
+		uint64_t *stack = (uint64_t *) (registers[REG_RSP] - 128);
+		*(--stack) = (uint64_t) registers[REG_RIP];
+		*(--stack) = (uint64_t) vector;
+		registers[REG_RSP] = (greg_t) stack;
+		registers[REG_RIP] = (greg_t) Sim_interruptTrampoline;
+		g_loopRun = 0;
+	}
+}
+
+/*******************************************************************************
+ *                                  Events                                     *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_eventInit
+ * [Description]	:
+ * 		Function that prepares an event with it's call-back.
+ * [Args]	:
+ * [In] event	: Indicates event address.
+ * [In] handler	: Indicates call-back function address.
+ * [In] arg		: Indicates call-back argument.
+ * [Return]		: Void.
+ */
+void Sim_eventInit(Sim_Event *event, void (*handler)(void *arg), void *arg)
+{
+	memset(event, 0, sizeof(*event));
+	(*event).handler = handler;
+	(*event).arg = arg;
+}
+
+/*
+ * [Function Name]	: Sim_eventSchedule
+ * [Description]	:
+ * 		Function that schedules an event, moving it if already scheduled.
+ * 		Events at the same time run in scheduling order.
+ * [Args]	:
+ * [In] event	: Indicates event address.
+ * [In] time	: Indicates time in cycles, a past time runs it at the next step.
+ * [Return]		: Void.
+ */
+void Sim_eventSchedule(Sim_Event *event, uint64_t time)
+{
+	Sim_Event **link = &g_events;
+	Sim_eventCancel(event);
+	if (time < Sim_cycles)
+	{
+		time = Sim_cycles;
+	}
+	while ((*link != NULL) && ((**link).time <= time))
+	{
+		link = &(**link).next;
+	}
+	(*event).time = time;
+	(*event).next = *link;
+	(*event).pending = TRUE;
+	*link = event;
+}
+
+/*
+ * [Function Name]	: Sim_eventCancel
+ * [Description]	:
+ * 		Function that removes an event if scheduled.
+ * [Args]	:
+ * [In] event	: Indicates event address.
+ * [Return]		: Void.
+ */
+void Sim_eventCancel(Sim_Event *event)
+{
+	Sim_Event **link = &g_events;
+	if (!(*event).pending)
+	{
+		return;
+	}
+	while (*link != NULL)
+	{
+		if (*link == event)
+		{
+			*link = (*event).next;
+			break;
+		}
+		link = &(**link).next;
+	}
+	(*event).pending = FALSE;
+}
+
+/*******************************************************************************
+ *                                   Time                                      *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_nextEventTime
+ * [Description]	:
+ * 		Function that gets the time of the next thing that happens by itself,
+ * 		a scheduled event or a timer flag.
+ * [Args]		: Void.
+ * [Return]		: Time in cycles or (SIM_NEVER).
+ */
+uint64_t Sim_nextEventTime(void)
+{
+	uint64_t next = Sim_timersNextEvent();
+	if ((g_events != NULL) && ((*g_events).time < next))
+	{
+		next = (*g_events).time;
+	}
+	return next;
+}
+
+/*
+ * [Function Name]	: Sim_advanceTo
+ * [Description]	:
+ * 		Function that moves time forward running timers & events on the way,
+ * 		waiting for the peer ECU when the link has not reached that time yet.
+ * [Args]	:
+ * [In] time	: Indicates target time in cycles.
+ * [Return]		: Void.
+ */
+void Sim_advanceTo(uint64_t time)
+{
+	while (Sim_cycles < time)
+	{
+		uint64_t next = Sim_nextEventTime();
+		if (next > time)
+		{
+			next = time;
+		}
+		if (next > g_timeLimit)
+		{
+			Sim_timersSync(g_timeLimit);
+			Sim_cycles = g_timeLimit;
+			Sim_stop("time limit");
+		}
+		/* The peer may send a byte that arrives before (next) */
+		while (next > Sim_linkPeerTime())
+		{
+			Sim_linkSync(Sim_cycles);
+			next = Sim_nextEventTime();
+			if (next > time)
+			{
+				next = time;
+			}
+		}
+		if (g_realTime)
+		{
+			Sim_pollConsole(FALSE);
+		}
+		if (next > Sim_cycles)
+		{
+			Sim_timersSync(next);
+			Sim_cycles = next;
+		}
+		while ((g_events != NULL) && ((*g_events).time <= Sim_cycles))
+		{
+			Sim_Event *event = g_events;
+			g_events = (*event).next;
+			(*event).pending = FALSE;
+			(*event).handler((*event).arg);
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Sim_step
+ * [Description]	:
+ * 		Function that moves time to the next event while the CPU waits, the
+ * 		peer ECU is told the CPU can not transmit before (idleUntil).
+ * [Args]	:
+ * [In] limit		: Indicates time not to pass.
+ * [In] idleUntil	: Indicates when the CPU runs again by itself.
+ * [Return]			: Void.
+ */
+static void Sim_step(uint64_t limit, uint64_t idleUntil)
+{
+	uint64_t next;
+	while (TRUE)
+	{
+		next = Sim_nextEventTime();
+		if (next > limit)
+		{
+			next = limit;
+		}
+		if (next <= Sim_linkPeerTime())
+		{
+			break;
+		}
+		/* Nothing happens here before (next), the peer may send something first */
+		Sim_linkSync((next < idleUntil) ? next : idleUntil);
+	}
+	if (next == SIM_NEVER)
+	{
+		if (g_realTime)
+		{
+			Sim_pollConsole(TRUE);
+			return;
+		}
+		Sim_stop("CPU waits for an event that never comes");
+	}
+	Sim_advanceTo(next);
+}
+
+/*
+ * [Function Name]	: Sim_cyclesFromSeconds
+ * [Description]	:
+ * 		Function that converts seconds to CPU cycles.
+ */
+uint64_t Sim_cyclesFromSeconds(double seconds)
+{
+	return (uint64_t) (seconds * (double) F_CPU + 0.5);
+}
+
+/*
+ * [Function Name]	: Sim_seconds
+ * [Description]	:
+ * 		Function that converts CPU cycles to seconds.
+ */
+double Sim_seconds(uint64_t cycles)
+{
+	return (double) cycles / (double) F_CPU;
+}
+
+/*
+ * [Function Name]	: Sim_delayCycles
+ * [Description]	:
+ * 		Function that busy waits, interrupts are taken at their time.
+ * [Args]	:
+ * [In] cycles	: Indicates delay in cycles.
+ * [Return]		: Void.
+ */
+void Sim_delayCycles(uint64_t cycles)
+{
+	uint64_t end = Sim_cycles + cycles;
+	g_statDelayCycles += cycles;
+	g_seiShadow = FALSE;
+	/* A loop with a delay is timed, not polling, time already passes here */
+	Sim_restartIdleDetection();
+	while (TRUE)
+	{
+		Sim_dispatchInterrupts();
+		if (Sim_cycles >= end)
+		{
+			break;
+		}
+		Sim_step(end, end);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_restartIdleDetection
+ * [Description]	:
+ * 		Function that forgets the repeated accesses seen so far, for code
+ * 		that changes the board between two accesses, like a benchmark.
+ */
+void Sim_restartIdleDetection(void)
+{
+	g_loopPeriod = 0;
+	g_loopRun = 0;
+}
+
+/*******************************************************************************
+ *                                 Interrupts                                  *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_setVector
+ * [Description]	:
+ * 		Function that installs an ISR, called by the ISR macro before main.
+ */
+void Sim_setVector(int vector, void (*handler)(void), const char *name)
+{
+	if ((vector <= 0) || (vector >= SIM_VECTORS_NUM))
+	{
+		Sim_fatal("bad interrupt vector %s", name);
+	}
+	if (g_vectors[vector] != NULL)
+	{
+		Sim_fatal("multiple definition of ISR(%s)", name);
+	}
+	g_vectors[vector] = handler;
+	g_vectorNames[vector] = name;
+}
+
+/*
+ * [Function Name]	: Sim_enableInterrupts
+ * [Description]	:
+ * 		SEI instruction, pending interrupts wait for the next instruction.
+ */
+void Sim_enableInterrupts(void)
+{
+	SREG |= (1 << SREG_I);
+	g_seiShadow = TRUE;
+}
+
+/*
+ * [Function Name]	: Sim_disableInterrupts
+ * [Description]	:
+ * 		CLI instruction.
+ */
+void Sim_disableInterrupts(void)
+{
+	SREG &= ~(1 << SREG_I);
+}
+
+/*
+ * [Function Name]	: Sim_interruptsEnabled
+ * [Description]	:
+ * 		Function that checks the I-bit & the SEI shadow.
+ */
+uint8_t Sim_interruptsEnabled(void)
+{
+	return ((SREG & (1 << SREG_I)) != 0) && !g_seiShadow;
+}
+
+/*
+ * [Function Name]	: Sim_pendingVector
+ * [Description]	:
+ * 		Function that finds the highest priority interrupt with it's flag &
+ * 		enable bits set, ignoring the I-bit.
+ * [Args]	:
+ * [In] allowMask	: Indicates vectors considered.
+ * [Return]			: Vector number or (0).
+ */
+static int Sim_pendingVector(uint32_t allowMask)
+{
+	uint32_t pending = 0;
+	uint8_t timsk = TIMSK;
+	uint8_t tifr = TIFR;
+
+	/* External interrupts, low level sense has no flag */
+	if (GICR & (1 << INT0))
+	{
+		if ((GIFR & (1 << INTF0))
+				|| (((MCUCR & 0x03) == 0) && !Sim_gpioLevel(SIM_PORTD, 2)))
+		{
+			pending |= SIM_VECTOR_BIT(INT0_vect_num);
+		}
+	}
+	if (GICR & (1 << INT1))
+	{
+		if ((GIFR & (1 << INTF1))
+				|| (((MCUCR & 0x0C) == 0) && !Sim_gpioLevel(SIM_PORTD, 3)))
+		{
+			pending |= SIM_VECTOR_BIT(INT1_vect_num);
+		}
+	}
+	if ((GICR & (1 << INT2)) && (GIFR & (1 << INTF2)))
+	{
+		pending |= SIM_VECTOR_BIT(INT2_vect_num);
+	}
+	/* Timers */
+	if (timsk & tifr)
+	{
+		if (timsk & tifr & (1 << OCF2))
+			pending |= SIM_VECTOR_BIT(TIMER2_COMP_vect_num);
+		if (timsk & tifr & (1 << TOV2))
+			pending |= SIM_VECTOR_BIT(TIMER2_OVF_vect_num);
+		if (timsk & tifr & (1 << ICF1))
+			pending |= SIM_VECTOR_BIT(TIMER1_CAPT_vect_num);
+		if (timsk & tifr & (1 << OCF1A))
+			pending |= SIM_VECTOR_BIT(TIMER1_COMPA_vect_num);
+		if (timsk & tifr & (1 << OCF1B))
+			pending |= SIM_VECTOR_BIT(TIMER1_COMPB_vect_num);
+		if (timsk & tifr & (1 << TOV1))
+			pending |= SIM_VECTOR_BIT(TIMER1_OVF_vect_num);
+		if (timsk & tifr & (1 << OCF0))
+			pending |= SIM_VECTOR_BIT(TIMER0_COMP_vect_num);
+		if (timsk & tifr & (1 << TOV0))
+			pending |= SIM_VECTOR_BIT(TIMER0_OVF_vect_num);
+	}
+	/* Serial interfaces */
+	if ((SPCR & (1 << SPIE)) && (SPSR & (1 << SPIF)))
+		pending |= SIM_VECTOR_BIT(SPI_STC_vect_num);
+	if ((UCSRB & (1 << RXCIE)) && (UCSRA & (1 << RXC)))
+		pending |= SIM_VECTOR_BIT(USART_RXC_vect_num);
+	if ((UCSRB & (1 << UDRIE)) && (UCSRA & (1 << UDRE)))
+		pending |= SIM_VECTOR_BIT(USART_UDRE_vect_num);
+	if ((UCSRB & (1 << TXCIE)) && (UCSRA & (1 << TXC)))
+		pending |= SIM_VECTOR_BIT(USART_TXC_vect_num);
+	if ((ADCSRA & (1 << ADIE)) && (ADCSRA & (1 << ADIF)))
+		pending |= SIM_VECTOR_BIT(ADC_vect_num);
+	if ((EECR & (1 << EERIE)) && !(EECR & (1 << EEWE)))
+		pending |= SIM_VECTOR_BIT(EE_RDY_vect_num);
+	if ((ACSR & (1 << ACIE)) && (ACSR & (1 << ACI)))
+		pending |= SIM_VECTOR_BIT(ANA_COMP_vect_num);
+	if ((TWCR & (1 << TWIE)) && (TWCR & (1 << TWINT)))
+		pending |= SIM_VECTOR_BIT(TWI_vect_num);
+
+	pending &= allowMask;
+	if (pending == 0)
+	{
+		return 0;
+	}
+	return __builtin_ctz(pending);
+}
+
+/*
+ * [Function Name]	: Sim_serviceInterrupt
+ * [Description]	:
+ * 		Function that takes an interrupt: clears the flags cleared by hardware,
+ * 		clears the I-bit, executes the ISR & sets the I-bit like RETI.
+ * [Args]	:
+ * [In] vector	: Indicates vector number.
+ * [Return]		: Void.
+ */
+void Sim_serviceInterrupt(long vector)
+{
+	static const uint8_t timerFlags[SIM_VECTORS_NUM] = {
+		[TIMER2_COMP_vect_num] = (1 << OCF2), [TIMER2_OVF_vect_num] = (1 << TOV2),
+		[TIMER1_CAPT_vect_num] = (1 << ICF1), [TIMER1_COMPA_vect_num] = (1 << OCF1A),
+		[TIMER1_COMPB_vect_num] = (1 << OCF1B), [TIMER1_OVF_vect_num] = (1 << TOV1),
+		[TIMER0_COMP_vect_num] = (1 << OCF0), [TIMER0_OVF_vect_num] = (1 << TOV0) };
+
+	if (g_vectors[vector] == NULL)
+	{
+		/* avr-libc jumps to __bad_interrupt which resets the CPU */
+		Sim_fatal("interrupt vector %ld enabled without an ISR", vector);
+	}
+	switch (vector)
+	{
+		case INT0_vect_num:
+			GIFR &= ~(1 << INTF0);
+		break;
+		case INT1_vect_num:
+			GIFR &= ~(1 << INTF1);
+		break;
+		case INT2_vect_num:
+			GIFR &= ~(1 << INTF2);
+		break;
+		case USART_TXC_vect_num:
+			UCSRA &= ~(1 << TXC);
+		break;
+		case ADC_vect_num:
+			ADCSRA &= ~(1 << ADIF);
+		break;
+		case ANA_COMP_vect_num:
+			ACSR &= ~(1 << ACI);
+		break;
+		default:
+			TIFR &= ~timerFlags[vector];
+		break;
+	}
+	SREG &= ~(1 << SREG_I);
+	g_statInterrupts++;
+	g_statVectorCount[vector]++;
+	g_interruptDepth++;
+	Sim_advanceTo(Sim_cycles + SIM_INTERRUPT_CYCLES);
+	g_vectors[vector]();
+	Sim_advanceTo(Sim_cycles + SIM_INTERRUPT_CYCLES);
+	g_interruptDepth--;
+	SREG |= (1 << SREG_I);
+}
+
+/*
+ * [Function Name]	: Sim_dispatchInterrupts
+ * [Description]	:
+ * 		Function that takes pending interrupts from simulator code, used while
+ * 		the CPU sleeps or waits in a delay.
+ */
+static void Sim_dispatchInterrupts(void)
+{
+	int vector;
+	while (Sim_interruptsEnabled()
+			&& ((vector = Sim_pendingVector(SIM_WAKE_IDLE)) != 0))
+	{
+		Sim_serviceInterrupt(vector);
+	}
+}
+
+/*******************************************************************************
+ *                                   Sleep                                     *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_sleep
+ * [Description]	:
+ * 		SLEEP instruction, waits for an interrupt allowed by the sleep mode in
+ * 		MCUCR. The I/O clock stops in every mode but idle, which stops timer0 &
+ * 		timer1, ADC noise reduction mode starts a conversion.
+ */
+void Sim_sleep(void)
+{
+	uint32_t allowMask;
+	uint8_t mode;
+	uint64_t start = Sim_cycles;
+
+	g_seiShadow = FALSE;
+	if (!(MCUCR & (1 << SE)))
+	{
+		return;
+	}
+	mode = MCUCR & ((1 << SM2) | (1 << SM1) | (1 << SM0));
+	switch (mode)
+	{
+		case SLEEP_MODE_IDLE:
+			allowMask = SIM_WAKE_IDLE;
+		break;
+		case SLEEP_MODE_ADC:
+			allowMask = SIM_WAKE_ADC_NOISE_REDUCTION;
+		break;
+		default:
+			allowMask = SIM_WAKE_POWER_DOWN;
+		break;
+	}
+	if (mode != SLEEP_MODE_IDLE)
+	{
+		Sim_timersSetClockStopped(TRUE);
+	}
+	if (mode == SLEEP_MODE_ADC)
+	{
+		Sim_adcSleepStart();
+	}
+	while (Sim_pendingVector(allowMask) == 0)
+	{
+		Sim_step(SIM_NEVER, SIM_NEVER);
+	}
+	Sim_timersSetClockStopped(FALSE);
+	g_statSleepCycles += Sim_cycles - start;
+	Sim_advanceTo(Sim_cycles + SIM_WAKEUP_CYCLES);
+	Sim_dispatchInterrupts();
+}
+
+/*******************************************************************************
+ *                                 Commands                                    *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_addCommand
+ * [Description]	:
+ * 		Function that registers a "name=value" command for scripts & console.
+ */
+void Sim_addCommand(const char *name, void (*handler)(const char *value),
+		const char *help)
+{
+	if (g_commandsNum == SIM_COMMANDS_MAX)
+	{
+		Sim_fatal("too many commands");
+	}
+	g_commands[g_commandsNum].name = name;
+	g_commands[g_commandsNum].handler = handler;
+	g_commands[g_commandsNum].help = help;
+	g_commandsNum++;
+}
+
+/*
+ * [Function Name]	: Sim_runCommand
+ * [Description]	:
+ * 		Function that executes a "name=value" command now.
+ */
+void Sim_runCommand(const char *command)
+{
+	char name[32];
+	const char *value = strchr(command, '=');
+	size_t length = (value == NULL) ? strlen(command) : (size_t) (value - command);
+	uint8_t index;
+
+	if (length >= sizeof(name))
+	{
+		length = sizeof(name) - 1;
+	}
+	memcpy(name, command, length);
+	name[length] = '\0';
+	value = (value == NULL) ? "" : value + 1;
+
+	if (strcmp(name, "quit") == 0)
+	{
+		Sim_stop("quit command");
+	}
+	if (strcmp(name, "help") == 0)
+	{
+		for (index = 0; index < g_commandsNum; index++)
+		{
+			Sim_log("SIM", "%s=%s", g_commands[index].name, g_commands[index].help);
+		}
+		Sim_log("SIM", "quit");
+		return;
+	}
+	for (index = 0; index < g_commandsNum; index++)
+	{
+		if (strcmp(name, g_commands[index].name) == 0)
+		{
+			g_commands[index].handler(value);
+			return;
+		}
+	}
+	Sim_log("SIM", "unknown command '%s'", name);
+}
+
+/*
+ * [Function Name]	: Sim_scriptHandler
+ * [Description]	:
+ * 		Event call-back of a scripted command.
+ */
+static void Sim_scriptHandler(void *arg)
+{
+	Sim_ScriptEntry *entry = (Sim_ScriptEntry *) arg;
+	Sim_runCommand((*entry).command);
+	free(entry);
+}
+
+/*
+ * [Function Name]	: Sim_parseScript
+ * [Description]	:
+ * 		Function that schedules "TIME:name=value" commands separated by ';' or
+ * 		new lines. TIME is in seconds with an optional ms/us suffix, a leading
+ * 		'+' makes it relative to the previous command, '#' starts a comment.
+ */
+static void Sim_parseScript(const char *script)
+{
+	const char *cursor = script;
+	while (*cursor != '\0')
+	{
+		char line[128];
+		char *separator;
+		char *text = line;
+		char *unit;
+		size_t length = strcspn(cursor, ";\n");
+		double value;
+		uint8_t relative = FALSE;
+		uint64_t time;
+		Sim_ScriptEntry *entry;
+
+		if (length >= sizeof(line))
+		{
+			length = sizeof(line) - 1;
+		}
+		memcpy(line, cursor, length);
+		line[length] = '\0';
+		cursor += strcspn(cursor, ";\n");
+		if (*cursor != '\0')
+		{
+			cursor++;
+		}
+		if ((separator = strchr(line, '#')) != NULL)
+		{
+			*separator = '\0';
+		}
+		while ((*text == ' ') || (*text == '\t') || (*text == '\r'))
+		{
+			text++;
+		}
+		if (*text == '\0')
+		{
+			continue;
+		}
+		separator = strpbrk(text, ": \t");
+		if (separator == NULL)
+		{
+			Sim_fatal("script entry '%s' has no time", text);
+		}
+		*separator = '\0';
+		if (*text == '+')
+		{
+			relative = TRUE;
+			text++;
+		}
+		value = strtod(text, &unit);
+		if (strcmp(unit, "ms") == 0)
+		{
+			value /= 1e3;
+		}
+		else if (strcmp(unit, "us") == 0)
+		{
+			value /= 1e6;
+		}
+		time = Sim_cyclesFromSeconds(value);
+		if (relative)
+		{
+			time += g_scriptLastTime;
+		}
+		g_scriptLastTime = time;
+		text = separator + 1;
+		while ((*text == ' ') || (*text == '\t'))
+		{
+			text++;
+		}
+		length = strcspn(text, " \t\r");
+		text[length] = '\0';
+		entry = malloc(sizeof(Sim_ScriptEntry));
+		snprintf((*entry).command, sizeof((*entry).command), "%s", text);
+		Sim_eventInit(&(*entry).event, Sim_scriptHandler, entry);
+		Sim_eventSchedule(&(*entry).event, time);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_pollConsole
+ * [Description]	:
+ * 		Function that paces simulated time to the host clock & runs commands
+ * 		typed on the console, used with (SIM_REALTIME) only.
+ * [Args]	:
+ * [In] block	: Indicates waiting for a command when nothing else can happen.
+ */
+static void Sim_pollConsole(uint8_t block)
+{
+	struct timespec now;
+	int64_t hostNs;
+	int64_t simNs = (int64_t) (Sim_seconds(Sim_cycles) * 1e9);
+	struct pollfd console = { STDIN_FILENO, POLLIN, 0 };
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	hostNs = (now.tv_sec - g_hostStart.tv_sec) * 1000000000LL
+			+ (now.tv_nsec - g_hostStart.tv_nsec);
+	if (simNs > hostNs)
+	{
+		struct timespec pause = { (simNs - hostNs) / 1000000000LL,
+				(simNs - hostNs) % 1000000000LL };
+		nanosleep(&pause, NULL);
+	}
+	if (!block && (simNs < g_consoleNextPoll))
+	{
+		return;
+	}
+	g_consoleNextPoll = simNs + SIM_CONSOLE_POLL_NS;
+	if (poll(&console, 1, block ? -1 : 0) > 0)
+	{
+		char line[128];
+		if (fgets(line, sizeof(line), stdin) == NULL)
+		{
+			Sim_stop("console closed");
+		}
+		line[strcspn(line, "\r\n")] = '\0';
+		if (strpbrk(line, ":") != NULL)
+		{
+			Sim_parseScript(line);
+		}
+		else if (line[0] != '\0')
+		{
+			Sim_runCommand(line);
+		}
+	}
+}
+
+/*******************************************************************************
+ *                                  Output                                     *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_log
+ * [Description]	:
+ * 		Function that prints a line stamped with simulated time.
+ */
+void Sim_log(const char *source, const char *format, ...)
+{
+	va_list args;
+	printf("[%12.6f] %-6s ", Sim_seconds(Sim_cycles), source);
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+	putchar('\n');
+}
+
+/*
+ * [Function Name]	: Sim_fatal
+ * [Description]	:
+ * 		Function that stops the simulation with an error.
+ */
+void Sim_fatal(const char *format, ...)
+{
+	va_list args;
+	fflush(stdout);
+	fprintf(stderr, "sim: error: ");
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+	exit(2);
+}
+
+/*
+ * [Function Name]	: Sim_getOption
+ * [Description]	:
+ * 		Function that reads an option from the environment.
+ */
+const char *Sim_getOption(const char *name, const char *defaultValue)
+{
+	const char *value = getenv(name);
+	return ((value == NULL) || (value[0] == '\0')) ? defaultValue : value;
+}
+
+/*
+ * [Function Name]	: Sim_stop
+ * [Description]	:
+ * 		Function that ends the simulation normally.
+ */
+static void Sim_stop(const char *reason)
+{
+	Sim_log("SIM", "stop: %s", reason);
+	exit(0);
+}
+
+/*
+ * [Function Name]	: Sim_printStatistics
+ * [Description]	:
+ * 		Exit handler that prints run statistics on the standard error.
+ */
+static void Sim_printStatistics(void)
+{
+	struct timespec now;
+	double hostSeconds;
+	int vector;
+
+	fflush(stdout);
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	hostSeconds = (double) (now.tv_sec - g_hostStart.tv_sec)
+			+ (double) (now.tv_nsec - g_hostStart.tv_nsec) / 1e9;
+	fprintf(stderr, "sim: simulated %.6f s (%llu cycles) in %.3f s host\n",
+			Sim_seconds(Sim_cycles), (unsigned long long) Sim_cycles, hostSeconds);
+	fprintf(stderr, "sim: register accesses %llu, interrupts %llu\n",
+			(unsigned long long) g_statAccesses,
+			(unsigned long long) g_statInterrupts);
+	if (Sim_cycles != 0)
+	{
+		fprintf(stderr,
+				"sim: sleep %.1f%%, delays %.1f%%, polling loops %.1f%%\n",
+				100.0 * (double) g_statSleepCycles / (double) Sim_cycles,
+				100.0 * (double) g_statDelayCycles / (double) Sim_cycles,
+				100.0 * (double) g_statSkippedCycles / (double) Sim_cycles);
+	}
+	for (vector = 1; vector < SIM_VECTORS_NUM; vector++)
+	{
+		if (g_statVectorCount[vector] != 0)
+		{
+			fprintf(stderr, "sim:   %-16s %llu\n", g_vectorNames[vector],
+					(unsigned long long) g_statVectorCount[vector]);
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Sim_getStatistics
+ * [Description]	:
+ * 		Function that reads the run counters, differences of two readings
+ * 		measure the code between them.
+ * [Args]	:
+ * [Out] statistics_Ptr	: Holds counters since reset.
+ * [Return]				: Void.
+ */
+void Sim_getStatistics(Sim_Statistics *statistics_Ptr)
+{
+	(*statistics_Ptr).cycles = Sim_cycles;
+	(*statistics_Ptr).accesses = g_statAccesses;
+	(*statistics_Ptr).interrupts = g_statInterrupts;
+	(*statistics_Ptr).sleepCycles = g_statSleepCycles;
+	(*statistics_Ptr).delayCycles = g_statDelayCycles;
+	(*statistics_Ptr).skippedCycles = g_statSkippedCycles;
+}
+
+/*******************************************************************************
+ *                             avr-libc Extensions                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: itoa
+ * [Description]	:
+ * 		Function that converts an integer to a string in the given radix, a
+ * 		negative value has a sign in radix (10) only.
+ */
+char *itoa(int value, char *string, int radix)
+{
+	char digits[sizeof(int) * 8 + 1];
+	unsigned int magnitude = (unsigned int) value;
+	char *out = string;
+	int count = 0;
+
+	if ((radix < 2) || (radix > 36))
+	{
+		*string = '\0';
+		return string;
+	}
+	if ((radix == 10) && (value < 0))
+	{
+		*out++ = '-';
+		magnitude = -(unsigned int) value;
+	}
+	do
+	{
+		unsigned int digit = magnitude % (unsigned int) radix;
+		digits[count++] = (char) ((digit < 10) ? ('0' + digit) : ('a' + digit - 10));
+		magnitude /= (unsigned int) radix;
+	} while (magnitude != 0);
+	while (count > 0)
+	{
+		*out++ = digits[--count];
+	}
+	*out = '\0';
+	return string;
+}
@@ -0,0 +1,340 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim_gpio.c
+ * Description: Source file for the simulated GPIO ports & external interrupts.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <string.h>
+#include "sim.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* PINx, DDRx & PORTx are consecutive, port A first at the highest address */
+#define SIM_PIN_ADDR(port)		((uint16_t) (0x39 - 3 * (port)))
+#define SIM_DDR_ADDR(port)		((uint16_t) (SIM_PIN_ADDR(port) + 1))
+#define SIM_PORT_ADDR(port)		((uint16_t) (SIM_PIN_ADDR(port) + 2))
+#define SIM_LISTENERS_MAX		16
+#define SIM_UPDATE_DEPTH_MAX	8
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	Sim_GpioListener listener;
+	void *arg;
+	uint8_t port;
+} Sim_GpioListenerEntry;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static int8_t g_drive[SIM_PORTS_NUM][8];
+static uint8_t g_pull[SIM_PORTS_NUM][8];
+static uint8_t g_levels[SIM_PORTS_NUM];
+static Sim_GpioListenerEntry g_listeners[SIM_LISTENERS_MAX];
+static uint8_t g_listenersNum = 0;
+static uint8_t g_updateDepth = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Sim_gpioWriteHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static void Sim_gpioPinHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static uint8_t Sim_gpioResolve(uint8_t port);
+static void Sim_gpioEdges(uint8_t port, uint8_t oldLevels, uint8_t newLevels);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_gpioInit
+ * [Description]	:
+ * 		Function that resets ports to inputs without pull-up & installs hooks.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_gpioInit(void)
+{
+	uint8_t port;
+	memset(g_drive, SIM_DRIVE_NONE, sizeof(g_drive));
+	memset(g_pull, SIM_PULL_NONE, sizeof(g_pull));
+	for (port = 0; port < SIM_PORTS_NUM; port++)
+	{
+		Sim_setAccessHook(SIM_PIN_ADDR(port), Sim_gpioPinHook);
+		Sim_setAccessHook(SIM_DDR_ADDR(port), Sim_gpioWriteHook);
+		Sim_setAccessHook(SIM_PORT_ADDR(port), Sim_gpioWriteHook);
+	}
+	Sim_setAccessHook(SIM_ADDR(SFIOR), Sim_gpioWriteHook);
+	Sim_gpioUpdate();
+}
+
+/*
+ * [Function Name]	: Sim_gpioDrive
+ * [Description]	:
+ * 		Function that drives a pin from outside the MCU.
+ * [Args]	:
+ * [In] port	: Indicates port ID.
+ * [In] pin		: Indicates pin number.
+ * [In] level	: Indicates LOGIC_LOW, LOGIC_HIGH or (SIM_DRIVE_NONE) to release.
+ * [Return]		: Void.
+ */
+void Sim_gpioDrive(uint8_t port, uint8_t pin, int level)
+{
+	g_drive[port][pin] = (int8_t) ((level == SIM_DRIVE_NONE) ? level : (level != 0));
+	Sim_gpioUpdate();
+}
+
+/*
+ * [Function Name]	: Sim_gpioSetPull
+ * [Description]	:
+ * 		Function that sets the external resistor of a pin.
+ * [Args]	:
+ * [In] port	: Indicates port ID.
+ * [In] pin		: Indicates pin number.
+ * [In] pull	: Indicates (SIM_PULL_NONE), (SIM_PULL_UP) or (SIM_PULL_DOWN).
+ * [Return]		: Void.
+ */
+void Sim_gpioSetPull(uint8_t port, uint8_t pin, uint8_t pull)
+{
+	g_pull[port][pin] = pull;
+	Sim_gpioUpdate();
+}
+
+/*
+ * [Function Name]	: Sim_gpioLevel
+ * [Description]	:
+ * 		Function that gets the level of a pin.
+ */
+uint8_t Sim_gpioLevel(uint8_t port, uint8_t pin)
+{
+	return (g_levels[port] >> pin) & 1;
+}
+
+/*
+ * [Function Name]	: Sim_gpioPortLevels
+ * [Description]	:
+ * 		Function that gets the levels of all pins of a port.
+ */
+uint8_t Sim_gpioPortLevels(uint8_t port)
+{
+	return g_levels[port];
+}
+
+/*
+ * [Function Name]	: Sim_gpioIsDrivenLow
+ * [Description]	:
+ * 		Function that checks if the MCU drives a pin low, used by passive
+ * 		models like a keypad that connect pins together.
+ */
+uint8_t Sim_gpioIsDrivenLow(uint8_t port, uint8_t pin)
+{
+	return ((Sim_io[SIM_DDR_ADDR(port)] >> pin) & 1)
+			&& !((Sim_io[SIM_PORT_ADDR(port)] >> pin) & 1);
+}
+
+/*
+ * [Function Name]	: Sim_gpioAddListener
+ * [Description]	:
+ * 		Function that registers a call-back for level changes of a port.
+ */
+void Sim_gpioAddListener(uint8_t port, Sim_GpioListener listener, void *arg)
+{
+	if (g_listenersNum == SIM_LISTENERS_MAX)
+	{
+		Sim_fatal("too many GPIO listeners");
+	}
+	g_listeners[g_listenersNum].listener = listener;
+	g_listeners[g_listenersNum].arg = arg;
+	g_listeners[g_listenersNum].port = port;
+	g_listenersNum++;
+}
+
+/*
+ * [Function Name]	: Sim_gpioUpdate
+ * [Description]	:
+ * 		Function that resolves pin levels after any change, updates the PINx
+ * 		registers, detects external interrupt & input capture edges & calls
+ * 		listeners. A listener may change drives, levels resolve again.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_gpioUpdate(void)
+{
+	uint8_t port;
+	uint8_t index;
+	uint8_t oldLevels;
+	uint8_t newLevels;
+
+	if (g_updateDepth == SIM_UPDATE_DEPTH_MAX)
+	{
+		Sim_fatal("GPIO models keep changing each other");
+	}
+	g_updateDepth++;
+	for (port = 0; port < SIM_PORTS_NUM; port++)
+	{
+		newLevels = Sim_gpioResolve(port);
+		Sim_io[SIM_PIN_ADDR(port)] = newLevels;
+		oldLevels = g_levels[port];
+		if (newLevels == oldLevels)
+		{
+			continue;
+		}
+		g_levels[port] = newLevels;
+		Sim_gpioEdges(port, oldLevels, newLevels);
+		for (index = 0; index < g_listenersNum; index++)
+		{
+			if (g_listeners[index].port == port)
+			{
+				g_listeners[index].listener(g_listeners[index].arg, port, oldLevels,
+						newLevels);
+			}
+		}
+	}
+	g_updateDepth--;
+}
+
+/*
+ * [Function Name]	: Sim_gpioParsePin
+ * [Description]	:
+ * 		Function that parses a pin name like "PD2".
+ * [Return]		: TRUE if valid.
+ */
+uint8_t Sim_gpioParsePin(const char *name, uint8_t *port, uint8_t *pin)
+{
+	if ((name[0] != 'P') || (name[1] < 'A') || (name[1] > 'D') || (name[2] < '0')
+			|| (name[2] > '7') || (name[3] != '\0'))
+	{
+		return FALSE;
+	}
+	*port = (uint8_t) (name[1] - 'A');
+	*pin = (uint8_t) (name[2] - '0');
+	return TRUE;
+}
+
+/*
+ * [Function Name]	: Sim_gpioResolve
+ * [Description]	:
+ * 		Function that computes the levels of a port: output, external drive,
+ * 		internal pull-up, external resistor, else low.
+ */
+static uint8_t Sim_gpioResolve(uint8_t port)
+{
+	uint8_t ddr = Sim_io[SIM_DDR_ADDR(port)];
+	uint8_t portValue = Sim_io[SIM_PORT_ADDR(port)];
+	uint8_t pullUpDisabled = (SFIOR >> PUD) & 1;
+	uint8_t levels = 0;
+	uint8_t pin;
+	uint8_t level;
+
+	for (pin = 0; pin < 8; pin++)
+	{
+		if ((ddr >> pin) & 1)
+		{
+			level = (portValue >> pin) & 1;
+		}
+		else if (g_drive[port][pin] != SIM_DRIVE_NONE)
+		{
+			level = (uint8_t) g_drive[port][pin];
+		}
+		else if (((portValue >> pin) & 1) && !pullUpDisabled)
+		{
+			level = 1;
+		}
+		else
+		{
+			level = (g_pull[port][pin] == SIM_PULL_UP);
+		}
+		levels |= (uint8_t) (level << pin);
+	}
+	return levels;
+}
+
+/*
+ * [Function Name]	: Sim_gpioEdges
+ * [Description]	:
+ * 		Function that sets external interrupt flags per their sense control &
+ * 		triggers input capture on ICP1 (PD6).
+ */
+static void Sim_gpioEdges(uint8_t port, uint8_t oldLevels, uint8_t newLevels)
+{
+	uint8_t changed = oldLevels ^ newLevels;
+	uint8_t sense;
+	uint8_t rising;
+
+	if (port == SIM_PORTD)
+	{
+		if (changed & (1 << PD2))
+		{
+			sense = (MCUCR >> ISC00) & 0x03;
+			rising = (newLevels >> PD2) & 1;
+			if ((sense == 1) || ((sense == 2) && !rising) || ((sense == 3) && rising))
+			{
+				if (!(GIFR & (1 << INTF0)))
+				{
+					Sim_adcTrigger(SIM_ADC_TRIG_INT0);
+				}
+				GIFR |= (1 << INTF0);
+			}
+		}
+		if (changed & (1 << PD3))
+		{
+			sense = (MCUCR >> ISC10) & 0x03;
+			rising = (newLevels >> PD3) & 1;
+			if ((sense == 1) || ((sense == 2) && !rising) || ((sense == 3) && rising))
+			{
+				GIFR |= (1 << INTF1);
+			}
+		}
+		if (changed & (1 << PD6))
+		{
+			rising = (newLevels >> PD6) & 1;
+			if (rising == ((TCCR1B >> ICES1) & 1))
+			{
+				Sim_timer1Capture();
+			}
+		}
+	}
+	else if ((port == SIM_PORTB) && (changed & (1 << PB2)))
+	{
+		rising = (newLevels >> PB2) & 1;
+		if (rising == ((MCUCSR >> ISC2) & 1))
+		{
+			GIFR |= (1 << INTF2);
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Sim_gpioWriteHook
+ * [Description]	:
+ * 		Side effects of DDRx, PORTx & SFIOR accesses, the prescaler reset bits
+ * 		of SFIOR read as zero once the reset is done.
+ */
+static void Sim_gpioWriteHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	(void) oldValue;
+	if (isWrite)
+	{
+		if (addr == SIM_ADDR(SFIOR))
+		{
+			Sim_io[addr] &= ~((1 << PSR2) | (1 << PSR10));
+		}
+		Sim_gpioUpdate();
+	}
+}
+
+/*
+ * [Function Name]	: Sim_gpioPinHook
+ * [Description]	:
+ * 		Side effects of PINx accesses, read only on the ATmega32.
+ */
+static void Sim_gpioPinHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	if (isWrite)
+	{
+		Sim_io[addr] = (uint8_t) oldValue;
+	}
+}
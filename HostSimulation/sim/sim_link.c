@@ -0,0 +1,400 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim_link.c
+ * Description: Source file for the USART link between two simulated ECUs.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+
+/*******************************************************************************
+ *                          Link Model Useful Notes                            *
+ *******************************************************************************/
+/*
+ * 		SIM_UART selects where transmitted frames go:
+ * 			loopback		: back to the receiver of the same ECU.
+ * 			listen:PATH		: peer ECU connecting on a UNIX socket.
+ * 			connect:PATH	: peer ECU listening on a UNIX socket.
+ *
+ * 		Two ECUs keep their own time & stay deterministic: each one promises
+ * 		the other it will not send a frame ending before some time, a frame
+ * 		takes at least one frame time from the moment the CPU can decide to
+ * 		send it, so an ECU that is busy promises now + one frame, an idle one
+ * 		promises the time it wakes up + one frame. An ECU never runs past the
+ * 		promise of it's peer, they advance together in frame sized steps while
+ * 		the link is used & jump together while both are idle.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_LINK_QUEUE_SIZE			256
+#define SIM_LINK_CONNECT_RETRIES	500
+#define SIM_LINK_MESSAGE_SIZE		19
+#define SIM_LINK_DATA				'D'
+#define SIM_LINK_PROMISE			'P'
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	uint64_t time;
+	uint8_t data;
+} Sim_LinkFrame;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static int g_socket = -1;
+static uint8_t g_loopback = FALSE;
+/* Promises exchanged with the peer */
+static uint64_t g_peerTime = SIM_NEVER;
+static uint8_t g_peerIdle = FALSE;
+static uint64_t g_peerSeen = 0;
+static uint64_t g_sentTime = 0;
+/* Frames on the way to the receiver */
+static Sim_LinkFrame g_queue[SIM_LINK_QUEUE_SIZE];
+static uint16_t g_queueHead = 0;
+static uint16_t g_queueCount = 0;
+static Sim_Event g_receiveEvent;
+static uint8_t g_receiveBuffer[SIM_LINK_MESSAGE_SIZE];
+static uint8_t g_receiveLength = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Sim_linkQueue(uint8_t data, uint64_t time);
+static void Sim_linkReceive(void *arg);
+static void Sim_linkTransmit(uint8_t data);
+static void Sim_linkSend(uint8_t type, uint8_t data, uint8_t idle, uint64_t time);
+static uint8_t Sim_linkRead(uint8_t block);
+static void Sim_linkClosed(void);
+static void Sim_linkCommandRx(const char *value);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_linkInit
+ * [Description]	:
+ * 		Function that opens the link selected by (SIM_UART).
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_linkInit(void)
+{
+	const char *option = Sim_getOption("SIM_UART", NULL);
+	struct sockaddr_un address;
+	int server;
+	int retries;
+
+	Sim_eventInit(&g_receiveEvent, Sim_linkReceive, NULL);
+	Sim_addCommand("rx", Sim_linkCommandRx, "TEXT frames to the receiver, \\n \\r \\xNN escapes");
+	if (option == NULL)
+	{
+		return;
+	}
+	if (strcmp(option, "loopback") == 0)
+	{
+		g_loopback = TRUE;
+		Sim_usartSetTransmitHandler(Sim_linkTransmit);
+		return;
+	}
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (strncmp(option, "listen:", 7) == 0)
+	{
+		snprintf(address.sun_path, sizeof(address.sun_path), "%s", option + 7);
+		server = socket(AF_UNIX, SOCK_STREAM, 0);
+		unlink(address.sun_path);
+		if ((bind(server, (struct sockaddr *) &address, sizeof(address)) != 0)
+				|| (listen(server, 1) != 0))
+		{
+			Sim_fatal("SIM_UART %s: %s", option, strerror(errno));
+		}
+		Sim_log("LINK", "waiting for the peer ECU on %s", address.sun_path);
+		g_socket = accept(server, NULL, NULL);
+		close(server);
+		unlink(address.sun_path);
+	}
+	else if (strncmp(option, "connect:", 8) == 0)
+	{
+		snprintf(address.sun_path, sizeof(address.sun_path), "%s", option + 8);
+		for (retries = 0; retries < SIM_LINK_CONNECT_RETRIES; retries++)
+		{
+			struct timespec pause = { 0, 10000000L };
+			g_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (connect(g_socket, (struct sockaddr *) &address, sizeof(address)) == 0)
+			{
+				break;
+			}
+			close(g_socket);
+			g_socket = -1;
+			nanosleep(&pause, NULL);
+		}
+	}
+	else
+	{
+		Sim_fatal("SIM_UART should be loopback, listen:PATH or connect:PATH");
+	}
+	if (g_socket < 0)
+	{
+		Sim_fatal("SIM_UART %s: no peer ECU", option);
+	}
+	Sim_log("LINK", "connected to the peer ECU");
+	g_peerTime = 0;
+	Sim_usartSetTransmitHandler(Sim_linkTransmit);
+}
+
+/*
+ * [Function Name]	: Sim_linkConnected
+ * [Description]	:
+ * 		Function that checks if a peer ECU is connected.
+ */
+uint8_t Sim_linkConnected(void)
+{
+	return g_socket >= 0;
+}
+
+/*
+ * [Function Name]	: Sim_linkPeerTime
+ * [Description]	:
+ * 		Function that gets the time before which the peer will not deliver
+ * 		any frame, (SIM_NEVER) without a peer.
+ */
+uint64_t Sim_linkPeerTime(void)
+{
+	return g_peerTime;
+}
+
+/*
+ * [Function Name]	: Sim_linkSync
+ * [Description]	:
+ * 		Function that promises the peer this CPU can not start a frame before
+ * 		(busyFrom) or a frame from the peer & waits for the next promise or
+ * 		frame. Two ECUs idle forever end the simulation.
+ * [Args]	:
+ * [In] busyFrom	: Indicates earliest time the CPU may transmit on it's own.
+ * [Return]			: Void.
+ */
+void Sim_linkSync(uint64_t busyFrom)
+{
+	uint64_t lookahead = Sim_usartFrameCycles();
+	uint64_t promise = (busyFrom < g_peerTime) ? busyFrom : g_peerTime;
+	uint8_t idle = (busyFrom == SIM_NEVER);
+
+	if (g_socket < 0)
+	{
+		return;
+	}
+	promise = (promise > SIM_NEVER - lookahead) ? SIM_NEVER : (promise + lookahead);
+	if (idle && g_peerIdle && (g_peerSeen == g_sentTime))
+	{
+		/* The peer saw everything & waits for this ECU, which waits for it */
+		Sim_log("LINK", "both ECUs wait for an event that never comes");
+		exit(0);
+	}
+	/* Every wait starts with a message so the peer never waits for nothing */
+	if (promise > g_sentTime)
+	{
+		g_sentTime = promise;
+	}
+	Sim_linkSend(SIM_LINK_PROMISE, 0, idle, g_sentTime);
+	while (!Sim_linkRead(TRUE))
+	{
+	}
+	while ((g_socket >= 0) && Sim_linkRead(FALSE))
+	{
+	}
+}
+
+/*
+ * [Function Name]	: Sim_linkSend
+ * [Description]	:
+ * 		Function that sends a message: type, data, idle flag, time & the
+ * 		last peer promise seen.
+ */
+static void Sim_linkSend(uint8_t type, uint8_t data, uint8_t idle, uint64_t time)
+{
+	uint8_t message[SIM_LINK_MESSAGE_SIZE];
+	message[0] = type;
+	message[1] = data;
+	message[2] = idle;
+	memcpy(&message[3], &time, sizeof(time));
+	memcpy(&message[11], &g_peerTime, sizeof(g_peerTime));
+	if (write(g_socket, message, sizeof(message)) != (ssize_t) sizeof(message))
+	{
+		Sim_linkClosed();
+	}
+}
+
+/*
+ * [Function Name]	: Sim_linkRead
+ * [Description]	:
+ * 		Function that reads & handles one message.
+ * [Args]	:
+ * [In] block	: Indicates waiting for the message.
+ * [Return]		: TRUE if a message was handled.
+ */
+static uint8_t Sim_linkRead(uint8_t block)
+{
+	ssize_t length;
+	uint64_t time;
+
+	if (g_socket < 0)
+	{
+		return TRUE;
+	}
+	length = recv(g_socket, &g_receiveBuffer[g_receiveLength],
+			SIM_LINK_MESSAGE_SIZE - g_receiveLength, block ? 0 : MSG_DONTWAIT);
+	if (length == 0)
+	{
+		Sim_linkClosed();
+		return TRUE;
+	}
+	if (length < 0)
+	{
+		if ((errno != EAGAIN) && (errno != EINTR))
+		{
+			Sim_linkClosed();
+			return TRUE;
+		}
+		return FALSE;
+	}
+	g_receiveLength += (uint8_t) length;
+	if (g_receiveLength < SIM_LINK_MESSAGE_SIZE)
+	{
+		return FALSE;
+	}
+	g_receiveLength = 0;
+	memcpy(&time, &g_receiveBuffer[3], sizeof(time));
+	if (g_receiveBuffer[0] == SIM_LINK_DATA)
+	{
+		Sim_linkQueue(g_receiveBuffer[1], time);
+	}
+	else
+	{
+		g_peerTime = time;
+		g_peerIdle = g_receiveBuffer[2];
+		memcpy(&g_peerSeen, &g_receiveBuffer[11], sizeof(g_peerSeen));
+	}
+	return TRUE;
+}
+
+/*
+ * [Function Name]	: Sim_linkClosed
+ * [Description]	:
+ * 		Function that continues alone after the peer ECU stopped.
+ */
+static void Sim_linkClosed(void)
+{
+	Sim_log("LINK", "peer ECU stopped");
+	close(g_socket);
+	g_socket = -1;
+	g_peerTime = SIM_NEVER;
+	Sim_usartSetTransmitHandler(NULL);
+}
+
+/*
+ * [Function Name]	: Sim_linkTransmit
+ * [Description]	:
+ * 		USART call-back at the start of a frame, the peer receives it one
+ * 		frame time later.
+ */
+static void Sim_linkTransmit(uint8_t data)
+{
+	uint64_t arrival = Sim_cycles + Sim_usartFrameCycles();
+	Sim_log("UART", "TX 0x%02X '%c'", data, isprint(data) ? data : '.');
+	if (g_loopback)
+	{
+		Sim_linkQueue(data, arrival);
+	}
+	else
+	{
+		Sim_linkSend(SIM_LINK_DATA, data, FALSE, arrival);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_linkQueue
+ * [Description]	:
+ * 		Function that queues a frame for the receiver at it's end time.
+ */
+static void Sim_linkQueue(uint8_t data, uint64_t time)
+{
+	Sim_LinkFrame *frame;
+	if (g_queueCount == SIM_LINK_QUEUE_SIZE)
+	{
+		Sim_fatal("USART link queue full");
+	}
+	frame = &g_queue[(g_queueHead + g_queueCount) % SIM_LINK_QUEUE_SIZE];
+	(*frame).data = data;
+	(*frame).time = (time < Sim_cycles) ? Sim_cycles : time;
+	g_queueCount++;
+	if (g_queueCount == 1)
+	{
+		Sim_eventSchedule(&g_receiveEvent, (*frame).time);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_linkReceive
+ * [Description]	:
+ * 		Event call-back at the end of a queued frame.
+ */
+static void Sim_linkReceive(void *arg)
+{
+	(void) arg;
+	Sim_usartReceive(g_queue[g_queueHead].data);
+	g_queueHead = (g_queueHead + 1) % SIM_LINK_QUEUE_SIZE;
+	g_queueCount--;
+	if (g_queueCount != 0)
+	{
+		Sim_eventSchedule(&g_receiveEvent, g_queue[g_queueHead].time);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_linkCommandRx
+ * [Description]	:
+ * 		Command that sends text to the receiver, one frame after the other.
+ */
+static void Sim_linkCommandRx(const char *value)
+{
+	uint64_t time = Sim_cycles;
+	while (*value != '\0')
+	{
+		uint8_t data = (uint8_t) *value++;
+		if ((data == '\\') && (*value != '\0'))
+		{
+			data = (uint8_t) *value++;
+			if (data == 'n')
+			{
+				data = '\n';
+			}
+			else if (data == 'r')
+			{
+				data = '\r';
+			}
+			else if (data == 'x')
+			{
+				char *end;
+				data = (uint8_t) strtoul(value, &end, 16);
+				value = end;
+			}
+		}
+		time += Sim_usartFrameCycles();
+		Sim_linkQueue(data, time);
+	}
+}
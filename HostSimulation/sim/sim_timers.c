@@ -0,0 +1,617 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim_timers.c
+ * Description: Source file for the simulated Timer0, Timer1 & Timer2.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <string.h>
+#include "sim.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_TIMERS_NUM				3
+#define SIM_TIMER0					0
+#define SIM_TIMER1					1
+#define SIM_TIMER2					2
+
+/* When the compare registers take the value written by the firmware */
+#define SIM_OCR_UPDATE_IMMEDIATE	0
+#define SIM_OCR_UPDATE_TOP			1
+#define SIM_OCR_UPDATE_BOTTOM		2
+
+/* Where TOP comes from */
+#define SIM_TOP_FIXED				0
+#define SIM_TOP_OCRA				1
+#define SIM_TOP_ICR1				2
+
+/* A timer with clear flags sets one of them within two full periods */
+#define SIM_TIMER_SEARCH_TICKS		(4UL * 0x10000UL)
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Sim_TimerMode
+ * [Description]	:
+ * 		A structure that describes a waveform generation mode.
+ */
+typedef struct
+{
+	uint8_t topSource;
+	uint16_t top;
+	uint8_t dualSlope;
+	uint8_t fastPwm;
+	uint8_t ocrUpdate;
+} Sim_TimerMode;
+
+/*
+ * [Structure Name]	: Sim_TimerState
+ * [Description]	:
+ * 		A structure that holds the counter state, copied to search the next
+ * 		event without side effects.
+ */
+typedef struct
+{
+	uint16_t value;
+	uint8_t down;
+	uint16_t ocr[2];
+} Sim_TimerState;
+
+/*
+ * [Structure Name]	: Sim_Timer
+ * [Description]	:
+ * 		A structure that holds a timer registers & state.
+ */
+typedef struct
+{
+	Sim_TimerState state;
+	Sim_TimerMode mode;
+	uint16_t max;
+	uint32_t prescaler;
+	uint64_t lastSync;
+	uint64_t nextEvent;
+	uint8_t nextEventValid;
+	uint8_t nextEventFlags;
+	uint16_t tcntAddr;
+	uint16_t ocrAddr[2];
+	uint8_t ocrNum;
+	uint8_t ocfMask[2];
+	uint8_t tovMask;
+	uint8_t topMask;
+} Sim_Timer;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Sim_Timer g_timers[SIM_TIMERS_NUM];
+static uint8_t g_clockStopped = FALSE;
+
+static const uint16_t g_prescalers01[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+static const uint16_t g_prescalers2[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+/* Timer0 & Timer2 modes, WGMn1:0 */
+static const Sim_TimerMode g_modes8[4] = {
+	{ SIM_TOP_FIXED, 0xFF, FALSE, FALSE, SIM_OCR_UPDATE_IMMEDIATE },
+	{ SIM_TOP_FIXED, 0xFF, TRUE, FALSE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_OCRA, 0, FALSE, FALSE, SIM_OCR_UPDATE_IMMEDIATE },
+	{ SIM_TOP_FIXED, 0xFF, FALSE, TRUE, SIM_OCR_UPDATE_TOP } };
+
+/* Timer1 modes, WGM13:0 */
+static const Sim_TimerMode g_modes16[16] = {
+	{ SIM_TOP_FIXED, 0xFFFF, FALSE, FALSE, SIM_OCR_UPDATE_IMMEDIATE },
+	{ SIM_TOP_FIXED, 0x00FF, TRUE, FALSE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_FIXED, 0x01FF, TRUE, FALSE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_FIXED, 0x03FF, TRUE, FALSE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_OCRA, 0, FALSE, FALSE, SIM_OCR_UPDATE_IMMEDIATE },
+	{ SIM_TOP_FIXED, 0x00FF, FALSE, TRUE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_FIXED, 0x01FF, FALSE, TRUE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_FIXED, 0x03FF, FALSE, TRUE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_ICR1, 0, TRUE, FALSE, SIM_OCR_UPDATE_BOTTOM },
+	{ SIM_TOP_OCRA, 0, TRUE, FALSE, SIM_OCR_UPDATE_BOTTOM },
+	{ SIM_TOP_ICR1, 0, TRUE, FALSE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_OCRA, 0, TRUE, FALSE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_ICR1, 0, FALSE, FALSE, SIM_OCR_UPDATE_IMMEDIATE },
+	{ SIM_TOP_FIXED, 0xFFFF, FALSE, FALSE, SIM_OCR_UPDATE_IMMEDIATE },
+	{ SIM_TOP_ICR1, 0, FALSE, TRUE, SIM_OCR_UPDATE_TOP },
+	{ SIM_TOP_OCRA, 0, FALSE, TRUE, SIM_OCR_UPDATE_TOP } };
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Sim_timerConfigure(uint8_t index);
+static uint16_t Sim_timerTop(const Sim_Timer *timer, const Sim_TimerState *state);
+static uint32_t Sim_timerRun(const Sim_Timer *timer, Sim_TimerState *state,
+		uint32_t ticks, uint8_t stopMask, uint8_t *flags);
+static void Sim_timerRegisterHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static void Sim_timerFlagsHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static void Sim_timerSetFlags(uint8_t flags);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_timersInit
+ * [Description]	:
+ * 		Function that describes the timers registers & installs hooks.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_timersInit(void)
+{
+	static const uint16_t hookedRegisters[] = { 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+			0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x52, 0x53, 0x5C };
+	uint8_t index;
+
+	memset(g_timers, 0, sizeof(g_timers));
+
+	g_timers[SIM_TIMER0].max = 0xFF;
+	g_timers[SIM_TIMER0].tcntAddr = SIM_ADDR(TCNT0);
+	g_timers[SIM_TIMER0].ocrAddr[0] = SIM_ADDR(OCR0);
+	g_timers[SIM_TIMER0].ocrNum = 1;
+	g_timers[SIM_TIMER0].ocfMask[0] = (1 << OCF0);
+	g_timers[SIM_TIMER0].tovMask = (1 << TOV0);
+
+	g_timers[SIM_TIMER1].max = 0xFFFF;
+	g_timers[SIM_TIMER1].tcntAddr = SIM_ADDR(TCNT1L);
+	g_timers[SIM_TIMER1].ocrAddr[0] = SIM_ADDR(OCR1AL);
+	g_timers[SIM_TIMER1].ocrAddr[1] = SIM_ADDR(OCR1BL);
+	g_timers[SIM_TIMER1].ocrNum = 2;
+	g_timers[SIM_TIMER1].ocfMask[0] = (1 << OCF1A);
+	g_timers[SIM_TIMER1].ocfMask[1] = (1 << OCF1B);
+	g_timers[SIM_TIMER1].tovMask = (1 << TOV1);
+
+	g_timers[SIM_TIMER2].max = 0xFF;
+	g_timers[SIM_TIMER2].tcntAddr = SIM_ADDR(TCNT2);
+	g_timers[SIM_TIMER2].ocrAddr[0] = SIM_ADDR(OCR2);
+	g_timers[SIM_TIMER2].ocrNum = 1;
+	g_timers[SIM_TIMER2].ocfMask[0] = (1 << OCF2);
+	g_timers[SIM_TIMER2].tovMask = (1 << TOV2);
+
+	for (index = 0; index < sizeof(hookedRegisters) / sizeof(hookedRegisters[0]);
+			index++)
+	{
+		Sim_setAccessHook(hookedRegisters[index], Sim_timerRegisterHook);
+	}
+	Sim_setAccessHook(SIM_ADDR(TIFR), Sim_timerFlagsHook);
+	for (index = 0; index < SIM_TIMERS_NUM; index++)
+	{
+		Sim_timerConfigure(index);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_timersSync
+ * [Description]	:
+ * 		Function that counts the timer clocks up to a time & sets the flags.
+ * [Args]	:
+ * [In] now		: Indicates time in cycles.
+ * [Return]		: Void.
+ */
+void Sim_timersSync(uint64_t now)
+{
+	uint8_t index;
+	for (index = 0; index < SIM_TIMERS_NUM; index++)
+	{
+		Sim_Timer *timer = &g_timers[index];
+		uint8_t flags = 0;
+		uint64_t ticks;
+
+		if (now <= (*timer).lastSync)
+		{
+			continue;
+		}
+		if (((*timer).prescaler != 0) && !g_clockStopped)
+		{
+			/* The prescaler counts all the time, ticks are aligned on it */
+			ticks = now / (*timer).prescaler - (*timer).lastSync / (*timer).prescaler;
+			if (ticks != 0)
+			{
+				(*timer).state.value = (index == SIM_TIMER1) ?
+						(uint16_t) (Sim_io[(*timer).tcntAddr]
+								| (Sim_io[(*timer).tcntAddr + 1] << 8)) :
+						Sim_io[(*timer).tcntAddr];
+				while (ticks != 0)
+				{
+					uint32_t chunk = (ticks > SIM_TIMER_SEARCH_TICKS) ?
+							SIM_TIMER_SEARCH_TICKS : (uint32_t) ticks;
+					Sim_timerRun(timer, &(*timer).state, chunk, 0, &flags);
+					ticks -= chunk;
+				}
+				Sim_io[(*timer).tcntAddr] = (uint8_t) (*timer).state.value;
+				if (index == SIM_TIMER1)
+				{
+					Sim_io[(*timer).tcntAddr + 1] = (uint8_t) ((*timer).state.value >> 8);
+				}
+			}
+		}
+		(*timer).lastSync = now;
+		if (flags != 0)
+		{
+			Sim_timerSetFlags(flags);
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Sim_timersNextEvent
+ * [Description]	:
+ * 		Function that finds the next timer clock that sets a flag which is
+ * 		clear now, the only thing the CPU can observe.
+ * [Args]		: Void.
+ * [Return]		: Time in cycles or (SIM_NEVER).
+ */
+uint64_t Sim_timersNextEvent(void)
+{
+	uint64_t next = SIM_NEVER;
+	uint8_t index;
+	for (index = 0; index < SIM_TIMERS_NUM; index++)
+	{
+		Sim_Timer *timer = &g_timers[index];
+		/* Flags cleared by the interrupt response change the answer too */
+		if (!(*timer).nextEventValid || ((*timer).nextEventFlags != TIFR))
+		{
+			uint8_t watched = ((*timer).ocfMask[0] | (*timer).ocfMask[1]
+					| (*timer).tovMask | (*timer).topMask) & ~TIFR;
+			(*timer).nextEvent = SIM_NEVER;
+			if (((*timer).prescaler != 0) && !g_clockStopped && (watched != 0))
+			{
+				Sim_TimerState copy = (*timer).state;
+				uint8_t flags = 0;
+				uint32_t ticks;
+				copy.value = (index == SIM_TIMER1) ?
+						(uint16_t) (Sim_io[(*timer).tcntAddr]
+								| (Sim_io[(*timer).tcntAddr + 1] << 8)) :
+						Sim_io[(*timer).tcntAddr];
+				ticks = Sim_timerRun(timer, &copy, SIM_TIMER_SEARCH_TICKS, watched,
+						&flags);
+				if (flags & watched)
+				{
+					(*timer).nextEvent = ((*timer).lastSync / (*timer).prescaler
+							+ ticks) * (*timer).prescaler;
+				}
+			}
+			(*timer).nextEventValid = TRUE;
+			(*timer).nextEventFlags = TIFR;
+		}
+		if ((*timer).nextEvent < next)
+		{
+			next = (*timer).nextEvent;
+		}
+	}
+	return next;
+}
+
+/*
+ * [Function Name]	: Sim_timersSetClockStopped
+ * [Description]	:
+ * 		Function that stops the timers clock in sleep modes without I/O clock.
+ */
+void Sim_timersSetClockStopped(uint8_t stopped)
+{
+	uint8_t index;
+	Sim_timersSync(Sim_cycles);
+	g_clockStopped = stopped;
+	for (index = 0; index < SIM_TIMERS_NUM; index++)
+	{
+		g_timers[index].nextEventValid = FALSE;
+	}
+}
+
+/*
+ * [Function Name]	: Sim_timer1Capture
+ * [Description]	:
+ * 		Function that captures TCNT1 in ICR1 on an ICP1 edge, ICR1 is not
+ * 		written in modes where it defines TOP.
+ */
+void Sim_timer1Capture(void)
+{
+	if (g_timers[SIM_TIMER1].mode.topSource == SIM_TOP_ICR1)
+	{
+		return;
+	}
+	Sim_timersSync(Sim_cycles);
+	ICR1L = TCNT1L;
+	ICR1H = TCNT1H;
+	Sim_timerSetFlags(1 << ICF1);
+}
+
+/*
+ * [Function Name]	: Sim_timerConfigure
+ * [Description]	:
+ * 		Function that decodes the control registers of a timer.
+ */
+static void Sim_timerConfigure(uint8_t index)
+{
+	Sim_Timer *timer = &g_timers[index];
+	uint8_t ocr;
+
+	switch (index)
+	{
+		case SIM_TIMER0:
+			(*timer).prescaler = g_prescalers01[TCCR0 & 0x07];
+			(*timer).mode = g_modes8[((TCCR0 >> WGM00) & 1)
+					| (((TCCR0 >> WGM01) & 1) << 1)];
+		break;
+		case SIM_TIMER1:
+			(*timer).prescaler = g_prescalers01[TCCR1B & 0x07];
+			(*timer).mode = g_modes16[(TCCR1A & 0x03) | (((TCCR1B >> WGM12) & 0x03) << 2)];
+			(*timer).topMask = ((*timer).mode.topSource == SIM_TOP_ICR1) ?
+					(1 << ICF1) : 0;
+		break;
+		default:
+			(*timer).prescaler = g_prescalers2[TCCR2 & 0x07];
+			(*timer).mode = g_modes8[((TCCR2 >> WGM20) & 1)
+					| (((TCCR2 >> WGM21) & 1) << 1)];
+		break;
+	}
+	if ((*timer).mode.ocrUpdate == SIM_OCR_UPDATE_IMMEDIATE)
+	{
+		for (ocr = 0; ocr < (*timer).ocrNum; ocr++)
+		{
+			(*timer).state.ocr[ocr] = Sim_io[(*timer).ocrAddr[ocr]];
+			if (index == SIM_TIMER1)
+			{
+				(*timer).state.ocr[ocr] |= Sim_io[(*timer).ocrAddr[ocr] + 1] << 8;
+			}
+		}
+	}
+	if (!(*timer).mode.dualSlope)
+	{
+		(*timer).state.down = FALSE;
+	}
+	(*timer).nextEventValid = FALSE;
+}
+
+/*
+ * [Function Name]	: Sim_timerTop
+ * [Description]	:
+ * 		Function that gets the TOP value of the current mode.
+ */
+static uint16_t Sim_timerTop(const Sim_Timer *timer, const Sim_TimerState *state)
+{
+	switch ((*timer).mode.topSource)
+	{
+		case SIM_TOP_OCRA:
+			return (*state).ocr[0];
+		case SIM_TOP_ICR1:
+			return (uint16_t) (ICR1L | (ICR1H << 8));
+		default:
+			return (*timer).mode.top;
+	}
+}
+
+/*
+ * [Function Name]	: Sim_timerUpdateOcr
+ * [Description]	:
+ * 		Function that loads double buffered compare registers.
+ */
+static void Sim_timerUpdateOcr(const Sim_Timer *timer, Sim_TimerState *state)
+{
+	uint8_t ocr;
+	for (ocr = 0; ocr < (*timer).ocrNum; ocr++)
+	{
+		(*state).ocr[ocr] = Sim_io[(*timer).ocrAddr[ocr]];
+		if ((*timer).max > 0xFF)
+		{
+			(*state).ocr[ocr] |= Sim_io[(*timer).ocrAddr[ocr] + 1] << 8;
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Sim_timerRun
+ * [Description]	:
+ * 		Function that counts timer clocks, jumping from one value where
+ * 		something happens (compare match, TOP, MAX or BOTTOM) to the next.
+ * [Args]	:
+ * [In] timer		: Indicates timer description.
+ * [In/Out] state	: Indicates counter state.
+ * [In] ticks		: Indicates timer clocks to count.
+ * [In] stopMask	: Indicates flags that stop counting once set.
+ * [Out] flags		: Indicates flags set by the counting.
+ * [Return]			: Timer clocks counted.
+ */
+static uint32_t Sim_timerRun(const Sim_Timer *timer, Sim_TimerState *state,
+		uint32_t ticks, uint8_t stopMask, uint8_t *flags)
+{
+	uint32_t counted = 0;
+	while (counted < ticks)
+	{
+		uint16_t top = Sim_timerTop(timer, state);
+		uint32_t limit = 0;
+		uint32_t target;
+		uint32_t steps;
+		uint8_t wrapped = FALSE;
+		uint8_t ocr;
+
+		if ((*timer).mode.dualSlope && (top == 0))
+		{
+			/* Stuck at BOTTOM */
+			counted = ticks;
+			break;
+		}
+		if ((*state).down && ((*state).value == 0))
+		{
+			(*state).down = FALSE;
+			continue;
+		}
+		if ((*timer).mode.dualSlope && !(*state).down && ((*state).value == top))
+		{
+			(*state).down = TRUE;
+			continue;
+		}
+		if (!(*state).down)
+		{
+			/* Past TOP the counter runs to MAX & wraps */
+			limit = ((*state).value > top) ? (*timer).max : top;
+			if ((*state).value == limit)
+			{
+				target = 0;
+				steps = 1;
+				wrapped = TRUE;
+			}
+			else
+			{
+				target = limit;
+				for (ocr = 0; ocr < (*timer).ocrNum; ocr++)
+				{
+					if (((*state).ocr[ocr] > (*state).value) && ((*state).ocr[ocr] < target))
+					{
+						target = (*state).ocr[ocr];
+					}
+				}
+				steps = target - (*state).value;
+			}
+		}
+		else
+		{
+			target = 0;
+			for (ocr = 0; ocr < (*timer).ocrNum; ocr++)
+			{
+				if (((*state).ocr[ocr] < (*state).value) && ((*state).ocr[ocr] > target))
+				{
+					target = (*state).ocr[ocr];
+				}
+			}
+			steps = (*state).value - target;
+		}
+
+		if (steps > ticks - counted)
+		{
+			steps = ticks - counted;
+			(*state).value = (uint16_t) ((*state).down ? ((*state).value - steps) :
+					((*state).value + steps));
+			counted = ticks;
+			break;
+		}
+		counted += steps;
+		(*state).value = (uint16_t) target;
+
+		/* Events at the new value */
+		if (wrapped)
+		{
+			if ((*timer).mode.fastPwm || (limit == (*timer).max))
+			{
+				*flags |= (*timer).tovMask;
+			}
+			if ((*timer).mode.ocrUpdate == SIM_OCR_UPDATE_TOP)
+			{
+				Sim_timerUpdateOcr(timer, state);
+			}
+		}
+		else if ((*timer).mode.dualSlope && !(*state).down && ((*state).value == top))
+		{
+			(*state).down = TRUE;
+			*flags |= (*timer).topMask;
+			if ((*timer).mode.ocrUpdate == SIM_OCR_UPDATE_TOP)
+			{
+				Sim_timerUpdateOcr(timer, state);
+			}
+		}
+		else if ((*timer).mode.dualSlope && (*state).down && ((*state).value == 0))
+		{
+			(*state).down = FALSE;
+			*flags |= (*timer).tovMask;
+			if ((*timer).mode.ocrUpdate == SIM_OCR_UPDATE_BOTTOM)
+			{
+				Sim_timerUpdateOcr(timer, state);
+			}
+		}
+		else if (!(*timer).mode.dualSlope && ((*state).value == top))
+		{
+			*flags |= (*timer).topMask;
+		}
+		for (ocr = 0; ocr < (*timer).ocrNum; ocr++)
+		{
+			if ((*state).value == (*state).ocr[ocr])
+			{
+				*flags |= (*timer).ocfMask[ocr];
+			}
+		}
+		if (*flags & stopMask)
+		{
+			break;
+		}
+	}
+	return counted;
+}
+
+/*
+ * [Function Name]	: Sim_timerSetFlags
+ * [Description]	:
+ * 		Function that sets timer flags, a flag rising edge may trigger the ADC.
+ */
+static void Sim_timerSetFlags(uint8_t flags)
+{
+	uint8_t rising = flags & ~TIFR;
+	uint8_t index;
+
+	TIFR |= flags;
+	for (index = 0; index < SIM_TIMERS_NUM; index++)
+	{
+		g_timers[index].nextEventValid = FALSE;
+	}
+	if (rising & (1 << OCF0))
+		Sim_adcTrigger(SIM_ADC_TRIG_TIMER0_COMP);
+	if (rising & (1 << TOV0))
+		Sim_adcTrigger(SIM_ADC_TRIG_TIMER0_OVF);
+	if (rising & (1 << OCF1B))
+		Sim_adcTrigger(SIM_ADC_TRIG_TIMER1_COMPB);
+	if (rising & (1 << TOV1))
+		Sim_adcTrigger(SIM_ADC_TRIG_TIMER1_OVF);
+	if (rising & (1 << ICF1))
+		Sim_adcTrigger(SIM_ADC_TRIG_TIMER1_CAPT);
+}
+
+/*
+ * [Function Name]	: Sim_timerRegisterHook
+ * [Description]	:
+ * 		Side effects of timer registers accesses: force output compare bits
+ * 		read as zero & the configuration is decoded again.
+ */
+static void Sim_timerRegisterHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	uint8_t index;
+	(void) oldValue;
+	if (!isWrite)
+	{
+		return;
+	}
+	if (addr == SIM_ADDR(TCCR0))
+	{
+		TCCR0 &= ~(1 << FOC0);
+	}
+	else if (addr == SIM_ADDR(TCCR2))
+	{
+		TCCR2 &= ~(1 << FOC2);
+	}
+	else if (addr == SIM_ADDR(TCCR1A))
+	{
+		TCCR1A &= ~((1 << FOC1A) | (1 << FOC1B));
+	}
+	for (index = 0; index < SIM_TIMERS_NUM; index++)
+	{
+		Sim_timerConfigure(index);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_timerFlagsHook
+ * [Description]	:
+ * 		Side effects of TIFR accesses, writing one clears a flag.
+ */
+static void Sim_timerFlagsHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	uint8_t index;
+	if (!isWrite)
+	{
+		return;
+	}
+	Sim_io[addr] = (uint8_t) oldValue & ~Sim_io[addr];
+	for (index = 0; index < SIM_TIMERS_NUM; index++)
+	{
+		g_timers[index].nextEventValid = FALSE;
+	}
+}
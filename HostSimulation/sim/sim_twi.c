@@ -0,0 +1,290 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim_twi.c
+ * Description: Source file for the simulated TWI in master mode.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include "sim.h"
+
+/*******************************************************************************
+ *                          TWI Model Useful Notes                             *
+ *******************************************************************************/
+/*
+ * 		Clearing TWINT starts an operation, the simulator decides which one
+ * 		at the next TWCR write or after one SCL period, so drivers that set
+ * 		TWSTA, TWSTO or TWEA or write TWDR right after clearing TWINT work
+ * 		like they do on target:
+ * 			1- STOP if TWSTO is set, TWINT stays cleared.
+ * 			2- START if the clearing write set TWSTA.
+ * 			3- Receive after SLA+R or if TWEA was set, ACK is TWEA at the end.
+ * 			4- START if a later write set TWSTA.
+ * 			5- Transmit TWDR.
+ * 		TWWC is never set & slave modes are not modelled.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_TWI_STATUS_MASK			0xF8
+#define SIM_TWI_START				0x08
+#define SIM_TWI_REP_START			0x10
+#define SIM_TWI_MT_SLA_W_ACK		0x18
+#define SIM_TWI_MT_SLA_W_NACK		0x20
+#define SIM_TWI_MT_DATA_ACK			0x28
+#define SIM_TWI_MT_DATA_NACK		0x30
+#define SIM_TWI_MR_SLA_R_ACK		0x40
+#define SIM_TWI_MR_SLA_R_NACK		0x48
+#define SIM_TWI_MR_DATA_ACK			0x50
+#define SIM_TWI_MR_DATA_NACK		0x58
+#define SIM_TWI_NO_INFO				0xF8
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+	SIM_TWI_IDLE, SIM_TWI_ADDRESS, SIM_TWI_TRANSMITTER, SIM_TWI_RECEIVER, SIM_TWI_NOT_ACKED
+} Sim_TwiState;
+
+typedef enum
+{
+	SIM_TWI_DECIDE, SIM_TWI_COMPLETE_START, SIM_TWI_COMPLETE_TRANSMIT, SIM_TWI_COMPLETE_RECEIVE
+} Sim_TwiPhase;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static Sim_TwiDevice *g_devices = NULL;
+static Sim_TwiDevice *g_addressed = NULL;
+static Sim_TwiState g_state = SIM_TWI_IDLE;
+static Sim_TwiPhase g_phase;
+static Sim_Event g_event;
+static uint8_t g_busy = FALSE;
+static uint64_t g_clearTime;
+/* Writes seen since TWINT was cleared */
+static uint8_t g_startOnClear;
+static uint8_t g_startLater;
+static uint8_t g_ackRaised;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static uint64_t Sim_twiSclPeriod(void);
+static void Sim_twiDecide(void);
+static void Sim_twiEvent(void *arg);
+static void Sim_twiFinish(uint8_t status);
+static void Sim_twiControlHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static void Sim_twiStatusHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_twiInit
+ * [Description]	:
+ * 		Function that resets the TWI & installs hooks.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_twiInit(void)
+{
+	TWSR = SIM_TWI_NO_INFO;
+	TWDR = 0xFF;
+	TWAR = 0xFE;
+	Sim_eventInit(&g_event, Sim_twiEvent, NULL);
+	Sim_setAccessHook(SIM_ADDR(TWCR), Sim_twiControlHook);
+	Sim_setAccessHook(SIM_ADDR(TWSR), Sim_twiStatusHook);
+}
+
+/*
+ * [Function Name]	: Sim_twiAttach
+ * [Description]	:
+ * 		Function that connects a slave device to the bus.
+ * [Args]	:
+ * [In] device	: Indicates device address, owned by the model.
+ * [Return]		: Void.
+ */
+void Sim_twiAttach(Sim_TwiDevice *device)
+{
+	(*device).next = g_devices;
+	g_devices = device;
+}
+
+/*
+ * [Function Name]	: Sim_twiSclPeriod
+ * [Description]	:
+ * 		Function that computes the SCL period, 16 + 2 * TWBR * 4^TWPS cycles.
+ */
+static uint64_t Sim_twiSclPeriod(void)
+{
+	return 16 + 2ULL * TWBR * (1ULL << (2 * (TWSR & 0x03)));
+}
+
+/*
+ * [Function Name]	: Sim_twiFinish
+ * [Description]	:
+ * 		Function that ends an operation with a status & sets TWINT.
+ */
+static void Sim_twiFinish(uint8_t status)
+{
+	g_busy = FALSE;
+	TWSR = (TWSR & ~SIM_TWI_STATUS_MASK) | status;
+	TWCR |= (1 << TWINT);
+}
+
+/*
+ * [Function Name]	: Sim_twiDecide
+ * [Description]	:
+ * 		Function that decides what the driver asked for, at the first TWCR
+ * 		write after clearing TWINT or one SCL period after it.
+ */
+static void Sim_twiDecide(void)
+{
+	if (TWCR & (1 << TWSTO))
+	{
+		Sim_eventCancel(&g_event);
+		if (g_addressed != NULL)
+		{
+			(*g_addressed).stop(g_addressed);
+			g_addressed = NULL;
+		}
+		g_state = SIM_TWI_IDLE;
+		g_busy = FALSE;
+		TWCR &= ~(1 << TWSTO);
+		TWSR = (TWSR & ~SIM_TWI_STATUS_MASK) | SIM_TWI_NO_INFO;
+		return;
+	}
+	if (g_startOnClear || (g_state == SIM_TWI_IDLE)
+			|| ((g_state != SIM_TWI_RECEIVER) && !g_ackRaised && g_startLater))
+	{
+		g_phase = SIM_TWI_COMPLETE_START;
+		Sim_eventSchedule(&g_event, g_clearTime + Sim_twiSclPeriod());
+	}
+	else
+	{
+		g_phase = ((g_state == SIM_TWI_RECEIVER) || g_ackRaised) ?
+				SIM_TWI_COMPLETE_RECEIVE : SIM_TWI_COMPLETE_TRANSMIT;
+		Sim_eventSchedule(&g_event, g_clearTime + 9 * Sim_twiSclPeriod());
+	}
+}
+
+/*
+ * [Function Name]	: Sim_twiEvent
+ * [Description]	:
+ * 		Event call-back of an operation, decides it if the driver did not
+ * 		write TWCR since clearing TWINT or completes it.
+ */
+static void Sim_twiEvent(void *arg)
+{
+	Sim_TwiDevice *device;
+	uint8_t ack;
+	(void) arg;
+
+	switch (g_phase)
+	{
+		case SIM_TWI_DECIDE:
+			Sim_twiDecide();
+		break;
+
+		case SIM_TWI_COMPLETE_START:
+			if (g_addressed != NULL)
+			{
+				(*g_addressed).stop(g_addressed);
+				g_addressed = NULL;
+			}
+			Sim_twiFinish((g_state == SIM_TWI_IDLE) ? SIM_TWI_START : SIM_TWI_REP_START);
+			g_state = SIM_TWI_ADDRESS;
+		break;
+
+		case SIM_TWI_COMPLETE_TRANSMIT:
+			if (g_state == SIM_TWI_ADDRESS)
+			{
+				uint8_t isRead = TWDR & 0x01;
+				for (device = g_devices; device != NULL; device = (*device).next)
+				{
+					if ((*device).address == (TWDR >> 1))
+					{
+						break;
+					}
+				}
+				ack = (device != NULL) && (*device).start(device, isRead);
+				g_addressed = ack ? device : NULL;
+				g_state = !ack ? SIM_TWI_NOT_ACKED :
+							isRead ? SIM_TWI_RECEIVER : SIM_TWI_TRANSMITTER;
+				Sim_twiFinish(isRead ?
+						(ack ? SIM_TWI_MR_SLA_R_ACK : SIM_TWI_MR_SLA_R_NACK) :
+						(ack ? SIM_TWI_MT_SLA_W_ACK : SIM_TWI_MT_SLA_W_NACK));
+			}
+			else
+			{
+				ack = (g_state == SIM_TWI_TRANSMITTER)
+						&& (*g_addressed).write(g_addressed, TWDR);
+				Sim_twiFinish(ack ? SIM_TWI_MT_DATA_ACK : SIM_TWI_MT_DATA_NACK);
+			}
+		break;
+
+		case SIM_TWI_COMPLETE_RECEIVE:
+			ack = (TWCR >> TWEA) & 1;
+			TWDR = (g_addressed != NULL) ? (*g_addressed).read(g_addressed, ack) : 0xFF;
+			Sim_twiFinish(ack ? SIM_TWI_MR_DATA_ACK : SIM_TWI_MR_DATA_NACK);
+		break;
+	}
+}
+
+/*
+ * [Function Name]	: Sim_twiControlHook
+ * [Description]	:
+ * 		Side effects of TWCR accesses: writing one to TWINT clears it & starts
+ * 		an operation, other writes are remembered for the decision.
+ */
+static void Sim_twiControlHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	uint8_t written = Sim_io[addr];
+	uint8_t old = (uint8_t) oldValue;
+
+	if (!isWrite)
+	{
+		return;
+	}
+	TWCR = (written & ~(1 << TWINT)) | ((written & (1 << TWINT)) ? 0 : (old & (1 << TWINT)));
+	if (!(written & (1 << TWEN)))
+	{
+		/* Disabling the TWI releases the bus */
+		Sim_eventCancel(&g_event);
+		g_busy = FALSE;
+		g_state = SIM_TWI_IDLE;
+		g_addressed = NULL;
+		TWCR &= ~((1 << TWINT) | (1 << TWSTO));
+		return;
+	}
+	if ((written & (1 << TWINT)) && !g_busy)
+	{
+		g_busy = TRUE;
+		g_startOnClear = (written & (1 << TWSTA)) && !(old & (1 << TWSTA));
+		g_startLater = FALSE;
+		g_ackRaised = (written & (1 << TWEA)) && !(old & (1 << TWEA));
+		g_phase = SIM_TWI_DECIDE;
+		g_clearTime = Sim_cycles;
+		Sim_eventSchedule(&g_event, Sim_cycles + Sim_twiSclPeriod());
+	}
+	else if (g_busy && (g_phase == SIM_TWI_DECIDE))
+	{
+		g_startLater = ((written & (1 << TWSTA)) != 0);
+		g_ackRaised |= (written & (1 << TWEA)) && !(old & (1 << TWEA));
+		Sim_twiDecide();
+	}
+}
+
+/*
+ * [Function Name]	: Sim_twiStatusHook
+ * [Description]	:
+ * 		Side effects of TWSR accesses, only the prescaler bits are written.
+ */
+static void Sim_twiStatusHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	if (isWrite)
+	{
+		Sim_io[addr] = ((uint8_t) oldValue & SIM_TWI_STATUS_MASK) | (Sim_io[addr] & 0x03);
+	}
+}
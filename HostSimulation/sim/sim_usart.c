@@ -0,0 +1,305 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: sim_usart.c
+ * Description: Source file for the simulated USART.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <ctype.h>
+#include <errno.h>
+#include <string.h>
+#include "sim.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_USART_FIFO_SIZE		2
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* UCSRC & UBRRH share one address, URSEL selects the written register */
+static uint8_t g_ucsrc = (1 << URSEL) | (1 << UCSZ1) | (1 << UCSZ0);
+static uint8_t g_ubrrh = 0;
+
+/* Transmitter: UDR buffer & shift register */
+static uint8_t g_txBuffer;
+static uint8_t g_txBufferFull = FALSE;
+static uint8_t g_txShifting = FALSE;
+static Sim_Event g_txEvent;
+static void (*g_transmitHandler)(uint8_t data) = NULL;
+/* Copy of every transmitted byte, (SIM_UART_CAPTURE) */
+static FILE *g_capture = NULL;
+
+/* Receiver: two level FIFO */
+static uint8_t g_rxFifo[SIM_USART_FIFO_SIZE];
+static uint8_t g_rxCount = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+static void Sim_usartShift(uint8_t data);
+static void Sim_usartTransmitComplete(void *arg);
+static void Sim_usartDataHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static void Sim_usartStatusHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static void Sim_usartControlHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+static void Sim_usartSharedHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Sim_usartInit
+ * [Description]	:
+ * 		Function that resets the USART & installs hooks.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+void Sim_usartInit(void)
+{
+	const char *capture = Sim_getOption("SIM_UART_CAPTURE", NULL);
+
+	UCSRA = (1 << UDRE);
+	UCSRC = g_ucsrc;
+	if ((capture != NULL) && ((g_capture = fopen(capture, "wb")) == NULL))
+	{
+		Sim_fatal("SIM_UART_CAPTURE %s: %s", capture, strerror(errno));
+	}
+	Sim_eventInit(&g_txEvent, Sim_usartTransmitComplete, NULL);
+	Sim_setAccessHook(SIM_ADDR(UDR), Sim_usartDataHook);
+	Sim_setAccessHook(SIM_ADDR(UCSRA), Sim_usartStatusHook);
+	Sim_setAccessHook(SIM_ADDR(UCSRB), Sim_usartControlHook);
+	Sim_setAccessHook(SIM_ADDR(UCSRC), Sim_usartSharedHook);
+}
+
+/*
+ * [Function Name]	: Sim_usartSetTransmitHandler
+ * [Description]	:
+ * 		Function that sets the call-back of each frame the transmitter starts,
+ * 		without one the frames are printed.
+ */
+void Sim_usartSetTransmitHandler(void (*handler)(uint8_t data))
+{
+	g_transmitHandler = handler;
+}
+
+/*
+ * [Function Name]	: Sim_usartReceiverEnabled
+ * [Description]	:
+ * 		Function that checks RXEN.
+ */
+uint8_t Sim_usartReceiverEnabled(void)
+{
+	return (UCSRB & (1 << RXEN)) != 0;
+}
+
+/*
+ * [Function Name]	: Sim_usartFrameCycles
+ * [Description]	:
+ * 		Function that computes the duration of one frame: start bit, data
+ * 		bits, parity & stop bits.
+ * [Args]		: Void.
+ * [Return]		: Frame duration in cycles.
+ */
+uint64_t Sim_usartFrameCycles(void)
+{
+	static const uint8_t dataBits[8] = { 5, 6, 7, 8, 8, 8, 8, 9 };
+	uint16_t ubrr = (uint16_t) (((g_ubrrh & 0x0F) << 8) | UBRRL);
+	uint8_t size = ((g_ucsrc >> UCSZ0) & 0x03) | ((UCSRB & (1 << UCSZ2)) ? 0x04 : 0);
+	uint8_t bits = 1 + dataBits[size] + (((g_ucsrc >> UPM0) & 0x03) ? 1 : 0)
+			+ ((g_ucsrc & (1 << USBS)) ? 2 : 1);
+	uint32_t bitCycles;
+
+	if (g_ucsrc & (1 << UMSEL))
+	{
+		bitCycles = 2UL * (ubrr + 1UL);
+	}
+	else if (UCSRA & (1 << U2X))
+	{
+		bitCycles = 8UL * (ubrr + 1UL);
+	}
+	else
+	{
+		bitCycles = 16UL * (ubrr + 1UL);
+	}
+	return (uint64_t) bits * bitCycles;
+}
+
+/*
+ * [Function Name]	: Sim_usartReceive
+ * [Description]	:
+ * 		Function that completes the reception of a frame now, a third frame
+ * 		while the FIFO is full is lost with a data overrun.
+ * [Args]	:
+ * [In] data	: Indicates received byte.
+ * [Return]		: Void.
+ */
+void Sim_usartReceive(uint8_t data)
+{
+	if (!Sim_usartReceiverEnabled())
+	{
+		return;
+	}
+	if (g_rxCount == SIM_USART_FIFO_SIZE)
+	{
+		UCSRA |= (1 << DOR);
+		return;
+	}
+	g_rxFifo[g_rxCount++] = data;
+	UDR = g_rxFifo[0];
+	UCSRA |= (1 << RXC);
+}
+
+/*
+ * [Function Name]	: Sim_usartShift
+ * [Description]	:
+ * 		Function that starts shifting a frame out.
+ */
+static void Sim_usartShift(uint8_t data)
+{
+	g_txShifting = TRUE;
+	Sim_eventSchedule(&g_txEvent, Sim_cycles + Sim_usartFrameCycles());
+	if (g_capture != NULL)
+	{
+		fputc(data, g_capture);
+		fflush(g_capture);
+	}
+	if (g_transmitHandler != NULL)
+	{
+		g_transmitHandler(data);
+	}
+	else
+	{
+		Sim_log("UART", "TX 0x%02X '%c'", data, isprint(data) ? data : '.');
+	}
+}
+
+/*
+ * [Function Name]	: Sim_usartTransmitComplete
+ * [Description]	:
+ * 		Event call-back at the end of a frame, the next buffered byte starts
+ * 		or TXC is set.
+ */
+static void Sim_usartTransmitComplete(void *arg)
+{
+	(void) arg;
+	g_txShifting = FALSE;
+	if (g_txBufferFull && (UCSRB & (1 << TXEN)))
+	{
+		g_txBufferFull = FALSE;
+		UCSRA |= (1 << UDRE);
+		Sim_usartShift(g_txBuffer);
+	}
+	else
+	{
+		UCSRA |= (1 << TXC);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_usartDataHook
+ * [Description]	:
+ * 		Side effects of UDR accesses: a write goes to the transmit buffer, a
+ * 		read takes a byte from the receive FIFO.
+ */
+static void Sim_usartDataHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	uint8_t index;
+	(void) oldValue;
+
+	if (isWrite)
+	{
+		uint8_t data = Sim_io[addr];
+		UDR = (g_rxCount != 0) ? g_rxFifo[0] : (uint8_t) oldValue;
+		if (!(UCSRB & (1 << TXEN)))
+		{
+			return;
+		}
+		if (!g_txShifting)
+		{
+			Sim_usartShift(data);
+		}
+		else
+		{
+			/* Overwrites an unsent byte when UDRE was not checked */
+			g_txBuffer = data;
+			g_txBufferFull = TRUE;
+			UCSRA &= ~(1 << UDRE);
+		}
+	}
+	else if (g_rxCount != 0)
+	{
+		for (index = 1; index < g_rxCount; index++)
+		{
+			g_rxFifo[index - 1] = g_rxFifo[index];
+		}
+		g_rxCount--;
+		UCSRA &= ~(1 << DOR);
+		if (g_rxCount != 0)
+		{
+			UDR = g_rxFifo[0];
+		}
+		else
+		{
+			UCSRA &= ~(1 << RXC);
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Sim_usartStatusHook
+ * [Description]	:
+ * 		Side effects of UCSRA accesses, only U2X & MPCM are written & writing
+ * 		one clears TXC.
+ */
+static void Sim_usartStatusHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	uint8_t written = Sim_io[addr];
+	uint8_t old = (uint8_t) oldValue;
+	const uint8_t writable = (1 << U2X) | (1 << MPCM);
+
+	if (isWrite)
+	{
+		Sim_io[addr] = (old & ~writable & ~(written & (1 << TXC)))
+				| (written & writable);
+	}
+}
+
+/*
+ * [Function Name]	: Sim_usartControlHook
+ * [Description]	:
+ * 		Side effects of UCSRB accesses, disabling the receiver flushes it.
+ */
+static void Sim_usartControlHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	(void) addr;
+	(void) oldValue;
+	if (isWrite && !Sim_usartReceiverEnabled())
+	{
+		g_rxCount = 0;
+		UCSRA &= ~((1 << RXC) | (1 << DOR));
+	}
+}
+
+/*
+ * [Function Name]	: Sim_usartSharedHook
+ * [Description]	:
+ * 		Side effects of UCSRC/UBRRH accesses, URSEL selects the register.
+ */
+static void Sim_usartSharedHook(uint16_t addr, uint8_t isWrite, uint16_t oldValue)
+{
+	uint8_t written = Sim_io[addr];
+	(void) oldValue;
+	if (!isWrite)
+	{
+		return;
+	}
+	if (written & (1 << URSEL))
+	{
+		g_ucsrc = written;
+	}
+	else
+	{
+		g_ubrrh = written;
+	}
+}
@@ -0,0 +1,67 @@
+#!/bin/sh
+################################################################################
+# Module: Host Simulation
+# File Name: stack.sh
+# Description: Worst case stack depth of the AVR builds from -fstack-usage.
+# Author: Mohamed Badr
+#
+# Usage: HostSimulation/stack.sh [IMAGE ...]
+# 		IMAGE is one of: fan distance stopwatch door_hmi door_control, all of
+# 		them by default. Needs avr-gcc. Each project is compiled for the
+# 		ATmega32 with the Debug options (AVR_OPT overrides -O0), the frame of
+# 		every function (.su) is added along the call graph read from the
+# 		call relocations, from main & from every ISR. The report is written
+# 		to HostSimulation/build/stack_IMAGE.txt with the flash size of the
+# 		linked image. Written without an AVR toolchain & never run, see the
+# 		README before trusting it's numbers.
+################################################################################
+
+set -e
+
+SIM_DIR=$(cd "$(dirname "$0")" && pwd)
+REPO_DIR=$(dirname "$SIM_DIR")
+BUILD_DIR="$SIM_DIR/build"
+
+. "$SIM_DIR/images.sh"
+. "$SIM_DIR/avr.sh"
+
+stack_image()
+{
+	set -- "$1" $(image_info "$1")
+	image=$1
+	project="$REPO_DIR/$2"
+	fcpu=$3
+	out="$BUILD_DIR/stack_$image.avr"
+	rm -rf "$out"
+	mkdir -p "$out"
+	find "$project" -name '*.c' -not -path '*/Debug/*' | while read -r source; do
+		object="$out/$(echo "${source#$project/}" | tr '/' '_' | sed 's/\.c$//').o"
+		avr-gcc $AVR_FLAGS -DF_CPU=$fcpu -fstack-usage -c "$source" -o "$object"
+	done
+	avr-gcc -mmcu=atmega32 -Wl,--gc-sections -o "$out/$image.elf" "$out"/*.o
+	avr_frames "$out"/*.su > "$out/frames.txt"
+	avr_calls "$out"/*.o > "$out/calls.txt"
+	# .data & .bss of the linked image
+	static=$(avr-size -A "$out/$image.elf" | awk '$1 == ".data" || $1 == ".bss" { s += $2 } END { print s + 0 }')
+	# Program memory, .data initial values are stored in flash
+	flash=$(avr-size -A "$out/$image.elf" | awk '$1 == ".text" || $1 == ".data" { s += $2 } END { print s + 0 }')
+	{
+		echo "$image ($AVR_OPT)"
+		stack_chains "$out/frames.txt" "$out/calls.txt" "$static"
+		echo "flash $flash bytes (.text & .data)"
+	} > "$BUILD_DIR/stack_$image.txt"
+	cat "$BUILD_DIR/stack_$image.txt"
+}
+
+if ! command -v avr-gcc > /dev/null 2>&1; then
+	echo "avr-gcc not found" >&2
+	exit 1
+fi
+mkdir -p "$BUILD_DIR"
+if [ $# -eq 0 ]; then
+	set -- fan distance stopwatch door_hmi door_control
+fi
+for image in "$@"; do
+	stack_image "$image"
+	echo
+done
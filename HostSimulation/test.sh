@@ -0,0 +1,27 @@
+#!/bin/sh
+################################################################################
+# Module: Host Simulation
+# File Name: test.sh
+# Description: Builds & runs the host tests of the firmware modules.
+# Author: Mohamed Badr
+#
+# Usage: HostSimulation/test.sh [TEST ...]
+# 		TEST is one of: test_lm35 test_lm35_10bit test_filter test_ultrasonic test_ultrasonic_array
+# 		test_ultrasonic_array, all of them by default. Each test prints it's results & the script
+# 		exits with failure if any test fails.
+################################################################################
+
+SIM_DIR=$(cd "$(dirname "$0")" && pwd)
+BUILD_DIR="$SIM_DIR/build"
+
+if [ $# -eq 0 ]; then
+	set -- test_lm35 test_lm35_10bit test_filter test_ultrasonic test_ultrasonic_array
+fi
+failed=0
+for test in "$@"; do
+	if ! "$SIM_DIR/build.sh" "$test" > /dev/null || ! "$BUILD_DIR/$test"; then
+		echo "$test: FAILED"
+		failed=1
+	fi
+done
+exit $failed
@@ -0,0 +1,261 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: test_filter.c
+ * Description: Host test of the integer filters on recorded noisy traces.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "filter.h"
+
+/*******************************************************************************
+ *                            Test Useful Notes                                *
+ *******************************************************************************/
+/*
+ * 		Runs the median & EMA pipeline of each application over the traces of
+ * 		tests/traces, lines of "TRUE MEASURED" values, & compares the mean &
+ * 		maximum absolute errors of the measured & filtered values. Then
+ * 		checks spike rejection, exact EMA settling for every shift & the rate
+ * 		limiter steps at the ends of the 16-bit range.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define TEST_TRACE_SIZE				2048
+/* Samples skipped before errors are counted, the median window filling */
+#define TEST_WARM_UP				FILTER_MEDIAN_SIZE
+/* Samples fed to an EMA to settle from one end of the range to the other */
+#define TEST_SETTLE_SAMPLES			4096
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static uint16 g_true[TEST_TRACE_SIZE];
+static uint16 g_measured[TEST_TRACE_SIZE];
+static unsigned long g_failures = 0;
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Test_expect
+ * [Description]	:
+ * 		Function that prints a check result & counts failures.
+ */
+static void Test_expect(int passed, const char *check)
+{
+	printf("%s  %s\n", passed ? "pass" : "FAIL", check);
+	if (!passed)
+	{
+		g_failures++;
+	}
+}
+
+/*
+ * [Function Name]	: Test_loadTrace
+ * [Description]	:
+ * 		Function that reads a trace file, lines starting with '#' are comments.
+ */
+static unsigned int Test_loadTrace(const char *name)
+{
+	char path[512];
+	char line[128];
+	unsigned int trueValue;
+	unsigned int measured;
+	unsigned int count = 0;
+	FILE *file;
+
+	snprintf(path, sizeof(path), "%s/traces/%s", TEST_DIR, name);
+	file = fopen(path, "r");
+	if (file == NULL)
+	{
+		perror(path);
+		exit(1);
+	}
+	while ((fgets(line, sizeof(line), file) != NULL) && (count < TEST_TRACE_SIZE))
+	{
+		if ((line[0] != '#') && (sscanf(line, "%u %u", &trueValue, &measured) == 2))
+		{
+			g_true[count] = (uint16) trueValue;
+			g_measured[count] = (uint16) measured;
+			count++;
+		}
+	}
+	fclose(file);
+	return count;
+}
+
+/*
+ * [Function Name]	: Test_trace
+ * [Description]	:
+ * 		Function that filters a trace like the application & checks the
+ * 		filtered errors stay under the given bounds.
+ */
+static void Test_trace(const char *name, uint8 shift, double maxMeanError,
+		unsigned int maxError)
+{
+	char check[160];
+	Filter_MedianType median;
+	Filter_EMAType ema;
+	unsigned int count = Test_loadTrace(name);
+	unsigned int sample;
+	unsigned int error;
+	unsigned int rawMax = 0;
+	unsigned int filteredMax = 0;
+	double rawSum = 0;
+	double filteredSum = 0;
+	uint16 filtered;
+
+	Filter_medianInit(&median);
+	Filter_EMAInit(&ema, shift);
+	for (sample = 0; sample < count; sample++)
+	{
+		filtered = Filter_EMA(&ema, Filter_median(&median, g_measured[sample]));
+		if (sample < TEST_WARM_UP)
+		{
+			continue;
+		}
+		error = (unsigned int) abs((int) g_measured[sample] - (int) g_true[sample]);
+		rawSum += error;
+		rawMax = (error > rawMax) ? error : rawMax;
+		error = (unsigned int) abs((int) filtered - (int) g_true[sample]);
+		filteredSum += error;
+		filteredMax = (error > filteredMax) ? error : filteredMax;
+	}
+	count -= TEST_WARM_UP;
+	snprintf(check, sizeof(check), "%s median + EMA shift %u: mean error %.1f -> %.1f, "
+			"maximum error %u -> %u", name, shift, rawSum / count, filteredSum / count,
+			rawMax, filteredMax);
+	Test_expect(((filteredSum / count) <= maxMeanError) && (filteredMax <= maxError), check);
+}
+
+/*
+ * [Function Name]	: Test_median
+ * [Description]	:
+ * 		Function that checks one or two spikes in a constant input never
+ * 		reach the median output once the window is full.
+ */
+static void Test_median(void)
+{
+	Filter_MedianType median;
+	unsigned int position;
+	unsigned int sample;
+	uint16 input;
+	int passed = 1;
+
+	for (position = 0; position < 2 * FILTER_MEDIAN_SIZE; position++)
+	{
+		Filter_medianInit(&median);
+		for (sample = 0; sample < 4 * FILTER_MEDIAN_SIZE; sample++)
+		{
+			/* Spikes at position & position + 1, high then low */
+			input = (sample == FILTER_MEDIAN_SIZE + position) ? 65535 :
+					(sample == FILTER_MEDIAN_SIZE + position + 1) ? 0 : 500;
+			if ((Filter_median(&median, input) != 500) && (sample >= FILTER_MEDIAN_SIZE))
+			{
+				passed = 0;
+			}
+		}
+	}
+	Test_expect(passed, "median rejects two adjacent spikes in a constant input");
+}
+
+/*
+ * [Function Name]	: Test_EMA
+ * [Description]	:
+ * 		Function that checks the EMA settles exactly on a constant input from
+ * 		both ends of the range & stays there, for every shift.
+ */
+static void Test_EMA(void)
+{
+	static const uint16 targets[] = { 0, 1, 300, 32768, 65534, 65535 };
+	static const uint16 starts[] = { 0, 65535 };
+	Filter_EMAType ema;
+	unsigned int shift;
+	unsigned int target;
+	unsigned int start;
+	unsigned int sample;
+	int passed = 1;
+	uint16 output = 0;
+
+	for (shift = 0; shift <= FILTER_EMA_MAX_SHIFT; shift++)
+	{
+		for (target = 0; target < sizeof(targets) / sizeof(targets[0]); target++)
+		{
+			for (start = 0; start < sizeof(starts) / sizeof(starts[0]); start++)
+			{
+				Filter_EMAInit(&ema, (uint8) shift);
+				Filter_EMA(&ema, starts[start]);
+				for (sample = 0; sample < TEST_SETTLE_SAMPLES; sample++)
+				{
+					output = Filter_EMA(&ema, targets[target]);
+				}
+				for (sample = 0; (sample < 100) && (output == targets[target]); sample++)
+				{
+					output = Filter_EMA(&ema, targets[target]);
+				}
+				if (output != targets[target])
+				{
+					printf("      shift %u from %u to %u: %u\n", shift, starts[start],
+							targets[target], output);
+					passed = 0;
+				}
+			}
+		}
+	}
+	Test_expect(passed, "EMA settles exactly from both ends of the range, shifts 0 to 8");
+}
+
+/*
+ * [Function Name]	: Test_rateLimit
+ * [Description]	:
+ * 		Function that checks rate limiter steps rising & falling, also across
+ * 		the whole 16-bit range.
+ */
+static void Test_rateLimit(void)
+{
+	Filter_RateLimitType limiter;
+	unsigned int sample;
+	unsigned int expected;
+	int passed = 1;
+
+	Filter_rateLimitInit(&limiter, 7);
+	passed &= (Filter_rateLimit(&limiter, 0) == 0);
+	for (sample = 1; sample <= 15; sample++)
+	{
+		expected = (sample * 7 < 100) ? sample * 7 : 100;
+		passed &= (Filter_rateLimit(&limiter, 100) == expected);
+	}
+	for (sample = 1; sample <= 15; sample++)
+	{
+		expected = (100 > sample * 7) ? 100 - sample * 7 : 0;
+		passed &= (Filter_rateLimit(&limiter, 0) == expected);
+	}
+	Filter_rateLimitInit(&limiter, 40000);
+	passed &= (Filter_rateLimit(&limiter, 65535) == 65535);
+	passed &= (Filter_rateLimit(&limiter, 0) == 25535);
+	passed &= (Filter_rateLimit(&limiter, 0) == 0);
+	passed &= (Filter_rateLimit(&limiter, 65535) == 40000);
+	passed &= (Filter_rateLimit(&limiter, 65535) == 65535);
+	Test_expect(passed, "rate limiter steps by the maximum & stops on the sample");
+}
+
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Runs every check, fails if any of them fails.
+ */
+int main(void)
+{
+	/* Fan controller: tenths of degree, EMA shift 2 */
+	Test_trace("lm35_tenths.txt", 2, 6.0, 25);
+	/* Distance measuring: centimeters, EMA shift 1 */
+	Test_trace("ultrasonic_cm.txt", 1, 2.0, 10);
+	Test_median();
+	Test_EMA();
+	Test_rateLimit();
+	printf("test_filter: %lu failures\n", g_failures);
+	return (g_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: test_lm35.c
+ * Description: Exhaustive check of the fan controller LM35 integer scaling.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdio.h>
+#include "adc.h"
+#include "lm35_three_terminal_sensor.h"
+
+/*******************************************************************************
+ *                            Test Useful Notes                                *
+ *******************************************************************************/
+/*
+ * 		Feeds every ADC result code of the configured resolution to
+ * 		LM35_getTemperature & LM35_getTemperatureTenths through ADC stubs &
+ * 		compares them with the floating point equation they replaced,
+ * 		evaluated in float like avr-gcc (32-bit double) & in double.
+ * 		test_lm35 checks the 12-bit results of adc.h & test_lm35_10bit the
+ * 		1024 codes of the plain 10-bit ADC (ADC_OVERSAMPLING_BITS given as 0).
+ */
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Code returned by the ADC stubs */
+static uint16 g_code = 0;
+
+/*******************************************************************************
+ *                                 ADC Stubs                                   *
+ *******************************************************************************/
+/*
+ * [Function Name]	: ADC_readChannel
+ * [Description]	:
+ * 		Stub of the polling conversion, returns the code under test.
+ */
+uint16 ADC_readChannel(uint8 channelNum)
+{
+	(void) channelNum;
+	return g_code;
+}
+
+/*
+ * [Function Name]	: ADC_getChannelResult
+ * [Description]	:
+ * 		Stub of the channels scan result, returns the code under test.
+ */
+uint8 ADC_getChannelResult(uint8 channelNum, uint16 *value_Ptr)
+{
+	(void) channelNum;
+	*value_Ptr = g_code;
+	return TRUE;
+}
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Test_check
+ * [Description]	:
+ * 		Function that compares one conversion with both references & prints
+ * 		the first mismatches.
+ */
+static unsigned long Test_check(const char *name, unsigned long value, float single,
+		double twice)
+{
+	unsigned long mismatches = 0;
+	if (value != (unsigned long) single)
+	{
+		mismatches++;
+	}
+	if (value != (unsigned long) twice)
+	{
+		mismatches++;
+	}
+	if (mismatches != 0)
+	{
+		printf("code %u %s: %lu, float %.4f, double %.4f\n", g_code, name, value,
+				single, twice);
+	}
+	return mismatches;
+}
+
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Checks every code, fails on any mismatch.
+ */
+int main(void)
+{
+	unsigned long mismatches = 0;
+	unsigned long code;
+	float scale = (float) ADC_RESULT_MAXIMUM_VALUE * (float) SENSOR_MAX_VOLT_VALUE;
+
+	for (code = 0; code <= ADC_RESULT_MAXIMUM_VALUE; code++)
+	{
+		g_code = (uint16) code;
+		/* Degrees are truncated to uint8 as before */
+		mismatches += Test_check("degrees", LM35_getTemperature(),
+				(float) (uint8) (uint16) ((float) code * SENSOR_MAX_TEMPERATURE
+						* (float) ADC_REF_VOLT_VALUE / scale),
+				(double) (uint8) (uint16) ((double) code * SENSOR_MAX_TEMPERATURE
+						* ADC_REF_VOLT_VALUE
+						/ ((double) ADC_RESULT_MAXIMUM_VALUE * SENSOR_MAX_VOLT_VALUE)));
+		mismatches += Test_check("tenths", LM35_getTemperatureTenths(),
+				(float) code * (SENSOR_MAX_TEMPERATURE * 10)
+						* (float) ADC_REF_VOLT_VALUE / scale,
+				(double) code * (SENSOR_MAX_TEMPERATURE * 10) * ADC_REF_VOLT_VALUE
+						/ ((double) ADC_RESULT_MAXIMUM_VALUE * SENSOR_MAX_VOLT_VALUE));
+	}
+	printf("test_lm35: %d-bit results, %lu codes, %lu mismatches\n", ADC_RESULT_BITS,
+			(unsigned long) ADC_RESULT_MAXIMUM_VALUE + 1, mismatches);
+	return (mismatches == 0) ? 0 : 1;
+}
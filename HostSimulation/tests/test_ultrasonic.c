@@ -0,0 +1,615 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: test_ultrasonic.c
+ * Description: Host test of the distance measuring ultrasonic driver.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/mman.h>
+#include <avr/io.h>
+#include "icu.h"
+#include "timer.h"
+#include "gpio.h"
+#include "ultrasonic_four_terminal_sensor.h"
+
+/*******************************************************************************
+ *                            Test Useful Notes                                *
+ *******************************************************************************/
+/*
+ * 		Converts every echo width up to the no-echo clamp at every temperature
+ * 		of Ultrasonic_setTemperature (-40 to 85 Celsius) & compares the results
+ * 		with the distance evaluated in double, then compares the 25 Celsius
+ * 		centi-meters with the float equation they replaced.
+ *
+ * 		Then runs the ranging schedule on mocked drivers, one loop iteration
+ * 		per ICU tick: the timer1 compare unit B call-back runs when the low 16
+ * 		bits of the free-running timestamp match the compare value & echo
+ * 		pulses reach the ICU queue & call-back at their falling edge. Sensors
+ * 		answer every trigger pin rising edge as configured by the test. The
+ * 		timestamp starts 3 seconds before it's 32-bit wrap-around.
+ *
+ * 		test_ultrasonic checks one sensor through echoes, disturbances,
+ * 		timeouts & the wrap-around. test_ultrasonic_array is built with four
+ * 		sensors (ULTRASONIC_SENSORS_NUMBER given as 4) on a multiplexer, three
+ * 		of them answering at different distances & one silent, & checks the
+ * 		round-robin schedule: channel selection, sensor cycle, slot & guard.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Largest error allowed against the double reference, in result units */
+#define TEST_MAX_ERROR				1.0
+/* Largest difference allowed against the replaced float equation, centi-meters */
+#define TEST_MAX_FLOAT_DIFFERENCE	1
+
+/* Sound speed used by the sensors, the driver default temperature */
+#define TEST_SOUND_SPEED			(ULTRASONIC_SOUND_SPEED_0C \
+		+ ULTRASONIC_SOUND_SPEED_SLOPE * ULTRASONIC_TEMPERATURE)
+/* Time from trigger to echo rising edge, the sensor sends it's burst */
+#define TEST_ECHO_DELAY_TICKS		ULTRASONIC_US_TO_TICKS(450ULL)
+/* Width of the pulse a sensor sends when nothing echoes */
+#define TEST_NO_ECHO_TICKS			ULTRASONIC_US_TO_TICKS(38500ULL)
+/* Oldest valid result while echoes come, a sensor cycle & the longest echo */
+#define TEST_MAX_AGE_MS				(ULTRASONIC_SENSOR_CYCLE_MS + 38)
+#define TEST_MS_TO_TICKS(ms)		((uint32) ULTRASONIC_US_TO_TICKS((ms) * 1000ULL))
+#define TEST_LINE_SIZE				16
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Enumeration Name]	: TEST_SENSOR_MODE
+ * [Description]		:
+ * 		Answer of a sensor to it's trigger.
+ */
+typedef enum
+{
+	TEST_ECHO, TEST_NO_ECHO, TEST_SILENT
+} TEST_SENSOR_MODE;
+
+/*
+ * [Structure Name]	: Test_PulseType
+ * [Description]	:
+ * 		Pulse on the echo line of a sensor, reaches the ICU at it's end.
+ */
+typedef struct
+{
+	uint32 start;
+	uint32 end;
+	uint8 sensorId;
+	uint8 echo;
+	uint8 pending;
+} Test_PulseType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static unsigned long g_failures = 0;
+
+/* Mocked ICU & timer1 compare unit B */
+static uint32 g_now = 0;
+static void (*g_ICUCallBack)(void) = NULL;
+static ICU_PulseType g_ICUQueue[TEST_LINE_SIZE];
+static uint8 g_ICUQueueHead = 0;
+static uint8 g_ICUQueueTail = 0;
+static void (*g_compareCallBack)(void) = NULL;
+static uint16 g_compareValue = 0;
+static uint8 g_compareEnabled = FALSE;
+
+/* Mocked sensors & echo lines */
+static TEST_SENSOR_MODE g_mode[ULTRASONIC_SENSORS_NUMBER];
+static uint16 g_distance[ULTRASONIC_SENSORS_NUMBER];
+static uint8 g_disturbances = FALSE;
+static Test_PulseType g_line[TEST_LINE_SIZE];
+static uint8 g_channel = 0;
+
+/* Observations */
+static unsigned long g_triggers[ULTRASONIC_SENSORS_NUMBER];
+static unsigned long g_echoes[ULTRASONIC_SENSORS_NUMBER];
+static uint32 g_lastTrigger[ULTRASONIC_SENSORS_NUMBER];
+static uint32 g_minSpacing = 0xFFFFFFFF;
+static unsigned long g_wrongChannels = 0;
+/* Closest triggers after a delivered echo & after a silent sensor trigger */
+static uint32 g_echoEnd = 0;
+static uint8 g_afterEcho = FALSE;
+static uint32 g_minGuard = 0xFFFFFFFF;
+static uint32 g_silentTrigger = 0;
+static uint8 g_afterSilent = FALSE;
+static uint32 g_minSlot = 0xFFFFFFFF;
+
+/*******************************************************************************
+ *                           ICU, Timer & GPIO Mocks                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Driver mocks
+ * [Description]	:
+ * 		Mocks of the drivers below the ultrasonic, the ICU timestamp is the
+ * 		test time & the queue holds pulses delivered by Test_run.
+ */
+void ICU_init(const ICU_ConfigType *Config_Ptr)
+{
+	(void) Config_Ptr;
+	g_ICUQueueHead = 0;
+	g_ICUQueueTail = 0;
+}
+
+void ICU_setCallBack(void (*Ptr2Function)(void))
+{
+	g_ICUCallBack = Ptr2Function;
+}
+
+uint32 ICU_getTimestamp(void)
+{
+	return g_now;
+}
+
+uint8 ICU_getPulse(ICU_PulseType *pulse_Ptr)
+{
+	if (g_ICUQueueTail == g_ICUQueueHead)
+	{
+		return FALSE;
+	}
+	*pulse_Ptr = g_ICUQueue[g_ICUQueueTail];
+	g_ICUQueueTail = (g_ICUQueueTail + 1) % TEST_LINE_SIZE;
+	return TRUE;
+}
+
+void ICU_flushPulses(void)
+{
+	g_ICUQueueTail = g_ICUQueueHead;
+}
+
+void Timer1_setCallBackUnitB(void (*Ptr2Function)(void))
+{
+	g_compareCallBack = Ptr2Function;
+}
+
+void Timer1_setCompareValueB(uint16 compareValue)
+{
+	g_compareValue = compareValue;
+}
+
+void Timer1_enableInterruptUnitB(void)
+{
+	g_compareEnabled = TRUE;
+}
+
+void GPIO_setupPinDirection(uint8 portNum, uint8 pinNum, GPIO_PinDirectionType direction)
+{
+	(void) portNum;
+	(void) pinNum;
+	(void) direction;
+}
+
+/*
+ * [Function Name]	: Test_addPulse
+ * [Description]	:
+ * 		Function that puts a pulse on the echo line of a sensor.
+ */
+static void Test_addPulse(uint8 sensorId, uint32 start, uint32 width, uint8 echo)
+{
+	uint8 slot;
+	for (slot = 0; slot < TEST_LINE_SIZE; slot++)
+	{
+		if (g_line[slot].pending == FALSE)
+		{
+			g_line[slot].start = start;
+			g_line[slot].end = start + width;
+			g_line[slot].sensorId = sensorId;
+			g_line[slot].echo = echo;
+			g_line[slot].pending = TRUE;
+			return;
+		}
+	}
+	printf("echo line full\n");
+	exit(1);
+}
+
+/*
+ * [Function Name]	: Test_trigger
+ * [Description]	:
+ * 		Function that answers a trigger rising edge as configured.
+ */
+static void Test_trigger(uint8 sensorId)
+{
+	uint32 width = (uint32) (2.0 * g_distance[sensorId] * F_CPU
+			/ ((double) ULTRASONIC_ICU_DIVISION * TEST_SOUND_SPEED) + 0.5);
+	uint32 spacing = g_now - g_lastTrigger[sensorId];
+	if ((g_triggers[sensorId] != 0) && (spacing < g_minSpacing))
+	{
+		g_minSpacing = spacing;
+	}
+	g_lastTrigger[sensorId] = g_now;
+	g_triggers[sensorId]++;
+	if (g_channel != sensorId)
+	{
+		g_wrongChannels++;
+	}
+	if ((g_afterEcho == TRUE) && ((g_now - g_echoEnd) < g_minGuard))
+	{
+		g_minGuard = g_now - g_echoEnd;
+	}
+	if ((g_afterSilent == TRUE) && ((g_now - g_silentTrigger) < g_minSlot))
+	{
+		g_minSlot = g_now - g_silentTrigger;
+	}
+	g_afterEcho = FALSE;
+	g_afterSilent = (g_mode[sensorId] == TEST_SILENT);
+	g_silentTrigger = g_now;
+	if (g_disturbances == TRUE)
+	{
+		/* Pulse that started before the trigger & noise shorter than 100 us */
+		Test_addPulse(sensorId, g_now - 300, 900, FALSE);
+		Test_addPulse(sensorId, g_now + 100, 50, FALSE);
+	}
+	if (g_mode[sensorId] == TEST_ECHO)
+	{
+		Test_addPulse(sensorId, g_now + TEST_ECHO_DELAY_TICKS, width, TRUE);
+		if (g_disturbances == TRUE)
+		{
+			/* Duplicate echo of a farther reflection */
+			Test_addPulse(sensorId, g_now + TEST_ECHO_DELAY_TICKS + width + 2000,
+					2 * width, FALSE);
+		}
+	}
+	else if (g_mode[sensorId] == TEST_NO_ECHO)
+	{
+		Test_addPulse(sensorId, g_now + TEST_ECHO_DELAY_TICKS, TEST_NO_ECHO_TICKS, FALSE);
+	}
+}
+
+void GPIO_writePin(uint8 portNum, uint8 pinNum, uint8 value)
+{
+	if ((portNum == ULTRASONIC_TRIGGER_PORT_ID) && (value == LOGIC_HIGH)
+			&& (pinNum >= ULTRASONIC_TRIGGER_FIRST_PIN_ID)
+			&& (pinNum < ULTRASONIC_TRIGGER_FIRST_PIN_ID + ULTRASONIC_SENSORS_NUMBER))
+	{
+		Test_trigger(pinNum - ULTRASONIC_TRIGGER_FIRST_PIN_ID);
+	}
+
+#if (ULTRASONIC_SENSORS_NUMBER > 1)
+
+	/* Multiplexer channel follows it's select pins */
+	if ((portNum == ULTRASONIC_MUX_PORT_ID)
+			&& ((uint8) (pinNum - ULTRASONIC_MUX_FIRST_PIN_ID) < ULTRASONIC_MUX_SELECT_BITS))
+	{
+		if (value == LOGIC_HIGH)
+		{
+			g_channel |= (1 << (pinNum - ULTRASONIC_MUX_FIRST_PIN_ID));
+		}
+		else
+		{
+			g_channel &= ~(1 << (pinNum - ULTRASONIC_MUX_FIRST_PIN_ID));
+		}
+	}
+
+#endif
+
+}
+
+void Sim_delayCycles(uint64_t cycles)
+{
+	g_now += (uint32) (cycles / ULTRASONIC_ICU_DIVISION);
+}
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Test_expect
+ * [Description]	:
+ * 		Function that prints a check result & counts failures.
+ */
+static void Test_expect(int passed, const char *check)
+{
+	printf("%s  %s\n", passed ? "pass" : "FAIL", check);
+	if (!passed)
+	{
+		g_failures++;
+	}
+}
+
+/*
+ * [Function Name]	: Test_scaling
+ * [Description]	:
+ * 		Function that checks every echo width at every temperature against
+ * 		the double reference & prints the worst errors.
+ */
+static void Test_scaling(void)
+{
+	double millimeterError = 0;
+	double centimeterError = 0;
+	double millimeters;
+	double error;
+	uint32 ticks;
+	int temperature;
+
+	for (temperature = -40; temperature <= 85; temperature++)
+	{
+		Ultrasonic_setTemperature((sint8) temperature);
+		for (ticks = 0; ticks <= ULTRASONIC_MAX_ECHO_TICKS; ticks++)
+		{
+			/* Half the echo width at the speed of sound in milli-meters per second */
+			millimeters = (double) ticks * ULTRASONIC_ICU_DIVISION / F_CPU
+					* (ULTRASONIC_SOUND_SPEED_0C
+							+ (double) ULTRASONIC_SOUND_SPEED_SLOPE * temperature) / 2;
+			error = fabs(Ultrasonic_ticksToMillimeters(ticks) - millimeters);
+			millimeterError = (error > millimeterError) ? error : millimeterError;
+			error = fabs(Ultrasonic_ticksToCentimeters(ticks) - millimeters / 10);
+			centimeterError = (error > centimeterError) ? error : centimeterError;
+		}
+	}
+	printf("worst error %.2f mm, %.2f cm\n", millimeterError, centimeterError);
+	Test_expect((millimeterError <= TEST_MAX_ERROR) && (centimeterError <= TEST_MAX_ERROR),
+			"every width at -40 to 85 C within 1 unit of the double reference");
+}
+
+/*
+ * [Function Name]	: Test_clamp
+ * [Description]	:
+ * 		Function that checks widths above the no-echo pulse give the distance
+ * 		of the pulse instead of an overflowed product.
+ */
+static void Test_clamp(void)
+{
+	static const uint32 widths[] = { ULTRASONIC_MAX_ECHO_TICKS + 1, 0x10000, 0x7FFFFFFF,
+			0xFFFFFFFF };
+	unsigned int width;
+	int passed = 1;
+
+	Ultrasonic_setTemperature(85);
+	for (width = 0; width < sizeof(widths) / sizeof(widths[0]); width++)
+	{
+		if ((Ultrasonic_ticksToMillimeters(widths[width])
+				!= Ultrasonic_ticksToMillimeters(ULTRASONIC_MAX_ECHO_TICKS))
+				|| (Ultrasonic_ticksToCentimeters(widths[width])
+						!= Ultrasonic_ticksToCentimeters(ULTRASONIC_MAX_ECHO_TICKS)))
+		{
+			passed = 0;
+		}
+	}
+	Test_expect(passed, "widths above the no-echo pulse are clamped");
+}
+
+/*
+ * [Function Name]	: Test_float
+ * [Description]	:
+ * 		Function that checks the 25 Celsius centi-meters against the float
+ * 		equation of the old Ultrasonic_readDistance.
+ */
+static void Test_float(void)
+{
+	long difference;
+	long worst = 0;
+	uint32 ticks;
+
+	Ultrasonic_setTemperature(ULTRASONIC_TEMPERATURE);
+	for (ticks = 0; ticks <= ULTRASONIC_MAX_ECHO_TICKS; ticks++)
+	{
+		difference = labs((long) Ultrasonic_ticksToCentimeters(ticks)
+				- (long) (uint16) ((float) 0.01731 * ticks));
+		worst = (difference > worst) ? difference : worst;
+	}
+	printf("worst difference from the float equation %ld cm\n", worst);
+	Test_expect(worst <= TEST_MAX_FLOAT_DIFFERENCE,
+			"25 C centi-meters within 1 cm of (float) 0.01731 * ticks");
+}
+
+/*
+ * [Function Name]	: Test_run
+ * [Description]	:
+ * 		Function that advances the test time, running the compare call-back
+ * 		on a match & delivering echo line pulses of the selected sensor at
+ * 		their end.
+ */
+static void Test_run(uint32 ticks)
+{
+	uint8 slot;
+	for (; ticks != 0; ticks--)
+	{
+		g_now++;
+		if ((g_compareEnabled == TRUE) && ((uint16) g_now == g_compareValue))
+		{
+			g_compareCallBack();
+		}
+		for (slot = 0; slot < TEST_LINE_SIZE; slot++)
+		{
+			if ((g_line[slot].pending == TRUE) && (g_line[slot].end == g_now))
+			{
+				g_line[slot].pending = FALSE;
+				if (g_line[slot].sensorId == g_channel)
+				{
+					g_ICUQueue[g_ICUQueueHead].start = g_line[slot].start;
+					g_ICUQueue[g_ICUQueueHead].end = g_line[slot].end;
+					g_ICUQueueHead = (g_ICUQueueHead + 1) % TEST_LINE_SIZE;
+					if (g_line[slot].echo == TRUE)
+					{
+						g_echoes[g_line[slot].sensorId]++;
+						g_echoEnd = g_now;
+						g_afterEcho = TRUE;
+					}
+					g_ICUCallBack();
+				}
+			}
+		}
+	}
+}
+
+/*
+ * [Function Name]	: Test_result
+ * [Description]	:
+ * 		Function that checks the result of a sensor, distance within 1 mm
+ * 		when a distance is given & age at most maxAge milli-seconds.
+ */
+static int Test_result(uint8 sensorId, ULTRASONIC_STATUS status, uint16 distance,
+		uint16 maxAge)
+{
+	Ultrasonic_ResultType result;
+	Ultrasonic_getResult(sensorId, &result);
+	printf("sensor %u: status %d, %u mm, %u cm, age %u ms, sequence %u\n", sensorId,
+			result.status, result.distanceMm, result.distanceCm, result.age,
+			result.sequence);
+	return (result.status == status)
+			&& ((distance == 0) || (abs(result.distanceMm - distance) <= 1))
+			&& (result.age <= maxAge);
+}
+
+#if (ULTRASONIC_SENSORS_NUMBER == 1)
+
+/*
+ * [Function Name]	: Test_ranging
+ * [Description]	:
+ * 		Function that runs one sensor through echoes with disturbances, no-echo
+ * 		pulses, silence & recovery across the timestamp wrap-around.
+ */
+static void Test_ranging(void)
+{
+	Ultrasonic_ResultType result;
+	unsigned long echoes;
+	uint8 sequence;
+
+	g_now = 0 - TEST_MS_TO_TICKS(3000);
+	Ultrasonic_init();
+	Test_run(TEST_MS_TO_TICKS(50));
+	Test_expect(Test_result(0, ULTRASONIC_NO_RESULT, 0, 0)
+			&& (Ultrasonic_readDistance(0) == 0), "no result before the first echo");
+
+	/* Echoes with a pulse started before the trigger, noise & a duplicate echo */
+	g_mode[0] = TEST_ECHO;
+	g_distance[0] = 1000;
+	g_disturbances = TRUE;
+	Test_run(TEST_MS_TO_TICKS(1000));
+	Ultrasonic_getResult(0, &result);
+	Test_expect(Test_result(0, ULTRASONIC_VALID, 1000, TEST_MAX_AGE_MS)
+			&& (result.sequence == (uint8) g_echoes[0]),
+			"disturbed echoes measure 1000 mm, one result per echo");
+
+	/* The sensor gives up, then stays silent */
+	g_mode[0] = TEST_NO_ECHO;
+	g_disturbances = FALSE;
+	sequence = result.sequence;
+	Test_run(TEST_MS_TO_TICKS(150));
+	Test_expect(Test_result(0, ULTRASONIC_TIMEOUT, 1000, ULTRASONIC_STALE_MS),
+			"no-echo pulses time out & keep the last distance");
+	g_mode[0] = TEST_SILENT;
+	Test_run(TEST_MS_TO_TICKS(100));
+	Test_expect(Test_result(0, ULTRASONIC_TIMEOUT, 1000, ULTRASONIC_STALE_MS),
+			"missing echoes time out at the slot end");
+	Test_run(TEST_MS_TO_TICKS(100));
+	Ultrasonic_getResult(0, &result);
+	Test_expect(Test_result(0, ULTRASONIC_STALE, 1000, 0xFFFF)
+			&& (result.age > ULTRASONIC_STALE_MS) && (result.sequence == sequence),
+			"stale after 300 ms without a valid echo");
+
+	/* Recovery, the timestamp wraps around during it */
+	g_mode[0] = TEST_ECHO;
+	g_distance[0] = 500;
+	echoes = g_echoes[0];
+	Test_run(TEST_MS_TO_TICKS(100));
+	Test_expect(Test_result(0, ULTRASONIC_VALID, 500, TEST_MAX_AGE_MS),
+			"valid again after the first echo");
+	Test_run(TEST_MS_TO_TICKS(2000));
+	Ultrasonic_getResult(0, &result);
+	Test_expect((g_now < TEST_MS_TO_TICKS(1000))
+			&& Test_result(0, ULTRASONIC_VALID, 500, TEST_MAX_AGE_MS)
+			&& ((uint8) (result.sequence - sequence) == (uint8) (g_echoes[0] - echoes)),
+			"ranging continues across the timestamp wrap-around");
+	printf("%lu triggers, %lu echoes, closest triggers %lu us apart\n", g_triggers[0],
+			g_echoes[0], (unsigned long) g_minSpacing);
+	Test_expect(g_minSpacing >= ULTRASONIC_SENSOR_CYCLE_TICKS,
+			"triggers at least one sensor cycle apart");
+}
+
+#else
+
+/*
+ * [Function Name]	: Test_sensors
+ * [Description]	:
+ * 		Function that runs all sensors round-robin, the last one silent,
+ * 		across the timestamp wrap-around.
+ */
+static void Test_sensors(void)
+{
+	Ultrasonic_ResultType result;
+	uint8 sensorId;
+	unsigned long fewest = 0xFFFFFFFF;
+	unsigned long most = 0;
+	int passed = 1;
+
+	for (sensorId = 0; sensorId < ULTRASONIC_SENSORS_NUMBER; sensorId++)
+	{
+		g_mode[sensorId] = TEST_ECHO;
+		g_distance[sensorId] = 300 + 700 * sensorId;
+	}
+	g_mode[ULTRASONIC_SENSORS_NUMBER - 1] = TEST_SILENT;
+	g_now = 0 - TEST_MS_TO_TICKS(1000);
+	Ultrasonic_init();
+	Test_run(TEST_MS_TO_TICKS(2000));
+
+	for (sensorId = 0; sensorId < ULTRASONIC_SENSORS_NUMBER - 1; sensorId++)
+	{
+		Ultrasonic_getResult(sensorId, &result);
+		if (!Test_result(sensorId, ULTRASONIC_VALID, g_distance[sensorId],
+				ULTRASONIC_STALE_MS) || (result.sequence != (uint8) g_echoes[sensorId]))
+		{
+			passed = 0;
+		}
+	}
+	Test_expect(passed, "answering sensors measure their own distance, one result per echo");
+	Test_expect(Test_result(ULTRASONIC_SENSORS_NUMBER - 1, ULTRASONIC_NO_RESULT, 0, 0)
+			&& Test_result(ULTRASONIC_SENSORS_NUMBER, ULTRASONIC_NO_RESULT, 0, 0),
+			"silent sensor & wrong sensor number have no result");
+	for (sensorId = 0; sensorId < ULTRASONIC_SENSORS_NUMBER; sensorId++)
+	{
+		fewest = (g_triggers[sensorId] < fewest) ? g_triggers[sensorId] : fewest;
+		most = (g_triggers[sensorId] > most) ? g_triggers[sensorId] : most;
+	}
+	printf("%lu to %lu triggers per sensor, closest %lu us apart\n", fewest, most,
+			(unsigned long) g_minSpacing);
+	printf("closest triggers %lu us after an echo, %lu us after a silent sensor\n",
+			(unsigned long) g_minGuard, (unsigned long) g_minSlot);
+	Test_expect((most - fewest <= 1) && (g_wrongChannels == 0),
+			"sensors triggered round-robin on their own multiplexer channel");
+	Test_expect(g_minSpacing >= ULTRASONIC_SENSOR_CYCLE_TICKS,
+			"each sensor triggered at least one sensor cycle apart");
+	Test_expect((g_minGuard >= ULTRASONIC_GUARD_TICKS) && (g_minSlot >= ULTRASONIC_SLOT_TICKS),
+			"next sensor waits the guard after an echo & the slot after silence");
+}
+
+#endif
+
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Runs every check, fails if any of them fails.
+ */
+int main(void)
+{
+	/* Plain memory for the registers the driver reads, the global interrupt state */
+	if (mmap((void *) SIM_IO_BASE, SIM_IO_SIZE, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != (void *) SIM_IO_BASE)
+	{
+		printf("cannot map register file at 0x%lx\n", SIM_IO_BASE);
+		return 1;
+	}
+	Test_scaling();
+	Test_clamp();
+	Test_float();
+
+#if (ULTRASONIC_SENSORS_NUMBER == 1)
+
+	Test_ranging();
+
+#else
+
+	Test_sensors();
+
+#endif
+
+	printf("test_ultrasonic: %lu failures\n", g_failures);
+	return (g_failures == 0) ? 0 : 1;
+}
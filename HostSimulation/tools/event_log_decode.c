@@ -0,0 +1,234 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: event_log_decode.c
+ * Description: Decoder of the event log frames sent by the firmware USART.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                          Decoder Useful Notes                               *
+ *******************************************************************************/
+/*
+ * 		Usage: event_log_decode [-t US_PER_TICK] [-n SOURCE]... [FILE]
+ *
+ * 		Reads the bytes transmitted by an ECU from FILE or the standard input,
+ * 		e.g. a serial port or SIM_UART_CAPTURE, & prints one line per event:
+ *
+ * 			    2.130048 s  CONTROL_EVENT_COMMAND         3 (0x0003)
+ *
+ * 		Frames are "A5 ID TIME_L TIME_H PAYLOAD_L PAYLOAD_H SUM" (event_log.h),
+ * 		bytes that do not start a frame with a valid sum are application
+ * 		bytes & skipped. The firmware sends an epoch frame each time the
+ * 		16-bit log clock wraps, it's payload counts the wraps since
+ * 		EventLog_init, so times count from it when the capture starts at
+ * 		reset, whatever the gap between events. An event stamped just after
+ * 		a wrap but queued before it's epoch frame, or after an epoch frame
+ * 		dropped by a full ring, has a time below the previous one & is moved
+ * 		to the next period. Epoch frames are not printed. Names come from the
+ * 		"#define NAME_EVENT_X N" lines of the SOURCE files, -t gives the log
+ * 		clock tick, (128) us for the (1024) pre-scaler at (8) MHz.
+ *
+ * 		The summary counts the events lost: dropped by the firmware while
+ * 		it's ring was full, & corrupt frames, a sync byte followed by a wrong
+ * 		sum. The firmware sends whole frames, so a corrupt frame means bytes
+ * 		lost or changed on the line, it's event is skipped & the loss rate
+ * 		gives how far the other events can be trusted.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define DECODE_SYNC					0xA5
+#define DECODE_FRAME_SIZE			7
+#define DECODE_NAME_SIZE			64
+#define DECODE_LINE_SIZE			512
+#define DECODE_DROPPED				0
+#define DECODE_EPOCH				255
+#define DECODE_PERIOD				65536
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+static char g_names[256][DECODE_NAME_SIZE];
+static double g_tickUs = 128.0;
+/* Unwrapped clock, log clock wraps counted by the epoch frames */
+static uint16_t g_epoch = 0;
+static uint64_t g_periods = 0;
+static uint64_t g_ticks = 0;
+/* Statistics */
+static unsigned long g_frames = 0;
+static unsigned long g_skipped = 0;
+static unsigned long g_dropped = 0;
+static unsigned long g_epochs = 0;
+static unsigned long g_corrupt = 0;
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Decode_loadNames
+ * [Description]	:
+ * 		Function that takes events names from the "#define" lines of a source
+ * 		file holding "_EVENT_" in their name.
+ */
+static void Decode_loadNames(const char *path)
+{
+	char line[DECODE_LINE_SIZE];
+	char name[DECODE_NAME_SIZE];
+	unsigned int id;
+	FILE *file = fopen(path, "r");
+
+	if (file == NULL)
+	{
+		perror(path);
+		exit(1);
+	}
+	while (fgets(line, sizeof(line), file) != NULL)
+	{
+		if ((sscanf(line, " #define %63s %u", name, &id) == 2)
+				&& (strstr(name, "_EVENT_") != NULL) && (id < 256))
+		{
+			snprintf(g_names[id], sizeof(g_names[id]), "%s", name);
+		}
+	}
+	fclose(file);
+}
+
+/*
+ * [Function Name]	: Decode_print
+ * [Description]	:
+ * 		Function that prints a valid frame.
+ */
+static void Decode_print(const uint8_t *frame)
+{
+	uint8_t id = frame[1];
+	uint16_t time = (uint16_t) (frame[2] | (frame[3] << 8));
+	uint16_t payload = (uint16_t) (frame[4] | (frame[5] << 8));
+	char unknown[DECODE_NAME_SIZE];
+	const char *name = g_names[id];
+	uint64_t ticks;
+
+	if (id == DECODE_EPOCH)
+	{
+		/* Epochs lost with a full ring are counted by the payload difference */
+		g_periods += (uint16_t) (payload - g_epoch);
+		g_epoch = payload;
+		g_epochs++;
+	}
+	ticks = (g_periods * DECODE_PERIOD) + time;
+	if (ticks < g_ticks)
+	{
+		/* Clock wrapped before it's epoch frame was received */
+		ticks += DECODE_PERIOD;
+	}
+	g_ticks = ticks;
+	if (id == DECODE_EPOCH)
+	{
+		return;
+	}
+	if (name[0] == '\0')
+	{
+		if (id == DECODE_DROPPED)
+		{
+			name = "DROPPED";
+		}
+		else
+		{
+			snprintf(unknown, sizeof(unknown), "EVENT_%u", id);
+			name = unknown;
+		}
+	}
+	if (id == DECODE_DROPPED)
+	{
+		g_dropped += payload;
+	}
+	else
+	{
+		g_frames++;
+	}
+	printf("%12.6f s  %-28s %5u (0x%04X)\n", (double) g_ticks * g_tickUs / 1e6, name,
+			payload, payload);
+	fflush(stdout);
+}
+
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Function that decodes the stream, a window of one frame slides over
+ * 		the bytes until it holds a sync byte & a valid sum.
+ */
+int main(int argc, char **argv)
+{
+	uint8_t window[DECODE_FRAME_SIZE];
+	uint8_t count = 0;
+	uint8_t sum;
+	uint8_t index;
+	unsigned long lost;
+	int data;
+	int arg;
+	FILE *input = stdin;
+
+	for (arg = 1; arg < argc; arg++)
+	{
+		if ((strcmp(argv[arg], "-t") == 0) && (arg + 1 < argc))
+		{
+			g_tickUs = atof(argv[++arg]);
+		}
+		else if ((strcmp(argv[arg], "-n") == 0) && (arg + 1 < argc))
+		{
+			Decode_loadNames(argv[++arg]);
+		}
+		else if ((argv[arg][0] == '-') || (input != stdin))
+		{
+			fprintf(stderr, "usage: %s [-t US_PER_TICK] [-n SOURCE]... [FILE]\n", argv[0]);
+			return 1;
+		}
+		else if ((input = fopen(argv[arg], "rb")) == NULL)
+		{
+			perror(argv[arg]);
+			return 1;
+		}
+	}
+
+	while ((data = fgetc(input)) != EOF)
+	{
+		window[count++] = (uint8_t) data;
+		while (count != 0)
+		{
+			if (window[0] == DECODE_SYNC)
+			{
+				if (count < DECODE_FRAME_SIZE)
+				{
+					break;
+				}
+				sum = 0;
+				for (index = 1; index < DECODE_FRAME_SIZE - 1; index++)
+				{
+					sum = (uint8_t) (sum + window[index]);
+				}
+				if (sum == window[DECODE_FRAME_SIZE - 1])
+				{
+					Decode_print(window);
+					count = 0;
+					continue;
+				}
+				g_corrupt++;
+			}
+			/* Not a frame, slide by one byte */
+			memmove(window, window + 1, --count);
+			g_skipped++;
+		}
+	}
+	g_skipped += count;
+	lost = g_dropped + g_corrupt;
+	fprintf(stderr, "event_log_decode: %lu events, %lu dropped by the firmware, "
+			"%lu corrupt frames, %.2f %% lost, %lu epochs, %lu other bytes\n", g_frames,
+			g_dropped, g_corrupt, (g_frames + lost == 0) ? 0.0 :
+			100.0 * lost / (g_frames + lost), g_epochs, g_skipped);
+	return 0;
+}
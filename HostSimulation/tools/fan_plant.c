@@ -0,0 +1,309 @@
+/******************************************************************************
+ * Module: Host Simulation
+ * File Name: fan_plant.c
+ * Description: Thermal plant simulation comparing the fan controllers.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "adc.h"
+#include "fan_controller_project.h"
+#include "filter.h"
+#include "lm35_three_terminal_sensor.h"
+#include "pid.h"
+
+/*******************************************************************************
+ *                          Plant Useful Notes                                 *
+ *******************************************************************************/
+/*
+ * 		Usage: fan_plant [-t SECONDS] [-v]
+ *
+ * 		Heated enclosure cooled by the fan:
+ *
+ * 			C dT/dt = P - (H0 + H1 * Duty) * (T - Ambient)
+ *
+ * 		The LM35 reading of T with uniform noise is quantized to an ADC code &
+ * 		converted by the fan controller LM35 HAL, the filters & the PI
+ * 		controller are the firmware LIB sources. Both controllers start at
+ * 		(PLANT_START_TEMP) & are reported with:
+ * 			final		: mean & peak to peak temperature over the last minute.
+ * 			settled		: time after which temperature stays within
+ * 						  (PLANT_SETTLE_BAND) of the final mean.
+ * 			commands	: DCMotor_Rotate calls in total & per second.
+ * 		-v prints both temperatures & speeds every second.
+ */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Plant, degrees Celsius, Watts, Joules per degree & Watts per degree */
+#define PLANT_AMBIENT				25.0
+#define PLANT_POWER					3.22
+#define PLANT_CAPACITY				20.0
+#define PLANT_H0					0.1
+#define PLANT_H1					1.0
+#define PLANT_START_TEMP			80.0
+#define PLANT_NOISE					0.3
+#define PLANT_STEP_MS				1
+#define PLANT_DEFAULT_SECONDS		600
+#define PLANT_FINAL_SECONDS			60
+#define PLANT_SETTLE_BAND			0.5
+/* LM35 output in volts per degree */
+#define PLANT_LM35_VOLT_PER_DEGREE	0.01
+
+/* Band ladder: one DCMotor_Rotate per main loop pass, the loop of the band
+ * ladder application made (35.5) passes per second on the host simulator */
+#define BANDS_LOOP_MS				28
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: Plant_RunType
+ * [Description]	:
+ * 		A structure in which it's instance holds one controller run.
+ */
+typedef struct
+{
+	const char *name;
+	double temp;
+	uint8 speed;
+	unsigned long commands;
+	double *history; /* Temperature every second */
+} Plant_RunType;
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Code returned by the ADC stubs */
+static uint16 g_code = 0;
+static unsigned long g_random = 12345;
+/* PI application state */
+static Filter_MedianType g_tempMedian;
+static Filter_EMAType g_tempEMA;
+static const Pid_ConfigType g_fanPidConfig = { FAN_PID_KP, FAN_PID_KI, 0,
+FAN_MIN_SPEED, FAN_MAX_SPEED, PID_REVERSE_ACTION };
+static Pid_ControllerType g_fanPid;
+static uint8 g_fanOn = FALSE;
+
+/*******************************************************************************
+ *                                 ADC Stubs                                   *
+ *******************************************************************************/
+/*
+ * [Function Name]	: ADC_readChannel
+ * [Description]	:
+ * 		Stub of the polling conversion, returns the sensor code.
+ */
+uint16 ADC_readChannel(uint8 channelNum)
+{
+	(void) channelNum;
+	return g_code;
+}
+
+/*
+ * [Function Name]	: ADC_getChannelResult
+ * [Description]	:
+ * 		Stub of the channels scan result, returns the sensor code.
+ */
+uint8 ADC_getChannelResult(uint8 channelNum, uint16 *value_Ptr)
+{
+	(void) channelNum;
+	*value_Ptr = g_code;
+	return TRUE;
+}
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Plant_sense
+ * [Description]	:
+ * 		Function that converts a temperature to the ADC code the sensor
+ * 		channel reads, with noise.
+ */
+static void Plant_sense(double temp)
+{
+	double code;
+	/* Fixed seed generator, the same noise for every run */
+	g_random = g_random * 1103515245UL + 12345UL;
+	temp += PLANT_NOISE * ((double) ((g_random >> 16) & 0x7FFF) / 16383.5 - 1.0);
+	code = temp * PLANT_LM35_VOLT_PER_DEGREE / ADC_REF_VOLT_VALUE
+			* ADC_RESULT_MAXIMUM_VALUE + 0.5;
+	code = (code < 0) ? 0 : (code > ADC_RESULT_MAXIMUM_VALUE) ? ADC_RESULT_MAXIMUM_VALUE : code;
+	g_code = (uint16) code;
+}
+
+/*
+ * [Function Name]	: Plant_bands
+ * [Description]	:
+ * 		Band ladder application pass, speed from whole degrees.
+ */
+static uint8 Plant_bands(void)
+{
+	uint8 tempValue = LM35_getTemperature();
+	if (tempValue < 30)
+	{
+		return 0;
+	}
+	else if (tempValue < 60)
+	{
+		return 25;
+	}
+	else if (tempValue < 90)
+	{
+		return 50;
+	}
+	else if (tempValue < 120)
+	{
+		return 75;
+	}
+	return 100;
+}
+
+/*
+ * [Function Name]	: Plant_pi
+ * [Description]	:
+ * 		PI application control sample, speed from filtered tenths of degree.
+ */
+static uint8 Plant_pi(void)
+{
+	uint16 tempTenths = Filter_median(&g_tempMedian, LM35_getTemperatureTenths());
+	tempTenths = Filter_EMA(&g_tempEMA, tempTenths);
+	if ((g_fanOn == FALSE) && (tempTenths >= FAN_ON_TEMP))
+	{
+		g_fanOn = TRUE;
+		Pid_reset(&g_fanPid, FAN_MIN_SPEED);
+	}
+	else if ((g_fanOn == TRUE) && (tempTenths < (FAN_ON_TEMP - FAN_HYSTERESIS)))
+	{
+		g_fanOn = FALSE;
+	}
+	return (g_fanOn == TRUE) ? (uint8) Pid_update(&g_fanPid, (sint16) tempTenths) : 0;
+}
+
+/*
+ * [Function Name]	: Plant_step
+ * [Description]	:
+ * 		Function that advances the plant temperature by one step.
+ */
+static void Plant_step(Plant_RunType *run_Ptr)
+{
+	double duty = (*run_Ptr).speed / 100.0;
+	double flow = PLANT_POWER - (PLANT_H0 + PLANT_H1 * duty) * ((*run_Ptr).temp - PLANT_AMBIENT);
+	(*run_Ptr).temp += flow * (PLANT_STEP_MS / 1000.0) / PLANT_CAPACITY;
+}
+
+/*
+ * [Function Name]	: Plant_report
+ * [Description]	:
+ * 		Function that prints final temperature, settling time & motor commands.
+ */
+static void Plant_report(const Plant_RunType *run_Ptr, unsigned long seconds)
+{
+	unsigned long second;
+	unsigned long settled = 0;
+	double mean = 0;
+	double minimum = 1e9;
+	double maximum = -1e9;
+	double temp;
+
+	for (second = seconds - PLANT_FINAL_SECONDS; second < seconds; second++)
+	{
+		temp = (*run_Ptr).history[second];
+		mean += temp / PLANT_FINAL_SECONDS;
+		minimum = (temp < minimum) ? temp : minimum;
+		maximum = (temp > maximum) ? temp : maximum;
+	}
+	for (second = 0; second < seconds; second++)
+	{
+		if (fabs((*run_Ptr).history[second] - mean) > PLANT_SETTLE_BAND)
+		{
+			settled = second + 1;
+		}
+	}
+	printf("%-6s final %5.1f C (+/-%.2f)  settled %4lu s  commands %6lu (%.2f/s)\n",
+			(*run_Ptr).name, mean, (maximum - minimum) / 2, settled, (*run_Ptr).commands,
+			(double) (*run_Ptr).commands / seconds);
+}
+
+/*
+ * [Function Name]	: main
+ * [Description]	:
+ * 		Runs both controllers on the same plant & prints their reports.
+ */
+int main(int argc, char **argv)
+{
+	Plant_RunType bands = { "bands", PLANT_START_TEMP, 0, 0, NULL };
+	Plant_RunType pi = { "pi", PLANT_START_TEMP, 0, 0, NULL };
+	unsigned long seconds = PLANT_DEFAULT_SECONDS;
+	unsigned long ms;
+	uint8 speed;
+	int verbose = 0;
+	int arg;
+
+	for (arg = 1; arg < argc; arg++)
+	{
+		if ((strcmp(argv[arg], "-t") == 0) && (arg + 1 < argc))
+		{
+			seconds = strtoul(argv[++arg], NULL, 10);
+		}
+		else if (strcmp(argv[arg], "-v") == 0)
+		{
+			verbose = 1;
+		}
+		else
+		{
+			fprintf(stderr, "usage: %s [-t SECONDS] [-v]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (seconds < PLANT_FINAL_SECONDS)
+	{
+		seconds = PLANT_FINAL_SECONDS;
+	}
+	bands.history = calloc(seconds, sizeof(double));
+	pi.history = calloc(seconds, sizeof(double));
+	Filter_medianInit(&g_tempMedian);
+	Filter_EMAInit(&g_tempEMA, SENSOR_EMA_SHIFT);
+	Pid_init(&g_fanPid, &g_fanPidConfig, FAN_TEMP_SETPOINT);
+
+	for (ms = 0; ms < seconds * 1000; ms += PLANT_STEP_MS)
+	{
+		if ((ms % BANDS_LOOP_MS) == 0)
+		{
+			Plant_sense(bands.temp);
+			bands.speed = Plant_bands();
+			bands.commands++;
+		}
+		if ((ms % CONTROL_PERIOD_MS) == 0)
+		{
+			Plant_sense(pi.temp);
+			speed = Plant_pi();
+			if (speed != pi.speed)
+			{
+				pi.speed = speed;
+				pi.commands++;
+			}
+		}
+		Plant_step(&bands);
+		Plant_step(&pi);
+		if (((ms + PLANT_STEP_MS) % 1000) == 0)
+		{
+			bands.history[ms / 1000] = bands.temp;
+			pi.history[ms / 1000] = pi.temp;
+			if (verbose)
+			{
+				printf("%4lu s  bands %5.1f C %3u%%  pi %5.1f C %3u%%\n", ms / 1000 + 1,
+						bands.temp, bands.speed, pi.temp, pi.speed);
+			}
+		}
+	}
+	Plant_report(&bands, seconds);
+	Plant_report(&pi, seconds);
+	free(bands.history);
+	free(pi.history);
+	return 0;
+}
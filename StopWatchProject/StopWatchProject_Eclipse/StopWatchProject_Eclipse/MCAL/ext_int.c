@@ -0,0 +1,357 @@
+/******************************************************************************
+ * Module: External Interrupts
+ * File Name: ext_int.c
+ * Description: Source file for external interrupts (INT0/INT1/INT2) driver.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <avr/interrupt.h>				/* For ISR of external interrupts */
+#include <avr/io.h>						/* For external interrupts registers usage */
+#include "../common_macros.h"			/* For common macros usage */
+#include "../MCAL/gpio.h"				/* For external interrupts pins */
+#include "ext_int.h"					/* For external interrupts prototypes & definitions */
+
+/*******************************************************************************
+ *                     External Interrupts Hardware Registers                  *
+ *******************************************************************************/
+/*
+ * MCUCR register bits description:
+ *
+ * 		ISC11:10/ISC01:00 = (00) The low level of INT1/INT0 generates an interrupt request.
+ * 				   		 	(01) Any logical change on INT1/INT0 generates an interrupt request.
+ * 				   		 	(10) The falling edge of INT1/INT0 generates an interrupt request.
+ * 				   		 	(11) The rising edge of INT1/INT0 generates an interrupt request.
+ *
+ * MCUCSR register bits description:
+ *
+ * 		ISC2		 = (0) The falling edge of INT2 generates an interrupt request.
+ * 			  	   	   (1) The rising edge of INT2 generates an interrupt request.
+ * 			  	   	   (INT2 MUST BE DISABLED WHILE CHANGING ISC2, THEN IT'S FLAG CLEARED)
+ *
+ * GICR register bits description:
+ *
+ * 		INT1/INT0/INT2 = (0) External interrupt request disable.
+ * 			  	   	   	 (1) External interrupt request enable.
+ *
+ * GIFR register bits description:
+ *
+ * 		INTF1/INTF0/INTF2 = (0) External interrupt flag unraised. (Automatic clear on interrupt)
+ * 			  		   		(1) External interrupt flag raised. (Automatic clear on interrupt)
+ */
+
+/*******************************************************************************
+ *                            Global Pointers                                  *
+ *******************************************************************************/
+/* Pointers that hold the addresses of the call-back functions */
+
+#if (EXT_INT0_ENABLE == TRUE) && !defined(EXT_INT0_FAST_HANDLER)
+
+static volatile void (*g_extInt0CallBack_Ptr)(void) = NULL_PTR;
+
+#endif
+
+#if (EXT_INT1_ENABLE == TRUE) && !defined(EXT_INT1_FAST_HANDLER)
+
+static volatile void (*g_extInt1CallBack_Ptr)(void) = NULL_PTR;
+
+#endif
+
+#if (EXT_INT2_ENABLE == TRUE) && !defined(EXT_INT2_FAST_HANDLER)
+
+static volatile void (*g_extInt2CallBack_Ptr)(void) = NULL_PTR;
+
+#endif
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+#if (EXT_INT0_ENABLE == TRUE)
+
+/*
+ * [Interrupt Vector]	: INT0_vect
+ * [Description]		:
+ * 		An interrupt that acts upon sensing the chosen level or edge on INT0.
+ */
+ISR(INT0_vect)
+{
+
+#ifdef EXT_INT0_FAST_HANDLER
+
+	EXT_INT0_FAST_HANDLER(); /* Execute inline handler */
+
+#else
+
+	if (g_extInt0CallBack_Ptr != NULL_PTR) /* If callback function pointer is not void */
+	{
+		(*g_extInt0CallBack_Ptr)(); /* Execute callback function */
+	}
+
+#endif
+
+}
+
+#endif
+
+#if (EXT_INT1_ENABLE == TRUE)
+
+/*
+ * [Interrupt Vector]	: INT1_vect
+ * [Description]		:
+ * 		An interrupt that acts upon sensing the chosen level or edge on INT1.
+ */
+ISR(INT1_vect)
+{
+
+#ifdef EXT_INT1_FAST_HANDLER
+
+	EXT_INT1_FAST_HANDLER(); /* Execute inline handler */
+
+#else
+
+	if (g_extInt1CallBack_Ptr != NULL_PTR) /* If callback function pointer is not void */
+	{
+		(*g_extInt1CallBack_Ptr)(); /* Execute callback function */
+	}
+
+#endif
+
+}
+
+#endif
+
+#if (EXT_INT2_ENABLE == TRUE)
+
+/*
+ * [Interrupt Vector]	: INT2_vect
+ * [Description]		:
+ * 		An interrupt that acts upon sensing the chosen edge on INT2.
+ */
+ISR(INT2_vect)
+{
+
+#ifdef EXT_INT2_FAST_HANDLER
+
+	EXT_INT2_FAST_HANDLER(); /* Execute inline handler */
+
+#else
+
+	if (g_extInt2CallBack_Ptr != NULL_PTR) /* If callback function pointer is not void */
+	{
+		(*g_extInt2CallBack_Ptr)(); /* Execute callback function */
+	}
+
+#endif
+
+}
+
+#endif
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: ExtInt_init
+ * [Description]	:
+ * 		Function that initialize an external interrupt.
+ * 		By default:
+ * 			1. Interrupt pin is set as input & internal pull-up is set as chosen.
+ * 			2. Sense control is set.
+ * 			3. Interrupt flag is cleared.
+ * 			4. Interrupt is enabled.
+ * [Args]	:
+ * [In] Config_Ptr	: Includes interrupt ID, sense control & pull-up state.
+ * [Return]			: Void.
+ */
+void ExtInt_init(const ExtInt_ConfigType *Config_Ptr)
+{
+	/* Setup interrupt pin direction & internal pull-up */
+	switch ((*Config_Ptr).interruptID)
+	{
+		case EXT_INT0:
+			GPIO_setupPinDirection(EXT_INT0_PORT_ID, EXT_INT0_PIN_ID, PIN_INPUT);
+			GPIO_writePin(EXT_INT0_PORT_ID, EXT_INT0_PIN_ID,
+					(*Config_Ptr).pullUpEnable);
+		break;
+		case EXT_INT1:
+			GPIO_setupPinDirection(EXT_INT1_PORT_ID, EXT_INT1_PIN_ID, PIN_INPUT);
+			GPIO_writePin(EXT_INT1_PORT_ID, EXT_INT1_PIN_ID,
+					(*Config_Ptr).pullUpEnable);
+		break;
+		case EXT_INT2:
+			GPIO_setupPinDirection(EXT_INT2_PORT_ID, EXT_INT2_PIN_ID, PIN_INPUT);
+			GPIO_writePin(EXT_INT2_PORT_ID, EXT_INT2_PIN_ID,
+					(*Config_Ptr).pullUpEnable);
+		break;
+	}
+	/* Set sense control (Disables the interrupt) */
+	ExtInt_setSenseControl((*Config_Ptr).interruptID,
+			(*Config_Ptr).senseControl);
+	/* Clear flag & enable interrupt */
+	ExtInt_enable((*Config_Ptr).interruptID);
+}
+
+/*
+ * [Function Name]	: ExtInt_setCallBack
+ * [Description]	:
+ * 		Function that sets the call-back function address of an external
+ * 		interrupt for the upper layer layer.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [In] Ptr2Function	: Indicates call-back function address.
+ * [Return]				: Void.
+ */
+void ExtInt_setCallBack(EXT_INT_ID interruptID, void (*Ptr2Function)(void))
+{
+	switch (interruptID)
+	{
+
+#if (EXT_INT0_ENABLE == TRUE) && !defined(EXT_INT0_FAST_HANDLER)
+
+		case EXT_INT0:
+			g_extInt0CallBack_Ptr = Ptr2Function;
+		break;
+
+#endif
+
+#if (EXT_INT1_ENABLE == TRUE) && !defined(EXT_INT1_FAST_HANDLER)
+
+		case EXT_INT1:
+			g_extInt1CallBack_Ptr = Ptr2Function;
+		break;
+
+#endif
+
+#if (EXT_INT2_ENABLE == TRUE) && !defined(EXT_INT2_FAST_HANDLER)
+
+		case EXT_INT2:
+			g_extInt2CallBack_Ptr = Ptr2Function;
+		break;
+
+#endif
+
+		default:
+			/* DO NOTHING */
+		break;
+	}
+}
+
+/*
+ * [Function Name]	: ExtInt_setSenseControl
+ * [Description]	:
+ * 		Function that changes sense control of an external interrupt, the
+ * 		interrupt is left disabled & must be enabled again by ExtInt_enable.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [In] senseControl	: Indicates required level or edge.
+ * [Return]				: Void.
+ */
+void ExtInt_setSenseControl(EXT_INT_ID interruptID,
+		EXT_INT_SENSE_CONTROL senseControl)
+{
+	/* Disable the interrupt to avoid a false request while changing sense */
+	ExtInt_disable(interruptID);
+	switch (interruptID)
+	{
+		case EXT_INT0:
+			/* Clear previous sense value & write new value in ISC01:00 */
+			OVERWRITE_REG(MCUCR, 0xFC, senseControl);
+		break;
+		case EXT_INT1:
+			/* Clear previous sense value & write new value in ISC11:10 */
+			OVERWRITE_REG(MCUCR, 0xF3, senseControl << 2);
+		break;
+		case EXT_INT2:
+			/* INT2 is edge triggered only */
+			if (senseControl == EXT_INT_RISING_EDGE)
+			{
+				SET_BIT(MCUCSR, ISC2);
+			}
+			else
+			{
+				CLEAR_BIT(MCUCSR, ISC2);
+			}
+		break;
+	}
+}
+
+/*
+ * [Function Name]	: ExtInt_enable
+ * [Description]	:
+ * 		Function that enables an external interrupt after clearing it's flag.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [Return]				: Void.
+ */
+void ExtInt_enable(EXT_INT_ID interruptID)
+{
+	/* Flags are cleared by writing (LOGIC_HIGH), write only the required flag */
+	switch (interruptID)
+	{
+		case EXT_INT0:
+			GIFR = (1 << INTF0);
+			SET_BIT(GICR, INT0);
+		break;
+		case EXT_INT1:
+			GIFR = (1 << INTF1);
+			SET_BIT(GICR, INT1);
+		break;
+		case EXT_INT2:
+			GIFR = (1 << INTF2);
+			SET_BIT(GICR, INT2);
+		break;
+	}
+}
+
+/*
+ * [Function Name]	: ExtInt_disable
+ * [Description]	:
+ * 		Function that disables an external interrupt without changing it's settings.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [Return]				: Void.
+ */
+void ExtInt_disable(EXT_INT_ID interruptID)
+{
+	switch (interruptID)
+	{
+		case EXT_INT0:
+			CLEAR_BIT(GICR, INT0);
+		break;
+		case EXT_INT1:
+			CLEAR_BIT(GICR, INT1);
+		break;
+		case EXT_INT2:
+			CLEAR_BIT(GICR, INT2);
+		break;
+	}
+}
+
+/*
+ * [Function Name]	: ExtInt_deInit
+ * [Description]	:
+ * 		Function that clears all settings of an external interrupt.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [Return]				: Void.
+ */
+void ExtInt_deInit(EXT_INT_ID interruptID)
+{
+	/* Disable interrupt & return sense control to low level */
+	ExtInt_setSenseControl(interruptID, EXT_INT_LOW_LEVEL);
+	/* Remove call-back function */
+	ExtInt_setCallBack(interruptID, NULL_PTR);
+	/* Clear interrupt flag */
+	switch (interruptID)
+	{
+		case EXT_INT0:
+			GIFR = (1 << INTF0);
+		break;
+		case EXT_INT1:
+			GIFR = (1 << INTF1);
+		break;
+		case EXT_INT2:
+			GIFR = (1 << INTF2);
+		break;
+	}
+}
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Module: External Interrupts
+ * File Name: ext_int.h
+ * Description: Header file for external interrupts (INT0/INT1/INT2) driver.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#ifndef EXT_INT_H_
+#define EXT_INT_H_
+
+#include "../std_types.h"		/* To use standard defined types */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Choose interrupts to enable, disable never used interrupts to decrease code size */
+#define EXT_INT0_ENABLE			TRUE
+#define EXT_INT1_ENABLE			TRUE
+#define EXT_INT2_ENABLE			TRUE
+
+/*
+ * ISR fast path:
+ * 		Define EXT_INTx_FAST_HANDLER() as a short inline statement to bind it
+ * 		directly to the vector instead of the call-back pointer. The compiler then
+ * 		saves only the registers the statement uses, where an indirect call forces
+ * 		saving every call-clobbered register. The call-back is ignored when defined.
+ *
+ * 		The statement is compiled inside ext_int.c, so define it here & declare
+ * 		here every application variable it uses, the variable itself is still
+ * 		defined once in the application:
+ *
+ * 			extern volatile uint8 g_buttonEvent;
+ * 			#define EXT_INT0_FAST_HANDLER()	(g_buttonEvent = TRUE)
+ */
+
+/* External interrupts hardware ports & pins IDs */
+#define EXT_INT0_PORT_ID		PORTD_ID
+#define EXT_INT0_PIN_ID			PIN2_ID
+#define EXT_INT1_PORT_ID		PORTD_ID
+#define EXT_INT1_PIN_ID			PIN3_ID
+#define EXT_INT2_PORT_ID		PORTB_ID
+#define EXT_INT2_PIN_ID			PIN2_ID
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+/*
+ * [Enumerate Name]	: EXT_INT_ID
+ * [Description]	:
+ * 		An enumerate that defines external interrupts IDs.
+ */
+typedef enum
+{
+	EXT_INT0, EXT_INT1, EXT_INT2
+} EXT_INT_ID;
+
+/*
+ * [Enumerate Name]	: EXT_INT_SENSE_CONTROL
+ * [Description]	:
+ * 		An enumerate that defines external interrupts sense control,
+ * 		INT2 only supports falling & rising edges.
+ */
+typedef enum
+{
+	EXT_INT_LOW_LEVEL,
+	EXT_INT_ANY_CHANGE,
+	EXT_INT_FALLING_EDGE,
+	EXT_INT_RISING_EDGE
+} EXT_INT_SENSE_CONTROL;
+
+/*******************************************************************************
+ *                                 Structures                                  *
+ *******************************************************************************/
+/*
+ * [Structure Name]	: ExtInt_ConfigType
+ * [Description]	:
+ * 		A structure in which it's instance hold interrupt ID, sense control
+ * 		& internal pull-up state in 1 byte to be used in ExtInt_init.
+ */
+typedef struct
+{
+	EXT_INT_ID interruptID :2;
+	EXT_INT_SENSE_CONTROL senseControl :2;
+	uint8 pullUpEnable :1;
+	uint8 :0;
+} ExtInt_ConfigType;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/*
+ * [Function Name]	: ExtInt_init
+ * [Description]	:
+ * 		Function that initialize an external interrupt.
+ * 		By default:
+ * 			1. Interrupt pin is set as input & internal pull-up is set as chosen.
+ * 			2. Sense control is set.
+ * 			3. Interrupt flag is cleared.
+ * 			4. Interrupt is enabled.
+ * [Args]	:
+ * [In] Config_Ptr	: Includes interrupt ID, sense control & pull-up state.
+ * [Return]			: Void.
+ */
+void ExtInt_init(const ExtInt_ConfigType *Config_Ptr);
+
+/*
+ * [Function Name]	: ExtInt_setCallBack
+ * [Description]	:
+ * 		Function that sets the call-back function address of an external
+ * 		interrupt for the upper layer layer.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [In] Ptr2Function	: Indicates call-back function address.
+ * [Return]				: Void.
+ */
+void ExtInt_setCallBack(EXT_INT_ID interruptID, void (*Ptr2Function)(void));
+
+/*
+ * [Function Name]	: ExtInt_setSenseControl
+ * [Description]	:
+ * 		Function that changes sense control of an external interrupt.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [In] senseControl	: Indicates required level or edge.
+ * [Return]				: Void.
+ */
+void ExtInt_setSenseControl(EXT_INT_ID interruptID,
+		EXT_INT_SENSE_CONTROL senseControl);
+
+/*
+ * [Function Name]	: ExtInt_enable
+ * [Description]	:
+ * 		Function that enables an external interrupt after clearing it's flag.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [Return]				: Void.
+ */
+void ExtInt_enable(EXT_INT_ID interruptID);
+
+/*
+ * [Function Name]	: ExtInt_disable
+ * [Description]	:
+ * 		Function that disables an external interrupt without changing it's settings.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [Return]				: Void.
+ */
+void ExtInt_disable(EXT_INT_ID interruptID);
+
+/*
+ * [Function Name]	: ExtInt_deInit
+ * [Description]	:
+ * 		Function that clears all settings of an external interrupt.
+ * [Args]	:
+ * [In] interruptID		: Indicates interrupt ID.
+ * [Return]				: Void.
+ */
+void ExtInt_deInit(EXT_INT_ID interruptID);
+
+#endif /* EXT_INT_H_ */
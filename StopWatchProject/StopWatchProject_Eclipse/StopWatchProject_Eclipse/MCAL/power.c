@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Module: Power
+ * File Name: power.c
+ * Description: Source file for sleep modes power management driver.
+ * Author: Mohamed Badr
+ *******************************************************************************/
+
+#include <avr/interrupt.h>				/* For enabling interrupts before sleeping */
+#include <avr/sleep.h>					/* For sleep modes */
+#include "power.h"						/* For power prototypes & definitions */
+
+/*******************************************************************************
+ *                            Power Useful Notes                               *
+ *******************************************************************************/
+/*
+ * 		Race free sleep:
+ * 			CLEAR I-bit -> check for work -> no work -> SEI -> SLEEP
+ * 		The instruction after SEI is always executed before a pending interrupt,
+ * 		so an interrupt raised after the check is taken after SLEEP and wakes
+ * 		the CPU up directly.
+ *
+ * 		ADC noise reduction mode starts a conversion on entry if the ADC is
+ * 		enabled & idle, it's interrupt wakes the CPU when the result is ready.
+ */
+
+/*******************************************************************************
+ *                              Global Variables                               *
+ *******************************************************************************/
+/* Preferred sleep mode & the mode entered by Power_sleep */
+static POWER_SLEEP_MODE g_preferredMode = POWER_IDLE_MODE;
+static POWER_SLEEP_MODE g_sleepMode = POWER_IDLE_MODE;
+/* Registered wake-up sources, a bit for each source */
+static uint16 g_wakeupSources = 0;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Power_selectMode
+ * [Description]	:
+ * 		Function that chooses the sleep mode after the registry changes.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void Power_selectMode(void);
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+/*
+ * [Function Name]	: Power_selectMode
+ * [Description]	:
+ * 		Function that chooses the sleep mode after the registry changes.
+ * [Args]		: Void.
+ * [Return]		: Void.
+ */
+static void Power_selectMode(void)
+{
+	if ((g_preferredMode == POWER_ADC_NOISE_REDUCTION_MODE)
+			&& ((g_wakeupSources & ~POWER_ADC_NOISE_REDUCTION_WAKEUPS) == 0))
+	{
+		g_sleepMode = POWER_ADC_NOISE_REDUCTION_MODE;
+	}
+	else
+	{
+		g_sleepMode = POWER_IDLE_MODE;
+	}
+}
+
+/*
+ * [Function Name]	: Power_init
+ * [Description]	:
+ * 		Function that sets the preferred sleep mode & empties wake-up sources registry.
+ * [Args]	:
+ * [In] mode	: Indicates preferred sleep mode.
+ * [Return]		: Void.
+ */
+void Power_init(POWER_SLEEP_MODE mode)
+{
+	g_preferredMode = mode;
+	g_wakeupSources = 0;
+	Power_selectMode();
+}
+
+/*
+ * [Function Name]	: Power_registerWakeup
+ * [Description]	:
+ * 		Function that adds an interrupt source the application waits for to
+ * 		the registry.
+ * [Args]	:
+ * [In] source	: Indicates wake-up source.
+ * [Return]		: Void.
+ */
+void Power_registerWakeup(POWER_WAKEUP_SOURCE source)
+{
+	g_wakeupSources |= (1u << source);
+	Power_selectMode();
+}
+
+/*
+ * [Function Name]	: Power_unregisterWakeup
+ * [Description]	:
+ * 		Function that removes an interrupt source from the registry.
+ * [Args]	:
+ * [In] source	: Indicates wake-up source.
+ * [Return]		: Void.
+ */
+void Power_unregisterWakeup(POWER_WAKEUP_SOURCE source)
+{
+	g_wakeupSources &= ~(1u << source);
+	Power_selectMode();
+}
+
+/*
+ * [Function Name]	: Power_getSleepMode
+ * [Description]	:
+ * 		Function that gets the sleep mode Power_sleep enters, the preferred
+ * 		mode if every registered source can wake the CPU from it, otherwise
+ * 		idle mode.
+ * [Args]		: Void.
+ * [Return]		: Sleep mode.
+ */
+POWER_SLEEP_MODE Power_getSleepMode(void)
+{
+	return g_sleepMode;
+}
+
+/*
+ * [Function Name]	: Power_sleep
+ * [Description]	:
+ * 		Function that sleeps until the next interrupt. Call it with global
+ * 		interrupt disabled right after finding no work, the I-bit is set by the
+ * 		instruction before sleeping so an interrupt raised after the check wakes
+ * 		the CPU instead of being slept through. Returns without sleeping if no
+ * 		wake-up source is registered.
+ * [Args]		: Void.
+ * [Return]		: Void, global interrupt is enabled on return.
+ */
+void Power_sleep(void)
+{
+	if (g_wakeupSources == 0)
+	{
+		/* Nothing would ever wake the CPU */
+		sei();
+		return;
+	}
+	/* Set on every sleep as other drivers may enter other modes by themselves */
+	if (g_sleepMode == POWER_ADC_NOISE_REDUCTION_MODE)
+	{
+		set_sleep_mode(SLEEP_MODE_ADC);
+	}
+	else
+	{
+		set_sleep_mode(SLEEP_MODE_IDLE);
+	}
+	sleep_enable();
+	sei(); /* Takes effect after the next instruction */
+	sleep_cpu();
+	sleep_disable();
+}
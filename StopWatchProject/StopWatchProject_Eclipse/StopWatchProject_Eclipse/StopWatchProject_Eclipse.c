@@ -6,128 +6,290 @@
  */
 
 #include <avr/io.h>				// Include avr input output library
-#include <util/delay.h>			// Include time delay library
 #include <avr/interrupt.h>		// Include avr interrupt library
+#include "MCAL/ext_int.h"		// Include external interrupts driver
+#include "MCAL/power.h"			// Include sleep modes driver
 
-unsigned char hours = 0;		// Hours counted global variable
-unsigned char minutes = 0;		// Minutes counted global variable
-unsigned char seconds = 0;		// Seconds counted global variable
+/* Number of splits kept, oldest split is overwritten when full (must be power of 2) */
+#define SPLITS_NUMBER		8
+/* Timer1 counts in one 10 ms tick, 1 Mhz clock with pre-scaler of 8 gives 8 us per count */
+#define TICK_COUNTS			1250
+/* Time a captured split stays on display, in 10 ms ticks */
+#define SPLIT_HOLD_TICKS	200
+/* Lap button edges ignored after a press to remove contact bouncing, in display
+ * refresh periods of 1.664 ms (200 ms), counted while paused too */
+#define SPLIT_LOCKOUT_REFRESHES	120
 
-/* Timer1 interrupt that handles stopwatch time increament */
+#if ((SPLITS_NUMBER & (SPLITS_NUMBER - 1)) != 0)
+#error "Number of splits should be a power of 2"
+#endif
+
+/* Time is kept as packed BCD, high nibble is ten's digit and low nibble is unit's digit */
+typedef struct {
+	unsigned char hundredths;	// Hundredths of second counted
+	unsigned char seconds;		// Seconds counted
+	unsigned char minutes;		// Minutes counted
+	unsigned char hours;		// Hours counted
+} Time;
+
+/* Split time with Timer1 counts inside it's 10 ms tick (8 us resolution) */
+typedef struct {
+	Time time;
+	unsigned short counts;
+} Split;
+
+volatile Time time = { 0 };		// Stopwatch time counted by Timer1 interrupt
+
+volatile Split splits[SPLITS_NUMBER];	// Splits ring buffer filled by capture interrupt
+volatile unsigned char splitsHead = 0;	// Index of next split to be written
+volatile unsigned char splitsCount = 0;	// Number of splits stored
+volatile unsigned char splitHold = 0;	// Ticks left while showing last split
+volatile unsigned char splitLockout = 0;	// Refresh periods left while ignoring lap button
+volatile unsigned char splitRecall = 0;	// Split shown next by lap while paused, 0 is the latest
+
+volatile unsigned char digits[6] = { 0 };	// Digits values shown by display refresh interrupt
+unsigned char currentDigit = 0;				// Digit shown by display refresh interrupt
+
+/* Fill digits buffer from a time, shows MM SS hh in the first hour then HH MM SS */
+void Display_update(const volatile Time *time_Ptr) {
+	if ((*time_Ptr).hours == 0) {
+		digits[0] = (*time_Ptr).hundredths & 0x0F;	// Obtain hundredths unit's value
+		digits[1] = (*time_Ptr).hundredths >> 4;	// Obtain hundredths ten's value
+		digits[2] = (*time_Ptr).seconds & 0x0F;		// Obtain seconds unit's value
+		digits[3] = (*time_Ptr).seconds >> 4;		// Obtain seconds ten's value
+		digits[4] = (*time_Ptr).minutes & 0x0F;		// Obtain minutes unit value
+		digits[5] = (*time_Ptr).minutes >> 4;		// Obtain minutes ten's value
+	} else {
+		digits[0] = (*time_Ptr).seconds & 0x0F;		// Obtain seconds unit's value
+		digits[1] = (*time_Ptr).seconds >> 4;		// Obtain seconds ten's value
+		digits[2] = (*time_Ptr).minutes & 0x0F;		// Obtain minutes unit value
+		digits[3] = (*time_Ptr).minutes >> 4;		// Obtain minutes ten's value
+		digits[4] = (*time_Ptr).hours & 0x0F;		// Obtain hours unit value
+		digits[5] = (*time_Ptr).hours >> 4;			// Obtain hours ten's value
+	}
+}
+
+/* Increase a packed BCD value by one, carry to ten's digit when unit's digit passes 9 */
+unsigned char Bcd_increment(unsigned char value) {
+	value++;
+	if ((value & 0x0F) == 0x0A) {
+		value += 0x06;
+	}
+	return value;
+}
+
+/* Increase a time by 10 ms, when reaching 24 hours start counting from 0 again */
+void Time_increment(volatile Time *time_Ptr) {
+	(*time_Ptr).hundredths = Bcd_increment((*time_Ptr).hundredths);
+	if ((*time_Ptr).hundredths == 0xA0) {
+		(*time_Ptr).hundredths = 0;
+		(*time_Ptr).seconds = Bcd_increment((*time_Ptr).seconds);
+		if ((*time_Ptr).seconds == 0x60) {
+			(*time_Ptr).seconds = 0;
+			(*time_Ptr).minutes = Bcd_increment((*time_Ptr).minutes);
+			if ((*time_Ptr).minutes == 0x60) {
+				(*time_Ptr).minutes = 0;
+				(*time_Ptr).hours = Bcd_increment((*time_Ptr).hours);
+				if ((*time_Ptr).hours == 0x24) {
+					(*time_Ptr).hours = 0;
+				}
+			}
+		}
+	}
+}
+
+/* Copy a stored split, index 0 is the latest split, returns 0 if not stored */
+unsigned char Stopwatch_getSplit(unsigned char index, Split *split_Ptr) {
+	unsigned char sreg = SREG;	// Save interrupts state
+	unsigned char found = 0;
+	cli();						// Capture interrupt must not write while copying
+	if (index < splitsCount) {
+		*split_Ptr = splits[(splitsHead - 1 - index) & (SPLITS_NUMBER - 1)];
+		found = 1;
+	}
+	SREG = sreg;				// Restore interrupts state
+	return found;
+}
+
+/* Timer0 interrupt that shows one digit each 1.664 ms, all 6 digits are refreshed at 100 Hz */
+ISR(TIMER0_COMP_vect) {
+	PORTA &= ~0x3F;				// Disable all anodes before changing value to avoid ghosting
+	PORTC = (PORTC & 0xF0) | digits[currentDigit];	// Set digit value
+	PORTA |= (1 << currentDigit);	// Enable digit anode
+	currentDigit++;				// Move to next digit
+	if (currentDigit == 6) {
+		currentDigit = 0;
+	}
+	if (splitLockout != 0) {
+		splitLockout--;
+	}
+}
+
+/* Timer1 interrupt that handles stopwatch time increament every 10 ms */
 ISR(TIMER1_COMPA_vect) {
-	seconds++;					// Increase a second every second
-	/* Increase a minute every 60 seconds and set seconds to 0 */
-	if (seconds == 60) {
-		seconds = 0;
-		minutes++;
+	Time_increment(&time);		// Increase 10 ms
+	if (splitHold != 0) {
+		splitHold--;			// Keep showing last split
+	} else {
+		Display_update(&time);	// Show new time
 	}
-	/* Increase an hourr every 60 minutes and set minutes to 0*/
-	if (minutes == 60) {
-		minutes = 0;
-		hours++;
+}
+
+/*
+ * Show the stored splits one per lap press while paused, from the latest to
+ * the oldest then the paused time again
+ */
+void Stopwatch_recallSplit(void) {
+	Split split;
+	if (Stopwatch_getSplit(splitRecall, &split)) {
+		Display_update(&split.time);	// Show the split
+		splitRecall++;
+	} else {
+		Display_update(&time);	// No older split, show paused time
+		splitRecall = 0;
+	}
+}
+
+/*
+ * Timer1 capture interrupt of lap button on ICP1 (PD6), the hardware latches
+ * Timer1 count at the edge so the split is exact whatever the interrupt latency is
+ */
+ISR(TIMER1_CAPT_vect) {
+	unsigned short counts = ICR1;	// Read captured count first
+	unsigned char index = splitsHead;
+	if (splitLockout != 0) {
+		return;					// Bouncing of last press
+	}
+	splitLockout = SPLIT_LOCKOUT_REFRESHES;
+	if ((TCCR1B & 0x07) == 0) {
+		Stopwatch_recallSplit();	// Stopwatch paused, show the stored splits
+		return;
+	}
+	splits[index].time = time;
+	/*
+	 * Compare interrupt has lower priority, if it's flag is pending and the
+	 * count was captured after the match, time was not increased yet
+	 */
+	if ((TIFR & (1 << OCF1A)) && (counts < (TICK_COUNTS / 2))) {
+		Time_increment(&splits[index].time);
 	}
-	/* When reacing 24 hours start counting from 0 again */
-	if (hours > 23) {
-		seconds = 0;
-		seconds = 0;
-		hours = 0;
+	splits[index].counts = counts;
+	splitsHead = (index + 1) & (SPLITS_NUMBER - 1);
+	if (splitsCount < SPLITS_NUMBER) {
+		splitsCount++;
 	}
+	splitHold = SPLIT_HOLD_TICKS;
+	Display_update(&splits[index].time);	// Show the split
 }
 
-/* Interrupt 0 activates upon resetting */
-ISR(INT0_vect) {
-	hours = 0;					// Set hours to 0
-	minutes = 0;				// Set minutes to 0
-	seconds = 0;				// Set seconds to 0
-	/* Turn TIMER1 on and set pre-scaler to clock/64 */
-	TCCR1B |= (1 << CS10);
+/* Interrupt 0 call-back activates upon resetting */
+void Stopwatch_reset(void) {
+	time.hours = 0;				// Set hours to 0
+	time.minutes = 0;			// Set minutes to 0
+	time.seconds = 0;			// Set seconds to 0
+	time.hundredths = 0;		// Set hundredths to 0
+	splitsHead = 0;				// Remove all splits
+	splitsCount = 0;
+	splitHold = 0;
+	splitLockout = 0;
+	splitRecall = 0;
+	Display_update(&time);		// Show new time
+	/* Turn TIMER1 on and set pre-scaler to clock/8 */
+	TCCR1B &= ~(1 << CS10);
 	TCCR1B |= (1 << CS11);
 	TCCR1B &= ~(1 << CS12);
 	TCNT1 = 0;					// Reset counter value to 0
 }
 
-/* Interrupt 1 activates upon pausing */
-ISR(INT1_vect) {
+/* Interrupt 1 call-back activates upon pausing */
+void Stopwatch_pause(void) {
 	/* Turn TIMER1 off without changing time values */
 	TCCR1B &= ~(1 << CS10);
 	TCCR1B &= ~(1 << CS11);
 	TCCR1B &= ~(1 << CS12);
+	splitHold = 0;				// Show paused time instead of last split
+	splitRecall = 0;			// Lap shows the latest split first
+	Display_update(&time);
 }
 
-/* Interrupt 2 activates upon resuming */
-ISR(INT2_vect) {
-	/* Turn TIMER1 on with pre-scaler clock/64 without changing time values */
-	TCCR1B |= (1 << CS10);
+/* Interrupt 2 call-back activates upon resuming */
+void Stopwatch_resume(void) {
+	/* Turn TIMER1 on with pre-scaler clock/8 without changing time values */
+	TCCR1B &= ~(1 << CS10);
 	TCCR1B |= (1 << CS11);
 	TCCR1B &= ~(1 << CS12);
 }
 
-/* Interrupt 0 Initialization */
-void INT0_Init(void) {
-	/* Trigger INT0 with the falling edge */
-	MCUCR &= ~(1 << ISC00);
-	MCUCR |= (1 << ISC01);
-	GICR |= (1 << INT0);		// Enable external interrupt pin at INT0
-}
-
-/* Interrupt 1 Initialization */
-void INT1_Init(void) {
-	/* Trigger INT1 with the rising edge */
-	MCUCR |= (1 << ISC10);
-	MCUCR &= ~(1 << ISC11);
-	GICR |= (1 << INT1);    	// Enable external interrupt pin at INT1
-}
-
-/* Interrupt 2 Initialization */
-void INT2_Init(void) {
-	MCUCSR &= ~(1 << ISC2);     // Trigger INT2 with the falling edge
-	GICR |= (1 << INT2);		// Enable external interrupt pin at INT2
+/* External interrupts Initialization */
+void Buttons_Init(void) {
+	/* Reset button on INT0 with the falling edge and internal pull-up */
+	ExtInt_ConfigType resetConfig = { EXT_INT0, EXT_INT_FALLING_EDGE, TRUE };
+	/* Pause button on INT1 with the rising edge and external pull-down */
+	ExtInt_ConfigType pauseConfig = { EXT_INT1, EXT_INT_RISING_EDGE, FALSE };
+	/* Resume button on INT2 with the falling edge and internal pull-up */
+	ExtInt_ConfigType resumeConfig = { EXT_INT2, EXT_INT_FALLING_EDGE, TRUE };
+	ExtInt_setCallBack(EXT_INT0, Stopwatch_reset);
+	ExtInt_setCallBack(EXT_INT1, Stopwatch_pause);
+	ExtInt_setCallBack(EXT_INT2, Stopwatch_resume);
+	ExtInt_init(&resetConfig);	// Enable external interrupt 0 (INT0)
+	ExtInt_init(&pauseConfig);	// Enable external interrupt 1 (INT1)
+	ExtInt_init(&resumeConfig);	// Enable external interrupt 2 (INT2)
 }
 
 /* Timer1 Initialization */
 void Timer1_CTC_Init(void) {
 	TCNT1 = 0;					// Set timer initial value to 0
-	/* Set compare value to 15625 representing 1 second
-	 * for 1 Mhz clock with pre-scaler of 64*/
-	OCR1A = 15625;
+	/* Set compare value to 1249 representing 10 ms (1250 counts)
+	 * for 1 Mhz clock with pre-scaler of 8 */
+	OCR1A = TICK_COUNTS - 1;
 	TCCR1A |= (1 << FOC1A);		// Enable force compare unit A bit
-	/* Set pre-scaler to clock/64 and enable compare mode */
-	TCCR1B |= (1 << WGM12) | (1 << CS11) | (1 << CS10);
-	TIMSK = (1 << OCIE1A);		// Enable compare A match interrupt
+	/* Set pre-scaler to clock/8 and enable compare mode */
+	TCCR1B |= (1 << WGM12) | (1 << CS11);
+	TIMSK |= (1 << OCIE1A);		// Enable compare A match interrupt
+}
+
+/* Lap button on ICP1 (PD6) with internal pull-up, captured on falling edge */
+void Lap_Init(void) {
+	DDRD &= ~(1 << PD6);		// Set PD6 as input pin
+	PORTD |= (1 << PD6);		// Enable internal pull-up
+	/* Enable noise canceler (4 clock cycles) and capture on falling edge */
+	TCCR1B |= (1 << ICNC1);
+	TCCR1B &= ~(1 << ICES1);
+	TIFR = (1 << ICF1);			// Clear capture flag set while configuring
+	TIMSK |= (1 << TICIE1);		// Enable input capture interrupt
+}
+
+/* Timer0 Initialization */
+void Timer0_CTC_Init(void) {
+	TCNT0 = 0;					// Set timer initial value to 0
+	/* Set compare value to 207 representing 1.664 ms (208 counts)
+	 * for 1 Mhz clock with pre-scaler of 8 */
+	OCR0 = 207;
+	/* Enable force compare, set pre-scaler to clock/8 and enable compare mode */
+	TCCR0 = (1 << FOC0) | (1 << WGM01) | (1 << CS01);
+	TIMSK |= (1 << OCIE0);		// Enable compare match interrupt
 }
 
 int main(void) {
 	sei();						// Enable global interrupt (I bit)
 	DDRA |= 0x3F;				// Set PA0 to PA5 as output pins
-	DDRB &= ~(1 << PB2);		// Set all PORTB as input pins
 	DDRC |= 0x0F;				// Set PC0 to PC3 as output pins
-	DDRD &= ~0x0C;				// Set all PORTD as input pins
 	PORTA &= ~0x3F;				// Initialize all PORTA pins by 0
-	PORTB |= (1 << PB2);		// Enable AVR internal pull-up at PB2
 	PORTC &= ~0x0F;				// Initialize all PORTC pins by 0
-	PORTD |= (1 << PD2);		// Enable AVR internal pull-up at PD2
-	INT0_Init();				// Enable external interrupt 0 (INT0)
-	INT1_Init();				// Enable external interrupt 1 (INT1)
-	INT2_Init();				// Enable external interrupt 2 (INT2)
+	Buttons_Init();				// Enable external interrupts (INT0, INT1 & INT2)
 	Timer1_CTC_Init();			// Enable Timer1
+	Lap_Init();					// Enable lap button capture
+	Timer0_CTC_Init();			// Enable display refresh
+	/* Wake up only by buttons, display refresh and time interrupts */
+	Power_init(POWER_IDLE_MODE);
+	Power_registerWakeup(POWER_WAKEUP_EXT_INT_EDGE);	// INT0 & INT1
+	Power_registerWakeup(POWER_WAKEUP_EXT_INT_LEVEL);	// INT2
+	Power_registerWakeup(POWER_WAKEUP_TIMER0);
+	Power_registerWakeup(POWER_WAKEUP_TIMER1);
 	while (1) {
-		PORTA = (1 << PA0);		// Enable PA0 anode
-		PORTC = seconds % 10;	// Obtain seconds unit's value
-		_delay_us(10);			// Wait 10 micro-seconds
-		PORTA = (1 << PA1);		// Enable PA1 anode
-		PORTC = seconds / 10;	// Obtain seconds ten's value
-		_delay_us(10);			// Wait 10 micro-seconds
-		PORTA = (1 << PA2);		// Enable PA2 anode
-		PORTC = minutes % 10;	// Obtain minutes unit value
-		_delay_us(10);			// Wait 10 micro-seconds
-		PORTA = (1 << PA3);		// Enable PA3 anode
-		PORTC = minutes / 10;	// Obtain minutes ten's value
-		_delay_us(10);			// Wait 10 micro-seconds
-		PORTA = (1 << PA4);		// Enable PA4 anode
-		PORTC = hours % 10;		// Obtain hours unit value
-		_delay_us(10);			// Wait 10 micro-seconds
-		PORTA = (1 << PA5);		// Enable PA5 anode
-		PORTC = hours / 10;		// Obtain hours ten's value
-		_delay_us(10);			// Wait 10 micro-seconds
+		/* Nothing to do, display is refreshed by Timer0 interrupt
+		 * and time is counted by Timer1 interrupt, so sleep */
+		cli();
+		Power_sleep();
 	}
 }